@@ -10,6 +10,11 @@
 #define STBI_MSC_SECURE_CRT
 #include "tiny_gltf.h"
 
+//
+// Load in stb_vorbis (.ogg decoding for the software audio backend)
+//
+#include <stb_vorbis.c>
+
 //
 // Load in VMA
 //
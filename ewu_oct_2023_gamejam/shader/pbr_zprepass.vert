@@ -51,11 +51,13 @@ layout(std140, set = 2, binding = 0) readonly buffer InstancePtrBuffer
 
 // Skeletal Animation/Skinning
 #define MAX_NUM_JOINTS 128
+#define NOT_PRESKINNED 0xFFFFFFFF
 struct SkeletonAnimationNode
 {
 	mat4 matrix;
 	mat4 jointMatrix[MAX_NUM_JOINTS];
 	float jointCount;
+	uint skinnedVertexBase;  // Where skinning.comp put this node's skinned vertices, or NOT_PRESKINNED.
 };
 
 layout (std140, set = 4, binding = 0) readonly buffer SkeletonAnimationNodeCollection
@@ -63,6 +65,17 @@ layout (std140, set = 4, binding = 0) readonly buffer SkeletonAnimationNodeColle
 	SkeletonAnimationNode nodes[];
 } nodeCollection;
 
+struct SkinnedVertex
+{
+	vec4 pos;
+	vec4 normal;
+};
+
+layout (std430, set = 4, binding = 1) readonly buffer SkinnedVertexBuffer
+{
+	SkinnedVertex vertices[];
+} skinnedVertexBuffer;
+
 
 void main()
 {
@@ -73,7 +86,14 @@ void main()
 	uint animatorNodeID = instancePtrBuffer.pointers[gl_BaseInstance].animatorNodeID;
 	mat4 nodeMatrix = nodeCollection.nodes[animatorNodeID].matrix;
 	vec4 locPos;
-	if (nodeCollection.nodes[animatorNodeID].jointCount > 0.0)
+	uint skinnedVertexBase = nodeCollection.nodes[animatorNodeID].skinnedVertexBase;
+	if (skinnedVertexBase != NOT_PRESKINNED)
+	{
+		// Already skinned this frame by skinning.comp
+		SkinnedVertex skinnedVertex = skinnedVertexBuffer.vertices[skinnedVertexBase + uint(gl_VertexIndex)];
+		locPos = modelMatrix * skinnedVertex.pos;
+	}
+	else if (nodeCollection.nodes[animatorNodeID].jointCount > 0.0)
 	{
 		// Is skinned
 		mat4 skinMat =
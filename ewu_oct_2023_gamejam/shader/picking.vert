@@ -50,11 +50,13 @@ layout(std140, set = 2, binding = 0) readonly buffer InstancePtrBuffer
 
 // Skeletal Animation/Skinning
 #define MAX_NUM_JOINTS 128
+#define NOT_PRESKINNED 0xFFFFFFFF
 struct SkeletonAnimationNode
 {
 	mat4 matrix;
 	mat4 jointMatrix[MAX_NUM_JOINTS];
 	float jointCount;
+	uint skinnedVertexBase;  // Where skinning.comp put this node's skinned vertices, or NOT_PRESKINNED.
 };
 
 layout (std140, set = 4, binding = 0) readonly buffer SkeletonAnimationNodeCollection
@@ -62,6 +64,17 @@ layout (std140, set = 4, binding = 0) readonly buffer SkeletonAnimationNodeColle
 	SkeletonAnimationNode nodes[];
 } nodeCollection;
 
+struct SkinnedVertex
+{
+	vec4 pos;
+	vec4 normal;
+};
+
+layout (std430, set = 4, binding = 1) readonly buffer SkinnedVertexBuffer
+{
+	SkinnedVertex vertices[];
+} skinnedVertexBuffer;
+
 
 void main()
 {
@@ -71,7 +84,13 @@ void main()
 	mat4 modelMatrix = objectBuffer.objects[instancePtrBuffer.pointers[gl_BaseInstance].objectID].modelMatrix;
 	SkeletonAnimationNode node = nodeCollection.nodes[instancePtrBuffer.pointers[gl_BaseInstance].animatorNodeID];
 	vec4 locPos;
-	if (node.jointCount > 0.0)
+	if (node.skinnedVertexBase != NOT_PRESKINNED)
+	{
+		// Already skinned this frame by skinning.comp
+		SkinnedVertex skinnedVertex = skinnedVertexBuffer.vertices[node.skinnedVertexBase + uint(gl_VertexIndex)];
+		locPos = modelMatrix * skinnedVertex.pos;
+	}
+	else if (node.jointCount > 0.0)
 	{
 		// Is skinned
 		mat4 skinMat =
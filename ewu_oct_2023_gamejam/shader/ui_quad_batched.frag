@@ -0,0 +1,53 @@
+#version 460
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout (location = 0) in vec2 inUV;
+layout (location = 1) flat in vec4 inTint;
+layout (location = 2) flat in vec4 inNineSlicingBounds;  // x1, x2, y1, y2
+layout (location = 3) flat in int inTextureIndex;
+layout (location = 4) flat in float inUseNineSlicing;
+
+layout (location = 0) out vec4 outFragColor;
+
+
+#define MAX_UI_QUAD_TEXTURES 64
+layout(set = 1, binding = 1) uniform sampler2D uiTextures[MAX_UI_QUAD_TEXTURES];
+
+#define ONE_THIRD 0.333333333333333333333333333
+
+void main()
+{
+	if (inTextureIndex < 0)
+	{
+		outFragColor = inTint;
+		return;
+	}
+
+	vec2 transUV = inUV;
+	if (inUseNineSlicing > 0.0)
+	{
+		float boundX1 = inNineSlicingBounds.x;
+		float boundX2 = inNineSlicingBounds.y;
+		float boundY1 = inNineSlicingBounds.z;
+		float boundY2 = inNineSlicingBounds.w;
+
+		// X
+		if (inUV.x < boundX1)
+			transUV.x = inUV.x / boundX1 * ONE_THIRD;
+		else if (inUV.x < boundX2)
+			transUV.x = mod(inUV.x, boundX1) / boundX1 * ONE_THIRD + ONE_THIRD;
+		else
+			transUV.x = (inUV.x - boundX2) / boundX1 * ONE_THIRD + ONE_THIRD * 2.0;
+
+		// Y
+		if (inUV.y < boundY1)
+			transUV.y = inUV.y / boundY1 * ONE_THIRD;
+		else if (inUV.y < boundY2)
+			transUV.y = mod(inUV.y, boundY1) / boundY1 * ONE_THIRD + ONE_THIRD;
+		else
+			transUV.y = (inUV.y - boundY2) / boundY1 * ONE_THIRD + ONE_THIRD * 2.0;
+	}
+
+	// @NOTE: quads with different textures end up in the same instanced draw, so the index isn't uniform.
+	outFragColor = texture(uiTextures[nonuniformEXT(inTextureIndex)], transUV) * inTint;
+}
@@ -0,0 +1,57 @@
+#version 460
+
+layout (location = 0) in vec3 inPos;
+layout (location = 1) in vec2 inUV;
+
+layout (location = 0) out vec2 outUV;
+layout (location = 1) flat out vec4 outTint;
+layout (location = 2) flat out vec4 outNineSlicingBounds;
+layout (location = 3) flat out int outTextureIndex;
+layout (location = 4) flat out float outUseNineSlicing;
+
+
+// UI Camera Props
+layout(set = 0, binding = 0) uniform UICameraBuffer
+{
+	mat4 projectionView;
+	mat4 screenspaceOrthoView;
+} cameraData;
+
+struct UIQuadInstance
+{
+	vec4 position;
+	vec4 rotation;  // Quaternion (xyzw).
+	vec4 scale;
+	vec4 tint;
+	vec4 nineSlicingBounds;  // x1, x2, y1, y2
+	int textureIndex;        // -1 is a flat color quad.
+	float useNineSlicing;
+	float padding0;
+	float padding1;
+};
+
+layout(std430, set = 1, binding = 0) readonly buffer UIQuadInstanceBuffer
+{
+	UIQuadInstance instances[];
+} instanceBuffer;
+
+
+vec3 rotateByQuat(vec4 q, vec3 v)
+{
+	vec3 t = 2.0 * cross(q.xyz, v);
+	return v + q.w * t + cross(q.xyz, t);
+}
+
+void main()
+{
+	UIQuadInstance quad = instanceBuffer.instances[gl_InstanceIndex];
+
+	outUV = inUV;
+	outTint = quad.tint;
+	outNineSlicingBounds = quad.nineSlicingBounds;
+	outTextureIndex = quad.textureIndex;
+	outUseNineSlicing = quad.useNineSlicing;
+
+	vec3 worldPos = quad.position.xyz + rotateByQuat(quad.rotation, inPos * quad.scale.xyz);
+	gl_Position = cameraData.screenspaceOrthoView * vec4(worldPos, 1.0);
+}
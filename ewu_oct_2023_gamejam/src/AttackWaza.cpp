@@ -0,0 +1,909 @@
+#include "AttackWaza.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+#include <cstring>
+#include "StringHelper.h"
+
+
+namespace waza
+{
+    void parseVec3CommaSeparated(const std::string& vec3Str, vec3& outVec3)
+    {
+        std::string strCopy = vec3Str;
+        std::string::size_type sz;
+        outVec3[0] = std::stof(strCopy, &sz);    strCopy = strCopy.substr(sz + 1);
+        outVec3[1] = std::stof(strCopy, &sz);    strCopy = strCopy.substr(sz + 1);
+        outVec3[2] = std::stof(strCopy);
+    }
+
+    void loadDataFromLine(AttackWaza& newWaza, const std::string& command, const std::vector<std::string>& params)
+    {
+        if (command == "entrance")
+        {
+            newWaza.entranceInputParams.enabled = true;
+            newWaza.entranceInputParams.weaponType = params[0];
+            newWaza.entranceInputParams.movementState = params[1];
+            newWaza.entranceInputParams.inputName = params[2];
+        }
+        else if (command == "animation_state")
+        {
+            newWaza.animationState = params[0];
+        }
+        else if (command == "stamina_cost")
+        {
+            newWaza.staminaCost = std::stoi(params[0]);
+        }
+        else if (command == "stamina_cost_hold")
+        {
+            newWaza.staminaCostHold = std::stoi(params[0]);
+            if (params.size() >= 2)
+                newWaza.staminaCostHoldTimeFrom = std::stoi(params[1]);
+            if (params.size() >= 3)
+                newWaza.staminaCostHoldTimeTo = std::stoi(params[2]);
+        }
+        else if (command == "duration")
+        {
+            newWaza.duration = std::stoi(params[0]);
+        }
+        else if (command == "hold_midair")
+        {
+            newWaza.holdMidair = true;
+            if (params.size() >= 2)
+            {
+                newWaza.holdMidairTimeFrom = std::stoi(params[0]);
+                newWaza.holdMidairTimeTo = std::stoi(params[1]);
+            }
+        }
+        else if (command == "gravity_multiplier")
+        {
+            newWaza.gravityMultiplier = std::stof(params[0]);
+        }
+        else if (command == "velocity_decay")
+        {
+            AttackWaza::VelocityDecaySetting newVelocityDecaySetting;
+            newVelocityDecaySetting.velocityDecay = std::stof(params[0]);
+            newVelocityDecaySetting.executeAtTime = std::stoi(params[1]);
+            newWaza.velocityDecaySettings.push_back(newVelocityDecaySetting);
+        }
+        else if (command == "velocity")
+        {
+            AttackWaza::VelocitySetting newVelocitySetting;
+            vec3 velo;
+            parseVec3CommaSeparated(params[0], velo);
+            glm_vec3_copy(velo, newVelocitySetting.velocity);
+            newVelocitySetting.executeAtTime = std::stoi(params[1]);
+            newWaza.velocitySettings.push_back(newVelocitySetting);
+        }
+        else if (command == "hitscan")
+        {
+            AttackWaza::HitscanFlowNode newHitscanNode;
+            vec3 end1, end2;
+            parseVec3CommaSeparated(params[0], end1);
+            parseVec3CommaSeparated(params[1], end2);
+            glm_vec3_copy(end1, newHitscanNode.nodeEnd1);
+            glm_vec3_copy(end2, newHitscanNode.nodeEnd2);
+            if (params.size() >= 3)
+                newHitscanNode.executeAtTime = std::stoi(params[2]);
+            newWaza.hitscanNodes.push_back(newHitscanNode);
+        }
+        else if (command == "hs_launch_velocity")
+        {
+            parseVec3CommaSeparated(params[0], newWaza.hitscanLaunchVelocity);
+        }
+        else if (command == "hs_rel_position")
+        {
+            parseVec3CommaSeparated(params[0], newWaza.hitscanLaunchRelPosition);
+            if (params.size() >= 2 && params[1] == "ignore_y")
+                newWaza.hitscanLaunchRelPositionIgnoreY = true;
+        }
+        else if (command == "vacuum_suck_in")
+        {
+            newWaza.vacuumSuckIn.enabled = true;
+            parseVec3CommaSeparated(params[0], newWaza.vacuumSuckIn.position);
+            newWaza.vacuumSuckIn.radius = std::stoi(params[1]);
+            newWaza.vacuumSuckIn.strength = std::stoi(params[2]);
+        }
+        else if (command == "force_zone")
+        {
+            newWaza.forceZone.enabled = true;
+            parseVec3CommaSeparated(params[0], newWaza.forceZone.origin);
+            parseVec3CommaSeparated(params[1], newWaza.forceZone.bounds);
+            parseVec3CommaSeparated(params[2], newWaza.forceZone.forceVelocity);
+            newWaza.forceZone.timeFrom = std::stoi(params[3]);
+            newWaza.forceZone.timeTo = std::stoi(params[4]);
+        }
+        else if (command == "chain")
+        {
+            AttackWaza::Chain newChain;
+            newChain.nextWazaName = params[0];
+            newChain.inputTimeWindowStart = std::stoi(params[1]);
+            newChain.inputTimeWindowEnd = std::stoi(params[2]);
+            newChain.inputName = params[3];
+            newWaza.chains.push_back(newChain);
+        }
+        else if (command == "on_hold_cancel")
+        {
+            newWaza.onHoldCancelWazaName = params[0];
+        }
+        else if (command == "on_duration_passed")
+        {
+            newWaza.onDurationPassedWazaName = params[0];
+        }
+        else if (command == "interruptable")
+        {
+            newWaza.interruptable.enabled = true;
+            if (params.size() >= 1)
+                newWaza.interruptable.from = std::stoi(params[0]);
+            if (params.size() >= 2)
+                newWaza.interruptable.to = std::stoi(params[1]);
+        }
+        else
+        {
+            // ERROR
+            std::cerr << "[WAZA LOADING]" << std::endl
+                << "ERROR: Unknown command token: " << command << std::endl;
+        }
+    }
+
+    int32_t getWazaIndexFromName(const std::unordered_map<std::string, int32_t>& wazaNameToIndex, const std::string& wazaName)
+    {
+        if (wazaName == "NULL")  // Special case.
+            return -1;
+
+        auto it = wazaNameToIndex.find(wazaName);
+        if (it != wazaNameToIndex.end())
+            return it->second;
+
+        std::cerr << "[WAZA LOADING]" << std::endl
+            << "ERROR: Waza with name \"" << wazaName << "\" was not found (`getWazaIndexFromName`)." << std::endl;
+        return -1;
+    }
+
+    AttackWaza::WazaInput getInputEnumFromName(const std::string& inputName)
+    {
+        int32_t enumValue = -1;
+        int32_t x = -1;
+        if (inputName.rfind("press_", 0) == 0)
+            x = 0;
+        else if (inputName.rfind("release_", 0) == 0)
+            x = 1;
+
+        int32_t y = -1;
+        std::string suffix = inputName.substr(inputName.find("_") + 1);
+        if (suffix == "x")
+            y = 0;
+        else if (suffix == "a")
+            y = 1;
+        else if (suffix == "x_a")
+            y = 2;
+
+        enumValue = 3 * x + y + 1;  // @COPYPASTA
+
+        if (enumValue < 1)
+        {
+            std::cerr << "[WAZA LOADING]" << std::endl
+                << "ERROR: Waza input \"" << inputName << "\" was not found (`getInputEnumFromName`)." << std::endl;
+            return AttackWaza::WazaInput(0);
+        }
+
+        return AttackWaza::WazaInput(enumValue);
+    }
+
+    AttackWaza* getWazaPtrFromIndex(std::vector<AttackWaza>& wazas, int32_t index)
+    {
+        return (index >= 0 ? &wazas[index] : nullptr);
+    }
+
+    void bakeWazaTimeline(AttackWaza& waza)
+    {
+        using Event = AttackWaza::TimelineEvent;
+
+        waza.timeline.clear();
+        waza.timeline.reserve(waza.velocityDecaySettings.size() + waza.velocitySettings.size() + waza.hitscanNodes.size());
+        for (size_t i = 0; i < waza.velocityDecaySettings.size(); i++)
+            waza.timeline.push_back({ waza.velocityDecaySettings[i].executeAtTime, Event::Type::VELOCITY_DECAY, (uint16_t)i });
+        for (size_t i = 0; i < waza.velocitySettings.size(); i++)
+            waza.timeline.push_back({ waza.velocitySettings[i].executeAtTime, Event::Type::VELOCITY, (uint16_t)i });
+        for (size_t i = 1; i < waza.hitscanNodes.size(); i++)
+            waza.timeline.push_back({ waza.hitscanNodes[i].executeAtTime, Event::Type::HITSCAN, (uint16_t)i });
+
+        // Same time events stay in the order that they used to get searched in (by type, then by file order).
+        std::sort(
+            waza.timeline.begin(),
+            waza.timeline.end(),
+            [](const Event& a, const Event& b) {
+                if (a.executeAtTime != b.executeAtTime)
+                    return a.executeAtTime < b.executeAtTime;
+                if (a.type != b.type)
+                    return a.type < b.type;
+                return a.index < b.index;
+            }
+        );
+    }
+
+    void bakeWazaSet(std::vector<AttackWaza>& wazas)
+    {
+        // @NOTE: the pointers need to get baked again every time `wazas` gets reallocated.
+        for (AttackWaza& waza : wazas)
+        {
+            for (AttackWaza::Chain& chain : waza.chains)
+                chain.nextWazaPtr = getWazaPtrFromIndex(wazas, chain.nextWazaIndex);
+            waza.onHoldCancelWazaPtr = getWazaPtrFromIndex(wazas, waza.onHoldCancelWazaIndex);
+            waza.onDurationPassedWazaPtr = getWazaPtrFromIndex(wazas, waza.onDurationPassedWazaIndex);
+            bakeWazaTimeline(waza);
+        }
+    }
+
+    void resolveWazaSet(std::vector<AttackWaza>& wazas)
+    {
+        //
+        // Bake string references into indices and pointers.
+        //
+        std::unordered_map<std::string, int32_t> wazaNameToIndex;
+        for (size_t i = 0; i < wazas.size(); i++)
+            wazaNameToIndex.emplace(wazas[i].wazaName, (int32_t)i);  // @NOTE: first one wins if there are duplicate names.
+
+        for (AttackWaza& waza : wazas)
+        {
+            if (waza.wazaName == "NULL")
+            {
+                std::cerr << "[WAZA LOADING]" << std::endl
+                    << "ERROR: You can't name a waza state \"NULL\"... it's a keyword!!! Aborting." << std::endl;
+                break;
+            }
+
+            if (waza.entranceInputParams.inputName != "NULL")
+                waza.entranceInputParams.input = getInputEnumFromName(waza.entranceInputParams.inputName);
+
+            for (AttackWaza::Chain& chain : waza.chains)
+            {
+                chain.nextWazaIndex = getWazaIndexFromName(wazaNameToIndex, chain.nextWazaName);
+                chain.input = getInputEnumFromName(chain.inputName);
+            }
+            waza.onHoldCancelWazaIndex = getWazaIndexFromName(wazaNameToIndex, waza.onHoldCancelWazaName);
+            waza.onDurationPassedWazaIndex = getWazaIndexFromName(wazaNameToIndex, waza.onDurationPassedWazaName);
+        }
+
+        bakeWazaSet(wazas);
+    }
+
+    void initWazaSetFromFile(std::vector<AttackWaza>& wazas, const std::string& fname)
+    {
+        std::ifstream wazaFile(fname);
+        if (!wazaFile.is_open())
+        {
+            std::cerr << "[WAZA LOADING]" << std::endl
+                << "WARNING: file \"" << fname << "\" not found, thus could not load the waza action commands." << std::endl;
+            return;
+        }
+
+        //
+        // Parse the commands
+        //
+        AttackWaza newWaza;
+        std::string line;
+        for (size_t lineNum = 1; std::getline(wazaFile, line); lineNum++)  // @COPYPASTA with SceneManagement.cpp
+        {
+            // Prep line data
+            std::string originalLine = line;
+
+            size_t found = line.find('#');
+            if (found != std::string::npos)
+            {
+                line = line.substr(0, found);
+            }
+
+            trim(line);
+            if (line.empty())
+                continue;
+
+            // Package finished state
+            if (line[0] == ':')
+            {
+                if (!newWaza.wazaName.empty())
+                {
+                    wazas.push_back(newWaza);
+                    newWaza = AttackWaza();
+                }
+            }
+
+            // Process line
+            if (line[0] == ':')
+            {
+                line = line.substr(1);  // Cut out colon
+                trim(line);
+
+                newWaza.wazaName = line;
+            }
+            else if (!newWaza.wazaName.empty())
+            {
+                std::string lineCommand = line.substr(0, line.find(' '));
+                trim(lineCommand);
+
+                std::string lineParams = line.substr(lineCommand.length());
+                trim(lineParams);
+                std::vector<std::string> paramsParsed;
+                while (true)
+                {
+                    size_t nextWS;
+                    if ((nextWS = lineParams.find(' ')) == std::string::npos)
+                    {
+                        // This is a single param. End of the list.
+                        paramsParsed.push_back(lineParams);
+                        break;
+                    }
+                    else
+                    {
+                        // Break off the param and add the first one to the list.
+                        std::string param = lineParams.substr(0, nextWS);
+                        trim(param);
+                        paramsParsed.push_back(param);
+
+                        lineParams = lineParams.substr(nextWS);
+                        trim(lineParams);
+                    }
+                }
+
+                loadDataFromLine(newWaza, lineCommand, paramsParsed);
+            }
+            else
+            {
+                // ERROR
+                std::cerr << "[WAZA LOADING]" << std::endl
+                    << "ERROR (line " << lineNum << ") (file: " << fname << "): Headless data" << std::endl
+                    << "   Trimmed line: " << line << std::endl
+                    << "  Original line: " << line << std::endl;
+            }
+        }
+
+        // Package finished state
+        // @COPYPASTA
+        if (!newWaza.wazaName.empty())
+        {
+            wazas.push_back(newWaza);
+            newWaza = AttackWaza();
+        }
+
+        resolveWazaSet(wazas);
+    }
+
+
+    //
+    // Cooked (binary) waza sets
+    //
+    struct HWABHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t numWazas;
+        uint32_t dataSize;  // Size of everything after the header.
+    };
+
+    struct CookedWriter
+    {
+        std::vector<uint8_t>& data;
+
+        template<typename T>
+        void write(const T& value)
+        {
+            size_t offset = data.size();
+            data.resize(offset + sizeof(T));
+            memcpy(data.data() + offset, &value, sizeof(T));
+        }
+
+        void writeVec3(const vec3& v)
+        {
+            write(v[0]);
+            write(v[1]);
+            write(v[2]);
+        }
+
+        void writeString(const std::string& str)
+        {
+            write((uint32_t)str.size());
+            size_t offset = data.size();
+            data.resize(offset + str.size());
+            memcpy(data.data() + offset, str.data(), str.size());
+        }
+    };
+
+    struct CookedReader
+    {
+        const uint8_t* data;
+        size_t size;
+        size_t offset = 0;
+        bool ok = true;  // @NOTE: once a read goes out of bounds everything after just reads zeros.
+
+        template<typename T>
+        T read()
+        {
+            T value = {};
+            if (!ok || offset + sizeof(T) > size)
+            {
+                ok = false;
+                return value;
+            }
+            memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        void readVec3(vec3& outV)
+        {
+            outV[0] = read<float_t>();
+            outV[1] = read<float_t>();
+            outV[2] = read<float_t>();
+        }
+
+        std::string readString()
+        {
+            uint32_t length = read<uint32_t>();
+            if (!ok || offset + length > size)
+            {
+                ok = false;
+                return "";
+            }
+            std::string str((const char*)data + offset, length);
+            offset += length;
+            return str;
+        }
+
+        uint32_t readCount(size_t minElementSize)
+        {
+            // Guards against allocating a huge vector from a corrupt count.
+            uint32_t count = read<uint32_t>();
+            if (!ok || (size_t)count * minElementSize > size - offset)
+            {
+                ok = false;
+                return 0;
+            }
+            return count;
+        }
+    };
+
+    void cookWazaSet(const std::vector<AttackWaza>& wazas, std::vector<uint8_t>& outData)
+    {
+        outData.clear();
+        outData.resize(sizeof(HWABHeader));
+
+        CookedWriter w{ outData };
+        for (const AttackWaza& waza : wazas)
+        {
+            w.writeString(waza.wazaName);
+
+            w.write((uint8_t)waza.entranceInputParams.enabled);
+            w.writeString(waza.entranceInputParams.weaponType);
+            w.writeString(waza.entranceInputParams.movementState);
+            w.writeString(waza.entranceInputParams.inputName);
+            w.write((int32_t)waza.entranceInputParams.input);
+
+            w.writeString(waza.animationState);
+            w.write(waza.staminaCost);
+            w.write(waza.staminaCostHold);
+            w.write(waza.staminaCostHoldTimeFrom);
+            w.write(waza.staminaCostHoldTimeTo);
+            w.write(waza.duration);
+            w.write((uint8_t)waza.holdMidair);
+            w.write(waza.holdMidairTimeFrom);
+            w.write(waza.holdMidairTimeTo);
+            w.write(waza.gravityMultiplier);
+
+            w.write((uint32_t)waza.velocityDecaySettings.size());
+            for (const AttackWaza::VelocityDecaySetting& vds : waza.velocityDecaySettings)
+            {
+                w.write(vds.velocityDecay);
+                w.write(vds.executeAtTime);
+            }
+
+            w.write((uint32_t)waza.velocitySettings.size());
+            for (const AttackWaza::VelocitySetting& vs : waza.velocitySettings)
+            {
+                w.writeVec3(vs.velocity);
+                w.write(vs.executeAtTime);
+            }
+
+            w.write(waza.numHitscanSamples);
+            w.write((uint32_t)waza.hitscanNodes.size());
+            for (const AttackWaza::HitscanFlowNode& node : waza.hitscanNodes)
+            {
+                w.writeVec3(node.nodeEnd1);
+                w.writeVec3(node.nodeEnd2);
+                w.write(node.executeAtTime);
+            }
+            w.writeVec3(waza.hitscanLaunchVelocity);
+            w.writeVec3(waza.hitscanLaunchRelPosition);
+            w.write((uint8_t)waza.hitscanLaunchRelPositionIgnoreY);
+
+            w.write((uint8_t)waza.vacuumSuckIn.enabled);
+            w.writeVec3(waza.vacuumSuckIn.position);
+            w.write(waza.vacuumSuckIn.radius);
+            w.write(waza.vacuumSuckIn.strength);
+
+            w.write((uint8_t)waza.forceZone.enabled);
+            w.writeVec3(waza.forceZone.origin);
+            w.writeVec3(waza.forceZone.bounds);
+            w.writeVec3(waza.forceZone.forceVelocity);
+            w.write(waza.forceZone.timeFrom);
+            w.write(waza.forceZone.timeTo);
+
+            w.write((uint32_t)waza.chains.size());
+            for (const AttackWaza::Chain& chain : waza.chains)
+            {
+                w.write(chain.inputTimeWindowStart);
+                w.write(chain.inputTimeWindowEnd);
+                w.writeString(chain.nextWazaName);
+                w.write(chain.nextWazaIndex);
+                w.writeString(chain.inputName);
+                w.write((int32_t)chain.input);
+            }
+
+            w.writeString(waza.onHoldCancelWazaName);
+            w.write(waza.onHoldCancelWazaIndex);
+            w.writeString(waza.onDurationPassedWazaName);
+            w.write(waza.onDurationPassedWazaIndex);
+
+            w.write((uint8_t)waza.interruptable.enabled);
+            w.write(waza.interruptable.from);
+            w.write(waza.interruptable.to);
+        }
+
+        HWABHeader header = {
+            .magic = HWAB_MAGIC,
+            .version = HWAB_VERSION,
+            .numWazas = (uint32_t)wazas.size(),
+            .dataSize = (uint32_t)(outData.size() - sizeof(HWABHeader)),
+        };
+        memcpy(outData.data(), &header, sizeof(header));
+    }
+
+    bool readCookedWazaSet(const uint8_t* data, size_t size, std::vector<AttackWaza>& outWazas)
+    {
+        HWABHeader header;
+        if (size < sizeof(header))
+            return false;
+        memcpy(&header, data, sizeof(header));
+        if (header.magic != HWAB_MAGIC ||
+            header.version != HWAB_VERSION ||
+            header.dataSize != size - sizeof(header))
+            return false;
+
+        constexpr size_t minWazaSize = 64;  // Roughly the size of a waza with no settings, chains or strings.
+        if ((size_t)header.numWazas * minWazaSize > header.dataSize)
+            return false;
+
+        CookedReader r{ .data = data + sizeof(header), .size = header.dataSize };
+        std::vector<AttackWaza> wazas(header.numWazas);
+        for (AttackWaza& waza : wazas)
+        {
+            waza.wazaName = r.readString();
+
+            waza.entranceInputParams.enabled = (r.read<uint8_t>() != 0);
+            waza.entranceInputParams.weaponType = r.readString();
+            waza.entranceInputParams.movementState = r.readString();
+            waza.entranceInputParams.inputName = r.readString();
+            waza.entranceInputParams.input = (AttackWaza::WazaInput)r.read<int32_t>();
+
+            waza.animationState = r.readString();
+            waza.staminaCost = r.read<int16_t>();
+            waza.staminaCostHold = r.read<int16_t>();
+            waza.staminaCostHoldTimeFrom = r.read<int16_t>();
+            waza.staminaCostHoldTimeTo = r.read<int16_t>();
+            waza.duration = r.read<int16_t>();
+            waza.holdMidair = (r.read<uint8_t>() != 0);
+            waza.holdMidairTimeFrom = r.read<int16_t>();
+            waza.holdMidairTimeTo = r.read<int16_t>();
+            waza.gravityMultiplier = r.read<float_t>();
+
+            waza.velocityDecaySettings.resize(r.readCount(sizeof(float_t) + sizeof(int16_t)));
+            for (AttackWaza::VelocityDecaySetting& vds : waza.velocityDecaySettings)
+            {
+                vds.velocityDecay = r.read<float_t>();
+                vds.executeAtTime = r.read<int16_t>();
+            }
+
+            waza.velocitySettings.resize(r.readCount(sizeof(float_t) * 3 + sizeof(int16_t)));
+            for (AttackWaza::VelocitySetting& vs : waza.velocitySettings)
+            {
+                r.readVec3(vs.velocity);
+                vs.executeAtTime = r.read<int16_t>();
+            }
+
+            waza.numHitscanSamples = r.read<uint32_t>();
+            waza.hitscanNodes.resize(r.readCount(sizeof(float_t) * 6 + sizeof(int16_t)));
+            for (AttackWaza::HitscanFlowNode& node : waza.hitscanNodes)
+            {
+                r.readVec3(node.nodeEnd1);
+                r.readVec3(node.nodeEnd2);
+                node.executeAtTime = r.read<int16_t>();
+            }
+            r.readVec3(waza.hitscanLaunchVelocity);
+            r.readVec3(waza.hitscanLaunchRelPosition);
+            waza.hitscanLaunchRelPositionIgnoreY = (r.read<uint8_t>() != 0);
+
+            waza.vacuumSuckIn.enabled = (r.read<uint8_t>() != 0);
+            r.readVec3(waza.vacuumSuckIn.position);
+            waza.vacuumSuckIn.radius = r.read<float_t>();
+            waza.vacuumSuckIn.strength = r.read<float_t>();
+
+            waza.forceZone.enabled = (r.read<uint8_t>() != 0);
+            r.readVec3(waza.forceZone.origin);
+            r.readVec3(waza.forceZone.bounds);
+            r.readVec3(waza.forceZone.forceVelocity);
+            waza.forceZone.timeFrom = r.read<int16_t>();
+            waza.forceZone.timeTo = r.read<int16_t>();
+
+            waza.chains.resize(r.readCount(sizeof(int16_t) * 2 + sizeof(uint32_t) * 2 + sizeof(int32_t) * 2));
+            for (AttackWaza::Chain& chain : waza.chains)
+            {
+                chain.inputTimeWindowStart = r.read<int16_t>();
+                chain.inputTimeWindowEnd = r.read<int16_t>();
+                chain.nextWazaName = r.readString();
+                chain.nextWazaIndex = r.read<int32_t>();
+                chain.inputName = r.readString();
+                chain.input = (AttackWaza::WazaInput)r.read<int32_t>();
+            }
+
+            waza.onHoldCancelWazaName = r.readString();
+            waza.onHoldCancelWazaIndex = r.read<int32_t>();
+            waza.onDurationPassedWazaName = r.readString();
+            waza.onDurationPassedWazaIndex = r.read<int32_t>();
+
+            waza.interruptable.enabled = (r.read<uint8_t>() != 0);
+            waza.interruptable.from = r.read<int16_t>();
+            waza.interruptable.to = r.read<int16_t>();
+
+            if (!r.ok)
+                return false;
+        }
+        if (r.offset != r.size)
+            return false;
+
+        // Validate the baked indices before turning them into pointers.
+        auto isValidIndex = [&](int32_t index) {
+            return (index >= -1 && index < (int32_t)wazas.size());
+        };
+        for (AttackWaza& waza : wazas)
+        {
+            for (AttackWaza::Chain& chain : waza.chains)
+                if (!isValidIndex(chain.nextWazaIndex))
+                    return false;
+            if (!isValidIndex(waza.onHoldCancelWazaIndex) ||
+                !isValidIndex(waza.onDurationPassedWazaIndex))
+                return false;
+        }
+
+        outWazas = std::move(wazas);
+        bakeWazaSet(outWazas);
+        return true;
+    }
+
+    bool saveCookedWazaSet(const std::string& fname, const std::vector<AttackWaza>& wazas)
+    {
+        std::vector<uint8_t> data;
+        cookWazaSet(wazas, data);
+
+        std::error_code ec;
+        std::filesystem::create_directories(std::filesystem::path(fname).parent_path(), ec);
+        std::ofstream file(fname, std::ios::binary);
+        if (!file.is_open())
+        {
+            std::cerr << "[SAVE COOKED WAZA SET]" << std::endl
+                << "ERROR: could not open \"" << fname << "\" for writing" << std::endl;
+            return false;
+        }
+        file.write((const char*)data.data(), data.size());
+        return true;
+    }
+
+    bool loadCookedWazaSet(const std::string& fname, std::vector<AttackWaza>& outWazas)
+    {
+        std::ifstream file(fname, std::ios::binary | std::ios::ate);
+        if (!file.is_open())
+            return false;
+
+        std::vector<uint8_t> data((size_t)file.tellg());
+        file.seekg(0);
+        if (!file.read((char*)data.data(), data.size()) ||
+            !readCookedWazaSet(data.data(), data.size(), outWazas))
+        {
+            std::cerr << "[LOAD COOKED WAZA SET]" << std::endl
+                << "ERROR: \"" << fname << "\" is not a valid .hwab file (or is an old version)" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    void loadWazaSet(std::vector<AttackWaza>& outWazas, const std::vector<std::string>& sourceFnames, const std::string& cookedFname)
+    {
+        std::error_code ec;
+        auto cookedTime = std::filesystem::last_write_time(cookedFname, ec);
+        bool cookedIsFresh = !ec;
+        for (const std::string& sourceFname : sourceFnames)
+        {
+            std::error_code sourceEC;
+            auto sourceTime = std::filesystem::last_write_time(sourceFname, sourceEC);
+            if (!sourceEC && sourceTime > cookedTime)  // @NOTE: if a source got deleted, the cooked one still gets used.
+                cookedIsFresh = false;
+        }
+
+        outWazas.clear();
+        if (cookedIsFresh && loadCookedWazaSet(cookedFname, outWazas))
+            return;
+
+        outWazas.clear();
+        for (const std::string& sourceFname : sourceFnames)
+            initWazaSetFromFile(outWazas, sourceFname);
+        saveCookedWazaSet(cookedFname, outWazas);
+    }
+
+    //
+    // Round trip test
+    //
+    bool vec3Equal(const vec3& a, const vec3& b)
+    {
+        return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+    }
+
+    bool wazaEqual(const AttackWaza& a, const AttackWaza& b, std::string& outMismatch)
+    {
+#define WAZA_CHECK(cond, fieldName) if (!(cond)) { outMismatch = fieldName; return false; }
+        WAZA_CHECK(a.wazaName == b.wazaName, "wazaName");
+        WAZA_CHECK(a.entranceInputParams.enabled == b.entranceInputParams.enabled &&
+            a.entranceInputParams.weaponType == b.entranceInputParams.weaponType &&
+            a.entranceInputParams.movementState == b.entranceInputParams.movementState &&
+            a.entranceInputParams.inputName == b.entranceInputParams.inputName &&
+            (a.entranceInputParams.inputName == "NULL" || a.entranceInputParams.input == b.entranceInputParams.input), "entranceInputParams");
+        WAZA_CHECK(a.animationState == b.animationState, "animationState");
+        WAZA_CHECK(a.staminaCost == b.staminaCost &&
+            a.staminaCostHold == b.staminaCostHold &&
+            a.staminaCostHoldTimeFrom == b.staminaCostHoldTimeFrom &&
+            a.staminaCostHoldTimeTo == b.staminaCostHoldTimeTo, "staminaCost");
+        WAZA_CHECK(a.duration == b.duration, "duration");
+        WAZA_CHECK(a.holdMidair == b.holdMidair &&
+            a.holdMidairTimeFrom == b.holdMidairTimeFrom &&
+            a.holdMidairTimeTo == b.holdMidairTimeTo, "holdMidair");
+        WAZA_CHECK(a.gravityMultiplier == b.gravityMultiplier, "gravityMultiplier");
+
+        WAZA_CHECK(a.velocityDecaySettings.size() == b.velocityDecaySettings.size(), "velocityDecaySettings");
+        for (size_t i = 0; i < a.velocityDecaySettings.size(); i++)
+            WAZA_CHECK(a.velocityDecaySettings[i].velocityDecay == b.velocityDecaySettings[i].velocityDecay &&
+                a.velocityDecaySettings[i].executeAtTime == b.velocityDecaySettings[i].executeAtTime, "velocityDecaySettings");
+
+        WAZA_CHECK(a.velocitySettings.size() == b.velocitySettings.size(), "velocitySettings");
+        for (size_t i = 0; i < a.velocitySettings.size(); i++)
+            WAZA_CHECK(vec3Equal(a.velocitySettings[i].velocity, b.velocitySettings[i].velocity) &&
+                a.velocitySettings[i].executeAtTime == b.velocitySettings[i].executeAtTime, "velocitySettings");
+
+        WAZA_CHECK(a.numHitscanSamples == b.numHitscanSamples, "numHitscanSamples");
+        WAZA_CHECK(a.hitscanNodes.size() == b.hitscanNodes.size(), "hitscanNodes");
+        for (size_t i = 0; i < a.hitscanNodes.size(); i++)
+            WAZA_CHECK(vec3Equal(a.hitscanNodes[i].nodeEnd1, b.hitscanNodes[i].nodeEnd1) &&
+                vec3Equal(a.hitscanNodes[i].nodeEnd2, b.hitscanNodes[i].nodeEnd2) &&
+                a.hitscanNodes[i].executeAtTime == b.hitscanNodes[i].executeAtTime, "hitscanNodes");
+        WAZA_CHECK(vec3Equal(a.hitscanLaunchVelocity, b.hitscanLaunchVelocity), "hitscanLaunchVelocity");
+        WAZA_CHECK(vec3Equal(a.hitscanLaunchRelPosition, b.hitscanLaunchRelPosition) &&
+            a.hitscanLaunchRelPositionIgnoreY == b.hitscanLaunchRelPositionIgnoreY, "hitscanLaunchRelPosition");
+
+        WAZA_CHECK(a.vacuumSuckIn.enabled == b.vacuumSuckIn.enabled &&
+            vec3Equal(a.vacuumSuckIn.position, b.vacuumSuckIn.position) &&
+            a.vacuumSuckIn.radius == b.vacuumSuckIn.radius &&
+            a.vacuumSuckIn.strength == b.vacuumSuckIn.strength, "vacuumSuckIn");
+        WAZA_CHECK(a.forceZone.enabled == b.forceZone.enabled &&
+            vec3Equal(a.forceZone.origin, b.forceZone.origin) &&
+            vec3Equal(a.forceZone.bounds, b.forceZone.bounds) &&
+            vec3Equal(a.forceZone.forceVelocity, b.forceZone.forceVelocity) &&
+            a.forceZone.timeFrom == b.forceZone.timeFrom &&
+            a.forceZone.timeTo == b.forceZone.timeTo, "forceZone");
+
+        WAZA_CHECK(a.chains.size() == b.chains.size(), "chains");
+        for (size_t i = 0; i < a.chains.size(); i++)
+            WAZA_CHECK(a.chains[i].inputTimeWindowStart == b.chains[i].inputTimeWindowStart &&
+                a.chains[i].inputTimeWindowEnd == b.chains[i].inputTimeWindowEnd &&
+                a.chains[i].nextWazaName == b.chains[i].nextWazaName &&
+                a.chains[i].nextWazaIndex == b.chains[i].nextWazaIndex &&
+                a.chains[i].inputName == b.chains[i].inputName &&
+                a.chains[i].input == b.chains[i].input, "chains");
+
+        WAZA_CHECK(a.onHoldCancelWazaName == b.onHoldCancelWazaName &&
+            a.onHoldCancelWazaIndex == b.onHoldCancelWazaIndex, "onHoldCancel");
+        WAZA_CHECK(a.onDurationPassedWazaName == b.onDurationPassedWazaName &&
+            a.onDurationPassedWazaIndex == b.onDurationPassedWazaIndex, "onDurationPassed");
+        WAZA_CHECK(a.interruptable.enabled == b.interruptable.enabled &&
+            a.interruptable.from == b.interruptable.from &&
+            a.interruptable.to == b.interruptable.to, "interruptable");
+#undef WAZA_CHECK
+        return true;
+    }
+
+    bool roundTripWazaSet(const std::string& name, const std::vector<AttackWaza>& wazas)
+    {
+        std::vector<uint8_t> data;
+        cookWazaSet(wazas, data);
+
+        std::vector<AttackWaza> readWazas;
+        if (!readCookedWazaSet(data.data(), data.size(), readWazas))
+        {
+            std::cout << "  FAIL  " << name << ": could not read back the cooked data" << std::endl;
+            return false;
+        }
+        if (readWazas.size() != wazas.size())
+        {
+            std::cout << "  FAIL  " << name << ": " << wazas.size() << " wazas cooked, " << readWazas.size() << " read back" << std::endl;
+            return false;
+        }
+
+        for (size_t i = 0; i < wazas.size(); i++)
+        {
+            std::string mismatch;
+            if (!wazaEqual(wazas[i], readWazas[i], mismatch))
+            {
+                std::cout << "  FAIL  " << name << ": waza \"" << wazas[i].wazaName << "\" has a different `" << mismatch << "`" << std::endl;
+                return false;
+            }
+
+            // The baked pointers have to point into the new set at the same spots.
+            for (size_t j = 0; j < readWazas[i].chains.size(); j++)
+            {
+                const AttackWaza::Chain& chain = readWazas[i].chains[j];
+                if (chain.nextWazaPtr != (chain.nextWazaIndex >= 0 ? &readWazas[chain.nextWazaIndex] : nullptr))
+                {
+                    std::cout << "  FAIL  " << name << ": waza \"" << wazas[i].wazaName << "\" chain " << j << " points at the wrong waza" << std::endl;
+                    return false;
+                }
+            }
+
+            // The timeline gets baked again on read, so it has to come out the same and in time order.
+            const std::vector<AttackWaza::TimelineEvent>& timeline = readWazas[i].timeline;
+            bool timelineMatches = (timeline.size() == wazas[i].timeline.size());
+            for (size_t j = 0; timelineMatches && j < timeline.size(); j++)
+                timelineMatches =
+                    timeline[j].executeAtTime == wazas[i].timeline[j].executeAtTime &&
+                    timeline[j].type == wazas[i].timeline[j].type &&
+                    timeline[j].index == wazas[i].timeline[j].index &&
+                    (j == 0 || timeline[j - 1].executeAtTime <= timeline[j].executeAtTime);
+            if (!timelineMatches)
+            {
+                std::cout << "  FAIL  " << name << ": waza \"" << wazas[i].wazaName << "\" has a different timeline" << std::endl;
+                return false;
+            }
+        }
+
+        // A truncated file has to get rejected instead of read.
+        std::vector<AttackWaza> truncatedWazas;
+        if (data.size() > 1 && readCookedWazaSet(data.data(), data.size() - 1, truncatedWazas))
+        {
+            std::cout << "  FAIL  " << name << ": truncated data got accepted" << std::endl;
+            return false;
+        }
+
+        std::cout << "  OK    " << name << ": " << wazas.size() << " wazas, " << data.size() << " bytes" << std::endl;
+        return true;
+    }
+
+    bool runRoundTripTest()
+    {
+        std::cout << "[WAZA ROUND TRIP TEST]" << std::endl;
+
+        std::vector<std::string> sourceFnames = {
+            "res/waza/default_waza.hwac",
+            "res/waza/air_waza.hwac",
+        };
+        bool success = true;
+        std::vector<AttackWaza> combinedSet;
+        for (const std::string& sourceFname : sourceFnames)
+        {
+            std::vector<AttackWaza> wazas;
+            initWazaSetFromFile(wazas, sourceFname);
+            success &= roundTripWazaSet(sourceFname, wazas);
+            initWazaSetFromFile(combinedSet, sourceFname);
+        }
+        success &= roundTripWazaSet("combined set", combinedSet);
+
+        std::cout << (success ? "PASSED" : "FAILED") << std::endl;
+        return success;
+    }
+}
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "ImportGLM.h"
+
+
+// @NOTE: attack actions (wazas) of the player. They get authored as text in `res/waza/*.hwac` (see
+//        `initWazaSetFromFile()`), and the text gets cooked into a binary `.hwab` (in "cache/") with all the chains
+//        already resolved into indices. At runtime the cooked file gets read in one go and validated,
+//        and the text only gets parsed again when it's newer than the cooked file.
+namespace waza
+{
+    struct AttackWaza
+    {
+        std::string wazaName = "";
+
+        enum class WazaInput
+        {
+            NONE = 0,
+            PRESS_X,       PRESS_A,       PRESS_X_A,
+            RELEASE_X,     RELEASE_A,     RELEASE_X_A,
+        };
+
+        struct EntranceInputParams
+        {
+            bool enabled = false;
+            std::string weaponType = "NULL";  // Valid options: twohanded, bow, dual, spear (NULL means there is no entrance)
+            std::string movementState = "NULL";  // Valid options: grounded, midair, upsidedown (NULL means there is no entrance)
+            std::string inputName = "NULL";  // Valid options: press_(x/a/x_a), hold_(x/a/x_a), release_(x/a/x_a), doubleclick_(x/a/x_a), doublehold_(x/a/x_a)
+            WazaInput input;
+            // @NOTE: for `input`, there are some inputs that collide with each other. You will have to worry about this depending on what an available chain's inputs are and which entrances are available (i.e. if you're in an interruptable state at the moment).
+            //        The inputs that collide are:
+            //            press_@, doubleclick_@, doublehold_@    // Bc doubleclick and doublehold each of them require a `press_@` at the beginning.
+            //        These don't collide because:
+            //            press_@, hold_@                         // Bc press requires to click and release in a short amount of time. Hold requires to click and hold @ for an amount of time.
+            //            press_@, release_@                      // Bc release will trigger the moment @ is not pressed, whereas press will require >=1 tick of @ not pressed, then >=1 <time_for_hold_to_activate tick(s) of @ pressed, then will trigger the moment @ is not pressed again.
+            //
+            // @REPLY: this point is moot. Will not do this waza input system anymore.
+        } entranceInputParams;
+
+        std::string animationState;
+        int16_t staminaCost = 0;
+        int16_t staminaCostHold = 0;
+        int16_t staminaCostHoldTimeFrom = -1;
+        int16_t staminaCostHoldTimeTo = -1;
+        int16_t duration = -1;
+        bool holdMidair = false;
+        int16_t holdMidairTimeFrom = -1;
+        int16_t holdMidairTimeTo = -1;
+        float_t gravityMultiplier = 1.0f;
+
+        struct VelocityDecaySetting
+        {
+            float_t velocityDecay;
+            int16_t executeAtTime = 0;
+        };
+        std::vector<VelocityDecaySetting> velocityDecaySettings;
+
+        struct VelocitySetting
+        {
+            vec3 velocity;
+            int16_t executeAtTime = 0;
+        };
+        std::vector<VelocitySetting> velocitySettings;
+        
+        struct HitscanFlowNode
+        {
+            // These ends create a line where `numHitscanSamples` number of points traverse.
+            // These points are connected to the previous node's ends' traversed lines to create
+            // the hitscan query lines. Note also that these points are in object space,
+            // where { 0, 0, 1 } represents the player's facing forward vector.
+            vec3 nodeEnd1, nodeEnd2;
+            int16_t executeAtTime = 0;
+        };
+        uint32_t numHitscanSamples = 5;
+        std::vector<HitscanFlowNode> hitscanNodes;  // Each node uses the previous node's data to create the hitscans (the first node is ignored except for using it as prev node data).
+        vec3 hitscanLaunchVelocity = GLM_VEC3_ZERO_INIT;  // Non-normalized vec3 of launch velocity of entity that gets hit by the waza.
+        vec3 hitscanLaunchRelPosition = GLM_VEC3_ZERO_INIT;  // Position relative to origin of original character to set hit character on first hit.
+        bool hitscanLaunchRelPositionIgnoreY = false;  // Flag to not set the Y relative position.
+
+        struct VacuumSuckIn
+        {
+            bool enabled = false;
+            vec3 position = GLM_VEC3_ZERO_INIT;  // Position relative to character to suck in nearby entities.
+            float_t radius = 3.0f;
+            float_t strength = 1.0f;
+        } vacuumSuckIn;
+
+        struct ForceZone
+        {
+            bool enabled = false;
+            vec3 origin = GLM_VEC3_ZERO_INIT;  // Relative position from character origin.
+            vec3 bounds = { 1.0f, 1.0f, 1.0f };  // @NOTE: this is an aabb.
+            vec3 forceVelocity = { 1.0f, 0.0f, 0.0f };
+            int16_t timeFrom = -1;
+            int16_t timeTo = -1;
+        } forceZone;
+
+        struct Chain
+        {
+            int16_t inputTimeWindowStart = 0;  // Press the attack button in this window to trigger the chain.
+            int16_t inputTimeWindowEnd = 0;
+            std::string nextWazaName = "";  // @NOTE: this is just for looking up the correct next action.
+            int32_t nextWazaIndex = -1;  // Baked data (index into the waza set).
+            AttackWaza* nextWazaPtr = nullptr;  // Baked data.
+            std::string inputName = "NULL";  // REQUIRED: see `EntranceInputParams::input` for list of valid inputs.
+            WazaInput input;
+        };
+        std::vector<Chain> chains;  // Note that you can have different chains depending on your rhythm in the attack.
+
+        std::string onHoldCancelWazaName = "NULL";
+        int32_t onHoldCancelWazaIndex = -1;
+        AttackWaza* onHoldCancelWazaPtr = nullptr;
+
+        std::string onDurationPassedWazaName = "NULL";
+        int32_t onDurationPassedWazaIndex = -1;
+        AttackWaza* onDurationPassedWazaPtr = nullptr;
+
+        struct IsInterruptable  // Can interrupt by starting another waza.
+        {
+            bool enabled = false;
+            int16_t from = -1;
+            int16_t to = -1;
+        } interruptable;
+
+        // Baked data: all the velocity decay settings, velocity settings and hitscan nodes sorted by time,
+        // so that a tick only has to look at the events that fire on it (see `bakeWazaTimeline()`).
+        struct TimelineEvent
+        {
+            enum class Type : uint8_t
+            {
+                VELOCITY_DECAY = 0,
+                VELOCITY,
+                HITSCAN,
+                NUM_TYPES
+            };
+            int16_t executeAtTime;
+            Type type;
+            uint16_t index;  // Into `velocityDecaySettings`, `velocitySettings` or `hitscanNodes`.
+        };
+        std::vector<TimelineEvent> timeline;
+    };
+
+    constexpr uint32_t HWAB_MAGIC   = 0x42415748;  // "HWAB"
+    constexpr uint32_t HWAB_VERSION = 1;
+
+    // Parses a text waza file and appends its wazas to `wazas`, then resolves the chains of the whole set.
+    void initWazaSetFromFile(std::vector<AttackWaza>& wazas, const std::string& fname);
+
+    // @NOTE: the 0th hitscan node doesn't get an event, since it's only used as the start of the 1st node's hitscans.
+    void bakeWazaTimeline(AttackWaza& waza);
+
+    bool saveCookedWazaSet(const std::string& fname, const std::vector<AttackWaza>& wazas);
+    bool loadCookedWazaSet(const std::string& fname, std::vector<AttackWaza>& outWazas);
+    void cookWazaSet(const std::vector<AttackWaza>& wazas, std::vector<uint8_t>& outData);
+    bool readCookedWazaSet(const uint8_t* data, size_t size, std::vector<AttackWaza>& outWazas);
+
+    // Loads the cooked set if it's newer than all of `sourceFnames`. Otherwise parses the sources (in order)
+    // and writes a new cooked set.
+    void loadWazaSet(std::vector<AttackWaza>& outWazas, const std::vector<std::string>& sourceFnames, const std::string& cookedFname);
+
+    // Parses both waza files, cooks them, reads them back and checks that every field survived. Prints a report.
+    bool runRoundTripTest();
+}
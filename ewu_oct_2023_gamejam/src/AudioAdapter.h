@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include "ImportGLM.h"
+
+
+// @NOTE: the backend that `AudioEngine` sits on top of. Channels are addressed by the channel
+//        slot that `AudioEngine` reserved (not the generational id), so backends don't have to
+//        care about stale ids. All of these get called from the main thread only.
+class AudioAdapter
+{
+public:
+    virtual ~AudioAdapter() = default;
+
+    virtual void update() = 0;
+
+    virtual int  loadSound(const std::string& fname, bool is3d, bool isLooping, bool stream) = 0;  // Returns the sound id, or -1 if loading failed.
+    virtual void unloadSound(int soundId) = 0;
+
+    virtual bool playSound(size_t channelSlot, int soundId, bool looping, vec3 position, float volume) = 0;
+    virtual bool isChannelPlaying(size_t channelSlot) = 0;
+    virtual void stopChannel(size_t channelSlot) = 0;
+    virtual void setChannel3dPosition(size_t channelSlot, vec3 position) = 0;
+    virtual void setChannelVolume(size_t channelSlot, float volume) = 0;
+    virtual void setChannelLowpassGain(size_t channelSlot, float gain) = 0;
+
+    virtual void set3dListenerTransform(vec3 position, vec3 forward) = 0;
+
+    // Studio events. Backends without an event system just ignore these.
+    virtual void loadBank(const std::string& bankName, uint32_t flags) {}
+    virtual void loadEvent(const std::string& eventName) {}
+    virtual void playEvent(const std::string& eventName) {}
+    virtual void stopEvent(const std::string& eventName, bool immediate) {}
+    virtual bool isEventPlaying(const std::string& eventName) const { return false; }
+    virtual void setEventParameter(const std::string& eventName, const std::string& parameterName, float value) {}
+    virtual void getEventParameter(const std::string& eventName, const std::string& parameterName, float* outValue) {}
+};
@@ -0,0 +1,238 @@
+#include "AudioAdapterFMOD.h"
+
+#include <fmod_errors.h>
+#include <iostream>
+
+
+#define ERRCHECK(_result) errorCheck(_result, __FILE__, __LINE__)
+void errorCheck(FMOD_RESULT result, const char* file, int line)
+{
+    if (result != FMOD_OK)
+    {
+        std::cerr << "FMOD ERROR:: " << file << " :::: Line " << line << std::endl << "\t" << FMOD_ErrorString(result) << std::endl;
+    }
+}
+
+
+AudioAdapter_FMOD::AudioAdapter_FMOD()
+{
+    fmodStudioSystem = nullptr;
+    fmodSystem = nullptr;
+    channels.fill(nullptr);
+
+    ERRCHECK(FMOD::Studio::System::create(&fmodStudioSystem));
+    ERRCHECK(fmodStudioSystem->getCoreSystem(&fmodSystem));
+    ERRCHECK(fmodSystem->setSoftwareFormat(0, FMOD_SPEAKERMODE_5POINT1, 0));
+    ERRCHECK(fmodStudioSystem->initialize(32, FMOD_STUDIO_INIT_LIVEUPDATE, FMOD_INIT_PROFILE_ENABLE, nullptr));        // @NOTE: this may be a problem with the FMOD_STUDIO_INIT_LIVEUPDATE when doing a release build      // @NOTE: Hey, so in the examples the max number of channels was 1024... maybe want to rethink the capacity??  -Timo
+}
+
+AudioAdapter_FMOD::~AudioAdapter_FMOD()
+{
+    ERRCHECK(fmodStudioSystem->unloadAll());
+    ERRCHECK(fmodStudioSystem->release());
+}
+
+void AudioAdapter_FMOD::update()
+{
+    ERRCHECK(fmodStudioSystem->update());
+}
+
+int AudioAdapter_FMOD::loadSound(const std::string& fname, bool is3d, bool isLooping, bool stream)
+{
+    FMOD_MODE mode = FMOD_DEFAULT;
+    mode |= is3d ? FMOD_3D : FMOD_2D;
+    mode |= isLooping ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
+    mode |= stream ? FMOD_CREATESTREAM : FMOD_CREATECOMPRESSEDSAMPLE;
+
+    FMOD::Sound* sound = nullptr;
+    ERRCHECK(fmodSystem->createSound(fname.c_str(), mode, nullptr, &sound));
+    if (!sound)
+        return -1;
+
+    sounds.push_back(sound);
+    return (int)sounds.size() - 1;
+}
+
+void AudioAdapter_FMOD::unloadSound(int soundId)
+{
+    if (sounds[soundId] == nullptr)
+        return;
+
+    ERRCHECK(sounds[soundId]->release());
+    sounds[soundId] = nullptr;
+}
+
+bool AudioAdapter_FMOD::playSound(size_t channelSlot, int soundId, bool looping, vec3 position, float volume)
+{
+    FMOD::Sound* sound = sounds[soundId];
+    if (sound == nullptr)
+        return false;
+
+    // Setup looping if that's changed
+    FMOD_MODE mode;
+    sound->getMode(&mode);
+    if (looping != (bool)(mode & FMOD_LOOP_NORMAL))
+    {
+        mode &= looping ? ~FMOD_LOOP_OFF : ~FMOD_LOOP_NORMAL;
+        mode |= looping ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
+        sound->setMode(mode);
+    }
+
+    // Play sound paused in case if 3D sound setup is required
+    FMOD::Channel* channel = nullptr;
+    ERRCHECK(fmodSystem->playSound(sound, nullptr, true, &channel));
+    if (channel)
+    {
+        if (mode & FMOD_3D)
+        {
+            FMOD_VECTOR fPosition = { position[0], position[1], position[2] };
+            ERRCHECK(channel->set3DAttributes(&fPosition, nullptr));       // @NOTE: I guess putting in velocity in the future should be useful and good eh!  -Timo
+        }
+        ERRCHECK(channel->setVolume(volume));
+        ERRCHECK(channel->setPaused(false));
+        channels[channelSlot] = channel;
+        return true;
+    }
+    return false;      // New channel didn't get created. Show failure.
+}
+
+bool AudioAdapter_FMOD::isChannelPlaying(size_t channelSlot)
+{
+    FMOD::Channel* channel = channels[channelSlot];
+    if (channel == nullptr)
+        return false;
+
+    // @NOTE: a finished channel is left in `channels` (FMOD handles of finished channels just go invalid).
+    //        `AudioEngine` releases the slot and won't touch it again until the next `playSound()` overwrites it.
+    bool isPlaying = false;
+    channel->isPlaying(&isPlaying);
+    return isPlaying;
+}
+
+void AudioAdapter_FMOD::stopChannel(size_t channelSlot)
+{
+    if (channels[channelSlot] == nullptr)
+        return;
+
+    ERRCHECK(channels[channelSlot]->stop());
+}
+
+void AudioAdapter_FMOD::setChannel3dPosition(size_t channelSlot, vec3 position)
+{
+    if (channels[channelSlot] == nullptr)
+        return;
+
+    FMOD_VECTOR fPosition = { position[0], position[1], position[2] };
+    ERRCHECK(channels[channelSlot]->set3DAttributes(&fPosition, nullptr));
+}
+
+void AudioAdapter_FMOD::setChannelVolume(size_t channelSlot, float volume)
+{
+    if (channels[channelSlot] == nullptr)
+        return;
+
+    ERRCHECK(channels[channelSlot]->setVolume(volume));
+}
+
+void AudioAdapter_FMOD::setChannelLowpassGain(size_t channelSlot, float gain)
+{
+    if (channels[channelSlot] == nullptr)
+        return;
+
+    ERRCHECK(channels[channelSlot]->setLowPassGain(gain));
+}
+
+void AudioAdapter_FMOD::set3dListenerTransform(vec3 position, vec3 forward)
+{
+    FMOD_3D_ATTRIBUTES attributes = { { 0.0f } };
+    attributes.position = { position[0], position[1], position[2] };
+    attributes.forward = { forward[0], forward[1], forward[2] };
+    attributes.up = { 0.0f, 1.0f, 0.0f };
+    ERRCHECK(fmodStudioSystem->setListenerAttributes(0, &attributes));
+}
+
+void AudioAdapter_FMOD::loadBank(const std::string& bankName, uint32_t flags)
+{
+    if (banks.find(bankName) != banks.end())
+        return;     // Bank was already loaded... exit.
+
+    FMOD::Studio::Bank* bank;
+    ERRCHECK(fmodStudioSystem->loadBankFile(bankName.c_str(), (FMOD_STUDIO_LOAD_BANK_FLAGS)flags, &bank));
+
+    if (bank)
+    {
+        banks[bankName] = bank;
+    }
+}
+
+void AudioAdapter_FMOD::loadEvent(const std::string& eventName)
+{
+    if (events.find(eventName) != events.end())
+        return;     // Event already loaded... exit.
+
+    FMOD::Studio::EventDescription* eventDescription = nullptr;
+    ERRCHECK(fmodStudioSystem->getEvent(eventName.c_str(), &eventDescription));
+
+    if (eventDescription)
+    {
+        FMOD::Studio::EventInstance* eventInstance = nullptr;
+        ERRCHECK(eventDescription->createInstance(&eventInstance));
+        if (eventInstance)
+        {
+            events[eventName] = eventInstance;
+        }
+    }
+}
+
+void AudioAdapter_FMOD::playEvent(const std::string& eventName)
+{
+    auto event = events.find(eventName);
+    if (event == events.end())
+    {
+        loadEvent(eventName);
+        event = events.find(eventName);
+        if (event == events.end())
+            return;     // Event failed the on-the-fly creation... exit.
+    }
+
+    event->second->start();
+}
+
+void AudioAdapter_FMOD::stopEvent(const std::string& eventName, bool immediate)
+{
+    auto event = events.find(eventName);
+    if (event == events.end())
+        return;     // Exit if event not found.
+
+    FMOD_STUDIO_STOP_MODE mode;
+    mode = immediate ? FMOD_STUDIO_STOP_IMMEDIATE : FMOD_STUDIO_STOP_ALLOWFADEOUT;
+    ERRCHECK(event->second->stop(mode));
+}
+
+bool AudioAdapter_FMOD::isEventPlaying(const std::string& eventName) const
+{
+    auto event = events.find(eventName);
+    if (event == events.end())
+        return false;       // Event not found.
+
+    FMOD_STUDIO_PLAYBACK_STATE* state = nullptr;
+    return (event->second->getPlaybackState(state) == FMOD_STUDIO_PLAYBACK_PLAYING);
+}
+
+void AudioAdapter_FMOD::setEventParameter(const std::string& eventName, const std::string& parameterName, float value)
+{
+    auto event = events.find(eventName);
+    if (event == events.end())
+        return;     // Exit if event isn't created
+
+    ERRCHECK(event->second->setParameterByName(parameterName.c_str(), value));
+}
+
+void AudioAdapter_FMOD::getEventParameter(const std::string& eventName, const std::string& parameterName, float* outValue)
+{
+    auto event = events.find(eventName);
+    if (event == events.end())
+        return;     // Exit if event isn't created
+
+    ERRCHECK(event->second->getParameterByName(parameterName.c_str(), outValue));
+}
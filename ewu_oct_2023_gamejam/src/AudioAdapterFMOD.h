@@ -0,0 +1,49 @@
+#pragma once
+
+#include <fmod_studio.hpp>
+#include <fmod.hpp>
+#include <string>
+#include <map>
+#include <vector>
+#include <array>
+#include "AudioAdapter.h"
+#include "AudioEngine.h"
+
+
+class AudioAdapter_FMOD : public AudioAdapter
+{
+public:
+    AudioAdapter_FMOD();
+    ~AudioAdapter_FMOD();
+
+    void update() override;
+
+    int  loadSound(const std::string& fname, bool is3d, bool isLooping, bool stream) override;
+    void unloadSound(int soundId) override;
+
+    bool playSound(size_t channelSlot, int soundId, bool looping, vec3 position, float volume) override;
+    bool isChannelPlaying(size_t channelSlot) override;
+    void stopChannel(size_t channelSlot) override;
+    void setChannel3dPosition(size_t channelSlot, vec3 position) override;
+    void setChannelVolume(size_t channelSlot, float volume) override;
+    void setChannelLowpassGain(size_t channelSlot, float gain) override;
+
+    void set3dListenerTransform(vec3 position, vec3 forward) override;
+
+    void loadBank(const std::string& bankName, uint32_t flags) override;
+    void loadEvent(const std::string& eventName) override;
+    void playEvent(const std::string& eventName) override;
+    void stopEvent(const std::string& eventName, bool immediate) override;
+    bool isEventPlaying(const std::string& eventName) const override;
+    void setEventParameter(const std::string& eventName, const std::string& parameterName, float value) override;
+    void getEventParameter(const std::string& eventName, const std::string& parameterName, float* outValue) override;
+
+private:
+    FMOD::Studio::System* fmodStudioSystem = nullptr;
+    FMOD::System* fmodSystem = nullptr;
+
+    std::map<std::string, FMOD::Studio::Bank*> banks;
+    std::map<std::string, FMOD::Studio::EventInstance*> events;
+    std::vector<FMOD::Sound*> sounds;  // @NOTE: indexed by sound id. Unloaded sounds are left as nullptr so that ids stay stable.
+    std::array<FMOD::Channel*, AUDIO_MAX_CHANNEL_SLOTS> channels;
+};
@@ -0,0 +1,373 @@
+#include "AudioAdapterSoftware.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <algorithm>
+#include <chrono>
+#define STB_VORBIS_HEADER_ONLY
+#include <stb_vorbis.c>
+
+
+namespace
+{
+    constexpr float MIN_3D_DISTANCE = 1.0f;  // @NOTE: same as FMOD's default rolloff min distance.
+
+    template<typename T>
+    T readLE(const uint8_t* data)
+    {
+        T value;
+        memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    float sampleToFloat(const uint8_t* data, uint16_t format, uint16_t bitsPerSample)
+    {
+        if (format == 3)
+            return (bitsPerSample == 64 ? (float)readLE<double>(data) : readLE<float>(data));
+
+        switch (bitsPerSample)
+        {
+        case 8:  return ((float)data[0] - 128.0f) / 128.0f;
+        case 16: return (float)readLE<int16_t>(data) / 32768.0f;
+        case 24: return (float)((int32_t)((uint32_t)data[0] << 8 | (uint32_t)data[1] << 16 | (uint32_t)data[2] << 24) >> 8) / 8388608.0f;
+        case 32: return (float)((double)readLE<int32_t>(data) / 2147483648.0);
+        }
+        return 0.0f;
+    }
+
+    bool decodeWav(const std::string& fname, uint32_t& outNumChannels, uint32_t& outSampleRate, size_t& outNumFrames, std::vector<float>& outSamples)
+    {
+        std::ifstream file(fname, std::ios::binary);
+        if (!file.is_open())
+            return false;
+        std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        if (bytes.size() < 12 ||
+            memcmp(bytes.data(), "RIFF", 4) != 0 ||
+            memcmp(bytes.data() + 8, "WAVE", 4) != 0)
+            return false;
+
+        uint16_t format = 0;
+        uint16_t numChannels = 0;
+        uint32_t sampleRate = 0;
+        uint16_t bitsPerSample = 0;
+        const uint8_t* pcm = nullptr;
+        size_t pcmSize = 0;
+
+        // Walk thru the chunks
+        size_t offset = 12;
+        while (offset + 8 <= bytes.size())
+        {
+            const uint8_t* chunk = bytes.data() + offset;
+            uint32_t chunkSize = readLE<uint32_t>(chunk + 4);
+            size_t chunkDataSize = std::min((size_t)chunkSize, bytes.size() - offset - 8);
+
+            if (memcmp(chunk, "fmt ", 4) == 0 && chunkDataSize >= 16)
+            {
+                format        = readLE<uint16_t>(chunk + 8);
+                numChannels   = readLE<uint16_t>(chunk + 10);
+                sampleRate    = readLE<uint32_t>(chunk + 12);
+                bitsPerSample = readLE<uint16_t>(chunk + 22);
+                if (format == 0xFFFE && chunkDataSize >= 26)
+                    format = readLE<uint16_t>(chunk + 32);  // WAVE_FORMAT_EXTENSIBLE: the real format is the start of the subformat guid.
+            }
+            else if (memcmp(chunk, "data", 4) == 0)
+            {
+                pcm = chunk + 8;
+                pcmSize = chunkDataSize;
+            }
+
+            offset += 8 + (size_t)chunkSize + (chunkSize & 1);  // Chunks are padded to an even size.
+        }
+
+        bool supported =
+            (format == 1 && (bitsPerSample == 8 || bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32)) ||
+            (format == 3 && (bitsPerSample == 32 || bitsPerSample == 64));
+        if (!supported || pcm == nullptr || numChannels == 0 || sampleRate == 0)
+            return false;
+
+        // Convert into float (only keep up to stereo).
+        size_t bytesPerSample = bitsPerSample / 8;
+        size_t numFrames = pcmSize / (bytesPerSample * numChannels);
+        uint32_t keptChannels = std::min<uint32_t>(numChannels, AudioAdapter_Software::OUTPUT_CHANNELS);
+
+        outSamples.resize(numFrames * keptChannels);
+        for (size_t i = 0; i < numFrames; i++)
+            for (uint32_t c = 0; c < keptChannels; c++)
+                outSamples[i * keptChannels + c] = sampleToFloat(pcm + (i * numChannels + c) * bytesPerSample, format, bitsPerSample);
+
+        outNumChannels = keptChannels;
+        outSampleRate = sampleRate;
+        outNumFrames = numFrames;
+        return true;
+    }
+
+    bool decodeOgg(const std::string& fname, uint32_t& outNumChannels, uint32_t& outSampleRate, size_t& outNumFrames, std::vector<float>& outSamples)
+    {
+        int numChannels, sampleRate;
+        short* pcm;
+        int numFrames = stb_vorbis_decode_filename(fname.c_str(), &numChannels, &sampleRate, &pcm);
+        if (numFrames < 0)
+            return false;
+
+        // Convert into float (only keep up to stereo).
+        uint32_t keptChannels = std::min<uint32_t>((uint32_t)numChannels, AudioAdapter_Software::OUTPUT_CHANNELS);
+        outSamples.resize((size_t)numFrames * keptChannels);
+        for (size_t i = 0; i < (size_t)numFrames; i++)
+            for (uint32_t c = 0; c < keptChannels; c++)
+                outSamples[i * keptChannels + c] = pcm[i * numChannels + c] / 32768.0f;
+        free(pcm);  // @NOTE: stb_vorbis mallocs the output.
+
+        outSampleRate = (uint32_t)sampleRate;
+        outNumChannels = keptChannels;
+        outNumFrames = numFrames;
+        return true;
+    }
+}
+
+
+void AudioAdapter_Software::update()
+{
+    // Nothing to do. Mixing only happens when `renderToBuffer()` pulls frames.
+}
+
+int AudioAdapter_Software::loadSound(const std::string& fname, bool is3d, bool isLooping, bool stream)
+{
+    DecodedSound sound = {
+        .loaded = true,
+        .is3d = is3d,
+    };
+
+    std::filesystem::path extension = std::filesystem::path(fname).extension();
+    bool decoded = false;
+    if (extension == ".wav")
+        decoded = decodeWav(fname, sound.numChannels, sound.sampleRate, sound.numFrames, sound.samples);
+    else if (extension == ".ogg")
+        decoded = decodeOgg(fname, sound.numChannels, sound.sampleRate, sound.numFrames, sound.samples);
+    if (!decoded)
+    {
+        std::cerr << "[SOFTWARE AUDIO]" << std::endl
+            << "ERROR: could not decode \"" << fname << "\". Only uncompressed .wav and Ogg Vorbis are supported." << std::endl;
+        return -1;
+    }
+
+    sounds.push_back(std::move(sound));
+    return (int)sounds.size() - 1;
+}
+
+void AudioAdapter_Software::unloadSound(int soundId)
+{
+    // Stop anything still using it.
+    for (Voice& voice : voices)
+        if (voice.active && voice.soundId == soundId)
+            voice.active = false;
+
+    sounds[soundId] = DecodedSound();
+}
+
+bool AudioAdapter_Software::playSound(size_t channelSlot, int soundId, bool looping, vec3 position, float volume)
+{
+    if (!sounds[soundId].loaded || sounds[soundId].numFrames == 0)
+        return false;
+
+    Voice& voice = voices[channelSlot];
+    voice = Voice();
+    voice.active = true;
+    voice.soundId = soundId;
+    voice.looping = looping;
+    voice.volume = volume;
+    glm_vec3_copy(position, voice.position);
+    return true;
+}
+
+bool AudioAdapter_Software::isChannelPlaying(size_t channelSlot)
+{
+    return voices[channelSlot].active;
+}
+
+void AudioAdapter_Software::stopChannel(size_t channelSlot)
+{
+    voices[channelSlot].active = false;
+}
+
+void AudioAdapter_Software::setChannel3dPosition(size_t channelSlot, vec3 position)
+{
+    glm_vec3_copy(position, voices[channelSlot].position);
+}
+
+void AudioAdapter_Software::setChannelVolume(size_t channelSlot, float volume)
+{
+    voices[channelSlot].volume = volume;
+}
+
+void AudioAdapter_Software::setChannelLowpassGain(size_t channelSlot, float gain)
+{
+    voices[channelSlot].lowpassGain = glm_clamp(gain, 0.0f, 1.0f);
+}
+
+void AudioAdapter_Software::set3dListenerTransform(vec3 position, vec3 forward)
+{
+    glm_vec3_copy(position, listenerPosition);
+    glm_vec3_copy(forward, listenerForward);
+}
+
+void AudioAdapter_Software::renderToBuffer(float* outSamples, size_t numFrames)
+{
+    memset(outSamples, 0, sizeof(float) * numFrames * OUTPUT_CHANNELS);
+
+    for (Voice& voice : voices)
+    {
+        if (!voice.active)
+            continue;
+
+        const DecodedSound& sound = sounds[voice.soundId];
+
+        // @NOTE: the gains only get calculated once per render, so moving sources/listener are block-rate.
+        float gains[OUTPUT_CHANNELS];
+        calculateVoiceGains(voice, sound, gains);
+
+        double step = (double)sound.sampleRate / (double)OUTPUT_SAMPLE_RATE;
+        float lowpass = voice.lowpassGain;
+
+        for (size_t i = 0; i < numFrames; i++)
+        {
+            if (voice.cursor >= (double)sound.numFrames)
+            {
+                if (!voice.looping)
+                {
+                    voice.active = false;
+                    break;
+                }
+                voice.cursor = fmod(voice.cursor, (double)sound.numFrames);
+            }
+
+            // Linear resample.
+            size_t frame0 = (size_t)voice.cursor;
+            size_t frame1 = frame0 + 1;
+            if (frame1 >= sound.numFrames)
+                frame1 = (voice.looping ? 0 : frame0);
+            float t = (float)(voice.cursor - (double)frame0);
+
+            for (uint32_t c = 0; c < OUTPUT_CHANNELS; c++)
+            {
+                uint32_t srcC = std::min(c, sound.numChannels - 1);  // Mono gets sent to both sides.
+                float s0 = sound.samples[frame0 * sound.numChannels + srcC];
+                float s1 = sound.samples[frame1 * sound.numChannels + srcC];
+                float sample = s0 + (s1 - s0) * t;
+
+                // One-pole lowpass. Gain of 1 is a passthru, like FMOD's `setLowPassGain()`.
+                voice.lowpassState[c] += lowpass * (sample - voice.lowpassState[c]);
+                outSamples[i * OUTPUT_CHANNELS + c] += voice.lowpassState[c] * gains[c];
+            }
+
+            voice.cursor += step;
+        }
+    }
+}
+
+size_t AudioAdapter_Software::getNumActiveVoices() const
+{
+    size_t count = 0;
+    for (const Voice& voice : voices)
+        if (voice.active)
+            count++;
+    return count;
+}
+
+#ifdef _DEVELOP
+void AudioAdapter_Software::benchmarkMixing(const std::string& directory)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    auto msSince = [](Clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    };
+
+    std::cout << "[BENCHMARK AUDIO MIX]" << std::endl;
+    AudioAdapter_Software* adapter = new AudioAdapter_Software();  // On the heap, since the voice array is big.
+
+    // Decode everything, like `AudioEngine::preloadSoundManifest()` does.
+    std::vector<int> soundIds;
+    auto start = Clock::now();
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        auto ext = entry.path().extension();
+        if (!entry.is_regular_file() || (ext != ".wav" && ext != ".ogg"))
+            continue;
+        int soundId = adapter->loadSound(entry.path().generic_string(), true, false, false);
+        if (soundId >= 0)
+            soundIds.push_back(soundId);
+    }
+    double loadMS = msSince(start);
+    std::cout << "Decoded " << soundIds.size() << " sounds from \"" << directory << "\" in " << loadMS << " ms" << std::endl;
+    if (soundIds.empty())
+    {
+        delete adapter;
+        return;
+    }
+
+    // Mix 10 seconds of audio at each voice count, in 60hz ticks like a headless run.
+    constexpr size_t numFramesPerTick = OUTPUT_SAMPLE_RATE / 60;
+    constexpr size_t numTicks = 60 * 10;
+    std::vector<float> buffer(numFramesPerTick * OUTPUT_CHANNELS);
+    vec3 listenerPosition = GLM_VEC3_ZERO_INIT;
+    vec3 listenerForward = { 0.0f, 0.0f, 1.0f };
+    adapter->set3dListenerTransform(listenerPosition, listenerForward);
+
+    constexpr size_t voiceCounts[] = { 1, 8, 32, 128, 512, AUDIO_MAX_CHANNEL_SLOTS };
+    for (size_t numVoices : voiceCounts)
+    {
+        for (size_t i = 0; i < AUDIO_MAX_CHANNEL_SLOTS; i++)
+            adapter->stopChannel(i);
+        for (size_t i = 0; i < numVoices; i++)
+        {
+            float angle = (float)i * 2.399963f;  // Golden angle, so the voices spread out around the listener.
+            vec3 position = { cosf(angle) * (float)(i % 16), 0.0f, sinf(angle) * (float)(i % 16) };
+            adapter->playSound(i, soundIds[i % soundIds.size()], true, position, 1.0f);
+            adapter->setChannelLowpassGain(i, (i % 2 == 0) ? 1.0f : 0.25f);
+        }
+
+        start = Clock::now();
+        for (size_t tick = 0; tick < numTicks; tick++)
+            adapter->renderToBuffer(buffer.data(), numFramesPerTick);
+        double mixMS = msSince(start);
+
+        std::cout << "    " << numVoices << " voices: " << (mixMS / numTicks) << " ms per tick, "
+            << (mixMS * 1e6 / ((double)numVoices * numFramesPerTick * numTicks)) << " ns per voice per frame" << std::endl;
+    }
+
+    delete adapter;
+}
+#endif
+
+void AudioAdapter_Software::calculateVoiceGains(const Voice& voice, const DecodedSound& sound, float outGains[OUTPUT_CHANNELS])
+{
+    if (!sound.is3d)
+    {
+        outGains[0] = outGains[1] = voice.volume;
+        return;
+    }
+
+    vec3 toSource;
+    glm_vec3_sub((float*)voice.position, listenerPosition, toSource);
+    float distance = glm_vec3_norm(toSource);
+
+    // Inverse distance rolloff.
+    float attenuation = MIN_3D_DISTANCE / std::max(distance, MIN_3D_DISTANCE);
+
+    // Equal power panning off of the listener's right direction.
+    float pan = 0.0f;
+    if (distance > 0.0001f)
+    {
+        vec3 up = { 0.0f, 1.0f, 0.0f };
+        vec3 right;
+        glm_vec3_cross(listenerForward, up, right);
+        glm_vec3_normalize(right);
+        pan = glm_clamp(glm_vec3_dot(toSource, right) / distance, -1.0f, 1.0f);
+    }
+    float angle = (pan + 1.0f) * (float)GLM_PI_4;
+
+    outGains[0] = voice.volume * attenuation * cosf(angle);
+    outGains[1] = voice.volume * attenuation * sinf(angle);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <array>
+#include "AudioAdapter.h"
+#include "AudioEngine.h"
+
+
+// @NOTE: a headless mixer that doesn't need an audio device (or FMOD). Nothing gets mixed
+//        until `renderToBuffer()` gets called, so whoever owns the timeline (tests, benchmarks,
+//        headless runs) decides how many frames to pull. Uncompressed .wav and Ogg Vorbis files get
+//        decoded whole at load time (`stream` is ignored); anything else fails to load like a missing
+//        file would.
+class AudioAdapter_Software : public AudioAdapter
+{
+public:
+    static constexpr uint32_t OUTPUT_SAMPLE_RATE = 48000;
+    static constexpr uint32_t OUTPUT_CHANNELS    = 2;
+
+    void update() override;
+
+    int  loadSound(const std::string& fname, bool is3d, bool isLooping, bool stream) override;
+    void unloadSound(int soundId) override;
+
+    bool playSound(size_t channelSlot, int soundId, bool looping, vec3 position, float volume) override;
+    bool isChannelPlaying(size_t channelSlot) override;
+    void stopChannel(size_t channelSlot) override;
+    void setChannel3dPosition(size_t channelSlot, vec3 position) override;
+    void setChannelVolume(size_t channelSlot, float volume) override;
+    void setChannelLowpassGain(size_t channelSlot, float gain) override;
+
+    void set3dListenerTransform(vec3 position, vec3 forward) override;
+
+    // Mixes all active voices into `outSamples` (interleaved stereo, `numFrames * OUTPUT_CHANNELS` floats).
+    void   renderToBuffer(float* outSamples, size_t numFrames);
+    size_t getNumActiveVoices() const;
+
+#ifdef _DEVELOP
+    // Times decoding the sounds in `directory`, then mixing increasing numbers of looping voices.
+    static void benchmarkMixing(const std::string& directory);
+#endif
+
+private:
+    struct DecodedSound
+    {
+        bool loaded = false;
+        bool is3d = true;
+        uint32_t numChannels = 0;
+        uint32_t sampleRate = 0;
+        size_t numFrames = 0;
+        std::vector<float> samples = {};  // Interleaved.
+    };
+    std::vector<DecodedSound> sounds;
+
+    struct Voice
+    {
+        bool active = false;
+        int soundId = -1;
+        bool looping = false;
+        double cursor = 0.0;  // In source frames.
+        vec3 position = GLM_VEC3_ZERO_INIT;
+        float volume = 1.0f;
+        float lowpassGain = 1.0f;
+        float lowpassState[OUTPUT_CHANNELS] = { 0.0f, 0.0f };
+    };
+    std::array<Voice, AUDIO_MAX_CHANNEL_SLOTS> voices;
+
+    vec3 listenerPosition = GLM_VEC3_ZERO_INIT;
+    vec3 listenerForward  = { 0.0f, 0.0f, 1.0f };
+
+    void calculateVoiceGains(const Voice& voice, const DecodedSound& sound, float outGains[OUTPUT_CHANNELS]);
+};
@@ -1,17 +1,12 @@
 #include "AudioEngine.h"
 
-#include <fmod_errors.h>
 #include <iostream>
-
-
-#define ERRCHECK(_result) errorCheck(_result, __FILE__, __LINE__)
-void errorCheck(FMOD_RESULT result, const char* file, int line)
-{
-    if (result != FMOD_OK)
-    {
-        std::cerr << "FMOD ERROR:: " << file << " :::: Line " << line << std::endl << "\t" << FMOD_ErrorString(result) << std::endl;
-    }
-}
+#include <filesystem>
+#include "AudioAdapter.h"
+#include "AudioAdapterSoftware.h"
+#ifndef AUDIOENGINE_NO_FMOD
+#include "AudioAdapterFMOD.h"
+#endif
 
 
 AudioEngine& AudioEngine::getInstance()
@@ -20,13 +15,58 @@ AudioEngine& AudioEngine::getInstance()
 	return instance;
 }
 
-void AudioEngine::initialize()
+void AudioEngine::initialize(AudioAdapterType adapterType)
 {
-    audioAdapter = new AudioAdapter_FMOD();
+    switch (adapterType)
+    {
+#ifndef AUDIOENGINE_NO_FMOD
+    case AudioAdapterType::FMOD:
+        audioAdapter = new AudioAdapter_FMOD();
+        break;
+#endif
+
+    default:
+        std::cerr << "[AUDIO ENGINE]" << std::endl
+            << "WARNING: requested audio adapter isn't available. Falling back to software mixer." << std::endl;
+        [[fallthrough]];
+    case AudioAdapterType::SOFTWARE:
+        audioAdapter = new AudioAdapter_Software();
+        break;
+    }
+
+    freeChannelSlots.reserve(AUDIO_MAX_CHANNEL_SLOTS);
+    for (size_t i = AUDIO_MAX_CHANNEL_SLOTS; i > 0; i--)
+        freeChannelSlots.push_back(i - 1);
+
+    // Get all the sfx decoded before gameplay starts so that nothing has to get loaded mid-tick.
+    preloadSoundManifest("res/sfx/");
 }
 
 void AudioEngine::update()
 {
+    // Take all the commands queued up since last update.
+    {
+        std::lock_guard<std::mutex> lg(commandMutex);
+        std::swap(pendingCommands, executingCommands);
+    }
+
+    for (auto& command : executingCommands)
+        executeCommand(command);
+    executingCommands.clear();
+
+    // Release the slots of channels that finished.
+    {
+        std::lock_guard<std::mutex> lg(commandMutex);
+        for (size_t i = 0; i < AUDIO_MAX_CHANNEL_SLOTS; i++)
+        {
+            if (!channelSlots[i].started)
+                continue;
+
+            if (!audioAdapter->isChannelPlaying(i))
+                releaseChannelSlot(i);
+        }
+    }
+
     audioAdapter->update();
 }
 
@@ -35,30 +75,53 @@ void AudioEngine::cleanup()
     delete audioAdapter;
 }
 
+void AudioEngine::preloadSoundManifest(const std::string& directory)
+{
+    for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        const auto& path = entry.path();
+        if (std::filesystem::is_directory(path))
+            continue;
+
+        auto ext = path.extension().string();
+        if (ext != ".wav" && ext != ".ogg" && ext != ".flac")
+            continue;
+
+        auto relativePath = std::filesystem::relative(path, ".");
+        loadSound(relativePath.generic_string());  // @NOTE: generic string so that the name matches the forward slash names used in `playSound()`.
+    }
+}
+
 void AudioEngine::loadSound(const std::string& fname, bool is3d, bool isLooping, bool stream)
 {
-    if (audioAdapter->sounds.find(fname) != audioAdapter->sounds.end())
-        return;     // Sound already loaded up... exit.
-
-    FMOD_MODE mode = FMOD_DEFAULT;
-    mode |= is3d ? FMOD_3D : FMOD_2D;
-    mode |= isLooping ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
-    mode |= stream ? FMOD_CREATESTREAM : FMOD_CREATECOMPRESSEDSAMPLE;
-
-    FMOD::Sound* sound = nullptr;
-    ERRCHECK(audioAdapter->fmodSystem->createSound(fname.c_str(), mode, nullptr, &sound));
-    if (sound)
-        audioAdapter->sounds[fname] = sound;
+    {
+        std::lock_guard<std::mutex> lg(commandMutex);
+        if (soundNameToSoundId.find(fname) != soundNameToSoundId.end())
+            return;     // Sound already loaded up... exit.
+    }
+
+    int soundId = audioAdapter->loadSound(fname, is3d, isLooping, stream);
+    if (soundId >= 0)
+    {
+        std::lock_guard<std::mutex> lg(commandMutex);
+        soundNameToSoundId[fname] = soundId;
+    }
 }
 
 void AudioEngine::unloadSound(const std::string& fname)
 {
-    auto sound = audioAdapter->sounds.find(fname);
-    if (sound == audioAdapter->sounds.end())
-        return;     // Sound doesn't exist in the map... exit.
+    int soundId;
+    {
+        std::lock_guard<std::mutex> lg(commandMutex);
+        auto it = soundNameToSoundId.find(fname);
+        if (it == soundNameToSoundId.end())
+            return;     // Sound doesn't exist in the map... exit.
+
+        soundId = it->second;
+        soundNameToSoundId.erase(it);
+    }
 
-    ERRCHECK(sound->second->release());
-    audioAdapter->sounds.erase(sound);
+    audioAdapter->unloadSound(soundId);
 }
 
 int AudioEngine::playSound(const std::string& fname, bool looping)
@@ -75,236 +138,244 @@ int AudioEngine::playSoundFromList(const std::vector<std::string>& fnames)
 
 int AudioEngine::playSound(const std::string& fname, bool looping, vec3 position, float db)
 {
-    int channelId = audioAdapter->nextChannelId++;
-    auto sound = audioAdapter->sounds.find(fname);
-    if (sound == audioAdapter->sounds.end())
-    {
-        // Load in the missing sound
-        loadSound(fname);
-        sound = audioAdapter->sounds.find(fname);
-        if (sound == audioAdapter->sounds.end())
-        {
-            return -1;      // For some reason it failed creating the new sound. Just exit early
-        }
-    }
-
-    // Setup looping if that's changed
-    FMOD_MODE mode;
-    sound->second->getMode(&mode);
-    if (looping != (bool)(mode & FMOD_LOOP_NORMAL))
-    {
-        mode &= looping ? ~FMOD_LOOP_OFF : ~FMOD_LOOP_NORMAL;
-        mode |= looping ? FMOD_LOOP_NORMAL : FMOD_LOOP_OFF;
-        sound->second->setMode(mode);
-    }
-
-    // Play sound paused in case if 3D sound setup is required
-    FMOD::Channel* channel = nullptr;
-    ERRCHECK(audioAdapter->fmodSystem->playSound(sound->second, nullptr, true, &channel));
-    if (channel)
-    {
-        if (mode & FMOD_3D)
-        {
-            FMOD_VECTOR fPosition = { position[0], position[1], position[2] };
-            ERRCHECK(channel->set3DAttributes(&fPosition, nullptr));       // @NOTE: I guess putting in velocity in the future should be useful and good eh!  -Timo
-        }
-        ERRCHECK(channel->setVolume(dbToVolume(db)));
-        ERRCHECK(channel->setPaused(false));
-        audioAdapter->channels[channelId] = channel;
-
-        return channelId;
-    }
-    return -1;      // New channel didn't get created. Show failure.
+    std::lock_guard<std::mutex> lg(commandMutex);
+
+    int channelId = reserveChannelId();
+    if (channelId < 0)
+        return -1;      // Ran out of channel slots.
+
+    AudioCommand command = {
+        .type = AudioCommand::Type::PLAY_SOUND,
+        .channelId = channelId,
+        .looping = looping,
+        .value = db,
+    };
+    glm_vec3_copy(position, command.position);
+
+    auto sound = soundNameToSoundId.find(fname);
+    if (sound == soundNameToSoundId.end())
+        command.soundFnameToLoad = fname;     // Not preloaded. Load in the missing sound on the main thread.
+    else
+        command.soundId = sound->second;
+
+    pushCommand(std::move(command));
+    return channelId;
 }
 
 void AudioEngine::setChannel3dPosition(int channelId, vec3 position)
 {
-    auto channel = audioAdapter->channels.find(channelId);
-    if (channel == audioAdapter->channels.end())
-        return;
-
-    FMOD_VECTOR fPosition = { position[0], position[1], position[2] };
-    ERRCHECK(channel->second->set3DAttributes(&fPosition, nullptr));
+    AudioCommand command = {
+        .type = AudioCommand::Type::SET_CHANNEL_3D_POSITION,
+        .channelId = channelId,
+    };
+    glm_vec3_copy(position, command.position);
+
+    std::lock_guard<std::mutex> lg(commandMutex);
+    pushCommand(std::move(command));
 }
 
 void AudioEngine::setChannelVolume(int channelId, float db)
 {
-    auto channel = audioAdapter->channels.find(channelId);
-    if (channel == audioAdapter->channels.end())
-        return;
-
-    ERRCHECK(channel->second->setVolume(dbToVolume(db)));
+    std::lock_guard<std::mutex> lg(commandMutex);
+    pushCommand({
+        .type = AudioCommand::Type::SET_CHANNEL_VOLUME,
+        .channelId = channelId,
+        .value = db,
+    });
 }
 
 void AudioEngine::setChannelLowpassGain(int channelId, float gain)
 {
-    auto channel = audioAdapter->channels.find(channelId);
-    if (channel == audioAdapter->channels.end())
-        return;
-
-    ERRCHECK(channel->second->setLowPassGain(gain));
+    std::lock_guard<std::mutex> lg(commandMutex);
+    pushCommand({
+        .type = AudioCommand::Type::SET_CHANNEL_LOWPASS_GAIN,
+        .channelId = channelId,
+        .value = gain,
+    });
 }
 
-void AudioEngine::loadBank(const std::string& bankName, FMOD_STUDIO_LOAD_BANK_FLAGS flags)
+void AudioEngine::loadBank(const std::string& bankName, uint32_t flags)
 {
-    if (audioAdapter->banks.find(bankName) != audioAdapter->banks.end())
-        return;     // Bank was already loaded... exit.
-
-    FMOD::Studio::Bank* bank;
-    ERRCHECK(audioAdapter->fmodStudioSystem->loadBankFile(bankName.c_str(), flags, &bank));
-    
-    if (bank)
-    {
-        audioAdapter->banks[bankName] = bank;
-    }
+    audioAdapter->loadBank(bankName, flags);
 }
 
 void AudioEngine::loadEvent(const std::string& eventName)
 {
-    if (audioAdapter->events.find(eventName) != audioAdapter->events.end())
-        return;     // Event already loaded... exit.
-
-    FMOD::Studio::EventDescription* eventDescription = nullptr;
-    ERRCHECK(audioAdapter->fmodStudioSystem->getEvent(eventName.c_str(), &eventDescription));
-
-    if (eventDescription)
-    {
-        FMOD::Studio::EventInstance* eventInstance = nullptr;
-        ERRCHECK(eventDescription->createInstance(&eventInstance));
-        if (eventInstance)
-        {
-            audioAdapter->events[eventName] = eventInstance;
-        }
-    }
+    audioAdapter->loadEvent(eventName);
 }
 
 void AudioEngine::playEvent(const std::string& eventName)
 {
-    auto event = audioAdapter->events.find(eventName);
-    if (event == audioAdapter->events.end())
-    {
-        loadEvent(eventName);
-        event = audioAdapter->events.find(eventName);
-        if (event == audioAdapter->events.end())
-            return;     // Event failed the on-the-fly creation... exit.
-    }
-
-    event->second->start();
+    audioAdapter->playEvent(eventName);
 }
 
 void AudioEngine::stopEvent(const std::string& eventName, bool immediate)
 {
-    auto event = audioAdapter->events.find(eventName);
-    if (event == audioAdapter->events.end())
-        return;     // Exit if event not found.
-
-    FMOD_STUDIO_STOP_MODE mode;
-    mode = immediate ? FMOD_STUDIO_STOP_IMMEDIATE : FMOD_STUDIO_STOP_ALLOWFADEOUT;
-    ERRCHECK(event->second->stop(mode));
+    audioAdapter->stopEvent(eventName, immediate);
 }
 
 bool AudioEngine::isEventPlaying(const std::string& eventName) const
 {
-    auto event = audioAdapter->events.find(eventName);
-    if (event == audioAdapter->events.end())
-        return false;       // Event not found.
-
-    FMOD_STUDIO_PLAYBACK_STATE* state = nullptr;
-    return (event->second->getPlaybackState(state) == FMOD_STUDIO_PLAYBACK_PLAYING);
+    return audioAdapter->isEventPlaying(eventName);
 }
 
 void AudioEngine::setEventParameter(const std::string& eventName, const std::string& parameterName, float value)
 {
-    auto event = audioAdapter->events.find(eventName);
-    if (event == audioAdapter->events.end())
-        return;     // Exit if event isn't created
-
-    ERRCHECK(event->second->setParameterByName(parameterName.c_str(), value));
+    audioAdapter->setEventParameter(eventName, parameterName, value);
 }
 
 void AudioEngine::getEventParameter(const std::string& eventName, const std::string& parameterName, float* outValue)
 {
-    auto event = audioAdapter->events.find(eventName);
-    if (event == audioAdapter->events.end())
-        return;     // Exit if event isn't created
-
-    ERRCHECK(event->second->getParameterByName(parameterName.c_str(), outValue));
+    audioAdapter->getEventParameter(eventName, parameterName, outValue);
 }
 
 void AudioEngine::set3dListenerTransform(vec3 position, vec3 forward)
 {
-    FMOD_3D_ATTRIBUTES attributes = { { 0.0f } };
-    attributes.position = { position[0], position[1], position[2] };
-    attributes.forward = { forward[0], forward[1], forward[2] };
-    attributes.up = { 0.0f, 1.0f, 0.0f };
-    ERRCHECK(audioAdapter->fmodStudioSystem->setListenerAttributes(0, &attributes));
+    audioAdapter->set3dListenerTransform(position, forward);
 }
 
 void AudioEngine::stopChannel(int channelId)
 {
-    auto channel = audioAdapter->channels.find(channelId);
-    if (channel == audioAdapter->channels.end())
-        return;     // Exit bc channel doesn't exist
-
-    ERRCHECK(channel->second->stop());        // NOTE: let the update() function take care of cleaning up the stopped channels
+    // @NOTE: let the update() function take care of cleaning up the stopped channels.
+    std::lock_guard<std::mutex> lg(commandMutex);
+    pushCommand({
+        .type = AudioCommand::Type::STOP_CHANNEL,
+        .channelId = channelId,
+    });
 }
 
 void AudioEngine::stopAllChannels()
 {
-    for (auto it = audioAdapter->channels.begin(); it != audioAdapter->channels.end(); it++)
-    {
-        bool isPlaying = false;
-        it->second->isPlaying(&isPlaying);
-        if (isPlaying)
-            ERRCHECK(it->second->stop());
-    }
+    std::lock_guard<std::mutex> lg(commandMutex);
+    pushCommand({
+        .type = AudioCommand::Type::STOP_ALL_CHANNELS,
+    });
 }
 
 bool AudioEngine::isPlaying(int channelId) const
 {
-    auto channel = audioAdapter->channels.find(channelId);
-    if (channel == audioAdapter->channels.end())
-        return false;     // Exit bc channel doesn't exist
-
-    bool isPlaying = false;
-    channel->second->isPlaying(&isPlaying);
-    return isPlaying;
+    // @NOTE: doesn't ask the adapter, since this can get called from any thread. A channel that
+    //        finished gets its slot released in `update()`, which makes the id stale, so this
+    //        reports it as playing until the next `update()` at the latest.
+    size_t slot;
+    return channelIdToSlot(channelId, slot);
 }
 
-
 //
-// FMOD Audio Adapter
+// Command queue
+// @NOTE: `reserveChannelId()`, `releaseChannelSlot()` and `pushCommand()` expect `commandMutex` to already be locked.
 //
-AudioAdapter_FMOD::AudioAdapter_FMOD()
+int AudioEngine::reserveChannelId()
+{
+    if (freeChannelSlots.empty())
+    {
+        std::cerr << "[AUDIO ENGINE]" << std::endl
+            << "ERROR: ran out of channel slots (max " << AUDIO_MAX_CHANNEL_SLOTS << ")." << std::endl;
+        return -1;
+    }
+
+    size_t slot = freeChannelSlots.back();
+    freeChannelSlots.pop_back();
+    channelSlots[slot].reserved = true;
+    return (channelSlots[slot].generation << AUDIO_CHANNEL_SLOT_BITS) | (int)slot;
+}
+
+void AudioEngine::releaseChannelSlot(size_t slot)
+{
+    ChannelSlot& cs = channelSlots[slot];
+    cs.reserved = false;
+    cs.started = false;
+    cs.generation = (cs.generation + 1) & (INT32_MAX >> AUDIO_CHANNEL_SLOT_BITS);  // Keep the channel id positive so -1 still means failure.
+    freeChannelSlots.push_back(slot);
+}
+
+bool AudioEngine::channelIdToSlot(int channelId, size_t& outSlot) const
 {
-    fmodStudioSystem = nullptr;
-    fmodSystem = nullptr;
+    if (channelId < 0)
+        return false;
+
+    std::lock_guard<std::mutex> lg(commandMutex);
+    size_t slot = (size_t)(channelId & AUDIO_CHANNEL_SLOT_MASK);
+    const ChannelSlot& cs = channelSlots[slot];
+    if (!cs.reserved || cs.generation != (channelId >> AUDIO_CHANNEL_SLOT_BITS))
+        return false;     // Stale id.
 
-    ERRCHECK(FMOD::Studio::System::create(&fmodStudioSystem));
-    ERRCHECK(fmodStudioSystem->getCoreSystem(&fmodSystem));
-    ERRCHECK(fmodSystem->setSoftwareFormat(0, FMOD_SPEAKERMODE_5POINT1, 0));
-    ERRCHECK(fmodStudioSystem->initialize(32, FMOD_STUDIO_INIT_LIVEUPDATE, FMOD_INIT_PROFILE_ENABLE, nullptr));        // @NOTE: this may be a problem with the FMOD_STUDIO_INIT_LIVEUPDATE when doing a release build      // @NOTE: Hey, so in the examples the max number of channels was 1024... maybe want to rethink the capacity??  -Timo
+    outSlot = slot;
+    return true;
 }
 
-AudioAdapter_FMOD::~AudioAdapter_FMOD()
+void AudioEngine::pushCommand(AudioCommand&& command)
 {
-    ERRCHECK(fmodStudioSystem->unloadAll());
-    ERRCHECK(fmodStudioSystem->release());
+    pendingCommands.push_back(std::move(command));
+}
+
+void AudioEngine::executeCommand(AudioCommand& command)
+{
+    if (command.type == AudioCommand::Type::PLAY_SOUND)
+    {
+        executePlaySound(command);
+        return;
+    }
+
+    if (command.type == AudioCommand::Type::STOP_ALL_CHANNELS)
+    {
+        for (size_t i = 0; i < AUDIO_MAX_CHANNEL_SLOTS; i++)
+            if (channelSlots[i].started)
+                audioAdapter->stopChannel(i);
+        return;
+    }
+
+    size_t slot;
+    if (!channelIdToSlot(command.channelId, slot) || !channelSlots[slot].started)
+        return;
+
+    switch (command.type)
+    {
+    case AudioCommand::Type::STOP_CHANNEL:
+        audioAdapter->stopChannel(slot);
+        break;
+
+    case AudioCommand::Type::SET_CHANNEL_3D_POSITION:
+        audioAdapter->setChannel3dPosition(slot, command.position);
+        break;
+
+    case AudioCommand::Type::SET_CHANNEL_VOLUME:
+        audioAdapter->setChannelVolume(slot, dbToVolume(command.value));
+        break;
+
+    case AudioCommand::Type::SET_CHANNEL_LOWPASS_GAIN:
+        audioAdapter->setChannelLowpassGain(slot, command.value);
+        break;
+
+    default:
+        break;
+    }
 }
 
-void AudioAdapter_FMOD::update()
+void AudioEngine::executePlaySound(AudioCommand& command)
 {
-    std::vector<std::map<int, FMOD::Channel*>::iterator> stoppedChannelRefs;
-    for (auto it = channels.begin(); it != channels.end(); it++)
+    size_t slot;
+    if (!channelIdToSlot(command.channelId, slot))
+        return;
+
+    if (command.soundId < 0)
     {
-        bool isPlaying = false;
-        it->second->isPlaying(&isPlaying);
-        if (!isPlaying)
-            stoppedChannelRefs.push_back(it);
+        // Load in the missing sound
+        loadSound(command.soundFnameToLoad);
+        std::lock_guard<std::mutex> lg(commandMutex);
+        auto it = soundNameToSoundId.find(command.soundFnameToLoad);
+        if (it != soundNameToSoundId.end())
+            command.soundId = it->second;
+    }
+
+    if (command.soundId >= 0 &&
+        audioAdapter->playSound(slot, command.soundId, command.looping, command.position, dbToVolume(command.value)))
+    {
+        channelSlots[slot].started = true;
+        return;
     }
 
-    for (auto& it : stoppedChannelRefs)
-        channels.erase(it);
-    
-    ERRCHECK(fmodStudioSystem->update());
+    // For some reason it failed creating the new sound or channel. Give up the channel.
+    std::lock_guard<std::mutex> lg(commandMutex);
+    releaseChannelSlot(slot);
 }
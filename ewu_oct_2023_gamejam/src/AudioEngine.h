@@ -2,25 +2,42 @@
 
 #pragma once
 
-#include <fmod_studio.hpp>
-#include <fmod.hpp>
 #include <string>
-#include <map>
+#include <unordered_map>
 #include <vector>
+#include <array>
+#include <mutex>
 #include "ImportGLM.h"
 
-struct AudioAdapter_FMOD;
+class AudioAdapter;
 
 
+// @NOTE: channel ids are generational handles. The lower bits are the channel slot and the
+//        upper bits are the generation of that slot, so a stale id from a sound that already
+//        finished will never touch a newer sound that got recycled into the same slot.
+constexpr int    AUDIO_CHANNEL_SLOT_BITS = 10;
+constexpr size_t AUDIO_MAX_CHANNEL_SLOTS = (size_t)1 << AUDIO_CHANNEL_SLOT_BITS;
+constexpr int    AUDIO_CHANNEL_SLOT_MASK = (int)AUDIO_MAX_CHANNEL_SLOTS - 1;
+
+enum class AudioAdapterType
+{
+    FMOD,
+    SOFTWARE,  // Headless software mixer. Renders into an offline buffer instead of an audio device.
+};
+
 class AudioEngine
 {
 public:
     static AudioEngine& getInstance();
 
-    void initialize();
+    void initialize(AudioAdapterType adapterType = AudioAdapterType::FMOD);
     void update();
     void cleanup();
 
+    // @NOTE: loading/unloading and events are blocking and need to be called from the main thread.
+    //        Everything dealing with channels is just put into the command queue, so it's safe to
+    //        call from any thread (e.g. the physics thread). The queued commands get executed in `update()`.
+    void preloadSoundManifest(const std::string& directory);
     void loadSound(const std::string& fname, bool is3d = true, bool isLooping = false, bool stream = false);
     void unloadSound(const std::string& fname);
     int playSound(const std::string& fname, bool looping = false);
@@ -31,7 +48,7 @@ public:
     void setChannelVolume(int channelId, float db);
     void setChannelLowpassGain(int channelId, float gain);
 
-    void loadBank(const std::string& bankName, FMOD_STUDIO_LOAD_BANK_FLAGS flags);
+    void loadBank(const std::string& bankName, uint32_t flags);
     void loadEvent(const std::string& eventName);
     void playEvent(const std::string& eventName);
     void stopEvent(const std::string& eventName, bool immediate = false);
@@ -50,27 +67,51 @@ public:
     inline float dbToVolume(float db) { return powf(10.0f, 0.05f * db); }
     inline float volumeToDb(float volume) { return 20.0f * log10f(volume); }
 
+    AudioAdapter* getAdapter() { return audioAdapter; }
+
 private:
     AudioEngine() = default;
     ~AudioEngine() {}
-    AudioAdapter_FMOD* audioAdapter = nullptr;
+    AudioAdapter* audioAdapter = nullptr;
+
+    struct AudioCommand
+    {
+        enum class Type
+        {
+            PLAY_SOUND,
+            STOP_CHANNEL,
+            STOP_ALL_CHANNELS,
+            SET_CHANNEL_3D_POSITION,
+            SET_CHANNEL_VOLUME,
+            SET_CHANNEL_LOWPASS_GAIN,
+        } type;
+        int channelId = -1;
+        int soundId   = -1;
+        std::string soundFnameToLoad = "";  // @NOTE: only filled in when the sound wasn't preloaded (i.e. `soundId == -1`).
+        bool looping  = false;
+        vec3 position = GLM_VEC3_ZERO_INIT;
+        float value   = 0.0f;  // Volume db or lowpass gain.
+    };
+
+    struct ChannelSlot
+    {
+        int generation = 0;
+        bool reserved  = false;
+        bool started   = false;  // @NOTE: only touched on the main thread, once the play command got executed.
+    };
+
+    mutable std::mutex commandMutex;  // For locking the command queue, channel slots, and the sound name lookup.
+    std::vector<AudioCommand> pendingCommands;
+    std::vector<AudioCommand> executingCommands;
+    std::array<ChannelSlot, AUDIO_MAX_CHANNEL_SLOTS> channelSlots;
+    std::vector<size_t> freeChannelSlots;
+    std::unordered_map<std::string, int> soundNameToSoundId;
+
+    int  reserveChannelId();
+    void releaseChannelSlot(size_t slot);
+    bool channelIdToSlot(int channelId, size_t& outSlot) const;
+    void pushCommand(AudioCommand&& command);
+    void executeCommand(AudioCommand& command);
+    void executePlaySound(AudioCommand& command);
 };
 
-
-struct AudioAdapter_FMOD
-{
-    AudioAdapter_FMOD();
-    ~AudioAdapter_FMOD();
-
-    void update();
-
-    FMOD::Studio::System* fmodStudioSystem = nullptr;
-    FMOD::System* fmodSystem = nullptr;
-
-    int nextChannelId = 0;
-
-    std::map<std::string, FMOD::Studio::Bank*> banks;
-    std::map<std::string, FMOD::Studio::EventInstance*> events;
-    std::map<std::string, FMOD::Sound*> sounds;
-    std::map<int, FMOD::Channel*> channels;
-};
@@ -21,6 +21,7 @@
 #include "StringHelper.h"
 #include "HarvestableItem.h"
 #include "UIQuad.h"
+#include "AttackWaza.h"
 #include "Debug.h"
 #include "imgui/imgui.h"
 #include "imgui/imgui_stdlib.h"
@@ -117,116 +118,7 @@ struct Character_XData
         float_t doRemove1HealthThreshold = 10.0f;
     } staminaData;
 
-    struct AttackWaza
-    {
-        std::string wazaName = "";
-
-        enum class WazaInput
-        {
-            NONE = 0,
-            PRESS_X,       PRESS_A,       PRESS_X_A,
-            RELEASE_X,     RELEASE_A,     RELEASE_X_A,
-        };
-
-        struct EntranceInputParams
-        {
-            bool enabled = false;
-            std::string weaponType = "NULL";  // Valid options: twohanded, bow, dual, spear (NULL means there is no entrance)
-            std::string movementState = "NULL";  // Valid options: grounded, midair, upsidedown (NULL means there is no entrance)
-            std::string inputName = "NULL";  // Valid options: press_(x/a/x_a), hold_(x/a/x_a), release_(x/a/x_a), doubleclick_(x/a/x_a), doublehold_(x/a/x_a)
-            WazaInput input;
-            // @NOTE: for `input`, there are some inputs that collide with each other. You will have to worry about this depending on what an available chain's inputs are and which entrances are available (i.e. if you're in an interruptable state at the moment).
-            //        The inputs that collide are:
-            //            press_@, doubleclick_@, doublehold_@    // Bc doubleclick and doublehold each of them require a `press_@` at the beginning.
-            //        These don't collide because:
-            //            press_@, hold_@                         // Bc press requires to click and release in a short amount of time. Hold requires to click and hold @ for an amount of time.
-            //            press_@, release_@                      // Bc release will trigger the moment @ is not pressed, whereas press will require >=1 tick of @ not pressed, then >=1 <time_for_hold_to_activate tick(s) of @ pressed, then will trigger the moment @ is not pressed again.
-            //
-            // @REPLY: this point is moot. Will not do this waza input system anymore.
-        } entranceInputParams;
-
-        std::string animationState;
-        int16_t staminaCost = 0;
-        int16_t staminaCostHold = 0;
-        int16_t staminaCostHoldTimeFrom = -1;
-        int16_t staminaCostHoldTimeTo = -1;
-        int16_t duration = -1;
-        bool holdMidair = false;
-        int16_t holdMidairTimeFrom = -1;
-        int16_t holdMidairTimeTo = -1;
-        float_t gravityMultiplier = 1.0f;
-
-        struct VelocityDecaySetting
-        {
-            float_t velocityDecay;
-            int16_t executeAtTime = 0;
-        };
-        std::vector<VelocityDecaySetting> velocityDecaySettings;
-
-        struct VelocitySetting
-        {
-            vec3 velocity;
-            int16_t executeAtTime = 0;
-        };
-        std::vector<VelocitySetting> velocitySettings;
-        
-        struct HitscanFlowNode
-        {
-            // These ends create a line where `numHitscanSamples` number of points traverse.
-            // These points are connected to the previous node's ends' traversed lines to create
-            // the hitscan query lines. Note also that these points are in object space,
-            // where { 0, 0, 1 } represents the player's facing forward vector.
-            vec3 nodeEnd1, nodeEnd2;
-            int16_t executeAtTime = 0;
-        };
-        uint32_t numHitscanSamples = 5;
-        std::vector<HitscanFlowNode> hitscanNodes;  // Each node uses the previous node's data to create the hitscans (the first node is ignored except for using it as prev node data).
-        vec3 hitscanLaunchVelocity = GLM_VEC3_ZERO_INIT;  // Non-normalized vec3 of launch velocity of entity that gets hit by the waza.
-        vec3 hitscanLaunchRelPosition = GLM_VEC3_ZERO_INIT;  // Position relative to origin of original character to set hit character on first hit.
-        bool hitscanLaunchRelPositionIgnoreY = false;  // Flag to not set the Y relative position.
-
-        struct VacuumSuckIn
-        {
-            bool enabled = false;
-            vec3 position = GLM_VEC3_ZERO_INIT;  // Position relative to character to suck in nearby entities.
-            float_t radius = 3.0f;
-            float_t strength = 1.0f;
-        } vacuumSuckIn;
-
-        struct ForceZone
-        {
-            bool enabled = false;
-            vec3 origin = GLM_VEC3_ZERO_INIT;  // Relative position from character origin.
-            vec3 bounds = { 1.0f, 1.0f, 1.0f };  // @NOTE: this is an aabb.
-            vec3 forceVelocity = { 1.0f, 0.0f, 0.0f };
-            int16_t timeFrom = -1;
-            int16_t timeTo = -1;
-        } forceZone;
-
-        struct Chain
-        {
-            int16_t inputTimeWindowStart = 0;  // Press the attack button in this window to trigger the chain.
-            int16_t inputTimeWindowEnd = 0;
-            std::string nextWazaName = "";  // @NOTE: this is just for looking up the correct next action.
-            AttackWaza* nextWazaPtr = nullptr;  // Baked data.
-            std::string inputName = "NULL";  // REQUIRED: see `EntranceInputParams::input` for list of valid inputs.
-            WazaInput input;
-        };
-        std::vector<Chain> chains;  // Note that you can have different chains depending on your rhythm in the attack.
-
-        std::string onHoldCancelWazaName = "NULL";
-        AttackWaza* onHoldCancelWazaPtr = nullptr;
-
-        std::string onDurationPassedWazaName = "NULL";
-        AttackWaza* onDurationPassedWazaPtr = nullptr;
-
-        struct IsInterruptable  // Can interrupt by starting another waza.
-        {
-            bool enabled = false;
-            int16_t from = -1;
-            int16_t to = -1;
-        } interruptable;
-    };
+    using AttackWaza = waza::AttackWaza;
     std::vector<AttackWaza> wazaSet;
 
     AttackWaza* currentWaza = nullptr;
@@ -235,6 +127,7 @@ struct Character_XData
     vec3        wazaVelocity;
     bool        wazaVelocityFirstStep = false;
     int16_t     wazaTimer = 0;  // Used for timing chains and hitscans.
+    size_t      wazaTimelineCursor = 0;  // Next event in `currentWaza->timeline`.
     float_t     wazaHitTimescale = 1.0f;
     float_t     wazaHitTimescaleOnHit = 0.01f;
     float_t     wazaHitTimescaleReturnToOneSpeed = 1500.0f;
@@ -507,312 +400,6 @@ void processRelease(Character_XData* d)
     textmesh::regenerateTextMeshMesh(d->uiMaterializeItem, getUIMaterializeItemText(d));
 }
 
-void parseVec3CommaSeparated(const std::string& vec3Str, vec3& outVec3)
-{
-    std::string strCopy = vec3Str;
-    std::string::size_type sz;
-    outVec3[0] = std::stof(strCopy, &sz);    strCopy = strCopy.substr(sz + 1);
-    outVec3[1] = std::stof(strCopy, &sz);    strCopy = strCopy.substr(sz + 1);
-    outVec3[2] = std::stof(strCopy);
-}
-
-void loadDataFromLine(Character_XData::AttackWaza& newWaza, const std::string& command, const std::vector<std::string>& params)
-{
-    if (command == "entrance")
-    {
-        newWaza.entranceInputParams.enabled = true;
-        newWaza.entranceInputParams.weaponType = params[0];
-        newWaza.entranceInputParams.movementState = params[1];
-        newWaza.entranceInputParams.inputName = params[2];
-    }
-    else if (command == "animation_state")
-    {
-        newWaza.animationState = params[0];
-    }
-    else if (command == "stamina_cost")
-    {
-        newWaza.staminaCost = std::stoi(params[0]);
-    }
-    else if (command == "stamina_cost_hold")
-    {
-        newWaza.staminaCostHold = std::stoi(params[0]);
-        if (params.size() >= 2)
-            newWaza.staminaCostHoldTimeFrom = std::stoi(params[1]);
-        if (params.size() >= 3)
-            newWaza.staminaCostHoldTimeTo = std::stoi(params[2]);
-    }
-    else if (command == "duration")
-    {
-        newWaza.duration = std::stoi(params[0]);
-    }
-    else if (command == "hold_midair")
-    {
-        newWaza.holdMidair = true;
-        if (params.size() >= 2)
-        {
-            newWaza.holdMidairTimeFrom = std::stoi(params[0]);
-            newWaza.holdMidairTimeTo = std::stoi(params[1]);
-        }
-    }
-    else if (command == "gravity_multiplier")
-    {
-        newWaza.gravityMultiplier = std::stof(params[0]);
-    }
-    else if (command == "velocity_decay")
-    {
-        Character_XData::AttackWaza::VelocityDecaySetting newVelocityDecaySetting;
-        newVelocityDecaySetting.velocityDecay = std::stof(params[0]);
-        newVelocityDecaySetting.executeAtTime = std::stoi(params[1]);
-        newWaza.velocityDecaySettings.push_back(newVelocityDecaySetting);
-    }
-    else if (command == "velocity")
-    {
-        Character_XData::AttackWaza::VelocitySetting newVelocitySetting;
-        vec3 velo;
-        parseVec3CommaSeparated(params[0], velo);
-        glm_vec3_copy(velo, newVelocitySetting.velocity);
-        newVelocitySetting.executeAtTime = std::stoi(params[1]);
-        newWaza.velocitySettings.push_back(newVelocitySetting);
-    }
-    else if (command == "hitscan")
-    {
-        Character_XData::AttackWaza::HitscanFlowNode newHitscanNode;
-        vec3 end1, end2;
-        parseVec3CommaSeparated(params[0], end1);
-        parseVec3CommaSeparated(params[1], end2);
-        glm_vec3_copy(end1, newHitscanNode.nodeEnd1);
-        glm_vec3_copy(end2, newHitscanNode.nodeEnd2);
-        if (params.size() >= 3)
-            newHitscanNode.executeAtTime = std::stoi(params[2]);
-        newWaza.hitscanNodes.push_back(newHitscanNode);
-    }
-    else if (command == "hs_launch_velocity")
-    {
-        parseVec3CommaSeparated(params[0], newWaza.hitscanLaunchVelocity);
-    }
-    else if (command == "hs_rel_position")
-    {
-        parseVec3CommaSeparated(params[0], newWaza.hitscanLaunchRelPosition);
-        if (params.size() >= 2 && params[1] == "ignore_y")
-            newWaza.hitscanLaunchRelPositionIgnoreY = true;
-    }
-    else if (command == "vacuum_suck_in")
-    {
-        newWaza.vacuumSuckIn.enabled = true;
-        parseVec3CommaSeparated(params[0], newWaza.vacuumSuckIn.position);
-        newWaza.vacuumSuckIn.radius = std::stoi(params[1]);
-        newWaza.vacuumSuckIn.strength = std::stoi(params[2]);
-    }
-    else if (command == "force_zone")
-    {
-        newWaza.forceZone.enabled = true;
-        parseVec3CommaSeparated(params[0], newWaza.forceZone.origin);
-        parseVec3CommaSeparated(params[1], newWaza.forceZone.bounds);
-        parseVec3CommaSeparated(params[2], newWaza.forceZone.forceVelocity);
-        newWaza.forceZone.timeFrom = std::stoi(params[3]);
-        newWaza.forceZone.timeTo = std::stoi(params[4]);
-    }
-    else if (command == "chain")
-    {
-        Character_XData::AttackWaza::Chain newChain;
-        newChain.nextWazaName = params[0];
-        newChain.inputTimeWindowStart = std::stoi(params[1]);
-        newChain.inputTimeWindowEnd = std::stoi(params[2]);
-        newChain.inputName = params[3];
-        newWaza.chains.push_back(newChain);
-    }
-    else if (command == "on_hold_cancel")
-    {
-        newWaza.onHoldCancelWazaName = params[0];
-    }
-    else if (command == "on_duration_passed")
-    {
-        newWaza.onDurationPassedWazaName = params[0];
-    }
-    else if (command == "interruptable")
-    {
-        newWaza.interruptable.enabled = true;
-        if (params.size() >= 1)
-            newWaza.interruptable.from = std::stoi(params[0]);
-        if (params.size() >= 2)
-            newWaza.interruptable.to = std::stoi(params[1]);
-    }
-    else
-    {
-        // ERROR
-        std::cerr << "[WAZA LOADING]" << std::endl
-            << "ERROR: Unknown command token: " << command << std::endl;
-    }
-}
-
-Character_XData::AttackWaza* getWazaPtrFromName(std::vector<Character_XData::AttackWaza>& wazas, const std::string& wazaName)
-{
-    if (wazaName == "NULL")  // Special case.
-        return nullptr;
-
-    for (Character_XData::AttackWaza& waza : wazas)
-    {
-        if (waza.wazaName == wazaName)
-            return &waza;
-    }
-
-    std::cerr << "[WAZA LOADING]" << std::endl
-        << "ERROR: Waza with name \"" << wazaName << "\" was not found (`getWazaPtrFromName`)." << std::endl;
-    return nullptr;
-}
-
-Character_XData::AttackWaza::WazaInput getInputEnumFromName(const std::string& inputName)
-{
-    int32_t enumValue = -1;
-    int32_t x = -1;
-    if (inputName.rfind("press_", 0) == 0)
-        x = 0;
-    else if (inputName.rfind("release_", 0) == 0)
-        x = 1;
-
-    int32_t y = -1;
-    std::string suffix = inputName.substr(inputName.find("_") + 1);
-    if (suffix == "x")
-        y = 0;
-    else if (suffix == "a")
-        y = 1;
-    else if (suffix == "x_a")
-        y = 2;
-    
-    enumValue = 3 * x + y + 1;  // @COPYPASTA
-    
-    if (enumValue < 1)
-    {
-        std::cerr << "[WAZA LOADING]" << std::endl
-            << "ERROR: Waza input \"" << inputName << "\" was not found (`getInputEnumFromName`)." << std::endl;
-        return Character_XData::AttackWaza::WazaInput(0);
-    }
-
-    return Character_XData::AttackWaza::WazaInput(enumValue);
-}
-
-void initWazaSetFromFile(std::vector<Character_XData::AttackWaza>& wazas, const std::string& fname)
-{
-    std::ifstream wazaFile(fname);
-    if (!wazaFile.is_open())
-    {
-        std::cerr << "[WAZA LOADING]" << std::endl
-            << "WARNING: file \"" << fname << "\" not found, thus could not load the waza action commands." << std::endl;
-        return;
-    }
-
-    //
-    // Parse the commands
-    //
-    Character_XData::AttackWaza newWaza;
-    std::string line;
-    for (size_t lineNum = 1; std::getline(wazaFile, line); lineNum++)  // @COPYPASTA with SceneManagement.cpp
-    {
-        // Prep line data
-        std::string originalLine = line;
-
-        size_t found = line.find('#');
-        if (found != std::string::npos)
-        {
-            line = line.substr(0, found);
-        }
-
-        trim(line);
-        if (line.empty())
-            continue;
-
-        // Package finished state
-        if (line[0] == ':')
-        {
-            if (!newWaza.wazaName.empty())
-            {
-                wazas.push_back(newWaza);
-                newWaza = Character_XData::AttackWaza();
-            }
-        }
-
-        // Process line
-        if (line[0] == ':')
-        {
-            line = line.substr(1);  // Cut out colon
-            trim(line);
-
-            newWaza.wazaName = line;
-        }
-        else if (!newWaza.wazaName.empty())
-        {
-            std::string lineCommand = line.substr(0, line.find(' '));
-            trim(lineCommand);
-
-            std::string lineParams = line.substr(lineCommand.length());
-            trim(lineParams);
-            std::vector<std::string> paramsParsed;
-            while (true)
-            {
-                size_t nextWS;
-                if ((nextWS = lineParams.find(' ')) == std::string::npos)
-                {
-                    // This is a single param. End of the list.
-                    paramsParsed.push_back(lineParams);
-                    break;
-                }
-                else
-                {
-                    // Break off the param and add the first one to the list.
-                    std::string param = lineParams.substr(0, nextWS);
-                    trim(param);
-                    paramsParsed.push_back(param);
-
-                    lineParams = lineParams.substr(nextWS);
-                    trim(lineParams);
-                }
-            }
-
-            loadDataFromLine(newWaza, lineCommand, paramsParsed);
-        }
-        else
-        {
-            // ERROR
-            std::cerr << "[WAZA LOADING]" << std::endl
-                << "ERROR (line " << lineNum << ") (file: " << fname << "): Headless data" << std::endl
-                << "   Trimmed line: " << line << std::endl
-                << "  Original line: " << line << std::endl;
-        }
-    }
-
-    // Package finished state
-    // @COPYPASTA
-    if (!newWaza.wazaName.empty())
-    {
-        wazas.push_back(newWaza);
-        newWaza = Character_XData::AttackWaza();
-    }
-
-    //
-    // Bake pointers into string references.
-    //
-    for (Character_XData::AttackWaza& waza : wazas)
-    {
-        if (waza.wazaName == "NULL")
-        {
-            std::cerr << "[WAZA LOADING]" << std::endl
-                << "ERROR: You can't name a waza state \"NULL\"... it's a keyword!!! Aborting." << std::endl;
-            break;
-        }
-
-        if (waza.entranceInputParams.inputName != "NULL")
-            waza.entranceInputParams.input = getInputEnumFromName(waza.entranceInputParams.inputName);
-
-        for (Character_XData::AttackWaza::Chain& chain : waza.chains)
-        {
-            chain.nextWazaPtr = getWazaPtrFromName(wazas, chain.nextWazaName);
-            chain.input = getInputEnumFromName(chain.inputName);
-        }
-        waza.onHoldCancelWazaPtr = getWazaPtrFromName(wazas, waza.onHoldCancelWazaName);
-        waza.onDurationPassedWazaPtr = getWazaPtrFromName(wazas, waza.onDurationPassedWazaName);
-    }
-}
-
 // @TODO: delete this once not needed. Well, it's not needed rn bc it's commented out, but once the knowledge isn't needed anymore, delete this.  -Timo 2023/09/19
 // void processWeaponAttackInput(Character_XData* d)
 // {
@@ -1150,135 +737,141 @@ void processWazaInput(Character_XData* d, Character_XData::AttackWaza::WazaInput
     }
 }
 
-void processWazaUpdate(Character_XData* d, EntityManager* em, const float_t& physicsDeltaTime, const std::string& myGuid, NextWazaPtr& inoutNextWaza, bool& inoutTurnOnAura)
+void executeWazaHitscanNode(Character_XData* d, EntityManager* em, const std::string& myGuid, size_t nodeIndex, bool& inoutPlayWazaHitSfx)
 {
-    //
-    // Deplete stamina
-    //
-    if (d->currentWaza->staminaCostHold > 0 &&
-        (d->currentWaza->staminaCostHoldTimeFrom < 0 || d->wazaTimer >= d->currentWaza->staminaCostHoldTimeFrom) &&
-        (d->currentWaza->staminaCostHoldTimeTo < 0 || d->wazaTimer <= d->currentWaza->staminaCostHoldTimeTo))
+    vec3 offset(0.0f, -physengine::getLengthOffsetToBase(*d->cpd), 0.0f);
+
+    mat4 rotation;
+    glm_euler_zyx(vec3{ 0.0f, d->facingDirection, 0.0f }, rotation);
+
+    auto& node = d->currentWaza->hitscanNodes[nodeIndex];
+    vec3 nodeEnd1WS, nodeEnd2WS;
+    glm_mat4_mulv3(rotation, node.nodeEnd1, 0.0f, nodeEnd1WS);
+    glm_mat4_mulv3(rotation, node.nodeEnd2, 0.0f, nodeEnd2WS);
+    glm_vec3_add(nodeEnd1WS, d->position, nodeEnd1WS);
+    glm_vec3_add(nodeEnd2WS, d->position, nodeEnd2WS);
+
+    if (nodeIndex == 1)
     {
-        changeStamina(d, -d->currentWaza->staminaCostHold * physicsDeltaTime, true);
-        inoutTurnOnAura = true;
+        // Set prev node to 0th flow nodes.
+        auto& nodePrev = d->currentWaza->hitscanNodes[nodeIndex - 1];
+        glm_mat4_mulv3(rotation, nodePrev.nodeEnd1, 0.0f, d->prevWazaHitscanNodeEnd1);
+        glm_mat4_mulv3(rotation, nodePrev.nodeEnd2, 0.0f, d->prevWazaHitscanNodeEnd2);
+        glm_vec3_add(d->prevWazaHitscanNodeEnd1, d->position, d->prevWazaHitscanNodeEnd1);
+        glm_vec3_add(d->prevWazaHitscanNodeEnd2, d->position, d->prevWazaHitscanNodeEnd2);
     }
 
-    //
-    // Execute all velocity decay settings.
-    //
-    for (Character_XData::AttackWaza::VelocityDecaySetting& vds : d->currentWaza->velocityDecaySettings)
-        if (vds.executeAtTime == d->wazaTimer)
-        {
-            d->wazaVelocityDecay = vds.velocityDecay;
-            break;
-        }
+    for (uint32_t s = 0; s <= d->currentWaza->numHitscanSamples; s++)
+    {
+        float_t t = (float_t)s / (float_t)d->currentWaza->numHitscanSamples;
+        vec3 pt1, pt2;
+        glm_vec3_lerp(nodeEnd1WS, nodeEnd2WS, t, pt1);
+        glm_vec3_lerp(d->prevWazaHitscanNodeEnd1, d->prevWazaHitscanNodeEnd2, t, pt2);
 
-    //
-    // Execute all velocity settings corresponding to the timer.
-    //
-    for (Character_XData::AttackWaza::VelocitySetting& velocitySetting : d->currentWaza->velocitySettings)
-        if (velocitySetting.executeAtTime == d->wazaTimer)
-        {
-            glm_vec3_copy(velocitySetting.velocity, d->wazaVelocity);
-            d->wazaVelocityFirstStep = true;
-            break;
-        }
+        vec3 directionAndMagnitude;  // https://www.youtube.com/watch?v=A05n32Bl0aY
+        glm_vec3_sub(pt2, pt1, directionAndMagnitude);
 
-    //
-    // Execute all hitscans that need to be executed in the timeline.
-    //
-    size_t hitscanLayer = physengine::getCollisionLayer("HitscanInteractible");
-    vec3 offset(0.0f, -physengine::getLengthOffsetToBase(*d->cpd), 0.0f);
-    assert(d->currentWaza->hitscanNodes.size() != 1);
+        std::string hitGuid;
+        if (physengine::raycastForEntity(pt1, directionAndMagnitude, hitGuid))
+        {
+            // Successful hitscan!
+            float_t attackLvl =
+                (float_t)(d->currentWeaponDurability > 0 ?
+                    d->materializedItem->weaponStats.attackPower :
+                    d->materializedItem->weaponStats.attackPowerWhenDulled);
 
-    bool playWazaHitSfx = false;
+            if (hitGuid == myGuid)
+                continue;  // Ignore if hitscan to self
 
-    for (size_t i = 1; i < d->currentWaza->hitscanNodes.size(); i++)  // @NOTE: 0th hitscan node is ignored bc it's used to draw the line from 0th to 1st hit scan line.
-    {
-        if (d->currentWaza->hitscanNodes[i].executeAtTime == d->wazaTimer)
-        {
+            DataSerializer ds;
+            ds.dumpString("msg_hitscan_hit");
+            ds.dumpFloat(attackLvl);
+            
             mat4 rotation;
             glm_euler_zyx(vec3{ 0.0f, d->facingDirection, 0.0f }, rotation);
+            vec3 facingWazaHSLaunchVelocity;
+            glm_mat4_mulv3(rotation, d->currentWaza->hitscanLaunchVelocity, 0.0f, facingWazaHSLaunchVelocity);
+            ds.dumpVec3(facingWazaHSLaunchVelocity);
+
+            vec3 setPosition;
+            glm_mat4_mulv3(rotation, d->currentWaza->hitscanLaunchRelPosition, 0.0f, setPosition);
+            glm_vec3_add(d->position, setPosition, setPosition);
+            glm_vec3_add(offset, setPosition, setPosition);
+            ds.dumpVec3(setPosition);
 
-            auto& node = d->currentWaza->hitscanNodes[i];
-            vec3 nodeEnd1WS, nodeEnd2WS;
-            glm_mat4_mulv3(rotation, node.nodeEnd1, 0.0f, nodeEnd1WS);
-            glm_mat4_mulv3(rotation, node.nodeEnd2, 0.0f, nodeEnd2WS);
-            glm_vec3_add(nodeEnd1WS, d->position, nodeEnd1WS);
-            glm_vec3_add(nodeEnd2WS, d->position, nodeEnd2WS);
+            float_t ignoreYF = (float_t)d->currentWaza->hitscanLaunchRelPositionIgnoreY;
+            ds.dumpFloat(ignoreYF);
 
-            if (i == 1)
+            DataSerialized dsd = ds.getSerializedData();
+            if (em->sendMessage(hitGuid, dsd))
             {
-                // Set prev node to 0th flow nodes.
-                auto& nodePrev = d->currentWaza->hitscanNodes[i - 1];
-                glm_mat4_mulv3(rotation, nodePrev.nodeEnd1, 0.0f, d->prevWazaHitscanNodeEnd1);
-                glm_mat4_mulv3(rotation, nodePrev.nodeEnd2, 0.0f, d->prevWazaHitscanNodeEnd2);
-                glm_vec3_add(d->prevWazaHitscanNodeEnd1, d->position, d->prevWazaHitscanNodeEnd1);
-                glm_vec3_add(d->prevWazaHitscanNodeEnd2, d->position, d->prevWazaHitscanNodeEnd2);
+                inoutPlayWazaHitSfx = true;
+
+                // Take off some durability bc of successful hitscan.
+                if (d->currentWeaponDurability > 0)
+                {
+                    d->currentWeaponDurability--;
+                    if (d->currentWeaponDurability <= 0)
+                        pushPlayerNotification("Weapon has dulled!", d);
+                }
             }
+        }
+    }
 
-            for (uint32_t s = 0; s <= d->currentWaza->numHitscanSamples; s++)
-            {
-                float_t t = (float_t)s / (float_t)d->currentWaza->numHitscanSamples;
-                vec3 pt1, pt2;
-                glm_vec3_lerp(nodeEnd1WS, nodeEnd2WS, t, pt1);
-                glm_vec3_lerp(d->prevWazaHitscanNodeEnd1, d->prevWazaHitscanNodeEnd2, t, pt2);
+    // Update prev hitscan node ends.
+    glm_vec3_copy(nodeEnd1WS, d->prevWazaHitscanNodeEnd1);
+    glm_vec3_copy(nodeEnd2WS, d->prevWazaHitscanNodeEnd2);
+}
 
-                vec3 directionAndMagnitude;  // https://www.youtube.com/watch?v=A05n32Bl0aY
-                glm_vec3_sub(pt2, pt1, directionAndMagnitude);
+void processWazaUpdate(Character_XData* d, EntityManager* em, const float_t& physicsDeltaTime, const std::string& myGuid, NextWazaPtr& inoutNextWaza, bool& inoutTurnOnAura)
+{
+    //
+    // Deplete stamina
+    //
+    if (d->currentWaza->staminaCostHold > 0 &&
+        (d->currentWaza->staminaCostHoldTimeFrom < 0 || d->wazaTimer >= d->currentWaza->staminaCostHoldTimeFrom) &&
+        (d->currentWaza->staminaCostHoldTimeTo < 0 || d->wazaTimer <= d->currentWaza->staminaCostHoldTimeTo))
+    {
+        changeStamina(d, -d->currentWaza->staminaCostHold * physicsDeltaTime, true);
+        inoutTurnOnAura = true;
+    }
 
-                std::string hitGuid;
-                if (physengine::raycastForEntity(pt1, directionAndMagnitude, hitGuid))
-                {
-                    // Successful hitscan!
-                    float_t attackLvl =
-                        (float_t)(d->currentWeaponDurability > 0 ?
-                            d->materializedItem->weaponStats.attackPower :
-                            d->materializedItem->weaponStats.attackPowerWhenDulled);
+    //
+    // Execute the timeline events that fire on this tick.
+    // @NOTE: the timeline is sorted by time, so the cursor only ever has to move forward. Only the first
+    //        event of each type gets executed per tick (there should only be one anyway).
+    //
+    assert(d->currentWaza->hitscanNodes.size() != 1);
 
-                    if (hitGuid == myGuid)
-                        continue;  // Ignore if hitscan to self
+    bool playWazaHitSfx = false;
 
-                    DataSerializer ds;
-                    ds.dumpString("msg_hitscan_hit");
-                    ds.dumpFloat(attackLvl);
-                    
-                    mat4 rotation;
-                    glm_euler_zyx(vec3{ 0.0f, d->facingDirection, 0.0f }, rotation);
-                    vec3 facingWazaHSLaunchVelocity;
-                    glm_mat4_mulv3(rotation, d->currentWaza->hitscanLaunchVelocity, 0.0f, facingWazaHSLaunchVelocity);
-                    ds.dumpVec3(facingWazaHSLaunchVelocity);
-
-                    vec3 setPosition;
-                    glm_mat4_mulv3(rotation, d->currentWaza->hitscanLaunchRelPosition, 0.0f, setPosition);
-                    glm_vec3_add(d->position, setPosition, setPosition);
-                    glm_vec3_add(offset, setPosition, setPosition);
-                    ds.dumpVec3(setPosition);
-
-                    float_t ignoreYF = (float_t)d->currentWaza->hitscanLaunchRelPositionIgnoreY;
-                    ds.dumpFloat(ignoreYF);
+    using TimelineEvent = Character_XData::AttackWaza::TimelineEvent;
+    auto& timeline = d->currentWaza->timeline;
+    while (d->wazaTimelineCursor < timeline.size() && timeline[d->wazaTimelineCursor].executeAtTime < d->wazaTimer)
+        d->wazaTimelineCursor++;  // Events that can never fire (e.g. negative times).
 
-                    DataSerialized dsd = ds.getSerializedData();
-                    if (em->sendMessage(hitGuid, dsd))
-                    {
-                        playWazaHitSfx = true;
+    bool executedType[(size_t)TimelineEvent::Type::NUM_TYPES] = {};
+    for (; d->wazaTimelineCursor < timeline.size() && timeline[d->wazaTimelineCursor].executeAtTime == d->wazaTimer; d->wazaTimelineCursor++)
+    {
+        TimelineEvent& event = timeline[d->wazaTimelineCursor];
+        if (executedType[(size_t)event.type])
+            continue;
+        executedType[(size_t)event.type] = true;
 
-                        // Take off some durability bc of successful hitscan.
-                        if (d->currentWeaponDurability > 0)
-                        {
-                            d->currentWeaponDurability--;
-                            if (d->currentWeaponDurability <= 0)
-                                pushPlayerNotification("Weapon has dulled!", d);
-                        }
-                    }
-                }
-            }
+        switch (event.type)
+        {
+            case TimelineEvent::Type::VELOCITY_DECAY:
+                d->wazaVelocityDecay = d->currentWaza->velocityDecaySettings[event.index].velocityDecay;
+                break;
 
-            // Update prev hitscan node ends.
-            glm_vec3_copy(nodeEnd1WS, d->prevWazaHitscanNodeEnd1);
-            glm_vec3_copy(nodeEnd2WS, d->prevWazaHitscanNodeEnd2);
+            case TimelineEvent::Type::VELOCITY:
+                glm_vec3_copy(d->currentWaza->velocitySettings[event.index].velocity, d->wazaVelocity);
+                d->wazaVelocityFirstStep = true;
+                break;
 
-            break;  // @NOTE: there should only be one waza hitscan at a certain time, so since this one got processed, then no need to keep searching for another.  -Timo 2023/08/10
+            case TimelineEvent::Type::HITSCAN:
+                executeWazaHitscanNode(d, em, myGuid, event.index, playWazaHitSfx);
+                break;
         }
     }
 
@@ -1392,6 +985,7 @@ void setWazaToCurrent(Character_XData* d, Character_XData::AttackWaza* nextWaza)
     d->wazaVelocityDecay = 0.0f;
     glm_vec3_copy((d->currentWaza != nullptr && d->currentWaza->velocitySettings.size() > 0 && d->currentWaza->velocitySettings[0].executeAtTime == 0) ? d->currentWaza->velocitySettings[0].velocity : vec3{ 0.0f, 0.0f, 0.0f }, d->wazaVelocity);  // @NOTE: this doesn't work if the executeAtTime's aren't sorted asc.
     d->wazaTimer = 0;
+    d->wazaTimelineCursor = 0;
     // if (d->currentWaza == nullptr)    // @NOTE: for EWU Game Jam.
     //     d->characterRenderObj->animator->setState("StateIdle");  // @TODO: this is a crutch.... need to turn this into more of a trigger based system.
     // else
@@ -1656,9 +1250,11 @@ Character::Character(EntityManager* em, RenderObjectManager* rom, Camera* camera
         _data->uiStamina->scale = 25.0f;
 
         auto loadWazasLambda = [&]() {
-            _data->wazaSet.clear();
-            initWazaSetFromFile(_data->wazaSet, "res/waza/default_waza.hwac");
-            initWazaSetFromFile(_data->wazaSet, "res/waza/air_waza.hwac");
+            waza::loadWazaSet(
+                _data->wazaSet,
+                { "res/waza/default_waza.hwac", "res/waza/air_waza.hwac" },
+                "cache/waza_set.hwab"
+            );
         };
         hotswapres::addReloadCallback("res/waza/default_waza.hwac", this, loadWazasLambda);
         hotswapres::addReloadCallback("res/waza/air_waza.hwac", this, loadWazasLambda);
@@ -3207,7 +2803,7 @@ void defaultRenderImGui(Character_XData* d)
                 d->attackWazaEditor.editingWazaFname = path;
 
                 d->attackWazaEditor.editingWazaSet.clear();
-                initWazaSetFromFile(d->attackWazaEditor.editingWazaSet, d->attackWazaEditor.editingWazaFname);
+                waza::initWazaSetFromFile(d->attackWazaEditor.editingWazaSet, d->attackWazaEditor.editingWazaFname);
 
                 d->attackWazaEditor.wazaIndex = 0;
                 d->attackWazaEditor.currentTick = 0;
@@ -99,7 +99,7 @@ struct DatingInterface_XData
 void initializePositionings(DatingInterface_XData* d)
 {
     // @HARDCODE: this is all hardcoded!!!
-    d->datingBackground->renderOrder = 100.0f;
+    ui::setRenderOrder(d->datingBackground, 100.0f);
     glm_vec3_copy(vec3{ 0.0f, 0.0f, 0.0f }, d->datingBackground->position);
     glm_vec3_copy(vec3{ 1086.0f, 600.0f, 1.0f }, d->datingBackground->scale);
     glm_vec4_copy(vec4{ 1.0f, 1.0f, 1.0f, 1.0f }, d->datingBackground->tint);
@@ -108,27 +108,27 @@ void initializePositionings(DatingInterface_XData* d)
 
     for (size_t i = 0; i < 3; i++)
     {
-        d->dateQuads[i]->renderOrder = 10.0f;
+        ui::setRenderOrder(d->dateQuads[i], 10.0f);
         glm_vec3_copy(vec3{ -456.0f, -45.0f, 0.0f }, d->dateQuads[i]->position);
         glm_vec3_copy(vec3{ 500.0f, 500.0f, 1.0f }, d->dateQuads[i]->scale);
     }
 
-    d->dateThinkingBoxTex->renderOrder = 0.0f;
+    ui::setRenderOrder(d->dateThinkingBoxTex, 0.0f);
     glm_vec3_copy(vec3{ 60.0f, 341.0f, 0.0f }, d->dateThinkingBoxTex->position);
     glm_vec3_copy(vec3{ 200.0f, 100.0f, 1.0f }, d->dateThinkingBoxTex->scale);
     glm_vec4_copy(vec4{ 0.5647058824f, 0.2f, 0.2f, 1.0f }, d->dateThinkingBoxTex->tint);
 
-    d->dateThinkingBoxFill->renderOrder = 1.0f;
+    ui::setRenderOrder(d->dateThinkingBoxFill, 1.0f);
     glm_vec3_copy(vec3{ -46.0f, 343.0f, 0.0f }, d->dateThinkingBoxFill->position);
     glm_vec3_copy(vec3{ 0.0f, 25.0f, 1.0f }, d->dateThinkingBoxFill->scale);
     glm_vec4_copy(vec4{ 1.0f, 1.0f, 1.0f, 1.0f }, d->dateThinkingBoxFill->tint);
 
-    d->dateThinkingTrailingBubbles->renderOrder = 0.0f;
+    ui::setRenderOrder(d->dateThinkingTrailingBubbles, 0.0f);
     glm_vec3_copy(vec3{ -101.0f, 276.0f, 0.0f }, d->dateThinkingTrailingBubbles->position);
     glm_vec3_copy(vec3{ 66.0f, 35.0f, 1.0f }, d->dateThinkingTrailingBubbles->scale);
     glm_vec4_copy(vec4{ 0.5647058824f, 0.2f, 0.2f, 1.0f }, d->dateThinkingTrailingBubbles->tint);
 
-    d->dateSpeechBox->renderOrder = 0.0f;
+    ui::setRenderOrder(d->dateSpeechBox, 0.0f);
     glm_vec3_copy(vec3{ 31.0f, 373.0f, 0.0f }, d->dateSpeechBox->position);
     glm_vec3_copy(vec3{ 188.0f, 50.0f, 1.0f }, d->dateSpeechBox->scale);
     d->dateSpeechBox->useNineSlicing = true;
@@ -138,22 +138,22 @@ void initializePositionings(DatingInterface_XData* d)
 
     glm_vec3_copy(vec3{ -133.0f, 385.0f, 0.0f }, d->dateSpeechText->renderPosition);
 
-    d->contestantThinkingBoxTex->renderOrder = 0.0f;
+    ui::setRenderOrder(d->contestantThinkingBoxTex, 0.0f);
     glm_vec3_copy(vec3{ 310.0f, 341.0f, 0.0f }, d->contestantThinkingBoxTex->position);
     glm_vec3_copy(vec3{ 200.0f, 100.0f, 1.0f }, d->contestantThinkingBoxTex->scale);
     glm_vec4_copy(vec4{ 0.1529411765f, 0.2313725490f, 0.1568627451f, 1.0f }, d->contestantThinkingBoxTex->tint);
 
-    d->contestantThinkingBoxFill->renderOrder = 1.0f;
+    ui::setRenderOrder(d->contestantThinkingBoxFill, 1.0f);
     glm_vec3_copy(vec3{ 148.0f, 343.0f, 0.0f }, d->contestantThinkingBoxFill->position);
     glm_vec3_copy(vec3{ 0.0f, 25.0f, 1.0f }, d->contestantThinkingBoxFill->scale);
     glm_vec4_copy(vec4{ 1.0f, 1.0f, 1.0f, 1.0f }, d->contestantThinkingBoxFill->tint);
 
-    d->contestantThinkingTrailingBubbles->renderOrder = 0.0f;
+    ui::setRenderOrder(d->contestantThinkingTrailingBubbles, 0.0f);
     glm_vec3_copy(vec3{ 456.0f, 142.0f, 0.0f }, d->contestantThinkingTrailingBubbles->position);
     glm_vec3_copy(vec3{ 66.0f, 35.0f, 1.0f }, d->contestantThinkingTrailingBubbles->scale);
     glm_vec4_copy(vec4{ 0.1529411765f, 0.2313725490f, 0.1568627451f, 1.0f }, d->contestantThinkingTrailingBubbles->tint);
 
-    d->contestantSpeechBox->renderOrder = 0.0f;
+    ui::setRenderOrder(d->contestantSpeechBox, 0.0f);
     glm_vec3_copy(vec3{ 292.0f, 142.0f, 0.0f }, d->contestantSpeechBox->position);
     glm_vec3_copy(vec3{ 188.0f, 50.0f, 1.0f }, d->contestantSpeechBox->scale);
     d->contestantSpeechBox->useNineSlicing = true;
@@ -163,7 +163,7 @@ void initializePositionings(DatingInterface_XData* d)
 
     glm_vec3_copy(vec3{ 122.0f, 148.0f, 0.0f }, d->contestantSpeechText->renderPosition);
 
-    d->menuSelectingCursor->renderOrder = -1.0f;
+    ui::setRenderOrder(d->menuSelectingCursor, -1.0f);
     glm_vec4_copy(vec4{ 0.6823529412f, 0.8196078431f, 0.0313725490f, 1.0f }, d->menuSelectingCursor->tint);
 
     d->buttonStrideY = -80.0f;
@@ -177,7 +177,7 @@ void initializePositionings(DatingInterface_XData* d)
             currentPosition[1] += d->buttonStrideY;
 
         auto& b = d->buttons[i];
-        b.background->renderOrder = 0.0f;
+        ui::setRenderOrder(b.background, 0.0f);
         glm_vec3_copy(currentPosition, b.background->position);
         glm_vec3_copy(vec3{ 150.0f, 50.0f, 1.0f }, b.background->scale);
         b.background->useNineSlicing = true;
@@ -867,7 +867,9 @@ void imguiUIQuad(const std::string& uiQuadName, ui::UIQuad* uiQuad)
         // }
         ImGui::DragFloat3(("Sca" + nameSuffix).c_str(), uiQuad->scale);
 
-        ImGui::DragFloat(("renderOrder" + nameSuffix).c_str(), &uiQuad->renderOrder);
+        float_t renderOrder = uiQuad->renderOrder;
+        if (ImGui::DragFloat(("renderOrder" + nameSuffix).c_str(), &renderOrder))
+            ui::setRenderOrder(uiQuad, renderOrder);
 
         ImGui::TreePop();
         ImGui::Separator();
@@ -8,7 +8,9 @@
 Entity::Entity(EntityManager* em, DataSerialized* ds) : _em(em)
 {
 	if (ds == nullptr)
-		_guid = generateGUID();
+	{
+		setGUID(generateGUID128());
+	}
     _em->INTERNALaddEntity(this);
 }
 
@@ -26,17 +28,32 @@ void Entity::dump(DataSerializer& ds)
 
 void Entity::load(DataSerialized& ds)
 {
-	ds.loadString(_guid);
+	std::string loadedGuid;
+	ds.loadString(loadedGuid);
+	setGUID(loadedGuid);
 
     if (_em->INTERNALcheckGUIDCollision(this))
 	{
 		// Resolve guid collision
 		// @NOTE: @INCOMPLETE: this doesn't solve if there are any references that use the guid.
 		//                     Hopefully that can be thought out before that issue can happen.
-		std::string newGuid = generateGUID();
+		GUID128 newGuid128 = generateGUID128();
+		std::string newGuid = guidToString(newGuid128);
 		std::cerr << "[ENTITY INSERTION ROUTINE]" << std::endl
 			<< "WARNING: GUID collision found. GUID regenerated for object with GUID: " << _guid << std::endl
 			<< "                                                New regenerated GUID: " << newGuid << std::endl;
-		_guid = newGuid;
+		setGUID(newGuid128);
 	}
 }
+
+void Entity::setGUID(const GUID128& guid128)
+{
+	_guid128 = guid128;
+	_guid = guidToString(_guid128);
+}
+
+void Entity::setGUID(const std::string& guid)
+{
+	_guid = guid;
+	_guid128 = guidFromString(_guid);
+}
@@ -3,6 +3,7 @@
 #include <cmath>
 #include <string>
 #include <cglm/types.h>
+#include "GenerateGUID.h"
 class EntityManager;
 class DataSerializer;
 class DataSerialized;
@@ -20,7 +21,8 @@ public:
     virtual void load(DataSerialized& ds) = 0;  // Loads data from the serialized data
     virtual bool processMessage(DataSerialized& message) { return false; }  // Called thru entitymanager::sendMessage if not directly
     virtual std::string getTypeName() = 0;
-    std::string& getGUID() { return _guid; }
+    const std::string& getGUID() const { return _guid; }
+    const GUID128& getGUID128() const { return _guid128; }  // Use this one for comparisons.
 
     virtual void reportMoved(mat4* matrixMoved) { }
     virtual void renderImGui() { }
@@ -34,9 +36,13 @@ public:
 
 protected:
     EntityManager* _em;
+    // @NOTE: the only way to change the guid, so `_guid` and `_guid128` stay in sync.
+    void setGUID(const GUID128& guid128);
+    void setGUID(const std::string& guid);  // Keeps the string as is (e.g. the older 64 char GUIDs).
 
 private:
     std::string _guid;
+    GUID128 _guid128;  // @NOTE: always matches `_guid`.
 
     friend class EntityManager;
 };
@@ -103,26 +103,29 @@ void EntityManager::INTERNALaddRemoveRequestedEntities()
 
 bool EntityManager::INTERNALcheckGUIDCollision(Entity* entity)
 {
-	// @IMPROVE: add short circuit for the collision evaluation
-	std::string guid = entity->getGUID();
-	bool collision = false;
+	const GUID128& guid = entity->getGUID128();
 	for (auto& ent : _entitiesToDestroyQueue)
-		if (ent != entity)
-			collision |= (ent->getGUID() == guid);
+		if (ent != entity && ent->getGUID128() == guid)
+			return true;
 	for (auto& ent : _entitiesToAddQueue)
-		if (ent != entity)
-			collision |= (ent->getGUID() == guid);
+		if (ent != entity && ent->getGUID128() == guid)
+			return true;
 	for (auto& ent : _entities)
-		if (ent != entity)
-			collision |= (ent->getGUID() == guid);
-	return collision;
+		if (ent != entity && ent->getGUID128() == guid)
+			return true;
+	return false;
 }
 
 Entity* EntityManager::getEntityViaGUID(const std::string& guid)
+{
+	return getEntityViaGUID(guidFromString(guid));
+}
+
+Entity* EntityManager::getEntityViaGUID(const GUID128& guid)
 {
 	for (auto& ent : _entities)
 	{
-		if (ent->getGUID() == guid)
+		if (ent->getGUID128() == guid)
 		{
 			return ent;
 		}
@@ -5,6 +5,7 @@
 #include <queue>
 #include <mutex>
 #include "SceneManagement.h"
+#include "GenerateGUID.h"
 
 class Entity;
 class DataSerialized;
@@ -29,6 +30,7 @@ private:
 
 public:
 	Entity* getEntityViaGUID(const std::string& guid);
+	Entity* getEntityViaGUID(const GUID128& guid);
 	bool sendMessage(const std::string& guid, DataSerialized& message);
 	void destroyEntity(Entity* entity);    // Do not use the destructor or INTERNALdestroyEntity(), use this function!
 	void destroyOwnedEntity(Entity* entity);    // DITTO as above.
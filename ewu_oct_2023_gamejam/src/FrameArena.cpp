@@ -0,0 +1,51 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+
+FrameArena::~FrameArena()
+{
+	reset();
+	::operator delete(memory);
+}
+
+void FrameArena::init(size_t newCapacity)
+{
+	capacity = newCapacity;
+	memory = (uint8_t*)::operator new(capacity);
+	offset = 0;
+	stats.capacity = capacity;
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+	assert(alignment <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);  // Any more than that isn't guaranteed for `memory` or the overflow blocks.
+
+	size_t alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+	if (memory != nullptr && alignedOffset + size <= capacity)
+	{
+		offset = alignedOffset + size;
+		return memory + alignedOffset;
+	}
+
+	// Out of space, so fall back to the heap for the rest of the frame.
+	void* block = ::operator new(size);
+	overflowBlocks.push_back(block);
+	overflowBytes += size;
+	return block;
+}
+
+void FrameArena::reset()
+{
+	stats.usedLastFrame = offset + overflowBytes;
+	stats.highWater = std::max(stats.highWater, stats.usedLastFrame);
+	stats.overflowAllocationsLastFrame = (uint32_t)overflowBlocks.size();
+
+	for (void* block : overflowBlocks)
+		::operator delete(block);
+	overflowBlocks.clear();
+	overflowBytes = 0;
+	offset = 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+// @NOTE: bump allocator for data that only lives during one frame (e.g. the draw compaction containers).
+//        There's one per frame in flight, and it gets reset once that frame's render fence signals, so
+//        nothing ever gets freed one by one. If a frame needs more than the capacity, the rest falls back
+//        to the heap until the next reset (and shows up in `overflowAllocationsLastFrame`).
+//        Not thread safe, so only use it from the main thread.
+class FrameArena
+{
+public:
+	FrameArena() = default;
+	~FrameArena();
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	void init(size_t capacity);
+	void* allocate(size_t size, size_t alignment);
+	void reset();
+
+	struct Stats
+	{
+		size_t capacity = 0;
+		size_t usedLastFrame = 0;  // Including overflow.
+		size_t highWater = 0;      // Most bytes used in any one frame.
+		uint32_t overflowAllocationsLastFrame = 0;
+	};
+	const Stats& getStats() const { return stats; }
+
+private:
+	uint8_t* memory = nullptr;
+	size_t capacity = 0;
+	size_t offset = 0;
+	size_t overflowBytes = 0;
+	std::vector<void*> overflowBlocks;
+	Stats stats;
+};
+
+// So that STL containers can live in a `FrameArena`. Deallocating does nothing, since the memory gets
+// reclaimed all at once when the arena resets (so these containers must not outlive the frame).
+template<typename T>
+struct FrameArenaAllocator
+{
+	using value_type = T;
+
+	FrameArena* arena;
+
+	FrameArenaAllocator(FrameArena& arena) : arena(&arena) { }
+	template<typename U>
+	FrameArenaAllocator(const FrameArenaAllocator<U>& other) : arena(other.arena) { }
+
+	T* allocate(size_t n) { return (T*)arena->allocate(n * sizeof(T), alignof(T)); }
+	void deallocate(T*, size_t) { }
+
+	template<typename U>
+	bool operator==(const FrameArenaAllocator<U>& other) const { return arena == other.arena; }
+	template<typename U>
+	bool operator!=(const FrameArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+template<typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
@@ -0,0 +1,258 @@
+#ifdef _DEVELOP
+#include "GLSLToSPIRVHelper.h"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <map>
+#include <unordered_set>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/for_each.hpp>
+#include "Profiler.h"
+
+
+namespace glslToSPIRVHelper
+{
+    const std::string compilerPath = "C:/VulkanSDK/1.3.224.1/Bin/glslc.exe";
+    const std::string manifestFname = "spirv.manifest";
+
+    bool isShaderSource(const std::filesystem::path& path)
+    {
+        const auto& ext = path.extension();
+        return (ext.compare(".vert") == 0 ||
+                ext.compare(".frag") == 0 ||
+                ext.compare(".comp") == 0);
+    }
+
+    bool runCompiler(const std::filesystem::path& sourceCodePath)
+    {
+        //
+        // Compile the file and save the results in a .spv file
+        //
+        auto spvPath = sourceCodePath;  spvPath += ".spv";
+        int compilerBit = system((compilerPath + " " + sourceCodePath.string() + " -o " + spvPath.string()).c_str());  // @NOTE: errors and output get routed to the console anyways! Yay!
+        return (compilerBit == 0);
+    }
+
+    bool compileGLSLShaderToSPIRV(const std::filesystem::path& sourceCodePath)
+    {
+        std::cout << "[COMPILING SHADER SOURCE]" << std::endl << sourceCodePath << " to SPIRV\t...\t";
+
+        if (!std::filesystem::exists(sourceCodePath))
+        {
+            std::cerr << "ERROR: shader source file " << sourceCodePath << " does not exist, osoraku" << std::endl;
+            std::cout << "FAILURE" << std::endl;
+            return false;
+        }
+
+        if (!runCompiler(sourceCodePath))
+        {
+            std::cout << "FAILURE" << std::endl;
+            return false;
+        }
+
+        std::cout << "SUCCESS" << std::endl;
+        return true;
+    }
+
+    //
+    // Content hashing
+    //
+    constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+    constexpr uint64_t FNV_PRIME        = 0x100000001b3ull;
+
+    void hashBytes(uint64_t& hash, const std::string& bytes)
+    {
+        for (unsigned char c : bytes)
+        {
+            hash ^= (uint64_t)c;
+            hash *= FNV_PRIME;
+        }
+    }
+
+    void hashShaderSourceRecursive(const std::filesystem::path& path, uint64_t& hash, std::unordered_set<std::string>& visited)
+    {
+        std::string key = std::filesystem::weakly_canonical(path).generic_string();
+        if (visited.find(key) != visited.end())
+            return;		// Already hashed (include guards / diamond includes).
+        visited.insert(key);
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            hashBytes(hash, "<missing>" + key);		// @NOTE: so that a missing include still changes the hash (and glslc gets to report the error).
+            return;
+        }
+        std::stringstream ss;
+        ss << file.rdbuf();
+        std::string source = ss.str();
+        hashBytes(hash, key);
+        hashBytes(hash, source);
+
+        // Follow `#include "..."` lines relative to this file.
+        std::istringstream lines(source);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+                continue;
+
+            size_t open = line.find('"', start + 8);
+            size_t close = (open == std::string::npos ? std::string::npos : line.find('"', open + 1));
+            if (close == std::string::npos)
+                continue;
+
+            hashShaderSourceRecursive(path.parent_path() / line.substr(open + 1, close - open - 1), hash, visited);
+        }
+    }
+
+    uint64_t hashShaderSource(const std::filesystem::path& sourceCodePath)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+        std::unordered_set<std::string> visited;
+        hashShaderSourceRecursive(sourceCodePath, hash, visited);
+        return hash;
+    }
+
+    //
+    // Manifest (one "<relative source path> <hash in hex>" per line)
+    //
+    std::map<std::string, uint64_t> loadManifest(const std::filesystem::path& manifestPath)
+    {
+        std::map<std::string, uint64_t> manifest;
+        std::ifstream infile(manifestPath);
+        std::string line;
+        while (std::getline(infile, line))
+        {
+            size_t split = line.find_last_of(' ');
+            if (split == std::string::npos)
+                continue;
+            manifest[line.substr(0, split)] = std::strtoull(line.substr(split + 1).c_str(), nullptr, 16);
+        }
+        return manifest;
+    }
+
+    void saveManifest(const std::filesystem::path& manifestPath, const std::map<std::string, uint64_t>& manifest)
+    {
+        std::ofstream outfile(manifestPath);
+        if (!outfile.is_open())
+        {
+            std::cerr << "[BUILD SHADERS]" << std::endl
+                << "ERROR: could not open " << manifestPath << " for writing" << std::endl;
+            return;
+        }
+
+        for (auto& [relativePath, hash] : manifest)
+            outfile << relativePath << " " << std::hex << std::setw(16) << std::setfill('0') << hash << std::dec << "\n";
+    }
+
+    ShaderBuildReport buildAllShaders(const std::filesystem::path& shaderDirectory)
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+        ShaderBuildReport report;
+
+        if (!std::filesystem::exists(shaderDirectory))
+        {
+            std::cerr << "[BUILD SHADERS]" << std::endl
+                << "ERROR: shader directory " << shaderDirectory << " does not exist" << std::endl;
+            return report;
+        }
+
+        const std::filesystem::path manifestPath = shaderDirectory / manifestFname;
+        std::map<std::string, uint64_t> oldManifest = loadManifest(manifestPath);
+        std::map<std::string, uint64_t> newManifest;
+
+        //
+        // Find which shaders are stale
+        //
+        struct ShaderJob
+        {
+            std::filesystem::path path;
+            std::string relativePath;
+            uint64_t hash;
+            bool success = false;
+        };
+        std::vector<ShaderJob> jobs;
+
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(shaderDirectory))
+        {
+            const auto& path = entry.path();
+            if (!entry.is_regular_file() || !isShaderSource(path))
+                continue;
+
+            report.numShaders++;
+            std::string relativePath = std::filesystem::relative(path, shaderDirectory).generic_string();
+            uint64_t hash = hashShaderSource(path);
+
+            auto spvPath = path;
+            spvPath += ".spv";
+            auto it = oldManifest.find(relativePath);
+            if (it != oldManifest.end() &&
+                it->second == hash &&
+                std::filesystem::exists(spvPath))
+            {
+                newManifest[relativePath] = hash;
+                report.numCached++;
+                continue;
+            }
+
+            jobs.push_back({
+                .path = path,
+                .relativePath = relativePath,
+                .hash = hash,
+            });
+        }
+
+        //
+        // Compile the stale ones in parallel
+        // @NOTE: each glslc is its own process, so the workers here are mostly just waiting on
+        //        the children. That's why there's a floor on the worker count even on small machines.
+        //
+        if (!jobs.empty())
+        {
+            std::mutex printMutex;
+            tf::Executor executor(std::max(4u, std::thread::hardware_concurrency()));
+            tf::Taskflow taskflow;
+            taskflow.for_each(jobs.begin(), jobs.end(), [&](ShaderJob& job) {
+                PROFILE_ZONE("Compile Shader");
+                job.success = runCompiler(job.path);
+
+                std::lock_guard<std::mutex> lg(printMutex);
+                std::cout << "[COMPILING SHADER SOURCE]" << std::endl << job.path << " to SPIRV\t...\t" << (job.success ? "SUCCESS" : "FAILURE") << std::endl;
+            });
+            executor.run(taskflow).wait();
+
+            for (auto& job : jobs)
+            {
+                if (job.success)
+                {
+                    newManifest[job.relativePath] = job.hash;  // @NOTE: failed shaders stay out of the manifest so they get retried next time.
+                    report.numCompiled++;
+                }
+                else
+                    report.numFailed++;
+            }
+        }
+
+        if (!jobs.empty() || newManifest.size() != oldManifest.size())
+            saveManifest(manifestPath, newManifest);
+
+        report.durationMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+        std::cout << "[BUILD SHADERS]" << std::endl
+            << (report.numCompiled + report.numFailed == 0 ? "Warm" : "Cold") << " build of " << report.numShaders << " shaders: "
+            << report.numCompiled << " compiled, "
+            << report.numCached << " cached, "
+            << report.numFailed << " failed in "
+            << report.durationMS << " ms" << std::endl;
+        return report;
+    }
+}
+
+#endif
@@ -3,42 +3,30 @@
 
 #ifdef _DEVELOP
 
-#include <iostream>
 #include <filesystem>
+#include <string>
+#include <cstdint>
 
 
 namespace glslToSPIRVHelper
 {
-    bool compileGLSLShaderToSPIRV(const std::filesystem::path& sourceCodePath)
+    struct ShaderBuildReport
     {
-        std::cout << "[COMPILING SHADER SOURCE]" << std::endl << sourceCodePath << " to SPIRV\t...\t";
-
-        if (!std::filesystem::exists(sourceCodePath))
-        {
-            std::cerr << "ERROR: shader source file " << sourceCodePath << " does not exist, osoraku" << std::endl;
-            std::cout << "FAILURE" << std::endl;
-            return false;
-        }
-
-        //
-        // Compile the file and save the results in a .spv file and the messages in a .log file
-        //
-        const static std::string compilerPath = "C:/VulkanSDK/1.3.224.1/Bin/glslc.exe";
-        auto spvPath = sourceCodePath;  spvPath += ".spv";
-        int compilerBit = system((compilerPath + " " + sourceCodePath.string() + " -o " + spvPath.string()).c_str());  // @NOTE: errors and output get routed to the console anyways! Yay!
-
-        //
-        // Read the .log file if there was an error
-        //
-        if (compilerBit != 0)
-        {
-            std::cout << "FAILURE" << std::endl;
-            return false;
-        }
-
-        std::cout << "SUCCESS" << std::endl;
-        return true;
-    }
+        size_t numShaders  = 0;
+        size_t numCompiled = 0;
+        size_t numCached   = 0;  // Source+includes hash matched the manifest and the .spv was still there.
+        size_t numFailed   = 0;
+        double durationMS  = 0.0;
+    };
+
+    bool compileGLSLShaderToSPIRV(const std::filesystem::path& sourceCodePath);
+
+    // Hash of the shader source plus every `#include "..."` it pulls in (recursively).
+    uint64_t hashShaderSource(const std::filesystem::path& sourceCodePath);
+
+    // Compiles every stale .vert/.frag under `shaderDirectory` in parallel. Staleness is decided
+    // by content hash against "<shaderDirectory>/spirv.manifest" instead of by mtime.
+    ShaderBuildReport buildAllShaders(const std::filesystem::path& shaderDirectory);
 }
 
-#endif
\ No newline at end of file
+#endif
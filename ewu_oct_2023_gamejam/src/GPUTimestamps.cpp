@@ -0,0 +1,205 @@
+#include "GPUTimestamps.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <algorithm>
+#include "VkDataStructures.h"
+
+
+namespace gputimestamps
+{
+	constexpr uint32_t NUM_QUERIES = NUM_GPU_PASSES * 2;  // Begin and end of each pass.
+
+	VkDevice device;
+	VkQueryPool queryPools[FRAME_OVERLAP];
+	uint64_t pendingFrameNumbers[FRAME_OVERLAP];
+	bool hasPendingResults[FRAME_OVERLAP] = {};
+	bool isSupported = false;
+	float_t nsPerTick = 1.0f;
+	uint64_t validBitsMask = ~0ULL;
+
+	FrameTimings latestTimings;
+	std::ofstream csvFile;
+
+	bool init(VkDevice newDevice, VkPhysicalDevice physicalDevice, uint32_t queueFamily, float_t timestampPeriod, DeletionQueue& deletionQueue)
+	{
+		device = newDevice;
+		nsPerTick = timestampPeriod;
+
+		// Check that the graphics queue can write timestamps at all.
+		uint32_t numQueueFamilies;
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numQueueFamilies, nullptr);
+		std::vector<VkQueueFamilyProperties> queueFamilies(numQueueFamilies);
+		vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &numQueueFamilies, queueFamilies.data());
+
+		uint32_t validBits = (queueFamily < numQueueFamilies ? queueFamilies[queueFamily].timestampValidBits : 0);
+		if (validBits == 0 || timestampPeriod <= 0.0f)
+		{
+			std::cerr << "[GPU TIMESTAMPS]" << std::endl
+				<< "WARNING: the graphics queue doesn't support timestamps. GPU pass timings are disabled." << std::endl;
+			isSupported = false;
+			return false;
+		}
+		validBitsMask = (validBits >= 64 ? ~0ULL : (1ULL << validBits) - 1);
+
+		VkQueryPoolCreateInfo queryPoolInfo = {
+			.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+			.pNext = nullptr,
+			.queryType = VK_QUERY_TYPE_TIMESTAMP,
+			.queryCount = NUM_QUERIES,
+		};
+		for (uint32_t i = 0; i < FRAME_OVERLAP; i++)
+		{
+			VK_CHECK(vkCreateQueryPool(device, &queryPoolInfo, nullptr, &queryPools[i]));
+			hasPendingResults[i] = false;
+		}
+
+		deletionQueue.pushFunction([=]() {
+			stopCSVExport();
+			for (uint32_t i = 0; i < FRAME_OVERLAP; i++)
+				vkDestroyQueryPool(device, queryPools[i], nullptr);
+			isSupported = false;
+		});
+
+		isSupported = true;
+		return true;
+	}
+
+	void writeTimingsToCSV(const FrameTimings& timings)
+	{
+		csvFile << timings.frameNumber;
+		for (uint32_t i = 0; i < NUM_GPU_PASSES; i++)
+		{
+			csvFile << ",";
+			if (timings.passWritten[i])
+				csvFile << timings.passMS[i];
+		}
+		csvFile << "," << timings.frameMS << "\n";
+	}
+
+	void readResultsAndReset(VkCommandBuffer cmd, uint32_t frameIndex, uint64_t frameNumber)
+	{
+		if (!isSupported)
+			return;
+
+		if (hasPendingResults[frameIndex])
+		{
+			// @NOTE: every query comes back as { timestamp, availability }. Passes that didn't get
+			//        recorded this frame (e.g. picking) just come back unavailable.
+			uint64_t results[NUM_QUERIES * 2];
+			VkResult result = vkGetQueryPoolResults(device, queryPools[frameIndex], 0, NUM_QUERIES, sizeof(results), results, sizeof(uint64_t) * 2, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+			if (result == VK_SUCCESS || result == VK_NOT_READY)
+			{
+				FrameTimings timings = {
+					.frameNumber = pendingFrameNumbers[frameIndex],
+				};
+				uint64_t frameBegin = ~0ULL;
+				uint64_t frameEnd = 0;
+				for (uint32_t i = 0; i < NUM_GPU_PASSES; i++)
+				{
+					bool beginAvailable = (results[(i * 2 + 0) * 2 + 1] != 0);
+					bool endAvailable   = (results[(i * 2 + 1) * 2 + 1] != 0);
+					if (!beginAvailable || !endAvailable)
+						continue;
+
+					uint64_t begin = results[(i * 2 + 0) * 2] & validBitsMask;
+					uint64_t end   = results[(i * 2 + 1) * 2] & validBitsMask;
+					if (end < begin)
+						continue;  // Wrapped around.
+
+					timings.passMS[i] = (float_t)(end - begin) * nsPerTick / 1000000.0f;
+					timings.passWritten[i] = true;
+					if (i != GPU_PASS_PICKING)  // Picking is its own submit, so it's not part of the frame.
+					{
+						frameBegin = std::min(frameBegin, begin);
+						frameEnd = std::max(frameEnd, end);
+					}
+				}
+				if (frameEnd > frameBegin)
+					timings.frameMS = (float_t)(frameEnd - frameBegin) * nsPerTick / 1000000.0f;
+
+				latestTimings = timings;
+				if (csvFile.is_open())
+					writeTimingsToCSV(timings);
+			}
+		}
+
+		vkCmdResetQueryPool(cmd, queryPools[frameIndex], 0, NUM_QUERIES);
+		pendingFrameNumbers[frameIndex] = frameNumber;
+		hasPendingResults[frameIndex] = true;
+	}
+
+	void beginPass(VkCommandBuffer cmd, uint32_t frameIndex, GPUPass pass)
+	{
+		if (!isSupported)
+			return;
+		vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPools[frameIndex], pass * 2 + 0);
+	}
+
+	void endPass(VkCommandBuffer cmd, uint32_t frameIndex, GPUPass pass)
+	{
+		if (!isSupported)
+			return;
+		vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPools[frameIndex], pass * 2 + 1);
+	}
+
+	const char* getPassName(GPUPass pass)
+	{
+		static const char* cascadeNames[] = { "Shadow Cascade 0", "Shadow Cascade 1", "Shadow Cascade 2", "Shadow Cascade 3", "Shadow Cascade 4", "Shadow Cascade 5", "Shadow Cascade 6", "Shadow Cascade 7" };
+		static_assert(SHADOWMAP_CASCADES <= sizeof(cascadeNames) / sizeof(cascadeNames[0]));
+
+		if (pass >= GPU_PASS_SHADOW_CASCADE_0 && pass < GPU_PASS_ZPREPASS)
+			return cascadeNames[pass - GPU_PASS_SHADOW_CASCADE_0];
+		switch (pass)
+		{
+			case GPU_PASS_SKINNING:    return "Skinning";
+			case GPU_PASS_ZPREPASS:    return "Z Prepass";
+			case GPU_PASS_MAIN:        return "Main";
+			case GPU_PASS_UI:          return "UI";
+			case GPU_PASS_BLOOM:       return "Bloom";
+			case GPU_PASS_DOF:         return "CoC/DOF";
+			case GPU_PASS_POSTPROCESS: return "Postprocess";
+			case GPU_PASS_PICKING:     return "Picking";
+			default:                   return "Unknown";
+		}
+	}
+
+	const FrameTimings& getLatestTimings()
+	{
+		return latestTimings;
+	}
+
+	bool startCSVExport(const std::string& fname)
+	{
+		stopCSVExport();
+
+		csvFile.open(fname, std::ios::out | std::ios::trunc);
+		if (!csvFile.is_open())
+		{
+			std::cerr << "[GPU TIMESTAMPS]" << std::endl
+				<< "ERROR: could not open \"" << fname << "\" for writing" << std::endl;
+			return false;
+		}
+
+		csvFile << "frame";
+		for (uint32_t i = 0; i < NUM_GPU_PASSES; i++)
+			csvFile << "," << getPassName((GPUPass)i) << " (ms)";
+		csvFile << ",Frame (ms)\n";
+
+		std::cout << "[GPU TIMESTAMPS]" << std::endl
+			<< "Exporting GPU pass timings to \"" << fname << "\"" << std::endl;
+		return true;
+	}
+
+	void stopCSVExport()
+	{
+		if (csvFile.is_open())
+			csvFile.close();
+	}
+
+	bool isExportingCSV()
+	{
+		return csvFile.is_open();
+	}
+}
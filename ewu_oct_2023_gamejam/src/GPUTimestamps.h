@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cmath>
+#include <vulkan/vulkan.h>
+#include "Settings.h"
+struct DeletionQueue;
+
+
+// @NOTE: GPU timings of each render pass. Every frame in flight has its own timestamp query pool, and a pass
+//        writes a timestamp at its begin and its end. The results get read back right after waiting on that
+//        frame's render fence (so they're already finished and reading them never stalls), which means the
+//        timings are always `FRAME_OVERLAP` frames behind.
+namespace gputimestamps
+{
+	enum GPUPass : uint32_t
+	{
+		GPU_PASS_SKINNING = 0,  // Compute pre-skinning, before all the passes that draw the render objects.
+		GPU_PASS_SHADOW_CASCADE_0,
+		GPU_PASS_ZPREPASS = GPU_PASS_SHADOW_CASCADE_0 + SHADOWMAP_CASCADES,
+		GPU_PASS_MAIN,
+		GPU_PASS_UI,
+		GPU_PASS_BLOOM,
+		GPU_PASS_DOF,          // CoC, halving, blur, gather and flood fill.
+		GPU_PASS_POSTPROCESS,  // Combining the postprocesses into the swapchain image (and ImGui).
+		GPU_PASS_PICKING,      // Only when something got clicked on.
+		NUM_GPU_PASSES
+	};
+
+	struct FrameTimings
+	{
+		uint64_t frameNumber = 0;
+		float_t passMS[NUM_GPU_PASSES] = {};
+		bool passWritten[NUM_GPU_PASSES] = {};
+		float_t frameMS = 0.0f;  // From the first pass's begin to the last pass's end.
+	};
+
+	bool init(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamily, float_t timestampPeriod, DeletionQueue& deletionQueue);
+
+	// Call after waiting on the frame's render fence. Reads back the timings of the last frame that used
+	// `frameIndex`, then resets its queries in `cmd` (which must be outside of a renderpass).
+	void readResultsAndReset(VkCommandBuffer cmd, uint32_t frameIndex, uint64_t frameNumber);
+
+	void beginPass(VkCommandBuffer cmd, uint32_t frameIndex, GPUPass pass);
+	void endPass(VkCommandBuffer cmd, uint32_t frameIndex, GPUPass pass);
+
+	const char* getPassName(GPUPass pass);
+	const FrameTimings& getLatestTimings();
+
+	// Appends every read back frame into a CSV until stopped.
+	bool startCSVExport(const std::string& fname);
+	void stopCSVExport();
+	bool isExportingCSV();
+}
@@ -69,7 +69,7 @@ GameOverMenu::GameOverMenu(EntityManager* em, RenderObjectManager* rom, Camera*
     _data->wonArt = ui::registerUIQuad(&engine->_loadedTextures["WonArt"]);
     glm_vec3_copy(vec3{ 425.0f, 81.0f, 0.0f }, _data->wonArt->position);
     glm_vec3_copy(vec3{ 150.0f, 150.0f, 1.0f }, _data->wonArt->scale);
-    _data->wonArt->renderOrder = -1.0f;
+    ui::setRenderOrder(_data->wonArt, -1.0f);
     _data->wonArt->visible = false;
 
     _data->dateArt[0] = ui::registerUIQuad(&engine->_loadedTextures["DateArt0"]);
@@ -180,7 +180,9 @@ void imguiUIQuad2(const std::string& uiQuadName, ui::UIQuad* uiQuad)
         // }
         ImGui::DragFloat3(("Sca" + nameSuffix).c_str(), uiQuad->scale);
 
-        ImGui::DragFloat(("renderOrder" + nameSuffix).c_str(), &uiQuad->renderOrder);
+        float_t renderOrder = uiQuad->renderOrder;
+        if (ImGui::DragFloat(("renderOrder" + nameSuffix).c_str(), &renderOrder))
+            ui::setRenderOrder(uiQuad, renderOrder);
 
         ImGui::TreePop();
         ImGui::Separator();
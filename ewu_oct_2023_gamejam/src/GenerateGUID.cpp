@@ -1,27 +1,235 @@
 #include "GenerateGUID.h"
 
-#include "Imports.h"
+#include <iostream>
+#include <random>
+#include <chrono>
+#ifdef _DEVELOP
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#endif
 
 
-uint32_t randomChar()
+namespace
 {
-	std::random_device rd;
-	std::mt19937 gen(rd());
-	std::uniform_int_distribution<> dis(0, 255);
-	return dis(gen);
+	// xoshiro256** (https://prng.di.unimi.it/). One per thread so that there's no locking, and seeding
+	// from `std::random_device` only happens the first time a thread generates a GUID.
+	struct GUIDGenerator
+	{
+		uint64_t state[4];
+
+		GUIDGenerator()
+		{
+			std::random_device rd;
+			uint64_t seed = ((uint64_t)rd() << 32) ^ (uint64_t)rd();
+			seed ^= (uint64_t)std::chrono::steady_clock::now().time_since_epoch().count();
+			for (uint64_t& s : state)
+				s = splitmix64(seed);
+		}
+
+		static uint64_t splitmix64(uint64_t& x)
+		{
+			uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			return z ^ (z >> 31);
+		}
+
+		static uint64_t rotl(uint64_t x, int32_t k)
+		{
+			return (x << k) | (x >> (64 - k));
+		}
+
+		uint64_t next()
+		{
+			uint64_t result = rotl(state[1] * 5, 7) * 9;
+			uint64_t t = state[1] << 17;
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= t;
+			state[3] = rotl(state[3], 45);
+			return result;
+		}
+	};
+
+	thread_local GUIDGenerator guidGenerator;
+
+	int32_t hexCharToValue(char c)
+	{
+		if (c >= '0' && c <= '9') return c - '0';
+		if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+		if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+		return -1;
+	}
+
+	uint64_t hashString(const std::string& str, uint64_t hash)
+	{
+		// FNV-1a.
+		for (char c : str)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 0x100000001B3ULL;
+		}
+		return hash;
+	}
+}
+
+GUID128 generateGUID128()
+{
+	GUID128 guid;
+	guid.hi = guidGenerator.next();
+	guid.lo = guidGenerator.next();
+	return guid;
+}
+
+void guidToChars(const GUID128& guid, char outChars[GUID128_STRING_LENGTH + 1])
+{
+	constexpr char hexChars[] = "0123456789abcdef";
+	for (size_t i = 0; i < 16; i++)
+	{
+		outChars[i]      = hexChars[(guid.hi >> (60 - i * 4)) & 0xF];
+		outChars[i + 16] = hexChars[(guid.lo >> (60 - i * 4)) & 0xF];
+	}
+	outChars[GUID128_STRING_LENGTH] = '\0';
+}
+
+std::string guidToString(const GUID128& guid)
+{
+	char chars[GUID128_STRING_LENGTH + 1];
+	guidToChars(guid, chars);
+	return std::string(chars, GUID128_STRING_LENGTH);
+}
+
+GUID128 guidFromString(const std::string& guidString)
+{
+	GUID128 guid;
+	if (guidString.size() == GUID128_STRING_LENGTH)
+	{
+		bool isHex = true;
+		for (size_t i = 0; i < GUID128_STRING_LENGTH && isHex; i++)
+		{
+			int32_t value = hexCharToValue(guidString[i]);
+			isHex = (value >= 0);
+			uint64_t& half = (i < 16 ? guid.hi : guid.lo);
+			half = (half << 4) | (uint64_t)(value & 0xF);
+		}
+		if (isHex)
+			return guid;
+	}
+
+	// Not in the 128-bit form, so hash it instead (the entity keeps its original string).
+	guid.hi = hashString(guidString, 0xCBF29CE484222325ULL);
+	guid.lo = hashString(guidString, guid.hi ^ 0x84222325CBF29CE4ULL);
+	return guid;
 }
 
 std::string generateGUID()
 {
-	constexpr uint32_t numChars = 32;
-	std::stringstream ss;
-	for (uint32_t i = 0; i < numChars; i++)
+	return guidToString(generateGUID128());
+}
+
+#ifdef _DEVELOP
+namespace
+{
+	// The generator that was used before GUID128 (new `std::random_device` and `std::mt19937` for every
+	// byte). Only kept around to compare against.
+	std::string generateLegacyGUID()
 	{
-		const auto rc = randomChar();
-		std::stringstream hexstream;
-		hexstream << std::hex << rc;
-		auto hex = hexstream.str();
-		ss << (hex.length() < 2 ? '0' + hex : hex);
+		std::stringstream ss;
+		for (uint32_t i = 0; i < 32; i++)
+		{
+			std::random_device rd;
+			std::mt19937 gen(rd());
+			std::uniform_int_distribution<> dis(0, 255);
+			std::stringstream hexstream;
+			hexstream << std::hex << dis(gen);
+			auto hex = hexstream.str();
+			ss << (hex.length() < 2 ? '0' + hex : hex);
+		}
+		return ss.str();
 	}
-	return ss.str();
 }
+
+void benchmarkGUIDs()
+{
+	constexpr size_t numSpawns = 100000;
+	constexpr size_t numLegacySpawns = 1000;  // The legacy generator is too slow to spawn all of them.
+	constexpr size_t numLookups = 1000;
+	using Clock = std::chrono::high_resolution_clock;
+	auto msSince = [](Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	};
+
+	std::cout << "[BENCHMARK GUIDS]" << std::endl
+		<< "Spawning " << numSpawns << " ids, then " << numLookups << " lookups through all of them" << std::endl;
+
+	// Mass spawning.
+	auto start = Clock::now();
+	for (size_t i = 0; i < numLegacySpawns; i++)
+		generateLegacyGUID();
+	double legacySpawnMS = msSince(start) * (double)numSpawns / (double)numLegacySpawns;
+
+	std::vector<GUID128> guids;
+	guids.reserve(numSpawns);
+	start = Clock::now();
+	for (size_t i = 0; i < numSpawns; i++)
+		guids.push_back(generateGUID128());
+	double spawnMS = msSince(start);
+
+	// Same length strings as the legacy ones to look up through.
+	std::vector<std::string> legacyGuids;
+	legacyGuids.reserve(numSpawns);
+	for (size_t i = 0; i < numSpawns; i++)
+		legacyGuids.push_back(guidToString(guids[i]) + guidToString(guids[numSpawns - 1 - i]));
+
+	// Check the string form round trips, and that there's no duplicates.
+	size_t numRoundTripFails = 0;
+	for (const GUID128& guid : guids)
+		if (guidFromString(guidToString(guid)) != guid)
+			numRoundTripFails++;
+	std::vector<GUID128> sortedGuids = guids;
+	std::sort(sortedGuids.begin(), sortedGuids.end());
+	size_t numDuplicates = 0;
+	for (size_t i = 1; i < sortedGuids.size(); i++)
+		if (sortedGuids[i] == sortedGuids[i - 1])
+			numDuplicates++;
+
+	// Linear lookups, the same as `EntityManager::getEntityViaGUID()`.
+	size_t numFound = 0;
+	start = Clock::now();
+	for (size_t i = 0; i < numLookups; i++)
+	{
+		const std::string& target = legacyGuids[numSpawns - 1 - (i * 97) % numSpawns];
+		for (const std::string& guid : legacyGuids)
+			if (guid == target)
+			{
+				numFound++;
+				break;
+			}
+	}
+	double legacyLookupMS = msSince(start);
+
+	start = Clock::now();
+	for (size_t i = 0; i < numLookups; i++)
+	{
+		const GUID128& target = guids[numSpawns - 1 - (i * 97) % numSpawns];
+		for (const GUID128& guid : guids)
+			if (guid == target)
+			{
+				numFound++;
+				break;
+			}
+	}
+	double lookupMS = msSince(start);
+
+	std::cout << "\tSpawn  (string, legacy):\t" << legacySpawnMS << " ms (extrapolated from " << numLegacySpawns << ")" << std::endl
+		<< "\tSpawn  (GUID128):\t\t" << spawnMS << " ms" << std::endl
+		<< "\tLookup (string, legacy):\t" << legacyLookupMS << " ms" << std::endl
+		<< "\tLookup (GUID128):\t\t" << lookupMS << " ms" << std::endl
+		<< "\tFound: " << numFound << "/" << numLookups * 2
+		<< ", round trip fails: " << numRoundTripFails
+		<< ", duplicates: " << numDuplicates << std::endl;
+}
+#endif
@@ -1,6 +1,35 @@
 #pragma once
 
 #include <string>
+#include <cstdint>
 
 
+// @NOTE: 128-bit entity id. Comparing and hashing these doesn't allocate, unlike the string form.
+//        The string form (32 hex chars) is still what gets written into .ssdat files and passed
+//        around to messages, physics bodies, etc.
+struct GUID128
+{
+	uint64_t hi = 0;
+	uint64_t lo = 0;
+
+	bool operator==(const GUID128& other) const { return (hi == other.hi && lo == other.lo); }
+	bool operator!=(const GUID128& other) const { return !(*this == other); }
+	bool operator<(const GUID128& other) const { return (hi != other.hi ? hi < other.hi : lo < other.lo); }
+};
+
+struct GUID128Hash
+{
+	size_t operator()(const GUID128& guid) const { return (size_t)(guid.hi ^ (guid.lo * 0x9E3779B97F4A7C15ULL)); }
+};
+
+constexpr size_t GUID128_STRING_LENGTH = 32;
+
+GUID128 generateGUID128();  // Uses a per-thread generator that only gets seeded once.
+void guidToChars(const GUID128& guid, char outChars[GUID128_STRING_LENGTH + 1]);  // Null terminated.
+std::string guidToString(const GUID128& guid);
+GUID128 guidFromString(const std::string& guidString);  // @NOTE: anything that's not 32 hex chars (e.g. the older 64 char GUIDs) gets hashed into an id instead.
 std::string generateGUID();
+
+#ifdef _DEVELOP
+void benchmarkGUIDs();
+#endif
@@ -14,6 +14,7 @@
 #include "Character.h"
 #include "Hazard.h"
 #include "DatingInterface.h"
+#include "Profiler.h"
 
 
 namespace globalState
@@ -495,6 +496,7 @@ namespace globalState
         loadGlobalState();
 
         tfTaskAsyncWriting.emplace([&]() {
+            PROFILE_ZONE("Write Global State");
             saveGlobalState();
         });
     }
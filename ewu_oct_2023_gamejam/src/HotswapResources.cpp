@@ -3,11 +3,23 @@
 
 #include <iostream>
 #include <vector>
+#include <unordered_map>
 #include <filesystem>
 #include <thread>
+#include <chrono>
+#include <algorithm>
 #include <SDL2/SDL.h>
 #include "GLSLToSPIRVHelper.h"
 #include "RenderObject.h"
+#include "VulkanEngine.h"
+#include "VkglTFModel.h"
+#include "Profiler.h"
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 
 namespace hotswapres
@@ -18,7 +30,18 @@ namespace hotswapres
 		std::filesystem::file_time_type lastWriteTime;
 	};
 	std::vector<ResourceToWatch> resourcesToWatch;
+    std::vector<std::filesystem::path> directoriesToWatch;
+
+    constexpr uint32_t WATCHER_TICK_MS     = 100;
+    constexpr uint32_t POLLING_INTERVAL_MS = 1000;
+    constexpr uint32_t DEBOUNCE_MS         = 250;   // @NOTE: editors/exporters like to write a file in a few bursts, so wait until it settles down before reloading.
+
+#ifdef __linux__
+    int inotifyFd = -1;
+    std::unordered_map<int, std::filesystem::path> inotifyWatchToDirectory;
+#endif
 
+    bool isWatchableResource(const std::filesystem::path& path);
     void checkIfResourceUpdatedThenHotswapRoutineAsync(VulkanEngine* engine, bool* recreateSwapchain, RenderObjectManager* roManager);
     bool isAsyncRunnerRunning;
     std::thread* asyncRunner = nullptr;
@@ -31,40 +54,30 @@ namespace hotswapres
             "shader",
         };
         for (auto directory : directories)
+        {
+            directoriesToWatch.push_back(directory);
             for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
             {
                 // Add the resource if it should be watched
                 const auto& path = entry.path();
                 if (std::filesystem::is_directory(path))
+                {
+                    directoriesToWatch.push_back(path);
                     continue;		// Ignore directories
-                if (!path.has_extension())
-                    continue;		// @NOTE: only allow resource files if they have an extension!  -Timo
-
-                if (path.extension().compare(".spv") == 0 ||
-                    path.extension().compare(".log") == 0)
-                    continue;		// @NOTE: ignore compiled SPIRV shader files, logs
+                }
+                if (!isWatchableResource(path))
+                    continue;
 
                 ResourceToWatch resource = {
                     .path = path,
                     .lastWriteTime = std::filesystem::last_write_time(path),
                 };
                 resourcesToWatch.push_back(resource);
-
-                // Compile glsl shader if corresponding .spv file isn't up to date
-                const auto& ext = path.extension();
-                if (ext.compare(".vert") == 0 ||
-                    ext.compare(".frag") == 0)		// @COPYPASTA
-                {
-                    auto spvPath = path;
-                    spvPath += ".spv";
-
-                    if (!std::filesystem::exists(spvPath) ||
-                        std::filesystem::last_write_time(spvPath) <= std::filesystem::last_write_time(path))
-                    {
-                        glslToSPIRVHelper::compileGLSLShaderToSPIRV(path);
-                    }
-                }
             }
+        }
+
+        // Bring the .spv files up to date (only the shaders whose source changed get recompiled).
+        glslToSPIRVHelper::buildAllShaders("shader");
     }
 
     std::unordered_map<std::string, std::vector<ReloadCallback>> resourceReloadCallbackMap;
@@ -76,88 +89,266 @@ namespace hotswapres
         return &hotswapResourcesMutex;
     }
 
+    uint64_t getTicksMS()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool isWatchableResource(const std::filesystem::path& path)
+    {
+        if (!path.has_extension())
+            return false;		// @NOTE: only allow resource files if they have an extension!  -Timo
+
+        if (path.extension().compare(".spv") == 0 ||
+            path.extension().compare(".log") == 0 ||
+            path.extension().compare(".manifest") == 0 ||
+            path.extension().compare(".htex") == 0)
+            return false;		// @NOTE: ignore compiled SPIRV shader files, logs, the shader build manifest, cooked textures
+        return true;
+    }
+
+#ifdef __linux__
+    bool addEventWatch(const std::filesystem::path& directory)
+    {
+        // @NOTE: `IN_CREATE` is only here to catch new subdirectories. New files get picked up by their `IN_CLOSE_WRITE`.
+        int wd = inotify_add_watch(inotifyFd, directory.string().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (wd < 0)
+            return false;
+        inotifyWatchToDirectory[wd] = directory;
+        return true;
+    }
+
+    // Watches a directory that showed up after the watcher started, along with anything already inside of it.
+    void addEventWatchesForNewDirectory(const std::filesystem::path& directory, std::vector<std::filesystem::path>& outChangedPaths)
+    {
+        if (!addEventWatch(directory))
+        {
+            std::cerr << "[HOTSWAP RESOURCE WATCHER]" << std::endl
+                << "WARNING: could not watch new directory " << directory << ". Its resources won't get reloaded." << std::endl;
+            return;
+        }
+
+        // @NOTE: files could've been written (or the whole tree moved in) before the watch got added,
+        //        so there won't be any events for those. Report them as changed right away.
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(directory, ec))
+        {
+            const auto& path = entry.path();
+            if (entry.is_directory(ec))
+            {
+                if (!addEventWatch(path))
+                    std::cerr << "[HOTSWAP RESOURCE WATCHER]" << std::endl
+                        << "WARNING: could not watch new directory " << path << ". Its resources won't get reloaded." << std::endl;
+                continue;
+            }
+            if (isWatchableResource(path))
+                outChangedPaths.push_back(path);
+        }
+    }
+#endif
+
+    bool startEventWatcher()
+    {
+#ifdef __linux__
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd < 0)
+            return false;
+
+        for (auto& directory : directoriesToWatch)
+        {
+            if (!addEventWatch(directory))
+            {
+                std::cerr << "[HOTSWAP RESOURCE WATCHER]" << std::endl
+                    << "WARNING: could not watch " << directory << ". Falling back to polling." << std::endl;
+                close(inotifyFd);
+                inotifyFd = -1;
+                inotifyWatchToDirectory.clear();
+                return false;
+            }
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    void stopEventWatcher()
+    {
+#ifdef __linux__
+        if (inotifyFd >= 0)
+            close(inotifyFd);
+        inotifyFd = -1;
+        inotifyWatchToDirectory.clear();
+#endif
+    }
+
+    // Blocks for up to `WATCHER_TICK_MS` waiting for file writes.
+    void waitForChangedResourcesEvents(std::vector<std::filesystem::path>& outChangedPaths)
+    {
+#ifdef __linux__
+        pollfd pfd = {
+            .fd = inotifyFd,
+            .events = POLLIN,
+        };
+        if (poll(&pfd, 1, (int)WATCHER_TICK_MS) <= 0)
+            return;
+
+        alignas(inotify_event) char buffer[4096];
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* ptr = buffer; ptr < buffer + length; ptr += sizeof(inotify_event) + ((inotify_event*)ptr)->len)
+            {
+                const inotify_event* event = (const inotify_event*)ptr;
+                if (event->len == 0)
+                    continue;
+
+                auto it = inotifyWatchToDirectory.find(event->wd);
+                if (it == inotifyWatchToDirectory.end())
+                    continue;
+
+                auto path = it->second / event->name;  // @NOTE: copy, since adding watches below can rehash `inotifyWatchToDirectory`.
+                if (event->mask & IN_ISDIR)
+                {
+                    if (event->mask & (IN_CREATE | IN_MOVED_TO))
+                        addEventWatchesForNewDirectory(path, outChangedPaths);
+                    continue;
+                }
+                if (event->mask & IN_CREATE)
+                    continue;  // Wait for the file to finish getting written.
+
+                if (isWatchableResource(path))
+                    outChangedPaths.push_back(path);
+            }
+        }
+#endif
+    }
+
+    // Fallback for when there's no event watcher. Stats every resource once per `POLLING_INTERVAL_MS`.
+    void pollForChangedResources(std::vector<std::filesystem::path>& outChangedPaths, uint64_t& lastPollTicks)
+    {
+        SDL_Delay(WATCHER_TICK_MS);
+
+        uint64_t ticks = getTicksMS();
+        if (ticks - lastPollTicks < POLLING_INTERVAL_MS)
+            return;
+        lastPollTicks = ticks;
+
+        for (auto& resource : resourcesToWatch)
+        {
+            std::error_code ec;
+            const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(resource.path, ec);
+            if (ec || resource.lastWriteTime == lastWriteTime)
+                continue;
+
+            resource.lastWriteTime = lastWriteTime;
+            outChangedPaths.push_back(resource.path);
+        }
+    }
+
+    void reloadResource(const std::filesystem::path& path, VulkanEngine* engine, bool* recreateSwapchain, RenderObjectManager* roManager)
+    {
+        PROFILE_ZONE("Reload Resource");
+        std::cout << "[RELOAD HOTSWAPPABLE RESOURCE]" << std::endl
+            << "Name: " << path << std::endl;
+
+        //
+        // Find the extension and execute appropriate routine
+        // @NOTE: the heavy lifting (compiling, parsing) gets done before grabbing the lock
+        //        so that the render loop only gets blocked for the actual swap.
+        //
+        const auto& ext = path.extension();
+        if (ext.compare(".vert") == 0 ||
+            ext.compare(".frag") == 0 ||
+            ext.compare(".comp") == 0)
+        {
+            // Compile the shader (GLSL -> SPIRV)
+            if (!glslToSPIRVHelper::compileGLSLShaderToSPIRV(path))
+                return;
+
+            // Queue rebuilding only the pipelines that use this shader
+            std::string spvFilename = path.filename().string() + ".spv";
+            std::lock_guard<std::mutex> lg(hotswapResourcesMutex);
+            if (std::find(engine->_changedShaderFilenames.begin(), engine->_changedShaderFilenames.end(), spvFilename) == engine->_changedShaderFilenames.end())
+                engine->_changedShaderFilenames.push_back(spvFilename);
+            std::cout << "Recompile shader to SPIRV and queue pipeline rebuild SUCCESS" << std::endl;
+            return;
+        }
+        else if (ext.compare(".gltf") == 0 ||
+                ext.compare(".glb")  == 0)
+        {
+            tinygltf::Model gltfModel;
+            if (!vkglTF::Model::parseGltfFile(path.string(), gltfModel))
+                return;
+
+            std::lock_guard<std::mutex> lg(hotswapResourcesMutex);
+            roManager->reloadModelAndTriggerCallbacks(engine, path.stem().string(), path.string(), gltfModel);
+            std::cout << "Sent message to model \"" << path.stem().string() << "\" to reload." << std::endl;
+            return;
+        }
+        else
+        {
+            // Execute all callback functions attached to resource name.
+            std::lock_guard<std::mutex> lg(hotswapResourcesMutex);
+            std::string fname = path.string();
+            auto it = resourceReloadCallbackMap.find(fname);
+            if (it != resourceReloadCallbackMap.end())
+            {
+                for (auto& rc : it->second)
+                    rc.callback();
+
+                size_t callbacks = it->second.size();
+                if (callbacks > 0)
+                {
+                    std::cout << "Executed " << callbacks << " callback function(s) for \"" << fname << "\" to reload." << std::endl;
+                    return;
+                }
+            }
+        }
+
+        // Nothing to do to the resource!
+        // That means there's no routine for this certain resource
+        std::cout << "WARNING: No routine for " << ext << " files!" << std::endl;
+    }
+
 	void checkIfResourceUpdatedThenHotswapRoutineAsync(VulkanEngine* engine, bool* recreateSwapchain, RenderObjectManager* roManager)
     {
+        PROFILE_THREAD_NAME("Hotswap");
+        bool useEvents = startEventWatcher();
+        std::cout << "[HOTSWAP RESOURCE WATCHER]" << std::endl
+            << "Watching " << resourcesToWatch.size() << " resources " << (useEvents ? "with file events." : "by polling.") << std::endl;
+
+        std::unordered_map<std::string, uint64_t> pendingResourceToLastChangeTicks;
+        std::vector<std::filesystem::path> changedPaths;
+        uint64_t lastPollTicks = getTicksMS();
+
         while (isAsyncRunnerRunning)
         {
-            for (auto& resource : resourcesToWatch)
+            changedPaths.clear();
+            if (useEvents)
+                waitForChangedResourcesEvents(changedPaths);
+            else
+                pollForChangedResources(changedPaths, lastPollTicks);
+
+            // Debounce: keep pushing back the reload while the file is still getting written to.
+            uint64_t ticks = getTicksMS();
+            for (auto& path : changedPaths)
+                pendingResourceToLastChangeTicks[path.string()] = ticks;
+
+            for (auto it = pendingResourceToLastChangeTicks.begin(); it != pendingResourceToLastChangeTicks.end();)
             {
-                /*try
-                {*/
-                    const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(resource.path);
-                    if (resource.lastWriteTime == lastWriteTime)
-                        continue;
-
-                    // Insert lock guard to reload resources
-                    std::cout << "[RELOAD HOTSWAPPABLE RESOURCE]" << std::endl
-                        << "Asking to swap resources..." << std::endl;
-                    std::lock_guard<std::mutex> lg(hotswapResourcesMutex);
-
-                    //
-                    // Reload the resource
-                    //
-                    std::cout << "[RELOAD HOTSWAPPABLE RESOURCE]" << std::endl
-                        << "Name: " << resource.path << std::endl;
-                    resource.lastWriteTime = lastWriteTime;
-
-                    if (!resource.path.has_extension())
-                    {
-                        std::cerr << "ERROR: file " << resource.path << " has no extension!" << std::endl;
-                        continue;
-                    }
-
-                    //
-                    // Find the extension and execute appropriate routine
-                    //
-                    const auto& ext = resource.path.extension();
-                    if (ext.compare(".vert") == 0 ||
-                        ext.compare(".frag") == 0)
-                    {
-
-                        // Compile the shader (GLSL -> SPIRV)
-                        glslToSPIRVHelper::compileGLSLShaderToSPIRV(resource.path);
-
-                        // Trip reloading the shaders (recreate swapchain flag)
-                        *recreateSwapchain = true;
-                        std::cout << "Recompile shader to SPIRV and trigger swapchain recreation SUCCESS" << std::endl;
-                        continue;
-                    }
-                    else if (ext.compare(".gltf") == 0 ||
-                            ext.compare(".glb")  == 0)
-                    {
-                        roManager->reloadModelAndTriggerCallbacks(engine, resource.path.stem().string(), resource.path.string());
-                        std::cout << "Sent message to model \"" << resource.path.stem().string() << "\" to reload." << std::endl;
-                        continue;
-                    }
-                    else
-                    {
-                        // Execute all callback functions attached to resource name.
-                        std::string fname = resource.path.string();
-                        auto it = resourceReloadCallbackMap.find(fname);
-                        if (it != resourceReloadCallbackMap.end())
-                        {
-                            for (auto& rc : resourceReloadCallbackMap[fname])
-                                rc.callback();
-
-                            size_t callbacks = resourceReloadCallbackMap[fname].size();
-                            if (callbacks > 0)
-                            {
-                                std::cout << "Executed " << callbacks << " callback function(s) for \"" << fname << "\" to reload." << std::endl;
-                                continue;
-                            }
-                        }
-                    }
-
-                    // Nothing to do to the resource!
-                    // That means there's no routine for this certain resource
-                    std::cout << "WARNING: No routine for " << ext << " files!" << std::endl;
-                /*}
-                catch (...) { }*/   // Just continue on if you get the filesystem error
-            }
+                if (ticks - it->second < DEBOUNCE_MS)
+                {
+                    it++;
+                    continue;
+                }
 
-            // Just a simple static delay of 1 sec
-            SDL_Delay(1000);
+                reloadResource(it->first, engine, recreateSwapchain, roManager);
+                it = pendingResourceToLastChangeTicks.erase(it);
+            }
         }
+
+        stopEventWatcher();
     }
 
     void flagStopRunning()
@@ -171,8 +362,12 @@ namespace hotswapres
         // Shutdown the thread
         //
         isAsyncRunnerRunning = false;  // Redundant just in case
-        asyncRunner->join();
-        delete asyncRunner;
+        if (asyncRunner != nullptr)  // @NOTE: the checker never gets started in the headless simulation.
+        {
+            asyncRunner->join();
+            delete asyncRunner;
+            asyncRunner = nullptr;
+        }
 
         // @NOTE: nothing is around to tear down!
         //        There are just filesystem entries, so they only go until the lifetime
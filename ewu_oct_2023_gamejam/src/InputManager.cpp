@@ -3,6 +3,9 @@
 #include "InputManager.h"
 
 #include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
 #include <SDL2/SDL.h>
 #include "imgui/imgui.h"
 #include "imgui/imgui_impl_sdl.h"
@@ -52,6 +55,38 @@ extern bool input::onKeyLSBPress = false;
 extern bool input::onKeyRSBPress = false;
 extern bool input::onKeyF1Press = false;
 
+// Every input flag that gets written into a recording, in bit order.
+// @NOTE: only append to this list. Reordering it breaks all the existing recordings.
+static bool* const recordedInputFlags[] = {
+	&input::onLMBPress, &input::onLMBRelease, &input::LMBPressed,
+	&input::onRMBPress, &input::onRMBRelease, &input::RMBPressed,
+	&input::onKeyUpPress, &input::keyUpPressed, &input::onKeyDownPress, &input::keyDownPressed,
+	&input::keyLeftPressed, &input::keyRightPressed, &input::keyWorldUpPressed, &input::keyWorldDownPressed,
+	&input::keyShiftPressed, &input::keyDelPressed, &input::keyCtrlPressed,
+	&input::keyQPressed, &input::keyWPressed, &input::keyEPressed, &input::keyRPressed, &input::keyDPressed,
+	&input::keyCPressed, &input::keyXPressed, &input::keyVPressed, &input::keyBPressed,
+	&input::keyEscPressed, &input::keyEnterPressed, &input::keyTargetPressed,
+	&input::onKeyJumpPress, &input::keyJumpPressed, &input::onKeyInteractPress,
+	&input::onKeyF11Press, &input::onKeyF10Press, &input::onKeyF9Press, &input::onKeyF8Press,
+	&input::onKeyLSBPress, &input::onKeyRSBPress, &input::onKeyF1Press,
+};
+constexpr uint32_t numRecordedInputFlags = sizeof(recordedInputFlags) / sizeof(recordedInputFlags[0]);
+static_assert(numRecordedInputFlags <= 64, "Recorded input flags have to fit in a uint64_t.");
+
+constexpr char     INPUT_RECORDING_MAGIC[4] = { 'H', 'I', 'N', 'P' };
+constexpr uint32_t INPUT_RECORDING_VERSION  = 1;
+
+struct RecordedInputFrame
+{
+	uint64_t flags;
+	int32_t mouseDelta[2];
+	int32_t mouseScrollDelta[2];
+};
+
+static std::ofstream                   recordingFile;
+static std::vector<RecordedInputFrame> replayFrames;
+static size_t                          replayFrameIndex = 0;
+
 
 void input::processInput(bool* isRunning, bool* isWindowMinimized)
 {
@@ -211,4 +246,90 @@ void input::processInput(bool* isRunning, bool* isWindowMinimized)
 		}
         }
 	}
+
+	if (recordingFile.is_open())
+	{
+		RecordedInputFrame frame = {
+			.flags = 0,
+			.mouseDelta = { input::mouseDelta[0], input::mouseDelta[1] },
+			.mouseScrollDelta = { input::mouseScrollDelta[0], input::mouseScrollDelta[1] },
+		};
+		for (uint32_t i = 0; i < numRecordedInputFlags; i++)
+			if (*recordedInputFlags[i])
+				frame.flags |= (1ull << i);
+		recordingFile.write((const char*)&frame, sizeof(frame));
+	}
+}
+
+bool input::startRecording(const std::string& fname)
+{
+	recordingFile.open(fname, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!recordingFile.is_open())
+	{
+		std::cerr << "[START INPUT RECORDING]" << std::endl
+			<< "ERROR: could not open \"" << fname << "\" for writing" << std::endl;
+		return false;
+	}
+
+	recordingFile.write(INPUT_RECORDING_MAGIC, sizeof(INPUT_RECORDING_MAGIC));
+	recordingFile.write((const char*)&INPUT_RECORDING_VERSION, sizeof(INPUT_RECORDING_VERSION));
+	recordingFile.write((const char*)&numRecordedInputFlags, sizeof(numRecordedInputFlags));
+
+	std::cout << "[START INPUT RECORDING]" << std::endl
+		<< "Recording input to \"" << fname << "\"" << std::endl;
+	return true;
+}
+
+void input::stopRecording()
+{
+	if (recordingFile.is_open())
+		recordingFile.close();
+}
+
+bool input::loadReplay(const std::string& fname, size_t& outNumFrames)
+{
+	replayFrames.clear();
+	replayFrameIndex = 0;
+	outNumFrames = 0;
+
+	std::ifstream infile(fname, std::ios::in | std::ios::binary);
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t numFlags = 0;
+	if (!infile.is_open() ||
+		!infile.read(magic, sizeof(magic)) ||
+		!infile.read((char*)&version, sizeof(version)) ||
+		!infile.read((char*)&numFlags, sizeof(numFlags)) ||
+		memcmp(magic, INPUT_RECORDING_MAGIC, sizeof(magic)) != 0 ||
+		version != INPUT_RECORDING_VERSION ||
+		numFlags > numRecordedInputFlags)
+	{
+		std::cerr << "[LOAD INPUT REPLAY]" << std::endl
+			<< "ERROR: \"" << fname << "\" is not a valid input recording" << std::endl;
+		return false;
+	}
+
+	RecordedInputFrame frame;
+	while (infile.read((char*)&frame, sizeof(frame)))
+		replayFrames.push_back(frame);
+
+	outNumFrames = replayFrames.size();
+	return true;
+}
+
+void input::processReplayInput(bool* isRunning)
+{
+	if (replayFrameIndex >= replayFrames.size())
+	{
+		*isRunning = false;
+		return;
+	}
+
+	const RecordedInputFrame& frame = replayFrames[replayFrameIndex++];
+	for (uint32_t i = 0; i < numRecordedInputFlags; i++)
+		*recordedInputFlags[i] = (frame.flags & (1ull << i));
+	input::mouseDelta[0] = frame.mouseDelta[0];
+	input::mouseDelta[1] = frame.mouseDelta[1];
+	input::mouseScrollDelta[0] = frame.mouseScrollDelta[0];
+	input::mouseScrollDelta[1] = frame.mouseScrollDelta[1];
 }
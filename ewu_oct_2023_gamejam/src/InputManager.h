@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 
 namespace input
 {
@@ -50,4 +51,12 @@ namespace input
 		onKeyF1Press;
 
 	void processInput(bool* isRunning, bool* isWindowMinimized);
+
+	// @NOTE: input recording. While recording, every `processInput()` call appends the resulting input
+	//        state as one frame to the file. A recording gets played back with `processReplayInput()`
+	//        (one frame per call) instead of `processInput()`, e.g. for the headless simulation.
+	bool startRecording(const std::string& fname);
+	void stopRecording();
+	bool loadReplay(const std::string& fname, size_t& outNumFrames);
+	void processReplayInput(bool* isRunning);  // Sets `isRunning` to false once the replay is out of frames.
 }
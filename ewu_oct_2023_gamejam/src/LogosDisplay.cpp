@@ -173,7 +173,9 @@ void imguiUIQuad3(const std::string& uiQuadName, ui::UIQuad* uiQuad)
         // }
         ImGui::DragFloat3(("Sca" + nameSuffix).c_str(), uiQuad->scale);
 
-        ImGui::DragFloat(("renderOrder" + nameSuffix).c_str(), &uiQuad->renderOrder);
+        float_t renderOrder = uiQuad->renderOrder;
+        if (ImGui::DragFloat(("renderOrder" + nameSuffix).c_str(), &renderOrder))
+            ui::setRenderOrder(uiQuad, renderOrder);
 
         ImGui::TreePop();
         ImGui::Separator();
@@ -1,13 +1,117 @@
 #include <iostream>
+#include <cstring>
 #include "VulkanEngine.h"
+#ifdef _DEVELOP
+#include "GLSLToSPIRVHelper.h"
+#include "TextureCooker.h"
+#include "VoxelMesher.h"
+#include "AttackWaza.h"
+#include "GPUTimestamps.h"
+#include "GenerateGUID.h"
+#include "VkDeletionQueue.h"
+#include "TransformBatch.h"
+#include "RenderObject.h"
+#include "AudioAdapterSoftware.h"
+#endif
 
 
 #ifdef _DEVELOP
-int main()
+int main(int argc, char* argv[])
 #else
 int __stdcall WinMain(void*, void*, char* cmdLine, int)
 #endif
 {
+	VulkanEngine engine;
+
+#ifdef _DEVELOP
+	// Prebuild the shaders without starting up the engine (`make shaders`).
+	if (argc > 1 && strcmp(argv[1], "--build-shaders") == 0)
+	{
+		auto report = glslToSPIRVHelper::buildAllShaders("shader");
+		return (report.numFailed == 0 ? 0 : 1);
+	}
+
+	// Cook the textures into .htex files (`make textures`).
+	if (argc > 1 && strcmp(argv[1], "--cook-textures") == 0)
+	{
+		texturecooker::cookAllTextures("res/textures", {});
+		return 0;
+	}
+	if (argc > 2 && strcmp(argv[1], "--bench-texture") == 0)
+	{
+		texturecooker::benchmarkEncoders(argv[2]);
+		return 0;
+	}
+
+	// Compare a frame's worth of material lookups by name and by handle.
+	if (argc > 1 && strcmp(argv[1], "--bench-materials") == 0)
+	{
+		engine.benchmarkMaterialLookups();
+		return 0;
+	}
+
+	// Check the voxel mesher's output (triangle counts, closed surface, incremental re-meshing).
+	if (argc > 1 && strcmp(argv[1], "--test-voxel-mesher") == 0)
+		return (voxelmesher::runSelfTest() ? 0 : 1);
+
+	// Check that the waza files survive getting cooked into .hwab and read back.
+	if (argc > 1 && strcmp(argv[1], "--test-waza-cooker") == 0)
+		return (waza::runRoundTripTest() ? 0 : 1);
+
+	// Check the deletion queue's ordering and that refilling it doesn't allocate.
+	if (argc > 1 && strcmp(argv[1], "--test-deletion-queue") == 0)
+		return (vkdeletionqueue::runSelfTest() ? 0 : 1);
+
+	// Check that the SIMD transform kernels match their scalar references bit for bit, and time them.
+	if (argc > 1 && strcmp(argv[1], "--test-transform-batch") == 0)
+		return (transformbatch::runSelfTest() ? 0 : 1);
+	if (argc > 1 && strcmp(argv[1], "--bench-transform-batch") == 0)
+	{
+		transformbatch::runBenchmark();
+		return 0;
+	}
+
+	// Time registering and unregistering a full pool of render objects.
+	if (argc > 1 && strcmp(argv[1], "--bench-render-objects") == 0)
+	{
+		RenderObjectManager::benchmarkRegistration();
+		return 0;
+	}
+
+	// Time the software audio mixer.
+	if (argc > 1 && strcmp(argv[1], "--bench-audio-mix") == 0)
+	{
+		AudioAdapter_Software::benchmarkMixing("res/sfx");
+		return 0;
+	}
+
+	// Compare mass spawning and looking up entity GUIDs against the old string GUIDs.
+	if (argc > 1 && strcmp(argv[1], "--bench-guids") == 0)
+	{
+		benchmarkGUIDs();
+		return 0;
+	}
+
+	// Record this session's input (`--record-input <file>`), or replay a recording in a headless
+	// simulation (`--headless <file> [report.csv]`) for reproducible gameplay benchmarks.
+	std::string headlessReplayPath;
+	std::string headlessReportPath = "headless_report.csv";
+	if (argc > 2 && strcmp(argv[1], "--record-input") == 0)
+		engine._recordInputPath = argv[2];
+	if (argc > 2 && strcmp(argv[1], "--headless") == 0)
+	{
+		engine._headless = true;
+		headlessReplayPath = argv[2];
+		if (argc > 3)
+			headlessReportPath = argv[3];
+	}
+
+	// Write every frame's GPU pass timings into a CSV (`--gpu-timings <file.csv>`).
+	std::string gpuTimingsPath;
+	if (argc > 2 && strcmp(argv[1], "--gpu-timings") == 0)
+		gpuTimingsPath = argv[2];
+#endif
+
 	const char* logoText =
 		"                .^~7?7^                                             !P5PPY7^                       \n"
 		"                .?P#@@@BY!:                                          ~Y#@@@&P:                     \n"
@@ -39,8 +143,18 @@ int __stdcall WinMain(void*, void*, char* cmdLine, int)
 
 	// @TODO: disable Sticky Keys right here!!! And then restore the setting to what it was before at the end.
 
-	VulkanEngine engine;
 	engine.init();
+#ifdef _DEVELOP
+	if (!gpuTimingsPath.empty())
+		gputimestamps::startCSVExport(gpuTimingsPath);
+
+	if (engine._headless)
+	{
+		int32_t result = engine.runHeadless(headlessReplayPath, headlessReportPath);
+		engine.cleanup();
+		return result;
+	}
+#endif
 	engine.run();
 	engine.cleanup();
 
@@ -162,7 +162,7 @@ MainMenu::MainMenu(EntityManager* em, RenderObjectManager* rom, Camera* camera,
 
     // Create ui quads.
     _data->uiTitleLogo = ui::registerUIQuad(&engine->_loadedTextures["TitleLogo"]);
-    _data->uiTitleLogo->renderOrder = -1.0f;
+    ui::setRenderOrder(_data->uiTitleLogo, -1.0f);
     glm_vec3_copy(vec3{ 83.0f, 41.0f, 0.0f }, _data->uiTitleLogo->position);
     glm_vec3_copy(vec3{ 500.0f, 500.0f, 1.0f }, _data->uiTitleLogo->scale);
     glm_vec4_copy(vec4{ 1.0f, 1.0f, 1.0f, 0.0f }, _data->uiTitleLogo->tint);
@@ -170,7 +170,7 @@ MainMenu::MainMenu(EntityManager* em, RenderObjectManager* rom, Camera* camera,
     _data->titleLogoAlpha = 0.0f;
 
     _data->uiCovering = ui::registerUIQuad(&engine->_loadedTextures["empty"]);
-    _data->uiCovering->renderOrder = 100.0f;
+    ui::setRenderOrder(_data->uiCovering, 100.0f);
     glm_vec3_copy(vec3{ 1000.0f, 1000.0f, 1.0f }, _data->uiCovering->scale);
     glm_vec4_copy(vec4{ 0.0f, 0.0f, 0.0f, 1.0f }, _data->uiCovering->tint);
     _data->uiCovering->visible = true;
@@ -0,0 +1,248 @@
+#include "PBRTextureCache.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace pbrtexturecache
+{
+	constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+	struct HPBRHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t key;
+		uint32_t format;
+		uint32_t texelSize;
+		uint32_t width;
+		uint32_t height;
+		uint32_t mipLevels;
+		uint32_t layerCount;
+		uint64_t dataSize;
+	};
+
+	uint64_t hashBytes(const void* bytes, size_t numBytes, uint64_t hash)
+	{
+		const uint8_t* data = (const uint8_t*)bytes;
+		for (size_t i = 0; i < numBytes; i++)
+		{
+			hash ^= (uint64_t)data[i];
+			hash *= FNV_PRIME;
+		}
+		return hash;
+	}
+
+	uint64_t hashFile(const std::string& fname, uint64_t hash)
+	{
+		std::ifstream file(fname, std::ios::binary);
+		if (!file.is_open())
+			return hashBytes(fname.data(), fname.size(), hash ^ 0xFFull);  // @NOTE: a missing file still changes the hash, so it won't match a cache made when it existed.
+
+		std::vector<char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+		return hashBytes(bytes.data(), bytes.size(), hash);
+	}
+
+	bool loadCachedImage(const std::string& fname, uint64_t expectedKey, CachedImage& outImage)
+	{
+		std::ifstream file(fname, std::ios::binary);
+		if (!file.is_open())
+			return false;
+
+		HPBRHeader header;
+		if (!file.read((char*)&header, sizeof(header)) ||
+			header.magic != HPBR_MAGIC ||
+			header.version != HPBR_VERSION)
+		{
+			std::cerr << "[LOAD PBR TEXTURE CACHE]" << std::endl
+				<< "WARNING: \"" << fname << "\" is not a valid .hpbr file (or is an old version). Regenerating." << std::endl;
+			return false;
+		}
+		if (header.key != expectedKey)
+			return false;  // Stale. Inputs changed since this was generated.
+
+		outImage.key = header.key;
+		outImage.format = header.format;
+		outImage.texelSize = header.texelSize;
+		outImage.width = header.width;
+		outImage.height = header.height;
+		outImage.mipLevels = header.mipLevels;
+		outImage.layerCount = header.layerCount;
+		outImage.data.resize(header.dataSize);
+		if (!file.read((char*)outImage.data.data(), header.dataSize))
+		{
+			std::cerr << "[LOAD PBR TEXTURE CACHE]" << std::endl
+				<< "WARNING: \"" << fname << "\" is truncated. Regenerating." << std::endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool saveCachedImage(const std::string& fname, const CachedImage& image)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(fname).parent_path(), ec);
+
+		std::ofstream file(fname, std::ios::binary);
+		if (!file.is_open())
+		{
+			std::cerr << "[SAVE PBR TEXTURE CACHE]" << std::endl
+				<< "ERROR: could not open \"" << fname << "\" for writing" << std::endl;
+			return false;
+		}
+
+		HPBRHeader header = {
+			.magic = HPBR_MAGIC,
+			.version = HPBR_VERSION,
+			.key = image.key,
+			.format = image.format,
+			.texelSize = image.texelSize,
+			.width = image.width,
+			.height = image.height,
+			.mipLevels = image.mipLevels,
+			.layerCount = image.layerCount,
+			.dataSize = image.data.size(),
+		};
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)image.data.data(), image.data.size());
+		return true;
+	}
+
+	//
+	// CPU reference for the BRDF LUT
+	//
+	float halfToFloat(uint16_t half)
+	{
+		uint32_t sign = (uint32_t)(half >> 15) << 31;
+		uint32_t exponent = (half >> 10) & 0x1F;
+		uint32_t mantissa = half & 0x3FF;
+
+		uint32_t bits;
+		if (exponent == 0)
+		{
+			if (mantissa == 0)
+				bits = sign;
+			else
+			{
+				// Subnormal. Normalize it.
+				exponent = 127 - 15 + 1;
+				while ((mantissa & 0x400) == 0)
+				{
+					mantissa <<= 1;
+					exponent--;
+				}
+				bits = sign | (exponent << 23) | ((mantissa & 0x3FF) << 13);
+			}
+		}
+		else if (exponent == 0x1F)
+			bits = sign | 0x7F800000 | (mantissa << 13);  // Inf/NaN.
+		else
+			bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+
+		float value;
+		memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	// @NOTE: everything below mirrors genbrdflut.frag line for line (including the float precision), so that
+	//        the only differences left are the GPU's transcendentals and the R16 rounding.
+	float shaderRandom(float x, float y)
+	{
+		float dt = x * 12.9898f + y * 78.233f;
+		float sn = dt - 3.14f * std::floor(dt / 3.14f);
+		float r = std::sin(sn) * 43758.5453f;
+		return r - std::floor(r);
+	}
+
+	void hammersley2d(uint32_t i, uint32_t N, float outXi[2])
+	{
+		uint32_t bits = (i << 16u) | (i >> 16u);
+		bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+		bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+		bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+		bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+		outXi[0] = (float)i / (float)N;
+		outXi[1] = (float)bits * 2.3283064365386963e-10f;
+	}
+
+	void integrateBRDF(float NoV, float roughness, uint32_t numSamples, float outScaleBias[2])
+	{
+		constexpr float PI = 3.1415926536f;
+
+		// Normal is always +z for the 2D lookup, so the tangent frame is just the x/y axes.
+		const float V[3] = { std::sqrt(1.0f - NoV * NoV), 0.0f, NoV };
+		const float alpha = roughness * roughness;
+		const float phiOffset = shaderRandom(0.0f, 1.0f) * 0.1f;  // `random(normal.xz)`
+		const float k = (roughness * roughness) / 2.0f;
+
+		float scale = 0.0f;
+		float bias = 0.0f;
+		for (uint32_t i = 0; i < numSamples; i++)
+		{
+			float Xi[2];
+			hammersley2d(i, numSamples, Xi);
+
+			// importanceSample_GGX() with N = +z (tangentX = +x, tangentY = +y)
+			float phi = 2.0f * PI * Xi[0] + phiOffset;
+			float cosTheta = std::sqrt((1.0f - Xi[1]) / (1.0f + (alpha * alpha - 1.0f) * Xi[1]));
+			float sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+			float H[3] = { sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta };
+			float Hlength = std::sqrt(H[0] * H[0] + H[1] * H[1] + H[2] * H[2]);
+			for (float& h : H)
+				h /= Hlength;
+
+			float VoH = V[0] * H[0] + V[1] * H[1] + V[2] * H[2];
+			float L[3] = { 2.0f * VoH * H[0] - V[0], 2.0f * VoH * H[1] - V[1], 2.0f * VoH * H[2] - V[2] };
+
+			float dotNL = std::max(L[2], 0.0f);
+			float dotNV = std::max(V[2], 0.0f);
+			float dotVH = std::max(VoH, 0.0f);
+			float dotNH = std::max(H[2], 0.0f);
+
+			if (dotNL > 0.0f)
+			{
+				float GL = dotNL / (dotNL * (1.0f - k) + k);
+				float GV = dotNV / (dotNV * (1.0f - k) + k);
+				float G_Vis = (GL * GV * dotVH) / (dotNH * dotNV);
+				float Fc = std::pow(1.0f - dotVH, 5.0f);
+				scale += (1.0f - Fc) * G_Vis;
+				bias += Fc * G_Vis;
+			}
+		}
+
+		outScaleBias[0] = scale / (float)numSamples;
+		outScaleBias[1] = bias / (float)numSamples;
+	}
+
+	BRDFLUTValidation validateBRDFLUT(const uint16_t* lutRG, uint32_t dim, uint32_t numSamples, uint32_t stride)
+	{
+		BRDFLUTValidation validation;
+		double errorSum = 0.0;
+		for (uint32_t y = stride / 2; y < dim; y += stride)
+			for (uint32_t x = stride / 2; x < dim; x += stride)
+			{
+				float u = ((float)x + 0.5f) / (float)dim;
+				float v = ((float)y + 0.5f) / (float)dim;
+
+				float reference[2];
+				integrateBRDF(u, 1.0f - v, numSamples, reference);
+
+				const uint16_t* texel = &lutRG[((size_t)y * dim + x) * 2];
+				for (uint32_t c = 0; c < 2; c++)
+				{
+					float error = std::abs(halfToFloat(texel[c]) - reference[c]);
+					validation.maxError = std::max(validation.maxError, error);
+					errorSum += error;
+				}
+				validation.numTexelsChecked++;
+			}
+
+		if (validation.numTexelsChecked > 0)
+			validation.avgError = (float)(errorSum / (validation.numTexelsChecked * 2.0));
+		return validation;
+	}
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+// @NOTE: the generated PBR textures (environment, irradiance and prefiltered cubemaps and the BRDF LUT)
+//        only depend on their shaders and a handful of parameters, so they get rendered once, saved into
+//        "cache/", and then just uploaded on later launches. The key is a hash of all of those inputs, so
+//        changing the sky shader or the light direction makes them get regenerated.
+namespace pbrtexturecache
+{
+	constexpr uint32_t HPBR_MAGIC   = 0x52425048;  // "HPBR"
+	constexpr uint32_t HPBR_VERSION = 1;
+
+	constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+
+	struct CachedImage
+	{
+		uint64_t key = 0;
+		uint32_t format = 0;     // VkFormat
+		uint32_t texelSize = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t mipLevels = 0;
+		uint32_t layerCount = 0;
+		std::vector<uint8_t> data;  // Mip major, then layer (same order as `vkutil::readbackImage()`).
+	};
+
+	uint64_t hashBytes(const void* bytes, size_t numBytes, uint64_t hash = FNV_OFFSET_BASIS);
+	uint64_t hashFile(const std::string& fname, uint64_t hash = FNV_OFFSET_BASIS);
+
+	// Returns false if the file is missing, broken, or was made from a different key.
+	bool loadCachedImage(const std::string& fname, uint64_t expectedKey, CachedImage& outImage);
+	bool saveCachedImage(const std::string& fname, const CachedImage& image);
+
+	//
+	// CPU reference for the BRDF LUT
+	//
+	float halfToFloat(uint16_t half);
+
+	// Same integration (and sample sequence) as shader/genbrdflut.frag. Outputs the (scale, bias) pair.
+	void integrateBRDF(float NoV, float roughness, uint32_t numSamples, float outScaleBias[2]);
+
+	struct BRDFLUTValidation
+	{
+		uint32_t numTexelsChecked = 0;
+		float maxError = 0.0f;
+		float avgError = 0.0f;
+	};
+
+	// Checks every `stride`th texel of an R16G16_SFLOAT LUT (row 0 is roughness 1) against `integrateBRDF()`.
+	BRDFLUTValidation validateBRDFLUT(const uint16_t* lutRG, uint32_t dim, uint32_t numSamples, uint32_t stride);
+}
@@ -14,6 +14,9 @@
 #include <iostream>
 #include <chrono>
 #include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 #include <algorithm>
 #include <format>
 #include <map>
@@ -40,6 +43,8 @@
 #include "Hazard.h"
 #include "VoxelField.h"
 #include "GlobalState.h"
+#include "Profiler.h"
+#include "TransformBatch.h"
 #include "imgui/imgui.h"
 #include "imgui/implot.h"
 
@@ -63,10 +68,19 @@ namespace physengine
 
     void runPhysicsEngineAsync();
     EntityManager* entityManager;
-    bool isAsyncRunnerRunning;
+    std::atomic<bool> isAsyncRunnerRunning;
     std::thread* asyncRunner = nullptr;
     uint64_t lastTick;
 
+    // Lockstep mode (see `stepLockstep()`).
+    bool isLockstep = false;
+    std::mutex lockstepMutex;
+    std::condition_variable lockstepCV;
+    size_t lockstepTicksRequested = 0;
+    size_t lockstepTicksFinished = 0;
+    float_t lockstepAccumulatedTime = 0.0f;
+    float_t lockstepAlpha = 0.0f;
+
     PhysicsSystem* physicsSystem = nullptr;
     std::map<uint32_t, std::string> bodyIdToEntityGuidMap;
 
@@ -334,19 +348,42 @@ namespace physengine
     }
 #endif
 
-    void start(EntityManager* em)
+    void start(EntityManager* em, bool lockstep)
     {
         entityManager = em;
+        isLockstep = lockstep;
         isAsyncRunnerRunning = true;
         asyncRunner = new std::thread(runPhysicsEngineAsync);
     }
 
     void haltAsyncRunner()
     {
-        isAsyncRunnerRunning = false;
+        {
+            std::lock_guard<std::mutex> lg(lockstepMutex);
+            isAsyncRunnerRunning = false;
+        }
+        lockstepCV.notify_all();
         asyncRunner->join();
     }
 
+    size_t stepLockstep(const float_t& deltaTime)
+    {
+        lockstepAccumulatedTime += deltaTime;
+        size_t numTicks = (size_t)(lockstepAccumulatedTime / physicsDeltaTime);
+        lockstepAccumulatedTime -= numTicks * physicsDeltaTime;
+        lockstepAlpha = lockstepAccumulatedTime / physicsDeltaTime;
+
+        if (numTicks > 0)
+        {
+            std::unique_lock<std::mutex> lock(lockstepMutex);
+            lockstepTicksRequested += numTicks;
+            lockstepCV.notify_all();
+            lockstepCV.wait(lock, [] { return lockstepTicksFinished == lockstepTicksRequested; });
+        }
+        return numTicks;
+    }
+
+
     void cleanup()
     {
         delete asyncRunner;
@@ -366,6 +403,8 @@ namespace physengine
 
     float_t getPhysicsAlpha()
     {
+        if (isLockstep)
+            return lockstepAlpha;
         return (SDL_GetTicks64() - lastTick) * oneOverPhysicsDeltaTimeInMS * globalState::timescale;
     }
 
@@ -598,6 +637,7 @@ namespace physengine
         // Init Physics World.
         // REFERENCE: https://github.com/jrouwe/JoltPhysics/blob/master/HelloWorld/HelloWorld.cpp
         //
+        PROFILE_THREAD_NAME("Physics");
         RegisterDefaultAllocator();
 
         Trace = TraceImpl;
@@ -636,6 +676,15 @@ namespace physengine
         //
         while (isAsyncRunnerRunning)
         {
+            if (isLockstep)
+            {
+                // Wait until the next tick gets requested.
+                std::unique_lock<std::mutex> lock(lockstepMutex);
+                lockstepCV.wait(lock, [] { return lockstepTicksFinished < lockstepTicksRequested || !isAsyncRunnerRunning; });
+                if (!isAsyncRunnerRunning)
+                    break;
+            }
+
             lastTick = SDL_GetTicks64();
 
 #ifdef _DEVELOP
@@ -652,11 +701,20 @@ namespace physengine
             // @REPLY: I thought that the system should just run in a constant 40fps. As in,
             //         if the timescale slows down, then the tick rate should also slow down
             //         proportionate to the timescale.  -Timo 2023/06/10
-            tick();
-            entityManager->INTERNALphysicsUpdate(physicsDeltaTime);  // @NOTE: if timescale changes, then the system just waits longer/shorter.
-            globalState::drawDebugVisualization();
-            physicsSystem->Update(physicsDeltaTime, 1, 1, &tempAllocator, &jobSystem);
-            tock();
+            {
+                PROFILE_ZONE("Physics Tick");
+                tick();
+                {
+                    PROFILE_ZONE("Entity Physics Update");
+                    entityManager->INTERNALphysicsUpdate(physicsDeltaTime);  // @NOTE: if timescale changes, then the system just waits longer/shorter.
+                }
+                globalState::drawDebugVisualization();
+                {
+                    PROFILE_ZONE("Jolt Update");
+                    physicsSystem->Update(physicsDeltaTime, 1, 1, &tempAllocator, &jobSystem);
+                }
+                tock();
+            }
 
 #ifdef _DEVELOP
             {
@@ -686,6 +744,16 @@ namespace physengine
             }
 #endif
 
+            if (isLockstep)
+            {
+                {
+                    std::lock_guard<std::mutex> lg(lockstepMutex);
+                    lockstepTicksFinished++;
+                }
+                lockstepCV.notify_all();
+                continue;
+            }
+
             // Wait for remaining time
             uint64_t endingTime = SDL_GetTicks64();
             uint64_t timeDiff = endingTime - lastTick;
@@ -730,7 +798,12 @@ namespace physengine
             vfpd.sizeX = sizeX;
             vfpd.sizeY = sizeY;
             vfpd.sizeZ = sizeZ;
-            vfpd.voxelData = voxelData;
+            voxelstorage::clear(vfpd.voxelStorage);
+            if (voxelData != nullptr)
+            {
+                voxelstorage::importDense(vfpd.voxelStorage, voxelData, sizeX, sizeY, sizeZ);
+                delete[] voxelData;
+            }
             vfpd.bodyId = JPH::BodyID();
             vfpd.nsTriggerBodyId = JPH::BodyID();
             vfpd.ewTriggerBodyId = JPH::BodyID();
@@ -759,6 +832,8 @@ namespace physengine
                 }
                 numVFsCreated--;
 
+                voxelstorage::clear(vfpd->voxelStorage);
+
                 // Remove and delete the voxel field body.
                 BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
                 bodyInterface.RemoveBody(vfpd->bodyId);
@@ -775,15 +850,15 @@ namespace physengine
         if (x < 0 || y < 0 || z < 0 ||
             x >= vfpd.sizeX || y >= vfpd.sizeY || z >= vfpd.sizeZ)
             return 0;
-        return vfpd.voxelData[(size_t)x * vfpd.sizeY * vfpd.sizeZ + (size_t)y * vfpd.sizeZ + (size_t)z];
+        return voxelstorage::getVoxel(vfpd.voxelStorage, x, y, z);
     }
 
-    bool setVoxelDataAtPosition(const VoxelFieldPhysicsData& vfpd, const int32_t& x, const int32_t& y, const int32_t& z, uint8_t data)
+    bool setVoxelDataAtPosition(VoxelFieldPhysicsData& vfpd, const int32_t& x, const int32_t& y, const int32_t& z, uint8_t data)
     {
         if (x < 0 || y < 0 || z < 0 ||
             x >= vfpd.sizeX || y >= vfpd.sizeY || z >= vfpd.sizeZ)
             return false;
-        vfpd.voxelData[(size_t)x * vfpd.sizeY * vfpd.sizeZ + (size_t)y * vfpd.sizeZ + (size_t)z] = data;
+        voxelstorage::setVoxel(vfpd.voxelStorage, x, y, z, data);
         return true;
     }
 
@@ -796,23 +871,9 @@ namespace physengine
         glm_ivec3_mul(outOffset, ivec3{ -1, -1, -1 }, outOffset);
         glm_ivec3_add(newSize, outOffset, newSize);  // Adds on the offset.
 
-        // Create a new data grid with new bounds.
-        size_t arraySize = newSize[0] * newSize[1] * newSize[2];
-        uint8_t* newVD = new uint8_t[arraySize];
-        for (size_t i = 0; i < arraySize; i++)
-            newVD[i] = 0;  // Init the value to be empty.
-
-        for (size_t i = 0; i < vfpd.sizeX; i++)
-        for (size_t j = 0; j < vfpd.sizeY; j++)
-        for (size_t k = 0; k < vfpd.sizeZ; k++)
-        {
-            uint8_t data = vfpd.voxelData[i * vfpd.sizeY * vfpd.sizeZ + j * vfpd.sizeZ + k];
-            ivec3 newIJK;
-            glm_ivec3_add(ivec3{ (int32_t)i, (int32_t)j, (int32_t)k }, outOffset, newIJK);
-            newVD[newIJK[0] * newSize[1] * newSize[2] + newIJK[1] * newSize[2] + newIJK[2]] = data;
-        }
-        delete[] vfpd.voxelData;
-        vfpd.voxelData = newVD;
+        // Shift the storage origin instead of copying the voxels over into a new grid.
+        for (size_t i = 0; i < 3; i++)
+            vfpd.voxelStorage.origin[i] -= outOffset[i];
 
         // Update size for voxel data structure.
         vfpd.sizeX = (size_t)newSize[0];
@@ -825,17 +886,14 @@ namespace physengine
 
     void shrinkVoxelFieldBoundsAuto(VoxelFieldPhysicsData& vfpd, ivec3& outOffset)
     {
-        ivec3 boundsMin = { vfpd.sizeX, vfpd.sizeY, vfpd.sizeZ };
-        ivec3 boundsMax = { 0, 0, 0 };
-        for (size_t i = 0; i < vfpd.sizeX; i++)
-        for (size_t j = 0; j < vfpd.sizeY; j++)
-        for (size_t k = 0; k < vfpd.sizeZ; k++)
-            if (getVoxelDataAtPosition(vfpd, i, j, k) != 0)
-            {
-                ivec3 ijk = { i, j, k };
-                glm_ivec3_minv(boundsMin, ijk, boundsMin);
-                glm_ivec3_maxv(boundsMax, ijk, boundsMax);
-            }
+        ivec3 boundsMin;
+        ivec3 boundsMax;
+        if (!voxelstorage::calculateFilledBounds(vfpd.voxelStorage, boundsMin, boundsMax))
+        {
+            // Nothing's filled in. Leave the bounds alone.
+            glm_ivec3_zero(outOffset);
+            return;
+        }
         glm_ivec3_mul(boundsMin, ivec3{ -1, -1, -1 }, outOffset);
 
         // Set the new bounds to the smaller amount.
@@ -843,27 +901,9 @@ namespace physengine
         glm_ivec3_add(boundsMax, ivec3{ 1, 1, 1 }, newSize);
         glm_ivec3_sub(newSize, boundsMin, newSize);
 
-        // @COPYPASTA
-        // Create a new data grid with new bounds.
-        size_t arraySize = newSize[0] * newSize[1] * newSize[2];
-        uint8_t* newVD = new uint8_t[arraySize];
-        for (size_t i = 0; i < arraySize; i++)
-            newVD[i] = 0;  // Init the value to be empty.
-
-        for (size_t i = 0; i < vfpd.sizeX; i++)
-        for (size_t j = 0; j < vfpd.sizeY; j++)
-        for (size_t k = 0; k < vfpd.sizeZ; k++)
-        {
-            uint8_t data = vfpd.voxelData[i * vfpd.sizeY * vfpd.sizeZ + j * vfpd.sizeZ + k];
-            if (data == 0)
-                continue;  // Skip empty spaces (to also prevent inserting into out of bounds if shrinking the array).
-
-            ivec3 newIJK;
-            glm_ivec3_add(ivec3{ (int32_t)i, (int32_t)j, (int32_t)k }, outOffset, newIJK);
-            newVD[newIJK[0] * newSize[1] * newSize[2] + newIJK[1] * newSize[2] + newIJK[2]] = data;
-        }
-        delete[] vfpd.voxelData;
-        vfpd.voxelData = newVD;
+        // Shift the storage origin instead of copying the voxels over into a new grid.
+        for (size_t i = 0; i < 3; i++)
+            vfpd.voxelStorage.origin[i] -= outOffset[i];
 
         // Update size for voxel data structure.
         vfpd.sizeX = (size_t)newSize[0];
@@ -873,7 +913,10 @@ namespace physengine
         // Offset the transform.
         glm_translate(vfpd.transform, vec3{ -(float_t)outOffset[0], -(float_t)outOffset[1], -(float_t)outOffset[2] });
 
-        std::cout << "Shurnk to { " << vfpd.sizeX << ", " << vfpd.sizeY << ", " << vfpd.sizeZ << " }" << std::endl;
+        voxelstorage::MemoryUsage memoryUsage = voxelstorage::calculateMemoryUsage(vfpd.voxelStorage);
+        std::cout << "Shurnk to { " << vfpd.sizeX << ", " << vfpd.sizeY << ", " << vfpd.sizeZ << " } ("
+            << memoryUsage.numPackedBricks << " packed bricks, " << memoryUsage.numUniformBricks << " uniform bricks, "
+            << memoryUsage.byteSize << " bytes)" << std::endl;
     }
 
     void cookVoxelDataIntoShape(VoxelFieldPhysicsData& vfpd, const std::string& entityGuid, std::vector<VoxelFieldCollisionShape>& outShapes, std::vector<VoxelFieldCollisionShape>& outTriggers)
@@ -909,6 +952,9 @@ namespace physengine
         Ref<StaticCompoundShapeSettings> compoundNSTriggerShape = new StaticCompoundShapeSettings;
         Ref<StaticCompoundShapeSettings> compoundEWTriggerShape = new StaticCompoundShapeSettings;
 
+        std::vector<uint8_t> voxelData;  // @NOTE: cooking visits every voxel anyways, so unpack the bricks into a dense grid once up front.
+        voxelstorage::exportDense(vfpd.voxelStorage, vfpd.sizeX, vfpd.sizeY, vfpd.sizeZ, voxelData);
+
         bool* processed = new bool[vfpd.sizeX * vfpd.sizeY * vfpd.sizeZ];  // Init processing datastructure
         for (size_t i = 0; i < vfpd.sizeX * vfpd.sizeY * vfpd.sizeZ; i++)
             processed[i] = false;
@@ -918,13 +964,13 @@ namespace physengine
         for (size_t k = 0; k < vfpd.sizeZ; k++)
         {
             size_t idx = i * vfpd.sizeY * vfpd.sizeZ + j * vfpd.sizeZ + k;
-            if (vfpd.voxelData[idx] == 0 || processed[idx])
+            if (voxelData[idx] == 0 || processed[idx])
                 continue;
             
             // Start greedy search.
-            if (vfpd.voxelData[idx] == 1 || (6 <= vfpd.voxelData[idx] && vfpd.voxelData[idx] <= 7))
+            if (voxelData[idx] == 1 || (6 <= voxelData[idx] && voxelData[idx] <= 7))
             {
-                uint8_t myType = vfpd.voxelData[idx];
+                uint8_t myType = voxelData[idx];
 
                 // Filled space search.
                 size_t encX = 1,  // Encapsulation sizes. Multiply it all together to get the count of encapsulation.
@@ -934,7 +980,7 @@ namespace physengine
                 {
                     // Test whether next position is viable.
                     size_t idx = x * vfpd.sizeY * vfpd.sizeZ + j * vfpd.sizeZ + k;
-                    bool viable = (vfpd.voxelData[idx] == myType && !processed[idx]);
+                    bool viable = (voxelData[idx] == myType && !processed[idx]);
                     if (!viable)
                         break;  // Exit if not viable.
                     
@@ -947,7 +993,7 @@ namespace physengine
                     for (size_t x = i; x < i + encX; x++)
                     {
                         size_t idx = x * vfpd.sizeY * vfpd.sizeZ + y * vfpd.sizeZ + k;
-                        viable &= (vfpd.voxelData[idx] == myType && !processed[idx]);
+                        viable &= (voxelData[idx] == myType && !processed[idx]);
                         if (!viable)
                             break;
                     }
@@ -965,7 +1011,7 @@ namespace physengine
                     for (size_t y = j; y < j + encY; y++)
                     {
                         size_t idx = x * vfpd.sizeY * vfpd.sizeZ + y * vfpd.sizeZ + z;
-                        viable &= (vfpd.voxelData[idx] == myType && !processed[idx]);
+                        viable &= (voxelData[idx] == myType && !processed[idx]);
                         if (!viable)
                             break;
                     }
@@ -1007,9 +1053,9 @@ namespace physengine
                 else if (myType == 6 || myType == 7)
                     outTriggers.push_back(vfcs);
             }
-            else if (2 <= vfpd.voxelData[idx] && vfpd.voxelData[idx] <= 5)
+            else if (2 <= voxelData[idx] && voxelData[idx] <= 5)
             {
-                uint8_t myType = vfpd.voxelData[idx];
+                uint8_t myType = voxelData[idx];
                 bool even = (myType == 2 || myType == 4);
 
                 // Slope space search.
@@ -1027,7 +1073,7 @@ namespace physengine
                     else
                         idx = l * vfpd.sizeY * vfpd.sizeZ + j * vfpd.sizeZ + k;
 
-                    bool viable = (vfpd.voxelData[idx] == myType && !processed[idx]);
+                    bool viable = (voxelData[idx] == myType && !processed[idx]);
                     if (!viable)
                         break;  // Exit if not viable.
                     
@@ -1047,7 +1093,7 @@ namespace physengine
                         else
                             idx = l * vfpd.sizeY * vfpd.sizeZ + j * vfpd.sizeZ + w;
 
-                        viable &= (vfpd.voxelData[idx] == myType && !processed[idx]);
+                        viable &= (voxelData[idx] == myType && !processed[idx]);
                         if (!viable)
                             break;
                     }
@@ -1305,6 +1351,26 @@ namespace physengine
         return cpd.character->IsSlopeTooSteep(normal);
     }
 
+    uint64_t hashSimulationState()
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        auto hashBytes = [&](const void* data, size_t size) {
+            const uint8_t* bytes = (const uint8_t*)data;
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+        };
+
+        for (size_t i = 0; i < numVFsCreated; i++)
+            hashBytes(voxelFieldPool[voxelFieldIndices[i]].transform, sizeof(mat4));
+        for (size_t i = 0; i < numCapsCreated; i++)
+            hashBytes(capsulePool[capsuleIndices[i]].currentCOMPosition, sizeof(vec3));
+        return hash;
+    }
+
     //
     // Tick
     //
@@ -1468,7 +1534,7 @@ namespace physengine
                 for (size_t k = searchMin[2]; k <= searchMax[2]; k++)
                 {
                     lkjlkj++;
-                    uint8_t vd = vfpd.voxelData[i * vfpd.sizeY * vfpd.sizeZ + j * vfpd.sizeZ + k];
+                    uint8_t vd = getVoxelDataAtPosition(vfpd, i, j, k);
 
                     switch (vd)
                     {
@@ -1698,44 +1764,51 @@ namespace physengine
         bodyInterface.SetPositionAndRotation(bodyId, newPositionReal, newRotationJolt, activation);
     }
 
+    // Scratch for `setPhysicsObjectInterpolation()`. Kept around so the batches don't reallocate every frame.
+    std::vector<VoxelFieldPhysicsData*> vfsToInterpolate;
+    transformbatch::TRSArrays vfPrevTRSs, vfCurrentTRSs, vfInterpolTRSs;
+    std::vector<mat4s> vfInterpolTransforms;
+
     void setPhysicsObjectInterpolation(const float_t& physicsAlpha)
     {
         auto& bodyInterface = physicsSystem->GetBodyInterface();
 
         //
         // Set interpolated transform
+        // @NOTE: the voxel fields get decomposed one by one, then get blended and composed back into
+        //        matrices all as one batch.
         //
+        vfsToInterpolate.clear();
         for (size_t i = 0; i < numVFsCreated; i++)
+            vfsToInterpolate.push_back(&voxelFieldPool[voxelFieldIndices[i]]);
+
+        vfPrevTRSs.resize(vfsToInterpolate.size());
+        vfCurrentTRSs.resize(vfsToInterpolate.size());
+        for (size_t i = 0; i < vfsToInterpolate.size(); i++)
         {
-            VoxelFieldPhysicsData& vfpd = voxelFieldPool[voxelFieldIndices[i]];
-            if (vfpd.prevTransform != vfpd.transform)
-            {
-                vec4   prevPositionV4, positionV4;
-                vec3   prevPosition, position;
-                mat4   prevRotationM4, rotationM4;
-                versor prevRotation, rotation;
-                vec3   prevScale, scale;
-                glm_decompose(vfpd.prevTransform, prevPositionV4, prevRotationM4, prevScale);
-                glm_decompose(vfpd.transform, positionV4, rotationM4, scale);
-                glm_vec4_copy3(prevPositionV4, prevPosition);
-                glm_vec4_copy3(positionV4, position);
-                glm_mat4_quat(prevRotationM4, prevRotation);
-                glm_mat4_quat(rotationM4, rotation);
-
-                vec3 interpolPos;
-                glm_vec3_lerp(prevPosition, position, physicsAlpha, interpolPos);
-                versor interpolRot;
-                glm_quat_nlerp(prevRotation, rotation, physicsAlpha, interpolRot);
-                vec3 interpolSca;
-                glm_vec3_lerp(prevScale, scale, physicsAlpha, interpolSca);
-
-                mat4 transform = GLM_MAT4_IDENTITY_INIT;
-                glm_translate(transform, interpolPos);
-                glm_quat_rotate(transform, interpolRot, transform);
-                glm_scale(transform, interpolSca);
-                glm_mat4_copy(transform, vfpd.interpolTransform);
-            }
+            VoxelFieldPhysicsData& vfpd = *vfsToInterpolate[i];
+            vec4   prevPositionV4, positionV4;
+            vec3   prevPosition, position;
+            mat4   prevRotationM4, rotationM4;
+            versor prevRotation, rotation;
+            vec3   prevScale, scale;
+            glm_decompose(vfpd.prevTransform, prevPositionV4, prevRotationM4, prevScale);
+            glm_decompose(vfpd.transform, positionV4, rotationM4, scale);
+            glm_vec4_copy3(prevPositionV4, prevPosition);
+            glm_vec4_copy3(positionV4, position);
+            glm_mat4_quat(prevRotationM4, prevRotation);
+            glm_mat4_quat(rotationM4, rotation);
+
+            vfPrevTRSs.set(i, prevPosition, prevRotation, prevScale);
+            vfCurrentTRSs.set(i, position, rotation, scale);
         }
+
+        transformbatch::interpolate(vfPrevTRSs, vfCurrentTRSs, physicsAlpha, vfInterpolTRSs);
+        vfInterpolTransforms.resize(vfsToInterpolate.size());
+        transformbatch::compose(vfInterpolTRSs, (mat4*)vfInterpolTransforms.data());
+        for (size_t i = 0; i < vfsToInterpolate.size(); i++)
+            glm_mat4_copy(vfInterpolTransforms[i].raw, vfsToInterpolate[i]->interpolTransform);
+
         for (size_t i = 0; i < numCapsCreated; i++)
         {
             CapsulePhysicsData& cpd = capsulePool[capsuleIndices[i]];
@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include "ImportGLM.h"
+#include "VoxelStorage.h"
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Body/BodyID.h>
 #include <Jolt/Physics/Collision/CastResult.h>
@@ -30,10 +31,13 @@ namespace physengine
     void savePhysicsWorldSnapshot();
 #endif
 
-    void start(EntityManager* em);
+    void start(EntityManager* em, bool lockstep = false);  // @NOTE: in lockstep mode the physics thread doesn't run in real time. It only ticks when `stepLockstep()` asks it to.
     void haltAsyncRunner();
     void cleanup();
 
+    size_t stepLockstep(const float_t& deltaTime);  // Runs as many physics ticks as fit into `deltaTime` (the remainder carries over) and waits for them to finish. Returns the number of ticks run.
+    uint64_t hashSimulationState();                 // Hash of all the voxel field transforms and character positions. Only stable while the physics thread isn't ticking.
+
     float_t getPhysicsAlpha();
     void getWorldTransform(JPH::BodyID bodyId, mat4& outWorldTransform);
 
@@ -86,6 +90,8 @@ namespace physengine
         //        6: camera trigger volume (North/South)
         //        7: camera trigger volume (East/West)
         //
+        // @NOTE: types are stored in 4 bits (see VoxelStorage.h), so 15 is the highest type that can exist.
+        //
         // For the future:
         //        half-height space (bottom)
         //        half-height space (top)
@@ -99,7 +105,7 @@ namespace physengine
         //        4-step stair space (West  0.5 height, East  1.0 height)
         //
         size_t sizeX, sizeY, sizeZ;
-        uint8_t* voxelData;
+        voxelstorage::VoxelStorage voxelStorage;
         mat4 transform = GLM_MAT4_IDENTITY_INIT;
         mat4 prevTransform = GLM_MAT4_IDENTITY_INIT;
         mat4 interpolTransform = GLM_MAT4_IDENTITY_INIT;
@@ -115,10 +121,10 @@ namespace physengine
         vec3   extent;
     };
 
-    VoxelFieldPhysicsData* createVoxelField(const std::string& entityGuid, mat4 transform, const size_t& sizeX, const size_t& sizeY, const size_t& sizeZ, uint8_t* voxelData);
+    VoxelFieldPhysicsData* createVoxelField(const std::string& entityGuid, mat4 transform, const size_t& sizeX, const size_t& sizeY, const size_t& sizeZ, uint8_t* voxelData);  // Takes ownership of `voxelData` (dense, can be nullptr for an empty field).
     bool destroyVoxelField(VoxelFieldPhysicsData* vfpd);
     uint8_t getVoxelDataAtPosition(const VoxelFieldPhysicsData& vfpd, const int32_t& x, const int32_t& y, const int32_t& z);
-    bool setVoxelDataAtPosition(const VoxelFieldPhysicsData& vfpd, const int32_t& x, const int32_t& y, const int32_t& z, uint8_t data);
+    bool setVoxelDataAtPosition(VoxelFieldPhysicsData& vfpd, const int32_t& x, const int32_t& y, const int32_t& z, uint8_t data);
     void expandVoxelFieldBounds(VoxelFieldPhysicsData& vfpd, ivec3 boundsMin, ivec3 boundsMax, ivec3& outOffset);
     void shrinkVoxelFieldBoundsAuto(VoxelFieldPhysicsData& vfpd, ivec3& outOffset);
     void cookVoxelDataIntoShape(VoxelFieldPhysicsData& vfpd, const std::string& entityGuid, std::vector<VoxelFieldCollisionShape>& outShapes, std::vector<VoxelFieldCollisionShape>& outTriggers);
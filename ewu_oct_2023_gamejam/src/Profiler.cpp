@@ -0,0 +1,346 @@
+#include "Profiler.h"
+
+#if PROFILER_ENABLED
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include "imgui/imgui.h"
+
+
+namespace profiler
+{
+	constexpr size_t RING_CAPACITY = 1 << 15;  // Finished zones kept per thread.
+	constexpr size_t RING_MASK     = RING_CAPACITY - 1;
+	constexpr size_t FRAME_MARKS_CAPACITY = 256;
+
+	struct ZoneEvent
+	{
+		const char* name;
+		uint64_t startNS;
+		uint64_t endNS;
+		uint32_t depth;
+	};
+
+	struct ThreadBuffer
+	{
+		uint32_t threadId;
+		std::string threadName;                      // Guarded by `registryMutex`.
+		std::unique_ptr<ZoneEvent[]> events;
+		std::atomic<uint64_t> writeCount = 0;        // Total zones ever written. Slot is `writeCount & RING_MASK`.
+		uint32_t depth = 0;                          // Only touched by the owning thread.
+	};
+
+	std::mutex registryMutex;
+	std::vector<ThreadBuffer*> threadBuffers;     // @NOTE: never freed, so the zones of threads that are gone can still be exported.
+	std::vector<ThreadBuffer*> freeThreadBuffers; // From threads that exited. Reused by new threads (e.g. Taskflow executors that get created per load).
+
+	uint64_t frameMarks[FRAME_MARKS_CAPACITY];
+	std::atomic<uint64_t> frameMarkCount = 0;
+
+	inline uint64_t nowNS()
+	{
+		return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	const uint64_t epochNS = nowNS();
+
+	struct ThreadBufferOwner
+	{
+		ThreadBuffer* buffer = nullptr;
+
+		~ThreadBufferOwner()
+		{
+			if (buffer == nullptr)
+				return;
+			std::lock_guard<std::mutex> lg(registryMutex);
+			buffer->depth = 0;
+			freeThreadBuffers.push_back(buffer);
+		}
+	};
+	thread_local ThreadBufferOwner threadBufferOwner;
+
+	ThreadBuffer& getThreadBuffer()
+	{
+		if (threadBufferOwner.buffer != nullptr)
+			return *threadBufferOwner.buffer;
+
+		std::lock_guard<std::mutex> lg(registryMutex);
+		ThreadBuffer* buffer;
+		if (!freeThreadBuffers.empty())
+		{
+			buffer = freeThreadBuffers.back();
+			freeThreadBuffers.pop_back();
+		}
+		else
+		{
+			buffer = new ThreadBuffer();
+			buffer->threadId = (uint32_t)threadBuffers.size() + 1;
+			buffer->events = std::make_unique<ZoneEvent[]>(RING_CAPACITY);
+			threadBuffers.push_back(buffer);
+		}
+		buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+		threadBufferOwner.buffer = buffer;
+		return *buffer;
+	}
+
+	ScopedZone::ScopedZone(const char* name) : name(name)
+	{
+		getThreadBuffer().depth++;
+		startNS = nowNS();
+	}
+
+	ScopedZone::~ScopedZone()
+	{
+		uint64_t endNS = nowNS();
+		ThreadBuffer& buffer = getThreadBuffer();
+		buffer.depth--;
+
+		uint64_t index = buffer.writeCount.load(std::memory_order_relaxed);
+		buffer.events[index & RING_MASK] = {
+			.name = name,
+			.startNS = startNS,
+			.endNS = endNS,
+			.depth = buffer.depth,
+		};
+		buffer.writeCount.store(index + 1, std::memory_order_release);
+	}
+
+	void setThreadName(const char* name)
+	{
+		ThreadBuffer& buffer = getThreadBuffer();
+		std::lock_guard<std::mutex> lg(registryMutex);
+		buffer.threadName = name;
+	}
+
+	void markFrame()
+	{
+		uint64_t index = frameMarkCount.load(std::memory_order_relaxed);
+		frameMarks[index % FRAME_MARKS_CAPACITY] = nowNS();
+		frameMarkCount.store(index + 1, std::memory_order_release);
+	}
+
+	//
+	// Reading
+	//
+	struct ThreadSnapshot
+	{
+		uint32_t threadId;
+		std::string threadName;
+		std::vector<ZoneEvent> events;  // Oldest first (ordered by end time).
+	};
+
+	// Copies out the zones of a thread that ended at or after `minEndNS`.
+	// @NOTE: the owning thread keeps writing while this reads, so any slot that could've been lapped during
+	//        the copy gets thrown out afterwards (same idea as a seqlock).
+	void snapshotThread(ThreadBuffer& buffer, uint64_t minEndNS, std::vector<ZoneEvent>& outEvents)
+	{
+		outEvents.clear();
+		uint64_t end = buffer.writeCount.load(std::memory_order_acquire);
+		uint64_t begin = (end > RING_CAPACITY ? end - RING_CAPACITY : 0);
+
+		// Zones get written when they end, so end times only go up. Walk back until they're too old.
+		uint64_t first = end;
+		while (first > begin && buffer.events[(first - 1) & RING_MASK].endNS >= minEndNS)
+			first--;
+		for (uint64_t i = first; i < end; i++)
+			outEvents.push_back(buffer.events[i & RING_MASK]);
+
+		// @NOTE: the slot for zone `endAfter` could already be getting overwritten (the count only goes up once
+		//        it's written), so that one's unsafe too.
+		uint64_t endAfter = buffer.writeCount.load(std::memory_order_acquire);
+		uint64_t safeBegin = (endAfter + 1 > RING_CAPACITY ? endAfter + 1 - RING_CAPACITY : 0);
+		if (safeBegin > first)
+			outEvents.erase(outEvents.begin(), outEvents.begin() + (size_t)std::min<uint64_t>(safeBegin - first, outEvents.size()));
+	}
+
+	void snapshotAllThreads(uint64_t minEndNS, std::vector<ThreadSnapshot>& outSnapshots)
+	{
+		std::vector<ThreadBuffer*> buffers;
+		{
+			std::lock_guard<std::mutex> lg(registryMutex);
+			buffers = threadBuffers;
+			outSnapshots.resize(buffers.size());
+			for (size_t i = 0; i < buffers.size(); i++)
+			{
+				outSnapshots[i].threadId = buffers[i]->threadId;
+				outSnapshots[i].threadName = buffers[i]->threadName;
+			}
+		}
+		for (size_t i = 0; i < buffers.size(); i++)
+			snapshotThread(*buffers[i], minEndNS, outSnapshots[i].events);
+	}
+
+	void writeJSONString(std::ofstream& file, const std::string& str)
+	{
+		file << '"';
+		for (char c : str)
+		{
+			if (c == '"' || c == '\\')
+				file << '\\' << c;
+			else if ((unsigned char)c < 0x20)
+				file << ' ';
+			else
+				file << c;
+		}
+		file << '"';
+	}
+
+	bool exportChromeTrace(const std::string& fname)
+	{
+		std::vector<ThreadSnapshot> snapshots;
+		snapshotAllThreads(0, snapshots);
+
+		std::ofstream file(fname);
+		if (!file.is_open())
+		{
+			std::cerr << "[EXPORT CHROME TRACE]" << std::endl
+				<< "ERROR: could not open \"" << fname << "\" for writing" << std::endl;
+			return false;
+		}
+
+		size_t numZones = 0;
+		char number[64];
+		file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::endl;
+		bool first = true;
+		for (ThreadSnapshot& snapshot : snapshots)
+		{
+			file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << snapshot.threadId << ",\"args\":{\"name\":";
+			writeJSONString(file, snapshot.threadName);
+			file << "}}";
+			first = false;
+
+			for (ZoneEvent& event : snapshot.events)
+			{
+				file << ",\n{\"name\":";
+				writeJSONString(file, event.name);
+				snprintf(number, sizeof(number), "%.3f", (double)(event.startNS - epochNS) / 1000.0);
+				file << ",\"cat\":\"zone\",\"ph\":\"X\",\"pid\":1,\"tid\":" << snapshot.threadId << ",\"ts\":" << number;
+				snprintf(number, sizeof(number), "%.3f", (double)(event.endNS - event.startNS) / 1000.0);
+				file << ",\"dur\":" << number << "}";
+				numZones++;
+			}
+		}
+		file << std::endl << "]}" << std::endl;
+
+		std::cout << "[EXPORT CHROME TRACE]" << std::endl
+			<< "Wrote " << numZones << " zones from " << snapshots.size() << " threads to \"" << fname << "\"" << std::endl;
+		return true;
+	}
+
+	//
+	// Flame view
+	//
+	ImU32 zoneColor(const char* name)
+	{
+		// Same name, same color, even across frames.
+		uint32_t hash = 2166136261u;
+		for (const char* c = name; *c != '\0'; c++)
+			hash = (hash ^ (uint8_t)*c) * 16777619u;
+		return IM_COL32(96 + (hash & 0x7F), 96 + ((hash >> 8) & 0x7F), 96 + ((hash >> 16) & 0x7F), 255);
+	}
+
+	void renderImGuiFlameView()
+	{
+		static bool paused = false;
+		static std::vector<ThreadSnapshot> snapshots;
+		static uint64_t frameStartNS = 0;
+		static uint64_t frameEndNS = 0;
+		static std::string lastExportMessage;
+
+		ImGui::Checkbox("Pause", &paused);
+		ImGui::SameLine();
+		if (ImGui::Button("Export Chrome Trace"))
+			lastExportMessage = exportChromeTrace("profile_trace.json") ? "Wrote \"profile_trace.json\"" : "Export failed";
+		if (!lastExportMessage.empty())
+		{
+			ImGui::SameLine();
+			ImGui::Text(lastExportMessage.c_str());
+		}
+
+		// Grab the last complete frame.
+		uint64_t numFrameMarks = frameMarkCount.load(std::memory_order_acquire);
+		if (!paused && numFrameMarks >= 2)
+		{
+			frameStartNS = frameMarks[(numFrameMarks - 2) % FRAME_MARKS_CAPACITY];
+			frameEndNS = frameMarks[(numFrameMarks - 1) % FRAME_MARKS_CAPACITY];
+			snapshotAllThreads(frameStartNS, snapshots);
+			for (ThreadSnapshot& snapshot : snapshots)
+				std::erase_if(snapshot.events, [&](const ZoneEvent& event) { return event.startNS >= frameEndNS; });
+		}
+		if (frameEndNS <= frameStartNS)
+		{
+			ImGui::Text("Waiting for frames...");
+			return;
+		}
+
+		const double frameDurationMS = (double)(frameEndNS - frameStartNS) / 1000000.0;
+		ImGui::Text("Frame: %.3f ms", frameDurationMS);
+
+		// Top level zones of the main loop (what used to be the `perfs` printout).
+		if (!snapshots.empty() && ImGui::TreeNode("Main Thread Breakdown"))
+		{
+			for (ThreadSnapshot& snapshot : snapshots)
+			{
+				if (snapshot.threadName != "Main")
+					continue;
+				for (ZoneEvent& event : snapshot.events)
+				{
+					if (event.depth != 0 || event.startNS < frameStartNS)
+						continue;
+					double durationMS = (double)(event.endNS - event.startNS) / 1000000.0;
+					ImGui::Text("%-28s %8.3f ms  %5.1f%%", event.name, durationMS, durationMS * 100.0 / frameDurationMS);
+				}
+			}
+			ImGui::TreePop();
+		}
+
+		// Bars. One lane per thread, one row per nesting level.
+		constexpr float_t rowHeight = 18.0f;
+		const float_t width = std::max(600.0f, ImGui::GetContentRegionAvail().x);
+		ImDrawList* drawList = ImGui::GetWindowDrawList();
+		const double nsToPixels = (double)width / (double)(frameEndNS - frameStartNS);
+
+		for (ThreadSnapshot& snapshot : snapshots)
+		{
+			if (snapshot.events.empty())
+				continue;
+
+			uint32_t maxDepth = 0;
+			for (ZoneEvent& event : snapshot.events)
+				maxDepth = std::max(maxDepth, event.depth);
+
+			ImGui::Text(snapshot.threadName.c_str());
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+			float_t laneHeight = rowHeight * (float_t)(maxDepth + 1);
+			drawList->AddRectFilled(origin, ImVec2(origin.x + width, origin.y + laneHeight), IM_COL32(32, 32, 32, 255));
+
+			for (ZoneEvent& event : snapshot.events)
+			{
+				uint64_t clippedStart = std::max(event.startNS, frameStartNS);
+				uint64_t clippedEnd = std::min(event.endNS, frameEndNS);
+				ImVec2 min(origin.x + (float_t)((double)(clippedStart - frameStartNS) * nsToPixels), origin.y + rowHeight * (float_t)event.depth);
+				ImVec2 max(origin.x + (float_t)((double)(clippedEnd - frameStartNS) * nsToPixels), min.y + rowHeight - 1.0f);
+				max.x = std::max(max.x, min.x + 1.0f);
+				drawList->AddRectFilled(min, max, zoneColor(event.name));
+
+				if (max.x - min.x > 24.0f)
+				{
+					drawList->PushClipRect(min, max, true);
+					drawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), IM_COL32(0, 0, 0, 255), event.name);
+					drawList->PopClipRect();
+				}
+				if (ImGui::IsMouseHoveringRect(min, max))
+					ImGui::SetTooltip("%s\n%.3f ms", event.name, (double)(event.endNS - event.startNS) / 1000000.0);
+			}
+			ImGui::Dummy(ImVec2(width, laneHeight));
+		}
+	}
+}
+#endif
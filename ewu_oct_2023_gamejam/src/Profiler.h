@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+
+// @NOTE: scoped zone profiler. Every thread that opens a zone gets its own ring buffer of finished zones
+//        (only that thread ever writes into it, so recording is just a couple of stores and no locks).
+//        The rings get read by the ImGui flame view and by `exportChromeTrace()`, which writes a trace
+//        that can be opened in chrome://tracing or ui.perfetto.dev.
+//
+//        Only compiled in for _DEVELOP builds. Otherwise all the macros below turn into nothing.
+#ifdef _DEVELOP
+#define PROFILER_ENABLED 1
+#else
+#define PROFILER_ENABLED 0
+#endif
+
+namespace profiler
+{
+#if PROFILER_ENABLED
+	struct ScopedZone
+	{
+		ScopedZone(const char* name);  // @NOTE: `name` has to outlive the profiler (i.e. string literals only).
+		~ScopedZone();
+
+	private:
+		const char* name;
+		uint64_t startNS;
+	};
+
+	void setThreadName(const char* name);
+	void markFrame();  // Call at the start of every main loop iteration.
+
+	bool exportChromeTrace(const std::string& fname);
+	void renderImGuiFlameView();
+#endif
+}
+
+#if PROFILER_ENABLED
+#define PROFILER_CONCAT_INTERNAL(a, b) a##b
+#define PROFILER_CONCAT(a, b)          PROFILER_CONCAT_INTERNAL(a, b)
+#define PROFILE_ZONE(name)             profiler::ScopedZone PROFILER_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_THREAD_NAME(name)      profiler::setThreadName(name)
+#define PROFILE_FRAME_MARK()           profiler::markFrame()
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_THREAD_NAME(name)
+#define PROFILE_FRAME_MARK()
+#endif
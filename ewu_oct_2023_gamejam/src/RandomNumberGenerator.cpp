@@ -8,6 +8,11 @@ namespace rng
 {
     std::default_random_engine generator(std::chrono::system_clock::now().time_since_epoch().count());
 
+    void seed(uint32_t seed)
+    {
+        generator.seed(seed);
+    }
+
     float_t randomReal()
     {
         return randomRealRange(0.0f, 1.0f);
@@ -1,9 +1,11 @@
 #pragma once
 #include <cmath>
+#include <cstdint>
 #include <vector>
 
 namespace rng
 {
+    void seed(uint32_t seed);  // Reseeds the generator (e.g. for reproducible runs). Otherwise it's seeded from the clock.
     float_t randomReal();
     float_t randomRealRange(float_t min, float_t max);
     int32_t randomIntegerRange(int32_t min, int32_t max);
@@ -1,17 +1,20 @@
 #include "RenderObject.h"
 
 #include <iostream>
+#include <chrono>
 #include "VkglTFModel.h"
 
 
-bool RenderObjectManager::registerRenderObjects(std::vector<RenderObject> inRenderObjectDatas, std::vector<RenderObject**> outRenderObjectDatas)
+bool RenderObjectManager::registerRenderObjects(const std::vector<RenderObject>& inRenderObjectDatas, const std::vector<RenderObject**>& outRenderObjectDatas)
 {
 	// @NOTE: using a pool system bc of pointers losing information when stuff gets deleted.  -Timo 2022/11/06
 	// @NOTE: I think past me is talking about when a std::vector gets to a certain capacity, it
 	//        has to recreate a new array and insert all of the information into the array. Since
 	//        the array contains information that exists on the stack, it has to get moved, breaking
 	//        pointers and breaking my heart along the way.  -Timo 2023/05/27
-	if (_renderObjectsIndices.size() + inRenderObjectDatas.size() > RENDER_OBJECTS_MAX_CAPACITY)
+	std::lock_guard<std::mutex> lg(renderObjectIndicesAndPoolMutex);
+
+	if (inRenderObjectDatas.size() > _renderObjectsFreeSlots.size())
 	{
 		std::cerr << "[REGISTER RENDER OBJECT]" << std::endl
 			<< "ERROR: trying to register render object when capacity will overflow maximum." << std::endl
@@ -21,23 +24,18 @@ bool RenderObjectManager::registerRenderObjects(std::vector<RenderObject> inRend
 		return false;
 	}
 
-	std::lock_guard<std::mutex> lg(renderObjectIndicesAndPoolMutex);
-
 	// Register each render object in the batch.
 	for (size_t i = 0; i < inRenderObjectDatas.size(); i++)
 	{
-		size_t registerIndex = 0;
-		for (size_t i = 0; i < _renderObjectsIsRegistered.size(); i++)
-		{
-			if (!_renderObjectsIsRegistered[i])
-			{
-				registerIndex = i;
-				break;
-			}
-		}
+		size_t registerIndex = _renderObjectsFreeSlots.back();
+		_renderObjectsFreeSlots.pop_back();
+
+		// Register object
+		RenderObject& renderObjectData = _renderObjectPool[registerIndex];
+		renderObjectData = inRenderObjectDatas[i];
+		_renderObjectsIsRegistered[registerIndex] = true;
 
 		// Calculate instance pointers
-		RenderObject& renderObjectData = inRenderObjectDatas[i];
 		renderObjectData.calculatedModelInstances.clear();
 		auto primitives = renderObjectData.model->getAllPrimitivesInOrder();
 		for (auto& primitive : primitives)
@@ -51,66 +49,64 @@ bool RenderObjectManager::registerRenderObjects(std::vector<RenderObject> inRend
 				.voxelFieldLightingGridID = 0,  // @NOTE: the default lightmap is blank 1.0f with identity transform, so set 0 to use the default lightmap.
 				});
 
-		// Register object
-		_renderObjectPool[registerIndex] = renderObjectData;
-		_renderObjectsIsRegistered[registerIndex] = true;
-		_renderObjectsIndices.push_back(registerIndex);
-
-		*outRenderObjectDatas[i] = &_renderObjectPool[registerIndex];
-	}
+		// Insert next to the other render objects that share its model.
+		insertIntoModelBucket(registerIndex);
 
-	// Sort pool indices so that models are next to each other (helps with model compacting in the rendering stage).
-	std::sort(
-		_renderObjectsIndices.begin(),
-		_renderObjectsIndices.end(),
-		[&](size_t a, size_t b) {
-			return _renderObjectPool[a].model < _renderObjectPool[b].model;
+		if (renderObjectData.animator != nullptr)
+		{
+			_renderObjectsAnimatorIndicesPosition[registerIndex] = _renderObjectsWithAnimatorIndices.size();
+			_renderObjectsWithAnimatorIndices.push_back(registerIndex);
 		}
-	);
+
+		*outRenderObjectDatas[i] = &renderObjectData;
+	}
 
 	for (bool* sendFlag : _sendInstancePtrDataToGPU_refs)
 		*sendFlag = true;
 
-	// Recalculate what indices animated render objects are at
-	recalculateAnimatorIndices();
-
 	return true;
 }
 
-void RenderObjectManager::unregisterRenderObjects(std::vector<RenderObject*> objRegistrations)
+void RenderObjectManager::unregisterRenderObjects(const std::vector<RenderObject*>& objRegistrations)
 {
 	std::lock_guard<std::mutex> lg(renderObjectIndicesAndPoolMutex);
 
 	for (RenderObject* objRegistration : objRegistrations)
 	{
-		// Iterate thru each object registration, unregistering it.
-		bool found = false;
-		size_t indicesIndex = 0;
-		for (size_t poolIndex : _renderObjectsIndices)
+		// Find the pool index straight from the pointer.
+		// @NOTE: range check thru `uintptr_t` first, since subtracting a pointer that isn't in the pool is UB.
+		uintptr_t poolBegin = (uintptr_t)_renderObjectPool.data();
+		uintptr_t objAddress = (uintptr_t)objRegistration;
+		bool isInPool =
+			objAddress >= poolBegin &&
+			objAddress < poolBegin + _renderObjectPool.size() * sizeof(RenderObject) &&
+			(objAddress - poolBegin) % sizeof(RenderObject) == 0;
+		size_t poolIndex = (isInPool ? (size_t)(objRegistration - _renderObjectPool.data()) : 0);
+		if (!isInPool || !_renderObjectsIsRegistered[poolIndex])
 		{
-			auto& rod = _renderObjectPool[poolIndex];
-			if (&rod == objRegistration)
-			{
-				// Unregister object
-				_renderObjectsIsRegistered[poolIndex] = false;
-				_renderObjectsIndices.erase(_renderObjectsIndices.begin() + indicesIndex);
-
-				for (bool* sendFlag : _sendInstancePtrDataToGPU_refs)
-					*sendFlag = true;
-
-				// Recalculate what indices animated render objects are at
-				recalculateAnimatorIndices();
+			std::cerr << "[UNREGISTER RENDER OBJECT]" << std::endl
+				<< "ERROR: render object " << objRegistration << " was not found. Nothing unregistered." << std::endl;
+			continue;
+		}
 
-				found = true;
-				break;
-			}
+		// Unregister object
+		removeFromModelBucket(poolIndex);
 
-			indicesIndex++;
+		if (_renderObjectPool[poolIndex].animator != nullptr)
+		{
+			// Swap-remove from the animator indices.
+			size_t position = _renderObjectsAnimatorIndicesPosition[poolIndex];
+			size_t lastPoolIndex = _renderObjectsWithAnimatorIndices.back();
+			_renderObjectsWithAnimatorIndices[position] = lastPoolIndex;
+			_renderObjectsAnimatorIndicesPosition[lastPoolIndex] = position;
+			_renderObjectsWithAnimatorIndices.pop_back();
 		}
 
-		if (!found)
-			std::cerr << "[UNREGISTER RENDER OBJECT]" << std::endl
-				<< "ERROR: render object " << objRegistration << " was not found. Nothing unregistered." << std::endl;
+		_renderObjectsIsRegistered[poolIndex] = false;
+		_renderObjectsFreeSlots.push_back(poolIndex);
+
+		for (bool* sendFlag : _sendInstancePtrDataToGPU_refs)
+			*sendFlag = true;
 	}
 }
 
@@ -154,7 +150,7 @@ void RenderObjectManager::removeModelCallbacks(void* owner)
 	}
 }
 
-void RenderObjectManager::reloadModelAndTriggerCallbacks(VulkanEngine* engine, const std::string& name, const std::string& modelPath)
+void RenderObjectManager::reloadModelAndTriggerCallbacks(VulkanEngine* engine, const std::string& name, const std::string& modelPath, tinygltf::Model& parsedGltfModel)
 {
 	auto it = _renderObjectModels.find(name);
 	if (it == _renderObjectModels.end())
@@ -167,7 +163,7 @@ void RenderObjectManager::reloadModelAndTriggerCallbacks(VulkanEngine* engine, c
 	// Reload model
 	vkglTF::Model* model = _renderObjectModels[name];
 	model->destroy(_allocator);
-	model->loadFromFile(engine, modelPath);
+	model->loadFromParsedGltf(engine, modelPath, parsedGltfModel);
 
 	// Trigger Model Callbacks
 	for (auto& rc : _renderObjectModelCallbacks[name])
@@ -177,6 +173,13 @@ void RenderObjectManager::reloadModelAndTriggerCallbacks(VulkanEngine* engine, c
 
 RenderObjectManager::RenderObjectManager(VmaAllocator& allocator) : _allocator(allocator)
 {
+	_renderObjectsIsRegistered.fill(false);
+
+	// Fill free list in reverse so that the lowest pool indices get handed out first.
+	_renderObjectsFreeSlots.reserve(RENDER_OBJECTS_MAX_CAPACITY);
+	for (size_t i = RENDER_OBJECTS_MAX_CAPACITY; i > 0; i--)
+		_renderObjectsFreeSlots.push_back(i - 1);
+	_renderObjectsIndices.reserve(RENDER_OBJECTS_MAX_CAPACITY);
 }
 
 RenderObjectManager::~RenderObjectManager()
@@ -186,17 +189,150 @@ RenderObjectManager::~RenderObjectManager()
 	delete[] _renderObjectLayersEnabled;
 }
 
-void RenderObjectManager::recalculateAnimatorIndices()
+void RenderObjectManager::insertIntoModelBucket(size_t poolIndex)
 {
-	_renderObjectsWithAnimatorIndices.clear();
-	for (size_t poolIndex : _renderObjectsIndices)
+	vkglTF::Model* model = _renderObjectPool[poolIndex].model;
+	auto it = _modelToBucketIndex.find(model);
+	if (it == _modelToBucketIndex.end())
 	{
-		if (_renderObjectPool[poolIndex].animator == nullptr)
-			continue;
+		// New model goes at the very end.
+		_modelBuckets.push_back({
+			.model = model,
+			.start = _renderObjectsIndices.size(),
+			.count = 0,
+			});
+		it = _modelToBucketIndex.emplace(model, _modelBuckets.size() - 1).first;
+	}
+	size_t bucketIndex = it->second;
+
+	// Open up a hole at the end of the target bucket by moving the first
+	// index of every following bucket to that bucket's end.
+	size_t hole = _renderObjectsIndices.size();
+	_renderObjectsIndices.push_back(0);
+	for (size_t i = _modelBuckets.size() - 1; i > bucketIndex; i--)
+	{
+		ModelBucket& mb = _modelBuckets[i];
+		if (mb.count > 0)
+		{
+			size_t movedPoolIndex = _renderObjectsIndices[mb.start];
+			_renderObjectsIndices[hole] = movedPoolIndex;
+			_renderObjectsIndicesPosition[movedPoolIndex] = hole;
+			hole = mb.start;
+		}
+		mb.start++;
+	}
+
+	_renderObjectsIndices[hole] = poolIndex;
+	_renderObjectsIndicesPosition[poolIndex] = hole;
+	_renderObjectsBucketIndex[poolIndex] = bucketIndex;
+	_modelBuckets[bucketIndex].count++;
+}
+
+void RenderObjectManager::removeFromModelBucket(size_t poolIndex)
+{
+	size_t bucketIndex = _renderObjectsBucketIndex[poolIndex];
+	ModelBucket& target = _modelBuckets[bucketIndex];
+
+	// Swap-remove inside the bucket.
+	size_t position = _renderObjectsIndicesPosition[poolIndex];
+	size_t hole = target.start + target.count - 1;
+	size_t lastPoolIndex = _renderObjectsIndices[hole];
+	_renderObjectsIndices[position] = lastPoolIndex;
+	_renderObjectsIndicesPosition[lastPoolIndex] = position;
+	target.count--;
+
+	// Close the hole by moving the last index of every following bucket to its front.
+	for (size_t i = bucketIndex + 1; i < _modelBuckets.size(); i++)
+	{
+		ModelBucket& mb = _modelBuckets[i];
+		if (mb.count > 0)
+		{
+			size_t last = mb.start + mb.count - 1;
+			size_t movedPoolIndex = _renderObjectsIndices[last];
+			_renderObjectsIndices[hole] = movedPoolIndex;
+			_renderObjectsIndicesPosition[movedPoolIndex] = hole;
+			hole = last;
+		}
+		mb.start--;
+	}
+
+	_renderObjectsIndices.pop_back();
+
+	// Drop the bucket once its model has nothing left (e.g. the old model after a hot-reload),
+	// so the buckets don't keep piling up.
+	if (_modelBuckets[bucketIndex].count == 0)
+	{
+		_modelToBucketIndex.erase(_modelBuckets[bucketIndex].model);
+		_modelBuckets.erase(_modelBuckets.begin() + bucketIndex);
+		for (size_t i = bucketIndex; i < _modelBuckets.size(); i++)
+		{
+			ModelBucket& mb = _modelBuckets[i];
+			_modelToBucketIndex[mb.model] = i;
+			for (size_t j = mb.start; j < mb.start + mb.count; j++)
+				_renderObjectsBucketIndex[_renderObjectsIndices[j]] = i;
+		}
+	}
+}
+
+#ifdef _DEVELOP
+void RenderObjectManager::benchmarkRegistration()
+{
+	constexpr size_t numObjects = RENDER_OBJECTS_MAX_CAPACITY;
+	constexpr size_t numModels = 16;
+	using Clock = std::chrono::high_resolution_clock;
+	auto msSince = [](Clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	};
+
+	// @NOTE: the models are empty (no primitives), since only the bookkeeping is getting timed.
+	VmaAllocator allocator = VK_NULL_HANDLE;
+	RenderObjectManager* manager = new RenderObjectManager(allocator);  // On the heap, since the pools are huge.
+	vkglTF::Model* models = new vkglTF::Model[numModels];
+
+	std::vector<RenderObject> renderObjects(numObjects);
+	for (size_t i = 0; i < numObjects; i++)
+		renderObjects[i].model = &models[(i * 7) % numModels];  // Interleaved, so most inserts land in the middle.
+	std::vector<RenderObject*> registered(numObjects, nullptr);
+
+	std::cout << "[BENCHMARK RENDER OBJECTS]" << std::endl
+		<< "Registering and unregistering " << numObjects << " render objects (one at a time) across " << numModels << " models" << std::endl;
+
+	// Register one at a time, like entities do.
+	auto start = Clock::now();
+	for (size_t i = 0; i < numObjects; i++)
+		manager->registerRenderObjects({ renderObjects[i] }, { &registered[i] });
+	double registerMS = msSince(start);
 
-		_renderObjectsWithAnimatorIndices.push_back(poolIndex);
+	// Check that the indices stayed grouped by model.
+	bool grouped = (manager->_renderObjectsIndices.size() == numObjects);
+	for (size_t i = 0; i < manager->_modelBuckets.size(); i++)
+	{
+		const ModelBucket& mb = manager->_modelBuckets[i];
+		for (size_t j = mb.start; j < mb.start + mb.count; j++)
+		{
+			size_t poolIndex = manager->_renderObjectsIndices[j];
+			grouped &= (manager->_renderObjectPool[poolIndex].model == mb.model &&
+				manager->_renderObjectsIndicesPosition[poolIndex] == j &&
+				manager->_renderObjectsBucketIndex[poolIndex] == i);
+		}
 	}
+
+	// Unregister in a scattered order (7919 is prime, so this visits every object once).
+	start = Clock::now();
+	for (size_t i = 0; i < numObjects; i++)
+		manager->unregisterRenderObjects({ registered[(i * 7919) % numObjects] });
+	double unregisterMS = msSince(start);
+
+	bool emptied = (manager->_renderObjectsIndices.empty() && manager->_modelBuckets.empty() && manager->_modelToBucketIndex.empty());
+
+	std::cout << "Register:   " << registerMS << " ms (" << (registerMS * 1000.0 / numObjects) << " us each)" << std::endl
+		<< "Unregister: " << unregisterMS << " ms (" << (unregisterMS * 1000.0 / numObjects) << " us each)" << std::endl
+		<< "Grouped by model: " << (grouped ? "YES" : "NO") << "  Buckets emptied: " << (emptied ? "YES" : "NO") << std::endl;
+
+	delete manager;
+	delete[] models;
 }
+#endif
 
 void RenderObjectManager::updateAnimators(const float_t& deltaTime)
 {
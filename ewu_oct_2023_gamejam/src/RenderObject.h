@@ -11,6 +11,7 @@
 #include "Settings.h"
 
 namespace vkglTF { struct Model; struct Animator; }
+namespace tinygltf { class Model; }
 
 #ifdef _DEVELOP
 class VulkanEngine;
@@ -43,17 +44,21 @@ struct RenderObject
 class RenderObjectManager
 {
 public:
-	bool registerRenderObjects(std::vector<RenderObject> inRenderObjectDatas, std::vector<RenderObject**> outRenderObjectDatas);
-	void unregisterRenderObjects(std::vector<RenderObject*> objRegistrations);
+	bool registerRenderObjects(const std::vector<RenderObject>& inRenderObjectDatas, const std::vector<RenderObject**>& outRenderObjectDatas);
+	void unregisterRenderObjects(const std::vector<RenderObject*>& objRegistrations);
 
 #ifdef _DEVELOP
 	vkglTF::Model* getModel(const std::string& name, void* owner, std::function<void()>&& reloadCallback);  // This is to support model hot-reloading via a callback lambda
 	void           removeModelCallbacks(void* owner);
-	void           reloadModelAndTriggerCallbacks(VulkanEngine* engine, const std::string& name, const std::string& modelPath);
+	void           reloadModelAndTriggerCallbacks(VulkanEngine* engine, const std::string& name, const std::string& modelPath, tinygltf::Model& parsedGltfModel);
 #else
 	vkglTF::Model* getModel(const std::string& name);
 #endif
 
+#ifdef _DEVELOP
+	static void benchmarkRegistration();
+#endif
+
 private:
 	RenderObjectManager(VmaAllocator& allocator);
 	~RenderObjectManager();
@@ -62,11 +67,28 @@ private:
 
 	std::vector<bool*> _sendInstancePtrDataToGPU_refs;
 
-	std::vector<size_t> _renderObjectsWithAnimatorIndices;
-	void recalculateAnimatorIndices();
+	std::vector<size_t>                                   _renderObjectsWithAnimatorIndices;
+	std::array<size_t,       RENDER_OBJECTS_MAX_CAPACITY> _renderObjectsAnimatorIndicesPosition;  // Where each pool index lives inside `_renderObjectsWithAnimatorIndices` (for swap-removing).
 	void updateAnimators(const float_t& deltaTime);
 
+	// @NOTE: `_renderObjectsIndices` is kept grouped by model (helps with model compacting in the rendering stage).
+	//        Each model owns a contiguous window (bucket) of the indices, so inserting/removing only has to shuffle
+	//        one index per bucket instead of re-sorting the whole list.
+	struct ModelBucket
+	{
+		vkglTF::Model* model;
+		size_t start;
+		size_t count;
+	};
+	std::vector<ModelBucket>                              _modelBuckets;
+	std::unordered_map<vkglTF::Model*, size_t>            _modelToBucketIndex;
+	std::array<size_t,       RENDER_OBJECTS_MAX_CAPACITY> _renderObjectsBucketIndex;              // Which bucket each registered pool index is in.
+	std::array<size_t,       RENDER_OBJECTS_MAX_CAPACITY> _renderObjectsIndicesPosition;          // Where each registered pool index lives inside `_renderObjectsIndices`.
+	void insertIntoModelBucket(size_t poolIndex);
+	void removeFromModelBucket(size_t poolIndex);
+
 	std::vector<size_t>                                   _renderObjectsIndices;
+	std::vector<size_t>                                   _renderObjectsFreeSlots;  // Free list of pool indices. Lowest index gets popped off first.
     std::array<bool,         RENDER_OBJECTS_MAX_CAPACITY> _renderObjectsIsRegistered;  // @NOTE: this will be filled with `false` on init  (https://stackoverflow.com/questions/67648693/safely-initializing-a-stdarray-of-bools)
     std::array<RenderObject, RENDER_OBJECTS_MAX_CAPACITY> _renderObjectPool;
 	bool*                                                 _renderObjectLayersEnabled = new bool[] { true, false, false };
@@ -16,9 +16,11 @@ constexpr uint32_t SHADOWMAP_JITTERMAP_DIMENSION_Y = 144;
 constexpr uint32_t SHADOWMAP_JITTERMAP_DIMENSION_Z = 4 / 2;  // 2x2 samples (??ms on 2080 Ti)    @NOTE: I think the smaller the better, and then just using a shadow denoiser is the best thing to do. Spending 1.0ms on shadow "PCF+" rendering is NG, I believe.  -Timo 2023/10/09
 
 constexpr unsigned int FRAME_OVERLAP = 2;
+constexpr size_t FRAME_ARENA_CAPACITY = 4 * 1024 * 1024;  // Per frame in flight. See `FrameArena.h`.
 
 constexpr size_t RENDER_OBJECTS_MAX_CAPACITY = 10000;
 constexpr size_t INSTANCE_PTR_MAX_CAPACITY   = 100000;
+constexpr size_t MAX_NUM_PRESKINNED_VERTICES = 262144;  // Per frame in flight (32 bytes each). See `skinning.comp`.
 
 constexpr size_t MAX_NUM_MAPS = 128;
 constexpr size_t MAX_NUM_VOXEL_FIELD_LIGHTMAPS = 8;
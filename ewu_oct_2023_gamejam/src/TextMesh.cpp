@@ -288,8 +288,12 @@ namespace textmesh
 	{
 		TypeFace& tf = *tm.typeFace;
 
-		std::vector<Vertex> vertices;
-		std::vector<uint32_t> indices;
+		// @NOTE: only ever called from `INTERNALprocessChangeQueue()` on the main thread, so the frame arena is fine.
+		FrameArena& arena = engine->getCurrentFrameArena();
+		FrameVector<Vertex> vertices{ FrameArenaAllocator<Vertex>(arena) };
+		FrameVector<uint32_t> indices{ FrameArenaAllocator<uint32_t>(arena) };
+		vertices.reserve(text.size() * 4);
+		indices.reserve(text.size() * 6);
 		uint32_t indexOffset = 0;
 
 		float_t w = tf.textureSize[0];
@@ -0,0 +1,1323 @@
+#include "TextureCooker.h"
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stb_image.h>
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/for_each.hpp>
+#include "Profiler.h"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define TEXTURECOOKER_SSE 1
+#else
+#define TEXTURECOOKER_SSE 0
+#endif
+
+
+namespace texturecooker
+{
+	//
+	// 4-wide float helpers (one RGBA pixel per register)
+	//
+	struct Float4
+	{
+#if TEXTURECOOKER_SSE
+		__m128 v;
+#else
+		float v[4];
+#endif
+	};
+
+	inline Float4 f4Zero()
+	{
+#if TEXTURECOOKER_SSE
+		return { _mm_setzero_ps() };
+#else
+		return { { 0.0f, 0.0f, 0.0f, 0.0f } };
+#endif
+	}
+
+	inline Float4 f4Load(const float* src)
+	{
+#if TEXTURECOOKER_SSE
+		return { _mm_loadu_ps(src) };
+#else
+		return { { src[0], src[1], src[2], src[3] } };
+#endif
+	}
+
+	inline void f4Store(float* dst, Float4 a)
+	{
+#if TEXTURECOOKER_SSE
+		_mm_storeu_ps(dst, a.v);
+#else
+		memcpy(dst, a.v, sizeof(float) * 4);
+#endif
+	}
+
+	inline Float4 f4Add(Float4 a, Float4 b)
+	{
+#if TEXTURECOOKER_SSE
+		return { _mm_add_ps(a.v, b.v) };
+#else
+		return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+#endif
+	}
+
+	inline Float4 f4MulAdd(Float4 acc, Float4 a, float s)
+	{
+#if TEXTURECOOKER_SSE
+		return { _mm_add_ps(acc.v, _mm_mul_ps(a.v, _mm_set1_ps(s))) };
+#else
+		return { { acc.v[0] + a.v[0] * s, acc.v[1] + a.v[1] * s, acc.v[2] + a.v[2] * s, acc.v[3] + a.v[3] * s } };
+#endif
+	}
+
+	inline Float4 f4Scale(Float4 a, float s)
+	{
+		return f4MulAdd(f4Zero(), a, s);
+	}
+
+	//
+	// Color space
+	//
+	float srgbToLinear(float c)
+	{
+		return (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+	}
+
+	float linearToSrgb(float c)
+	{
+		return (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+	}
+
+	uint8_t floatToUnorm8(float c)
+	{
+		return (uint8_t)std::clamp((int32_t)std::lround(c * 255.0f), 0, 255);
+	}
+
+	void rgba8ToLinearPremultiplied(const uint8_t* rgba, size_t numPixels, bool isSRGB, std::vector<float>& outPixels)
+	{
+		float toLinear[256];
+		for (int32_t i = 0; i < 256; i++)
+			toLinear[i] = isSRGB ? srgbToLinear(i / 255.0f) : i / 255.0f;
+
+		outPixels.resize(numPixels * 4);
+		for (size_t i = 0; i < numPixels; i++)
+		{
+			float a = rgba[i * 4 + 3] / 255.0f;
+			outPixels[i * 4 + 0] = toLinear[rgba[i * 4 + 0]] * a;
+			outPixels[i * 4 + 1] = toLinear[rgba[i * 4 + 1]] * a;
+			outPixels[i * 4 + 2] = toLinear[rgba[i * 4 + 2]] * a;
+			outPixels[i * 4 + 3] = a;
+		}
+	}
+
+	void linearPremultipliedToRGBA8(const std::vector<float>& pixels, bool isSRGB, std::vector<uint8_t>& outRGBA)
+	{
+		size_t numPixels = pixels.size() / 4;
+		outRGBA.resize(numPixels * 4);
+		for (size_t i = 0; i < numPixels; i++)
+		{
+			float a = std::clamp(pixels[i * 4 + 3], 0.0f, 1.0f);
+			for (size_t c = 0; c < 3; c++)
+			{
+				float value = (a > 0.0f) ? std::clamp(pixels[i * 4 + c] / a, 0.0f, 1.0f) : 0.0f;
+				outRGBA[i * 4 + c] = floatToUnorm8(isSRGB ? linearToSrgb(value) : value);
+			}
+			outRGBA[i * 4 + 3] = floatToUnorm8(a);
+		}
+	}
+
+	//
+	// Resampling
+	//
+	struct FilterTap
+	{
+		uint32_t index;
+		float weight;
+	};
+
+	double besselI0(double x)
+	{
+		double sum = 1.0;
+		double term = 1.0;
+		for (int32_t k = 1; k < 32; k++)
+		{
+			term *= (x / (2.0 * k)) * (x / (2.0 * k));
+			sum += term;
+			if (term < sum * 1e-12)
+				break;
+		}
+		return sum;
+	}
+
+	float kaiserWeight(double d)
+	{
+		constexpr double KAISER_RADIUS = 3.0;  // In destination pixels.
+		constexpr double KAISER_ALPHA  = 4.0;
+		constexpr double PI = 3.14159265358979323846;
+		if (std::abs(d) >= KAISER_RADIUS)
+			return 0.0f;
+
+		double sinc = (d == 0.0) ? 1.0 : std::sin(PI * d) / (PI * d);
+		double x = d / KAISER_RADIUS;
+		double window = besselI0(KAISER_ALPHA * std::sqrt(1.0 - x * x)) / besselI0(KAISER_ALPHA);
+		return (float)(sinc * window);
+	}
+
+	// Taps for each destination pixel along one axis (normalized, edge clamped).
+	void calculateFilterTaps(uint32_t srcSize, uint32_t dstSize, MipFilter filter, std::vector<std::vector<FilterTap>>& outTaps)
+	{
+		double scale = (double)srcSize / (double)dstSize;
+		double support = (filter == MipFilter::BOX) ? scale * 0.5 : scale * 3.0;
+
+		outTaps.resize(dstSize);
+		for (uint32_t i = 0; i < dstSize; i++)
+		{
+			double center = (i + 0.5) * scale;
+			int64_t first = (int64_t)std::floor(center - support);
+			int64_t last  = (int64_t)std::ceil(center + support);
+
+			std::vector<FilterTap>& taps = outTaps[i];
+			taps.clear();
+			float weightSum = 0.0f;
+			for (int64_t j = first; j <= last; j++)
+			{
+				float weight;
+				if (filter == MipFilter::BOX)
+				{
+					// Coverage of the source pixel by the destination pixel's footprint.
+					double overlap = std::min((double)j + 1.0, center + support) - std::max((double)j, center - support);
+					weight = (float)std::max(0.0, overlap);
+				}
+				else
+					weight = kaiserWeight(((double)j + 0.5 - center) / scale);
+
+				if (weight == 0.0f)
+					continue;
+
+				taps.push_back({ (uint32_t)std::clamp<int64_t>(j, 0, (int64_t)srcSize - 1), weight });
+				weightSum += weight;
+			}
+
+			for (FilterTap& tap : taps)
+				tap.weight /= weightSum;
+		}
+	}
+
+	void downsample(const std::vector<float>& src, uint32_t srcWidth, uint32_t srcHeight, uint32_t dstWidth, uint32_t dstHeight, MipFilter filter, std::vector<float>& outDst)
+	{
+		outDst.assign((size_t)dstWidth * dstHeight * 4, 0.0f);
+
+		if (filter == MipFilter::BOX && srcWidth == dstWidth * 2 && srcHeight == dstHeight * 2)
+		{
+			// Fast path: exact 2x2 average.
+			for (uint32_t y = 0; y < dstHeight; y++)
+			{
+				const float* row0 = &src[(size_t)(y * 2 + 0) * srcWidth * 4];
+				const float* row1 = &src[(size_t)(y * 2 + 1) * srcWidth * 4];
+				float* dstRow = &outDst[(size_t)y * dstWidth * 4];
+				for (uint32_t x = 0; x < dstWidth; x++)
+				{
+					Float4 sum = f4Add(
+						f4Add(f4Load(row0 + x * 8), f4Load(row0 + x * 8 + 4)),
+						f4Add(f4Load(row1 + x * 8), f4Load(row1 + x * 8 + 4)));
+					f4Store(dstRow + x * 4, f4Scale(sum, 0.25f));
+				}
+			}
+			return;
+		}
+
+		// Separable: horizontal into `temp`, then vertical into `outDst`.
+		std::vector<std::vector<FilterTap>> tapsX, tapsY;
+		calculateFilterTaps(srcWidth, dstWidth, filter, tapsX);
+		calculateFilterTaps(srcHeight, dstHeight, filter, tapsY);
+
+		std::vector<float> temp((size_t)dstWidth * srcHeight * 4);
+		for (uint32_t y = 0; y < srcHeight; y++)
+		{
+			const float* srcRow = &src[(size_t)y * srcWidth * 4];
+			for (uint32_t x = 0; x < dstWidth; x++)
+			{
+				Float4 acc = f4Zero();
+				for (const FilterTap& tap : tapsX[x])
+					acc = f4MulAdd(acc, f4Load(srcRow + tap.index * 4), tap.weight);
+				f4Store(&temp[((size_t)y * dstWidth + x) * 4], acc);
+			}
+		}
+
+		for (uint32_t y = 0; y < dstHeight; y++)
+			for (uint32_t x = 0; x < dstWidth; x++)
+			{
+				Float4 acc = f4Zero();
+				for (const FilterTap& tap : tapsY[y])
+					acc = f4MulAdd(acc, f4Load(&temp[((size_t)tap.index * dstWidth + x) * 4]), tap.weight);
+				f4Store(&outDst[((size_t)y * dstWidth + x) * 4], acc);
+			}
+	}
+
+	void generateMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, bool isSRGB, MipFilter filter, std::vector<std::vector<uint8_t>>& outLevels)
+	{
+		outLevels.clear();
+		outLevels.emplace_back(rgba, rgba + (size_t)width * height * 4);
+
+		std::vector<float> current;
+		rgba8ToLinearPremultiplied(rgba, (size_t)width * height, isSRGB, current);
+
+		std::vector<float> next;
+		while (width > 1 || height > 1)
+		{
+			uint32_t nextWidth  = std::max(1u, width / 2);
+			uint32_t nextHeight = std::max(1u, height / 2);
+
+			// @NOTE: each level gets filtered from the previous float level, so there's no requantization buildup.
+			downsample(current, width, height, nextWidth, nextHeight, filter, next);
+			std::swap(current, next);
+			width = nextWidth;
+			height = nextHeight;
+
+			outLevels.emplace_back();
+			linearPremultipliedToRGBA8(current, isSRGB, outLevels.back());
+		}
+	}
+
+	//
+	// Block compression helpers
+	//
+	void fetchBlock(const uint8_t* rgba, uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t outBlock[64])
+	{
+		// @NOTE: partial blocks on the right/bottom edges replicate the last pixel.
+		for (uint32_t y = 0; y < 4; y++)
+			for (uint32_t x = 0; x < 4; x++)
+			{
+				uint32_t srcX = std::min(blockX * 4 + x, width - 1);
+				uint32_t srcY = std::min(blockY * 4 + y, height - 1);
+				memcpy(&outBlock[(y * 4 + x) * 4], &rgba[((size_t)srcY * width + srcX) * 4], 4);
+			}
+	}
+
+	void storeBlock(const uint8_t block[64], uint32_t width, uint32_t height, uint32_t blockX, uint32_t blockY, uint8_t* outRGBA)
+	{
+		for (uint32_t y = 0; y < 4; y++)
+			for (uint32_t x = 0; x < 4; x++)
+			{
+				uint32_t dstX = blockX * 4 + x;
+				uint32_t dstY = blockY * 4 + y;
+				if (dstX < width && dstY < height)
+					memcpy(&outRGBA[((size_t)dstY * width + dstX) * 4], &block[(y * 4 + x) * 4], 4);
+			}
+	}
+
+	// Principal axis of the block's colors (first `numChannels` channels) and the mean.
+	void calculatePrincipalAxis(const float pixels[16][4], uint32_t numChannels, float outMean[4], float outAxis[4])
+	{
+		for (uint32_t c = 0; c < 4; c++)
+			outMean[c] = outAxis[c] = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+			for (uint32_t c = 0; c < numChannels; c++)
+				outMean[c] += pixels[i][c] / 16.0f;
+
+		float covariance[4][4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+			for (uint32_t a = 0; a < numChannels; a++)
+				for (uint32_t b = 0; b < numChannels; b++)
+					covariance[a][b] += (pixels[i][a] - outMean[a]) * (pixels[i][b] - outMean[b]);
+
+		// Power iteration.
+		float axis[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+		for (uint32_t iteration = 0; iteration < 8; iteration++)
+		{
+			float next[4] = {};
+			float length = 0.0f;
+			for (uint32_t a = 0; a < numChannels; a++)
+			{
+				for (uint32_t b = 0; b < numChannels; b++)
+					next[a] += covariance[a][b] * axis[b];
+				length += next[a] * next[a];
+			}
+			length = std::sqrt(length);
+			if (length < 1e-6f)
+				break;
+			for (uint32_t a = 0; a < numChannels; a++)
+				axis[a] = next[a] / length;
+		}
+		for (uint32_t c = 0; c < numChannels; c++)
+			outAxis[c] = axis[c];
+	}
+
+	// Endpoints along the principal axis that cover all of the block's projections.
+	void calculateAxisEndpoints(const float pixels[16][4], uint32_t numChannels, float outEndpoint0[4], float outEndpoint1[4])
+	{
+		float mean[4], axis[4];
+		calculatePrincipalAxis(pixels, numChannels, mean, axis);
+
+		float minT = std::numeric_limits<float>::max();
+		float maxT = -std::numeric_limits<float>::max();
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float t = 0.0f;
+			for (uint32_t c = 0; c < numChannels; c++)
+				t += (pixels[i][c] - mean[c]) * axis[c];
+			minT = std::min(minT, t);
+			maxT = std::max(maxT, t);
+		}
+
+		for (uint32_t c = 0; c < numChannels; c++)
+		{
+			outEndpoint0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			outEndpoint1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+		}
+	}
+
+	// Least squares endpoints for a fixed set of interpolation weights (0 = endpoint0, 1 = endpoint1).
+	bool refineEndpointsLeastSquares(const float pixels[16][4], uint32_t numChannels, const float weights[16], float outEndpoint0[4], float outEndpoint1[4])
+	{
+		float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+		float ap[4] = {}, bp[4] = {};
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float a = 1.0f - weights[i];
+			float b = weights[i];
+			aa += a * a;
+			ab += a * b;
+			bb += b * b;
+			for (uint32_t c = 0; c < numChannels; c++)
+			{
+				ap[c] += a * pixels[i][c];
+				bp[c] += b * pixels[i][c];
+			}
+		}
+
+		float determinant = aa * bb - ab * ab;
+		if (std::abs(determinant) < 1e-6f)
+			return false;
+
+		for (uint32_t c = 0; c < numChannels; c++)
+		{
+			outEndpoint0[c] = std::clamp((ap[c] * bb - bp[c] * ab) / determinant, 0.0f, 255.0f);
+			outEndpoint1[c] = std::clamp((bp[c] * aa - ap[c] * ab) / determinant, 0.0f, 255.0f);
+		}
+		return true;
+	}
+
+	//
+	// BC1
+	//
+	uint16_t packRGB565(const float color[4])
+	{
+		uint16_t r = (uint16_t)std::lround(color[0] * 31.0f / 255.0f);
+		uint16_t g = (uint16_t)std::lround(color[1] * 63.0f / 255.0f);
+		uint16_t b = (uint16_t)std::lround(color[2] * 31.0f / 255.0f);
+		return (uint16_t)((r << 11) | (g << 5) | b);
+	}
+
+	void unpackRGB565(uint16_t packed, int32_t outColor[3])
+	{
+		int32_t r = (packed >> 11) & 31;
+		int32_t g = (packed >> 5) & 63;
+		int32_t b = packed & 31;
+		outColor[0] = (r << 3) | (r >> 2);
+		outColor[1] = (g << 2) | (g >> 4);
+		outColor[2] = (b << 3) | (b >> 2);
+	}
+
+	void calculateBC1Palette(uint16_t color0, uint16_t color1, bool forceFourColor, int32_t outPalette[4][3])
+	{
+		unpackRGB565(color0, outPalette[0]);
+		unpackRGB565(color1, outPalette[1]);
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			if (color0 > color1 || forceFourColor)
+			{
+				outPalette[2][c] = (2 * outPalette[0][c] + outPalette[1][c]) / 3;
+				outPalette[3][c] = (outPalette[0][c] + 2 * outPalette[1][c]) / 3;
+			}
+			else
+			{
+				outPalette[2][c] = (outPalette[0][c] + outPalette[1][c]) / 2;
+				outPalette[3][c] = 0;
+			}
+		}
+	}
+
+	// Returns the squared error. Always uses the 4 color mode (which is also how BC3 reads it).
+	float encodeBC1Colors(const float pixels[16][4], const float endpoint0[4], const float endpoint1[4], uint8_t outBlock[8])
+	{
+		uint16_t color0 = packRGB565(endpoint0);
+		uint16_t color1 = packRGB565(endpoint1);
+		if (color0 < color1)
+			std::swap(color0, color1);
+
+		int32_t palette[4][3];
+		calculateBC1Palette(color0, color1, true, palette);
+
+		uint32_t indices = 0;
+		float totalError = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			uint32_t bestIndex = 0;
+			float bestError = std::numeric_limits<float>::max();
+			for (uint32_t p = 0; p < (color0 == color1 ? 1u : 4u); p++)
+			{
+				float error = 0.0f;
+				for (uint32_t c = 0; c < 3; c++)
+					error += (pixels[i][c] - palette[p][c]) * (pixels[i][c] - palette[p][c]);
+				if (error < bestError)
+				{
+					bestError = error;
+					bestIndex = p;
+				}
+			}
+			indices |= bestIndex << (i * 2);
+			totalError += bestError;
+		}
+
+		outBlock[0] = (uint8_t)(color0 & 0xFF);
+		outBlock[1] = (uint8_t)(color0 >> 8);
+		outBlock[2] = (uint8_t)(color1 & 0xFF);
+		outBlock[3] = (uint8_t)(color1 >> 8);
+		memcpy(&outBlock[4], &indices, 4);
+		return totalError;
+	}
+
+	void encodeBC1Block(const uint8_t block[64], uint8_t outBlock[8])
+	{
+		float pixels[16][4];
+		for (uint32_t i = 0; i < 16; i++)
+			for (uint32_t c = 0; c < 4; c++)
+				pixels[i][c] = block[i * 4 + c];
+
+		float endpoint0[4], endpoint1[4];
+		calculateAxisEndpoints(pixels, 3, endpoint0, endpoint1);
+		float error = encodeBC1Colors(pixels, endpoint0, endpoint1, outBlock);
+
+		// One round of least squares refinement off of the chosen indices.
+		constexpr float BC1_INDEX_WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+		uint32_t indices;
+		memcpy(&indices, &outBlock[4], 4);
+		float weights[16];
+		for (uint32_t i = 0; i < 16; i++)
+			weights[i] = BC1_INDEX_WEIGHTS[(indices >> (i * 2)) & 3];
+
+		if (refineEndpointsLeastSquares(pixels, 3, weights, endpoint0, endpoint1))
+		{
+			uint8_t refinedBlock[8];
+			if (encodeBC1Colors(pixels, endpoint0, endpoint1, refinedBlock) < error)
+				memcpy(outBlock, refinedBlock, 8);
+		}
+	}
+
+	void decodeBC1Block(const uint8_t block[8], bool forceFourColor, uint8_t outBlock[64])
+	{
+		uint16_t color0 = (uint16_t)(block[0] | (block[1] << 8));
+		uint16_t color1 = (uint16_t)(block[2] | (block[3] << 8));
+		uint32_t indices;
+		memcpy(&indices, &block[4], 4);
+
+		int32_t palette[4][3];
+		calculateBC1Palette(color0, color1, forceFourColor, palette);
+
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			uint32_t index = (indices >> (i * 2)) & 3;
+			for (uint32_t c = 0; c < 3; c++)
+				outBlock[i * 4 + c] = (uint8_t)palette[index][c];
+			outBlock[i * 4 + 3] = (!forceFourColor && color0 <= color1 && index == 3) ? 0 : 255;
+		}
+	}
+
+	//
+	// BC4 (also the alpha half of BC3)
+	//
+	void encodeBC4Block(const uint8_t block[64], uint32_t channel, uint8_t outBlock[8])
+	{
+		uint8_t minValue = 255, maxValue = 0;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			minValue = std::min(minValue, block[i * 4 + channel]);
+			maxValue = std::max(maxValue, block[i * 4 + channel]);
+		}
+
+		// 8 value mode (endpoint0 > endpoint1). Palette is e0, e1, then 6 steps from e0 to e1.
+		uint64_t bits = (uint64_t)maxValue | ((uint64_t)minValue << 8);
+		if (maxValue != minValue)
+		{
+			int32_t palette[8] = { maxValue, minValue };
+			for (int32_t i = 1; i <= 6; i++)
+				palette[i + 1] = ((7 - i) * maxValue + i * minValue) / 7;
+
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				int32_t value = block[i * 4 + channel];
+				uint64_t bestIndex = 0;
+				int32_t bestError = std::numeric_limits<int32_t>::max();
+				for (uint32_t p = 0; p < 8; p++)
+				{
+					int32_t error = std::abs(value - palette[p]);
+					if (error < bestError)
+					{
+						bestError = error;
+						bestIndex = p;
+					}
+				}
+				bits |= bestIndex << (16 + i * 3);
+			}
+		}
+
+		for (uint32_t b = 0; b < 8; b++)
+			outBlock[b] = (uint8_t)(bits >> (b * 8));
+	}
+
+	void decodeBC4Block(const uint8_t block[8], uint32_t channel, uint8_t outBlock[64])
+	{
+		uint64_t bits = 0;
+		for (uint32_t b = 0; b < 8; b++)
+			bits |= (uint64_t)block[b] << (b * 8);
+
+		int32_t endpoint0 = block[0];
+		int32_t endpoint1 = block[1];
+		int32_t palette[8] = { endpoint0, endpoint1 };
+		if (endpoint0 > endpoint1)
+		{
+			for (int32_t i = 1; i <= 6; i++)
+				palette[i + 1] = ((7 - i) * endpoint0 + i * endpoint1) / 7;
+		}
+		else
+		{
+			for (int32_t i = 1; i <= 4; i++)
+				palette[i + 1] = ((5 - i) * endpoint0 + i * endpoint1) / 5;
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+
+		for (uint32_t i = 0; i < 16; i++)
+			outBlock[i * 4 + channel] = (uint8_t)palette[(bits >> (16 + i * 3)) & 7];
+	}
+
+	//
+	// BC7 (single subset modes only)
+	//   Mode 5: RGB 7.7.7 + A 8 endpoints, separate 2-bit color and alpha indices (no rotation).
+	//   Mode 6: RGBA 7.7.7.7 endpoints + unique p-bits, 4-bit indices.
+	//
+	constexpr int32_t BC7_WEIGHTS2[4]  = { 0, 21, 43, 64 };
+	constexpr int32_t BC7_WEIGHTS4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	inline int32_t bc7Interpolate(int32_t e0, int32_t e1, int32_t weight)
+	{
+		return ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+	}
+
+	struct BitWriter
+	{
+		uint64_t words[2] = { 0, 0 };
+		uint32_t position = 0;
+
+		void write(uint64_t value, uint32_t numBits)
+		{
+			for (uint32_t i = 0; i < numBits; i++, position++)
+				words[position / 64] |= ((value >> i) & 1ull) << (position % 64);
+		}
+	};
+
+	struct BitReader
+	{
+		uint64_t words[2] = { 0, 0 };
+		uint32_t position = 0;
+
+		uint32_t read(uint32_t numBits)
+		{
+			uint32_t value = 0;
+			for (uint32_t i = 0; i < numBits; i++, position++)
+				value |= (uint32_t)((words[position / 64] >> (position % 64)) & 1ull) << i;
+			return value;
+		}
+	};
+
+	// Picks the 7-bit values + p-bit that land closest to `endpoint` once expanded.
+	void quantizeBC7Mode6Endpoint(const float endpoint[4], uint32_t outValues[4], uint32_t& outPBit)
+	{
+		float bestError = std::numeric_limits<float>::max();
+		for (uint32_t p = 0; p < 2; p++)
+		{
+			uint32_t values[4];
+			float error = 0.0f;
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				values[c] = (uint32_t)std::clamp((int32_t)std::lround((endpoint[c] - p) / 2.0f), 0, 127);
+				float expanded = (float)((values[c] << 1) | p);
+				error += (expanded - endpoint[c]) * (expanded - endpoint[c]);
+			}
+			if (error < bestError)
+			{
+				bestError = error;
+				memcpy(outValues, values, sizeof(values));
+				outPBit = p;
+			}
+		}
+	}
+
+	// Returns the squared error.
+	float encodeBC7Mode6(const float pixels[16][4], const float endpoint0[4], const float endpoint1[4], uint8_t outBlock[16], uint32_t outIndices[16])
+	{
+		uint32_t values[2][4];
+		uint32_t pBits[2];
+		quantizeBC7Mode6Endpoint(endpoint0, values[0], pBits[0]);
+		quantizeBC7Mode6Endpoint(endpoint1, values[1], pBits[1]);
+
+		int32_t expanded[2][4];
+		for (uint32_t e = 0; e < 2; e++)
+			for (uint32_t c = 0; c < 4; c++)
+				expanded[e][c] = (int32_t)((values[e][c] << 1) | pBits[e]);
+
+		int32_t palette[16][4];
+		for (uint32_t i = 0; i < 16; i++)
+			for (uint32_t c = 0; c < 4; c++)
+				palette[i][c] = bc7Interpolate(expanded[0][c], expanded[1][c], BC7_WEIGHTS4[i]);
+
+		float totalError = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float bestError = std::numeric_limits<float>::max();
+			for (uint32_t p = 0; p < 16; p++)
+			{
+				float error = 0.0f;
+				for (uint32_t c = 0; c < 4; c++)
+					error += (pixels[i][c] - palette[p][c]) * (pixels[i][c] - palette[p][c]);
+				if (error < bestError)
+				{
+					bestError = error;
+					outIndices[i] = p;
+				}
+			}
+			totalError += bestError;
+		}
+
+		// The anchor index (pixel 0) only gets 3 bits, so its MSB has to be 0.
+		if (outIndices[0] & 8)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+				std::swap(values[0][c], values[1][c]);
+			std::swap(pBits[0], pBits[1]);
+			for (uint32_t i = 0; i < 16; i++)
+				outIndices[i] = 15 - outIndices[i];
+		}
+
+		BitWriter writer;
+		writer.write(1ull << 6, 7);  // Mode 6.
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			writer.write(values[0][c], 7);
+			writer.write(values[1][c], 7);
+		}
+		writer.write(pBits[0], 1);
+		writer.write(pBits[1], 1);
+		writer.write(outIndices[0], 3);
+		for (uint32_t i = 1; i < 16; i++)
+			writer.write(outIndices[i], 4);
+
+		memcpy(outBlock, writer.words, 16);
+		return totalError;
+	}
+
+	// Nearest palette entry for each pixel along one set of channels. Returns the squared error.
+	float chooseBC7Indices(const float pixels[16][4], uint32_t firstChannel, uint32_t numChannels, const int32_t expanded[2][4], const int32_t* weights, uint32_t numWeights, uint32_t outIndices[16])
+	{
+		float totalError = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			float bestError = std::numeric_limits<float>::max();
+			for (uint32_t p = 0; p < numWeights; p++)
+			{
+				float error = 0.0f;
+				for (uint32_t c = firstChannel; c < firstChannel + numChannels; c++)
+				{
+					float diff = pixels[i][c] - (float)bc7Interpolate(expanded[0][c], expanded[1][c], weights[p]);
+					error += diff * diff;
+				}
+				if (error < bestError)
+				{
+					bestError = error;
+					outIndices[i] = p;
+				}
+			}
+			totalError += bestError;
+		}
+		return totalError;
+	}
+
+	// Returns the squared error.
+	float encodeBC7Mode5(const float pixels[16][4], const float colorEndpoint0[4], const float colorEndpoint1[4], uint8_t outBlock[16], uint32_t outColorIndices[16])
+	{
+		uint32_t values[2][4];
+		int32_t expanded[2][4];
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			values[0][c] = (uint32_t)std::clamp((int32_t)std::lround(colorEndpoint0[c] * 127.0f / 255.0f), 0, 127);
+			values[1][c] = (uint32_t)std::clamp((int32_t)std::lround(colorEndpoint1[c] * 127.0f / 255.0f), 0, 127);
+			for (uint32_t e = 0; e < 2; e++)
+				expanded[e][c] = (int32_t)((values[e][c] << 1) | (values[e][c] >> 6));
+		}
+
+		// Alpha gets its own min/max endpoints at full precision.
+		float minAlpha = 255.0f, maxAlpha = 0.0f;
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			minAlpha = std::min(minAlpha, pixels[i][3]);
+			maxAlpha = std::max(maxAlpha, pixels[i][3]);
+		}
+		values[0][3] = (uint32_t)minAlpha;
+		values[1][3] = (uint32_t)maxAlpha;
+		expanded[0][3] = (int32_t)values[0][3];
+		expanded[1][3] = (int32_t)values[1][3];
+
+		uint32_t alphaIndices[16];
+		float totalError = chooseBC7Indices(pixels, 0, 3, expanded, BC7_WEIGHTS2, 4, outColorIndices);
+		totalError += chooseBC7Indices(pixels, 3, 1, expanded, BC7_WEIGHTS2, 4, alphaIndices);
+
+		// Anchor indices (pixel 0) only get 1 bit each, so their MSBs have to be 0.
+		if (outColorIndices[0] & 2)
+		{
+			for (uint32_t c = 0; c < 3; c++)
+				std::swap(values[0][c], values[1][c]);
+			for (uint32_t i = 0; i < 16; i++)
+				outColorIndices[i] = 3 - outColorIndices[i];
+		}
+		if (alphaIndices[0] & 2)
+		{
+			std::swap(values[0][3], values[1][3]);
+			for (uint32_t i = 0; i < 16; i++)
+				alphaIndices[i] = 3 - alphaIndices[i];
+		}
+
+		BitWriter writer;
+		writer.write(1ull << 5, 6);  // Mode 5.
+		writer.write(0, 2);          // No rotation.
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			writer.write(values[0][c], 7);
+			writer.write(values[1][c], 7);
+		}
+		writer.write(values[0][3], 8);
+		writer.write(values[1][3], 8);
+		for (uint32_t i = 0; i < 16; i++)
+			writer.write(outColorIndices[i], i == 0 ? 1 : 2);
+		for (uint32_t i = 0; i < 16; i++)
+			writer.write(alphaIndices[i], i == 0 ? 1 : 2);
+
+		memcpy(outBlock, writer.words, 16);
+		return totalError;
+	}
+
+	void encodeBC7Block(const uint8_t block[64], uint8_t outBlock[16])
+	{
+		float pixels[16][4];
+		for (uint32_t i = 0; i < 16; i++)
+			for (uint32_t c = 0; c < 4; c++)
+				pixels[i][c] = block[i * 4 + c];
+
+		// Start candidates: the principal axis, and the bounding box corners.
+		float candidates[2][2][4];
+		calculateAxisEndpoints(pixels, 4, candidates[0][0], candidates[0][1]);
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			candidates[1][0][c] = 255.0f;
+			candidates[1][1][c] = 0.0f;
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				candidates[1][0][c] = std::min(candidates[1][0][c], pixels[i][c]);
+				candidates[1][1][c] = std::max(candidates[1][1][c], pixels[i][c]);
+			}
+		}
+
+		float bestError = std::numeric_limits<float>::max();
+		for (auto& candidate : candidates)
+		{
+			float endpoint0[4], endpoint1[4];
+			memcpy(endpoint0, candidate[0], sizeof(endpoint0));
+			memcpy(endpoint1, candidate[1], sizeof(endpoint1));
+
+			// Least squares refinement off of the chosen indices, until it stops improving.
+			// @NOTE: the indices may have been flipped for the anchor, but the refine solves for both endpoints so it doesn't matter which is which.
+			for (uint32_t iteration = 0; iteration < 3; iteration++)
+			{
+				uint8_t encoded[16];
+				uint32_t indices[16];
+				float error = encodeBC7Mode6(pixels, endpoint0, endpoint1, encoded, indices);
+				if (error >= bestError)
+					break;
+
+				bestError = error;
+				memcpy(outBlock, encoded, 16);
+
+				float weights[16];
+				for (uint32_t i = 0; i < 16; i++)
+					weights[i] = BC7_WEIGHTS4[indices[i]] / 64.0f;
+				if (!refineEndpointsLeastSquares(pixels, 4, weights, endpoint0, endpoint1))
+					break;
+			}
+		}
+
+		// Mode 5 wins when alpha doesn't follow the color (e.g. cutout edges over junk RGB).
+		float endpoint0[4], endpoint1[4];
+		calculateAxisEndpoints(pixels, 3, endpoint0, endpoint1);
+		for (uint32_t iteration = 0; iteration < 2; iteration++)
+		{
+			uint8_t encoded[16];
+			uint32_t colorIndices[16];
+			float error = encodeBC7Mode5(pixels, endpoint0, endpoint1, encoded, colorIndices);
+			if (error < bestError)
+			{
+				bestError = error;
+				memcpy(outBlock, encoded, 16);
+			}
+
+			float weights[16];
+			for (uint32_t i = 0; i < 16; i++)
+				weights[i] = BC7_WEIGHTS2[colorIndices[i]] / 64.0f;
+			if (!refineEndpointsLeastSquares(pixels, 3, weights, endpoint0, endpoint1))
+				break;
+		}
+	}
+
+	bool decodeBC7Block(const uint8_t block[16], uint8_t outBlock[64])
+	{
+		BitReader reader;
+		memcpy(reader.words, block, 16);
+
+		uint32_t mode = 0;
+		while (mode < 8 && reader.read(1) == 0)
+			mode++;
+
+		uint32_t values[2][4];
+		int32_t expanded[2][4];
+		if (mode == 5)
+		{
+			reader.read(2);  // Rotation (always 0 from `encodeBC7Block()`).
+			for (uint32_t c = 0; c < 3; c++)
+			{
+				values[0][c] = reader.read(7);
+				values[1][c] = reader.read(7);
+				for (uint32_t e = 0; e < 2; e++)
+					expanded[e][c] = (int32_t)((values[e][c] << 1) | (values[e][c] >> 6));
+			}
+			expanded[0][3] = (int32_t)reader.read(8);
+			expanded[1][3] = (int32_t)reader.read(8);
+
+			for (uint32_t i = 0; i < 16; i++)
+			{
+				uint32_t index = reader.read(i == 0 ? 1 : 2);
+				for (uint32_t c = 0; c < 3; c++)
+					outBlock[i * 4 + c] = (uint8_t)bc7Interpolate(expanded[0][c], expanded[1][c], BC7_WEIGHTS2[index]);
+			}
+			for (uint32_t i = 0; i < 16; i++)
+				outBlock[i * 4 + 3] = (uint8_t)bc7Interpolate(expanded[0][3], expanded[1][3], BC7_WEIGHTS2[reader.read(i == 0 ? 1 : 2)]);
+			return true;
+		}
+
+		if (mode != 6)
+			return false;  // Only the modes that `encodeBC7Block()` writes are supported.
+
+		for (uint32_t c = 0; c < 4; c++)
+		{
+			values[0][c] = reader.read(7);
+			values[1][c] = reader.read(7);
+		}
+		uint32_t pBits[2] = { reader.read(1), reader.read(1) };
+		for (uint32_t e = 0; e < 2; e++)
+			for (uint32_t c = 0; c < 4; c++)
+				expanded[e][c] = (int32_t)((values[e][c] << 1) | pBits[e]);
+
+		for (uint32_t i = 0; i < 16; i++)
+		{
+			uint32_t index = reader.read(i == 0 ? 3 : 4);
+			for (uint32_t c = 0; c < 4; c++)
+				outBlock[i * 4 + c] = (uint8_t)bc7Interpolate(expanded[0][c], expanded[1][c], BC7_WEIGHTS4[index]);
+		}
+		return true;
+	}
+
+	//
+	// Whole images
+	//
+	size_t getBlockByteSize(CookedFormat format)
+	{
+		switch (format)
+		{
+		case CookedFormat::BC1:
+		case CookedFormat::BC4:
+			return 8;
+		case CookedFormat::BC3:
+		case CookedFormat::BC7:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	size_t calculateMipByteSize(CookedFormat format, uint32_t width, uint32_t height)
+	{
+		if (format == CookedFormat::RGBA8)
+			return (size_t)width * height * 4;
+		return (size_t)((width + 3) / 4) * ((height + 3) / 4) * getBlockByteSize(format);
+	}
+
+	void encodeImage(CookedFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& outData)
+	{
+		outData.resize(calculateMipByteSize(format, width, height));
+		if (format == CookedFormat::RGBA8)
+		{
+			memcpy(outData.data(), rgba, outData.size());
+			return;
+		}
+
+		uint32_t blocksX = (width + 3) / 4;
+		uint32_t blocksY = (height + 3) / 4;
+		size_t blockByteSize = getBlockByteSize(format);
+		for (uint32_t by = 0; by < blocksY; by++)
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				uint8_t block[64];
+				fetchBlock(rgba, width, height, bx, by, block);
+
+				uint8_t* dst = &outData[((size_t)by * blocksX + bx) * blockByteSize];
+				switch (format)
+				{
+				case CookedFormat::BC1: encodeBC1Block(block, dst); break;
+				case CookedFormat::BC3: encodeBC4Block(block, 3, dst); encodeBC1Block(block, dst + 8); break;
+				case CookedFormat::BC4: encodeBC4Block(block, 0, dst); break;
+				case CookedFormat::BC7: encodeBC7Block(block, dst); break;
+				default: break;
+				}
+			}
+	}
+
+	void decodeImage(CookedFormat format, const uint8_t* data, uint32_t width, uint32_t height, std::vector<uint8_t>& outRGBA)
+	{
+		outRGBA.assign((size_t)width * height * 4, 0);
+		if (format == CookedFormat::RGBA8)
+		{
+			memcpy(outRGBA.data(), data, outRGBA.size());
+			return;
+		}
+
+		uint32_t blocksX = (width + 3) / 4;
+		uint32_t blocksY = (height + 3) / 4;
+		size_t blockByteSize = getBlockByteSize(format);
+		for (uint32_t by = 0; by < blocksY; by++)
+			for (uint32_t bx = 0; bx < blocksX; bx++)
+			{
+				const uint8_t* src = &data[((size_t)by * blocksX + bx) * blockByteSize];
+				uint8_t block[64] = {};
+				switch (format)
+				{
+				case CookedFormat::BC1: decodeBC1Block(src, false, block); break;
+				case CookedFormat::BC3: decodeBC1Block(src + 8, true, block); decodeBC4Block(src, 3, block); break;
+				case CookedFormat::BC4:
+					decodeBC4Block(src, 0, block);
+					for (uint32_t i = 0; i < 16; i++)
+						block[i * 4 + 3] = 255;
+					break;
+				case CookedFormat::BC7: decodeBC7Block(src, block); break;
+				default: break;
+				}
+				storeBlock(block, width, height, bx, by, outRGBA.data());
+			}
+	}
+
+	double calculatePSNR(const uint8_t* rgbaA, const uint8_t* rgbaB, size_t numPixels, uint32_t numChannels)
+	{
+		double squaredError = 0.0;
+		for (size_t i = 0; i < numPixels; i++)
+			for (uint32_t c = 0; c < numChannels; c++)
+			{
+				double diff = (double)rgbaA[i * 4 + c] - (double)rgbaB[i * 4 + c];
+				squaredError += diff * diff;
+			}
+
+		double mse = squaredError / (double)(numPixels * numChannels);
+		if (mse == 0.0)
+			return std::numeric_limits<double>::infinity();
+		return 10.0 * std::log10(255.0 * 255.0 / mse);
+	}
+
+	//
+	// Container
+	//
+	bool loadCookedTexture(const std::string& fname, CookedTexture& outCookedTexture)
+	{
+		outCookedTexture = {};  // @NOTE: callers check `mips` to see if a cooked texture got loaded, so it has to stay empty on failure.
+
+		std::ifstream file(fname, std::ios::binary | std::ios::ate);
+		if (!file.is_open())
+			return false;
+		uint64_t fileSize = (uint64_t)file.tellg();
+		file.seekg(0);
+
+		HTexHeader header;
+		if (!file.read((char*)&header, sizeof(header)) ||
+			header.magic != HTEX_MAGIC ||
+			header.version != HTEX_VERSION ||
+			header.numMips == 0 ||
+			header.numMips > 32)
+		{
+			std::cerr << "[LOAD COOKED TEXTURE]" << std::endl
+				<< "ERROR: \"" << fname << "\" is not a valid .htex file (or is an old version)" << std::endl;
+			return false;
+		}
+
+		CookedTexture cookedTexture = {
+			.format = (CookedFormat)header.format,
+			.isSRGB = (header.isSRGB != 0),
+			.width = header.width,
+			.height = header.height,
+		};
+		cookedTexture.mips.resize(header.numMips);
+		if (!file.read((char*)cookedTexture.mips.data(), sizeof(HTexMip) * header.numMips))
+		{
+			std::cerr << "[LOAD COOKED TEXTURE]" << std::endl
+				<< "ERROR: \"" << fname << "\" is truncated" << std::endl;
+			return false;
+		}
+
+		// Make sure every mip is the size its format says it is and fits inside the mip data.
+		uint64_t dataSize = fileSize - sizeof(HTexHeader) - sizeof(HTexMip) * header.numMips;
+		for (const HTexMip& mip : cookedTexture.mips)
+		{
+			uint64_t expectedByteSize = calculateMipByteSize(cookedTexture.format, mip.width, mip.height);
+			if (expectedByteSize == 0 ||
+				mip.byteSize != expectedByteSize ||
+				mip.offset > dataSize ||
+				mip.byteSize > dataSize - mip.offset)
+			{
+				std::cerr << "[LOAD COOKED TEXTURE]" << std::endl
+					<< "ERROR: \"" << fname << "\" has a corrupt or truncated mip" << std::endl;
+				return false;
+			}
+		}
+
+		cookedTexture.data.resize(dataSize);
+		if (!file.read((char*)cookedTexture.data.data(), cookedTexture.data.size()))
+		{
+			std::cerr << "[LOAD COOKED TEXTURE]" << std::endl
+				<< "ERROR: \"" << fname << "\" is truncated" << std::endl;
+			return false;
+		}
+
+		outCookedTexture = std::move(cookedTexture);
+		return true;
+	}
+
+	bool saveCookedTexture(const std::string& fname, const CookedTexture& cookedTexture)
+	{
+		// @NOTE: write to a temp file and then swap it in, so that an interrupted cook can't leave
+		//        a truncated .htex that's newer than its source.
+		std::filesystem::path tempPath = fname;
+		tempPath.replace_extension(".tmp.htex");
+
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open())
+		{
+			std::cerr << "[SAVE COOKED TEXTURE]" << std::endl
+				<< "ERROR: could not open " << tempPath << " for writing" << std::endl;
+			return false;
+		}
+
+		HTexHeader header = {
+			.magic = HTEX_MAGIC,
+			.version = HTEX_VERSION,
+			.format = (uint32_t)cookedTexture.format,
+			.isSRGB = cookedTexture.isSRGB ? 1u : 0u,
+			.width = cookedTexture.width,
+			.height = cookedTexture.height,
+			.numMips = (uint32_t)cookedTexture.mips.size(),
+			.reserved = 0,
+		};
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)cookedTexture.mips.data(), sizeof(HTexMip) * cookedTexture.mips.size());
+		file.write((const char*)cookedTexture.data.data(), cookedTexture.data.size());
+		file.close();
+
+		std::error_code ec;
+		if (!file.good())
+		{
+			std::cerr << "[SAVE COOKED TEXTURE]" << std::endl
+				<< "ERROR: failed writing " << tempPath << std::endl;
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+
+		std::filesystem::rename(tempPath, fname, ec);
+		if (ec)
+		{
+			std::cerr << "[SAVE COOKED TEXTURE]" << std::endl
+				<< "ERROR: could not replace \"" << fname << "\": " << ec.message() << std::endl;
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+		return true;
+	}
+
+	//
+	// Cooking
+	//
+	bool cookTexture(const std::string& srcFname, const std::string& dstFname, const CookSettings& settings)
+	{
+		int32_t width, height, channels;
+		stbi_uc* pixels = stbi_load(srcFname.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+		if (!pixels)
+		{
+			std::cerr << "[COOK TEXTURE]" << std::endl
+				<< "ERROR: failed to load texture " << srcFname << std::endl;
+			return false;
+		}
+
+		std::vector<std::vector<uint8_t>> levels;
+		generateMipChain(pixels, (uint32_t)width, (uint32_t)height, settings.isSRGB, settings.filter, levels);
+		stbi_image_free(pixels);
+
+		CookedTexture cookedTexture = {
+			.format = settings.format,
+			.isSRGB = settings.isSRGB,
+			.width = (uint32_t)width,
+			.height = (uint32_t)height,
+		};
+
+		uint32_t mipWidth = (uint32_t)width;
+		uint32_t mipHeight = (uint32_t)height;
+		for (auto& level : levels)
+		{
+			std::vector<uint8_t> encoded;
+			encodeImage(settings.format, level.data(), mipWidth, mipHeight, encoded);
+
+			cookedTexture.mips.push_back({
+				.width = mipWidth,
+				.height = mipHeight,
+				.offset = cookedTexture.data.size(),
+				.byteSize = encoded.size(),
+			});
+			cookedTexture.data.insert(cookedTexture.data.end(), encoded.begin(), encoded.end());
+
+			mipWidth = std::max(1u, mipWidth / 2);
+			mipHeight = std::max(1u, mipHeight / 2);
+		}
+
+		return saveCookedTexture(dstFname, cookedTexture);
+	}
+
+	size_t cookAllTextures(const std::string& directory, const CookSettings& settings)
+	{
+		auto startTime = std::chrono::high_resolution_clock::now();
+
+		std::vector<std::filesystem::path> staleTextures;
+		size_t numTextures = 0;
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+		{
+			const auto& path = entry.path();
+			const auto& ext = path.extension();
+			if (!entry.is_regular_file() ||
+				(ext.compare(".png") != 0 &&
+				ext.compare(".jpg") != 0 &&
+				ext.compare(".jpeg") != 0))
+				continue;
+
+			numTextures++;
+			auto cookedPath = path;
+			cookedPath += ".htex";
+			if (std::filesystem::exists(cookedPath) &&
+				std::filesystem::last_write_time(cookedPath) >= std::filesystem::last_write_time(path))
+				continue;
+
+			staleTextures.push_back(path);
+		}
+
+		std::mutex printMutex;
+		size_t numCooked = 0;
+		tf::Executor executor;
+		tf::Taskflow taskflow;
+		taskflow.for_each(staleTextures.begin(), staleTextures.end(), [&](const std::filesystem::path& path) {
+			PROFILE_ZONE("Cook Texture");
+			auto cookedPath = path;
+			cookedPath += ".htex";
+			bool success = cookTexture(path.string(), cookedPath.string(), settings);
+
+			std::lock_guard<std::mutex> lg(printMutex);
+			std::cout << "[COOK TEXTURE]" << std::endl << path << "\t...\t" << (success ? "SUCCESS" : "FAILURE") << std::endl;
+			if (success)
+				numCooked++;
+		});
+		executor.run(taskflow).wait();
+
+		double durationMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - startTime).count();
+		std::cout << "[COOK TEXTURES]" << std::endl
+			<< "Cooked " << numCooked << " of " << staleTextures.size() << " stale textures (" << numTextures << " total) in " << durationMS << " ms" << std::endl;
+		return numCooked;
+	}
+
+	void benchmarkEncoders(const std::string& srcFname)
+	{
+		int32_t width, height, channels;
+		stbi_uc* pixels = stbi_load(srcFname.c_str(), &width, &height, &channels, STBI_rgb_alpha);
+		if (!pixels)
+		{
+			std::cerr << "[BENCHMARK TEXTURE ENCODERS]" << std::endl
+				<< "ERROR: failed to load texture " << srcFname << std::endl;
+			return;
+		}
+
+		size_t numPixels = (size_t)width * height;
+		double megapixels = numPixels / 1000000.0;
+		std::cout << "[BENCHMARK TEXTURE ENCODERS]" << std::endl
+			<< srcFname << " (" << width << "x" << height << ")" << std::endl;
+
+		// Mip filters
+		for (MipFilter filter : { MipFilter::BOX, MipFilter::KAISER })
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			std::vector<std::vector<uint8_t>> levels;
+			generateMipChain(pixels, (uint32_t)width, (uint32_t)height, true, filter, levels);
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+			std::cout << "\tMip chain (" << (filter == MipFilter::BOX ? "box" : "kaiser") << "):\t" << levels.size() << " levels in " << ms << " ms" << std::endl;
+		}
+
+		// Encoders
+		struct FormatToBench
+		{
+			CookedFormat format;
+			const char* name;
+			uint32_t psnrChannels;
+		};
+		const FormatToBench formats[] = {
+			{ CookedFormat::BC1, "BC1", 3 },
+			{ CookedFormat::BC3, "BC3", 4 },
+			{ CookedFormat::BC4, "BC4", 1 },
+			{ CookedFormat::BC7, "BC7", 4 },
+		};
+		for (const FormatToBench& ftb : formats)
+		{
+			auto start = std::chrono::high_resolution_clock::now();
+			std::vector<uint8_t> encoded;
+			encodeImage(ftb.format, pixels, (uint32_t)width, (uint32_t)height, encoded);
+			double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+			std::vector<uint8_t> decoded;
+			decodeImage(ftb.format, encoded.data(), (uint32_t)width, (uint32_t)height, decoded);
+			double psnr = calculatePSNR(pixels, decoded.data(), numPixels, ftb.psnrChannels);
+
+			std::cout << "\t" << ftb.name << ":\t"
+				<< ms << " ms (" << (megapixels / (ms / 1000.0)) << " MPix/s), "
+				<< "PSNR " << psnr << " dB, "
+				<< encoded.size() / 1024 << " KiB (vs " << numPixels * 4 / 1024 << " KiB RGBA8)" << std::endl;
+		}
+
+		stbi_image_free(pixels);
+	}
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+
+// @NOTE: cooked textures (.htex) hold the full mip chain, already downsampled (and optionally
+//        block compressed) offline. Loading one is just a file read and buffer->image copies,
+//        so there's no decoding or mip blitting at runtime. The cooker writes "<source>.htex"
+//        right next to the source image, the same way shaders get their ".spv".
+namespace texturecooker
+{
+	enum class CookedFormat : uint32_t
+	{
+		RGBA8 = 0,
+		BC1   = 1,  // RGB, 4bpp. Alpha gets dropped.
+		BC3   = 2,  // RGBA, 8bpp (BC1 color + BC4 alpha).
+		BC4   = 3,  // Single channel (red), 4bpp.
+		BC7   = 4,  // RGBA, 8bpp. Only the single subset modes (5 and 6) get encoded.
+	};
+
+	enum class MipFilter
+	{
+		BOX,
+		KAISER,
+	};
+
+	constexpr uint32_t HTEX_MAGIC   = 0x58455448;  // "HTEX"
+	constexpr uint32_t HTEX_VERSION = 1;
+
+	struct HTexHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t format;   // CookedFormat
+		uint32_t isSRGB;
+		uint32_t width;
+		uint32_t height;
+		uint32_t numMips;
+		uint32_t reserved;
+	};
+
+	struct HTexMip
+	{
+		uint32_t width;
+		uint32_t height;
+		uint64_t offset;    // From the start of the mip data.
+		uint64_t byteSize;
+	};
+
+	struct CookedTexture
+	{
+		CookedFormat format = CookedFormat::RGBA8;
+		bool isSRGB = true;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		std::vector<HTexMip> mips = {};
+		std::vector<uint8_t> data = {};
+	};
+
+	struct CookSettings
+	{
+		CookedFormat format = CookedFormat::BC7;
+		MipFilter filter = MipFilter::KAISER;
+		bool isSRGB = true;
+	};
+
+	size_t calculateMipByteSize(CookedFormat format, uint32_t width, uint32_t height);
+	bool loadCookedTexture(const std::string& fname, CookedTexture& outCookedTexture);
+	bool saveCookedTexture(const std::string& fname, const CookedTexture& cookedTexture);
+
+	// Filtering happens in linear space w/ premultiplied alpha. Levels are RGBA8, level 0 is a copy of `rgba`.
+	void generateMipChain(const uint8_t* rgba, uint32_t width, uint32_t height, bool isSRGB, MipFilter filter, std::vector<std::vector<uint8_t>>& outLevels);
+
+	void encodeImage(CookedFormat format, const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& outData);
+	void decodeImage(CookedFormat format, const uint8_t* data, uint32_t width, uint32_t height, std::vector<uint8_t>& outRGBA);
+	double calculatePSNR(const uint8_t* rgbaA, const uint8_t* rgbaB, size_t numPixels, uint32_t numChannels);
+
+	bool cookTexture(const std::string& srcFname, const std::string& dstFname, const CookSettings& settings);
+	size_t cookAllTextures(const std::string& directory, const CookSettings& settings);  // Only cooks the ones whose .htex is missing or older than the source. Returns the number cooked.
+
+	// Prints encode speed and PSNR of each format (and mip filter timings) for one image. CPU only.
+	void benchmarkEncoders(const std::string& srcFname);
+}
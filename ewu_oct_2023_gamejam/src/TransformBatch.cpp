@@ -0,0 +1,457 @@
+#include "TransformBatch.h"
+
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+#ifdef _DEVELOP
+#include <iostream>
+#include <random>
+#include <chrono>
+#include "Settings.h"
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#define TRANSFORM_BATCH_SSE 1
+#else
+#define TRANSFORM_BATCH_SSE 0
+#endif
+
+
+namespace transformbatch
+{
+	void TRSArrays::resize(size_t count)
+	{
+		for (std::vector<float_t>* component : { &posX, &posY, &posZ, &rotX, &rotY, &rotZ, &rotW, &scaX, &scaY, &scaZ })
+			component->resize(count);
+	}
+
+	void TRSArrays::set(size_t index, vec3 position, versor rotation, vec3 scale)
+	{
+		posX[index] = position[0];
+		posY[index] = position[1];
+		posZ[index] = position[2];
+		rotX[index] = rotation[0];
+		rotY[index] = rotation[1];
+		rotZ[index] = rotation[2];
+		rotW[index] = rotation[3];
+		scaX[index] = scale[0];
+		scaY[index] = scale[1];
+		scaZ[index] = scale[2];
+	}
+
+	//
+	// Compose
+	//
+	inline void composeOne(const TRSArrays& trs, size_t i, mat4& out)
+	{
+		// Same as `glm_quat_mat4()`.
+		float_t x = trs.rotX[i];
+		float_t y = trs.rotY[i];
+		float_t z = trs.rotZ[i];
+		float_t w = trs.rotW[i];
+		float_t norm = std::sqrt(x * x + y * y + z * z + w * w);
+		float_t s = norm > 0.0f ? 2.0f / norm : 0.0f;
+
+		float_t xx = s * x * x;   float_t xy = s * x * y;   float_t wx = s * w * x;
+		float_t yy = s * y * y;   float_t yz = s * y * z;   float_t wy = s * w * y;
+		float_t zz = s * z * z;   float_t xz = s * x * z;   float_t wz = s * w * z;
+
+		out[0][0] = (1.0f - yy - zz) * trs.scaX[i];
+		out[0][1] = (xy + wz) * trs.scaX[i];
+		out[0][2] = (xz - wy) * trs.scaX[i];
+		out[0][3] = 0.0f;
+
+		out[1][0] = (xy - wz) * trs.scaY[i];
+		out[1][1] = (1.0f - xx - zz) * trs.scaY[i];
+		out[1][2] = (yz + wx) * trs.scaY[i];
+		out[1][3] = 0.0f;
+
+		out[2][0] = (xz + wy) * trs.scaZ[i];
+		out[2][1] = (yz - wx) * trs.scaZ[i];
+		out[2][2] = (1.0f - xx - yy) * trs.scaZ[i];
+		out[2][3] = 0.0f;
+
+		out[3][0] = trs.posX[i];
+		out[3][1] = trs.posY[i];
+		out[3][2] = trs.posZ[i];
+		out[3][3] = 1.0f;
+	}
+
+#if TRANSFORM_BATCH_SSE
+	// Takes element `column` of 4 matrices as 4 SoA rows and writes them out as each matrix's column.
+	inline void storeColumn4(mat4* out, size_t column, __m128 row0, __m128 row1, __m128 row2, __m128 row3)
+	{
+		_MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+		_mm_storeu_ps(out[0][column], row0);
+		_mm_storeu_ps(out[1][column], row1);
+		_mm_storeu_ps(out[2][column], row2);
+		_mm_storeu_ps(out[3][column], row3);
+	}
+#endif
+
+	void compose(const TRSArrays& trs, mat4* outMatrices)
+	{
+		const size_t count = trs.size();
+		size_t i = 0;
+#if TRANSFORM_BATCH_SSE
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one  = _mm_set1_ps(1.0f);
+		const __m128 two  = _mm_set1_ps(2.0f);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 x = _mm_loadu_ps(&trs.rotX[i]);
+			__m128 y = _mm_loadu_ps(&trs.rotY[i]);
+			__m128 z = _mm_loadu_ps(&trs.rotZ[i]);
+			__m128 w = _mm_loadu_ps(&trs.rotW[i]);
+			__m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w));
+			__m128 norm = _mm_sqrt_ps(dot);
+			__m128 s = _mm_and_ps(_mm_cmpgt_ps(norm, zero), _mm_div_ps(two, norm));  // 0 where the norm is 0.
+
+			__m128 sx = _mm_mul_ps(s, x);
+			__m128 sy = _mm_mul_ps(s, y);
+			__m128 sz = _mm_mul_ps(s, z);
+			__m128 sw = _mm_mul_ps(s, w);
+			__m128 xx = _mm_mul_ps(sx, x);   __m128 xy = _mm_mul_ps(sx, y);   __m128 wx = _mm_mul_ps(sw, x);
+			__m128 yy = _mm_mul_ps(sy, y);   __m128 yz = _mm_mul_ps(sy, z);   __m128 wy = _mm_mul_ps(sw, y);
+			__m128 zz = _mm_mul_ps(sz, z);   __m128 xz = _mm_mul_ps(sx, z);   __m128 wz = _mm_mul_ps(sw, z);
+
+			__m128 scaX = _mm_loadu_ps(&trs.scaX[i]);
+			__m128 scaY = _mm_loadu_ps(&trs.scaY[i]);
+			__m128 scaZ = _mm_loadu_ps(&trs.scaZ[i]);
+
+			storeColumn4(outMatrices + i, 0,
+				_mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, yy), zz), scaX),
+				_mm_mul_ps(_mm_add_ps(xy, wz), scaX),
+				_mm_mul_ps(_mm_sub_ps(xz, wy), scaX),
+				zero);
+			storeColumn4(outMatrices + i, 1,
+				_mm_mul_ps(_mm_sub_ps(xy, wz), scaY),
+				_mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), zz), scaY),
+				_mm_mul_ps(_mm_add_ps(yz, wx), scaY),
+				zero);
+			storeColumn4(outMatrices + i, 2,
+				_mm_mul_ps(_mm_add_ps(xz, wy), scaZ),
+				_mm_mul_ps(_mm_sub_ps(yz, wx), scaZ),
+				_mm_mul_ps(_mm_sub_ps(_mm_sub_ps(one, xx), yy), scaZ),
+				zero);
+			storeColumn4(outMatrices + i, 3,
+				_mm_loadu_ps(&trs.posX[i]),
+				_mm_loadu_ps(&trs.posY[i]),
+				_mm_loadu_ps(&trs.posZ[i]),
+				one);
+		}
+#endif
+		for (; i < count; i++)
+			composeOne(trs, i, outMatrices[i]);
+	}
+
+	void composeReference(const TRSArrays& trs, mat4* outMatrices)
+	{
+		for (size_t i = 0; i < trs.size(); i++)
+			composeOne(trs, i, outMatrices[i]);
+	}
+
+	//
+	// Interpolate
+	//
+	inline void interpolateOne(const TRSArrays& from, const TRSArrays& to, float_t t, TRSArrays& out, size_t i)
+	{
+		out.posX[i] = from.posX[i] + t * (to.posX[i] - from.posX[i]);
+		out.posY[i] = from.posY[i] + t * (to.posY[i] - from.posY[i]);
+		out.posZ[i] = from.posZ[i] + t * (to.posZ[i] - from.posZ[i]);
+		out.scaX[i] = from.scaX[i] + t * (to.scaX[i] - from.scaX[i]);
+		out.scaY[i] = from.scaY[i] + t * (to.scaY[i] - from.scaY[i]);
+		out.scaZ[i] = from.scaZ[i] + t * (to.scaZ[i] - from.scaZ[i]);
+
+		// Same as `glm_quat_nlerp()` (take the short way around, lerp, then normalize).
+		float_t dot = from.rotX[i] * to.rotX[i] + from.rotY[i] * to.rotY[i] + from.rotZ[i] * to.rotZ[i] + from.rotW[i] * to.rotW[i];
+		float_t sign = (dot >= 0.0f) ? 1.0f : -1.0f;
+		float_t x = from.rotX[i] + t * (to.rotX[i] * sign - from.rotX[i]);
+		float_t y = from.rotY[i] + t * (to.rotY[i] * sign - from.rotY[i]);
+		float_t z = from.rotZ[i] + t * (to.rotZ[i] * sign - from.rotZ[i]);
+		float_t w = from.rotW[i] + t * (to.rotW[i] * sign - from.rotW[i]);
+		float_t lengthSquared = x * x + y * y + z * z + w * w;
+		if (lengthSquared > 0.0f)
+		{
+			float_t length = std::sqrt(lengthSquared);
+			out.rotX[i] = x / length;
+			out.rotY[i] = y / length;
+			out.rotZ[i] = z / length;
+			out.rotW[i] = w / length;
+		}
+		else
+		{
+			out.rotX[i] = 0.0f;
+			out.rotY[i] = 0.0f;
+			out.rotZ[i] = 0.0f;
+			out.rotW[i] = 1.0f;
+		}
+	}
+
+	void interpolate(const TRSArrays& from, const TRSArrays& to, float_t alpha, TRSArrays& out)
+	{
+		assert(from.size() == to.size());
+		const size_t count = from.size();
+		out.resize(count);
+
+		size_t i = 0;
+#if TRANSFORM_BATCH_SSE
+		const __m128 tV     = _mm_set1_ps(alpha);
+		const __m128 zero   = _mm_setzero_ps();
+		const __m128 one    = _mm_set1_ps(1.0f);
+		const __m128 negOne = _mm_set1_ps(-1.0f);
+		auto lerp = [&](const std::vector<float_t>& a, const std::vector<float_t>& b, std::vector<float_t>& dest) {
+			__m128 aV = _mm_loadu_ps(&a[i]);
+			_mm_storeu_ps(&dest[i], _mm_add_ps(aV, _mm_mul_ps(tV, _mm_sub_ps(_mm_loadu_ps(&b[i]), aV))));
+		};
+		for (; i + 4 <= count; i += 4)
+		{
+			lerp(from.posX, to.posX, out.posX);
+			lerp(from.posY, to.posY, out.posY);
+			lerp(from.posZ, to.posZ, out.posZ);
+			lerp(from.scaX, to.scaX, out.scaX);
+			lerp(from.scaY, to.scaY, out.scaY);
+			lerp(from.scaZ, to.scaZ, out.scaZ);
+
+			__m128 fx = _mm_loadu_ps(&from.rotX[i]);
+			__m128 fy = _mm_loadu_ps(&from.rotY[i]);
+			__m128 fz = _mm_loadu_ps(&from.rotZ[i]);
+			__m128 fw = _mm_loadu_ps(&from.rotW[i]);
+			__m128 tx = _mm_loadu_ps(&to.rotX[i]);
+			__m128 ty = _mm_loadu_ps(&to.rotY[i]);
+			__m128 tz = _mm_loadu_ps(&to.rotZ[i]);
+			__m128 tw = _mm_loadu_ps(&to.rotW[i]);
+			__m128 dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(fx, tx), _mm_mul_ps(fy, ty)), _mm_mul_ps(fz, tz)), _mm_mul_ps(fw, tw));
+			__m128 positive = _mm_cmpge_ps(dot, zero);
+			__m128 sign = _mm_or_ps(_mm_and_ps(positive, one), _mm_andnot_ps(positive, negOne));
+
+			__m128 x = _mm_add_ps(fx, _mm_mul_ps(tV, _mm_sub_ps(_mm_mul_ps(tx, sign), fx)));
+			__m128 y = _mm_add_ps(fy, _mm_mul_ps(tV, _mm_sub_ps(_mm_mul_ps(ty, sign), fy)));
+			__m128 z = _mm_add_ps(fz, _mm_mul_ps(tV, _mm_sub_ps(_mm_mul_ps(tz, sign), fz)));
+			__m128 w = _mm_add_ps(fw, _mm_mul_ps(tV, _mm_sub_ps(_mm_mul_ps(tw, sign), fw)));
+			__m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)), _mm_mul_ps(w, w));
+			__m128 valid = _mm_cmpgt_ps(lengthSquared, zero);
+			__m128 length = _mm_sqrt_ps(lengthSquared);
+
+			// Degenerate lanes become the identity quaternion.
+			_mm_storeu_ps(&out.rotX[i], _mm_and_ps(valid, _mm_div_ps(x, length)));
+			_mm_storeu_ps(&out.rotY[i], _mm_and_ps(valid, _mm_div_ps(y, length)));
+			_mm_storeu_ps(&out.rotZ[i], _mm_and_ps(valid, _mm_div_ps(z, length)));
+			_mm_storeu_ps(&out.rotW[i], _mm_or_ps(_mm_and_ps(valid, _mm_div_ps(w, length)), _mm_andnot_ps(valid, one)));
+		}
+#endif
+		for (; i < count; i++)
+			interpolateOne(from, to, alpha, out, i);
+	}
+
+	void interpolateReference(const TRSArrays& from, const TRSArrays& to, float_t alpha, TRSArrays& out)
+	{
+		assert(from.size() == to.size());
+		out.resize(from.size());
+		for (size_t i = 0; i < from.size(); i++)
+			interpolateOne(from, to, alpha, out, i);
+	}
+
+#ifdef _DEVELOP
+	void fillRandomTRS(TRSArrays& trs, size_t count, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<float_t> positionDist(-500.0f, 500.0f);
+		std::uniform_real_distribution<float_t> unitDist(-1.0f, 1.0f);
+		std::uniform_real_distribution<float_t> scaleDist(0.1f, 4.0f);
+		trs.resize(count);
+		for (size_t i = 0; i < count; i++)
+		{
+			vec3 position = { positionDist(rng), positionDist(rng), positionDist(rng) };
+			versor rotation = { unitDist(rng), unitDist(rng), unitDist(rng), unitDist(rng) };
+			glm_quat_normalize(rotation);
+			vec3 scale = { scaleDist(rng), scaleDist(rng), scaleDist(rng) };
+			trs.set(i, position, rotation, scale);
+		}
+	}
+
+	void composeViaCGLM(const TRSArrays& trs, size_t i, mat4& out)
+	{
+		vec3 position = { trs.posX[i], trs.posY[i], trs.posZ[i] };
+		versor rotation = { trs.rotX[i], trs.rotY[i], trs.rotZ[i], trs.rotW[i] };
+		vec3 scale = { trs.scaX[i], trs.scaY[i], trs.scaZ[i] };
+		glm_mat4_identity(out);
+		glm_translate(out, position);
+		glm_quat_rotate(out, rotation, out);
+		glm_scale(out, scale);
+	}
+
+	bool nearlyEqual(const float_t* a, const float_t* b, size_t count, float_t epsilon)
+	{
+		for (size_t i = 0; i < count; i++)
+			if (std::abs(a[i] - b[i]) > epsilon * std::max(1.0f, std::abs(b[i])))
+				return false;
+		return true;
+	}
+
+	bool runSelfTest()
+	{
+		std::cout << "[TRANSFORM BATCH SELF TEST]" << std::endl
+			<< "SIMD: " << (TRANSFORM_BATCH_SSE ? "SSE" : "none (scalar only)") << std::endl;
+		bool success = true;
+
+		// Odd count so the scalar tail gets hit too.
+		constexpr size_t count = RENDER_OBJECTS_MAX_CAPACITY + 3;
+		std::mt19937 rng(1234);
+		TRSArrays from, to;
+		fillRandomTRS(from, count, rng);
+		fillRandomTRS(to, count, rng);
+
+		// Edge cases: a zero quaternion, opposite quaternions (nlerps through zero) and negative scale.
+		vec3 edgePosition = { 1.0f, 2.0f, 3.0f };
+		vec3 edgeScale = { -1.0f, 2.0f, 1.0f };
+		versor zeroRotation = { 0.0f, 0.0f, 0.0f, 0.0f };
+		versor identityRotation = GLM_QUAT_IDENTITY_INIT;
+		versor flippedIdentityRotation = { 0.0f, 0.0f, 0.0f, -1.0f };
+		from.set(0, edgePosition, zeroRotation, edgeScale);
+		from.set(1, edgePosition, identityRotation, edgeScale);
+		to.set(1, edgePosition, flippedIdentityRotation, edgeScale);
+
+		// Compose.
+		std::vector<mat4s> simd(count), reference(count);
+		compose(from, (mat4*)simd.data());
+		composeReference(from, (mat4*)reference.data());
+		if (memcmp(simd.data(), reference.data(), count * sizeof(mat4s)) != 0)
+		{
+			std::cout << "  FAIL  compose() doesn't match composeReference() bit for bit" << std::endl;
+			success = false;
+		}
+		size_t numCGLMMismatches = 0;
+		for (size_t i = 0; i < count; i++)
+		{
+			mat4 viaCGLM;
+			composeViaCGLM(from, i, viaCGLM);
+			if (!nearlyEqual((float_t*)reference[i].raw, (float_t*)viaCGLM, 16, 1e-5f))
+				numCGLMMismatches++;
+		}
+		if (numCGLMMismatches > 0)
+		{
+			std::cout << "  FAIL  " << numCGLMMismatches << " composed matrices don't match glm_translate/glm_quat_rotate/glm_scale" << std::endl;
+			success = false;
+		}
+
+		// Interpolate.
+		for (float_t alpha : { 0.0f, 0.25f, 0.5f, 0.9f, 1.0f, 1.5f })
+		{
+			TRSArrays simdOut, referenceOut;
+			interpolate(from, to, alpha, simdOut);
+			interpolateReference(from, to, alpha, referenceOut);
+			bool bitEqual = true;
+			for (auto component : { &TRSArrays::posX, &TRSArrays::posY, &TRSArrays::posZ, &TRSArrays::rotX, &TRSArrays::rotY, &TRSArrays::rotZ, &TRSArrays::rotW, &TRSArrays::scaX, &TRSArrays::scaY, &TRSArrays::scaZ })
+				bitEqual &= (memcmp((simdOut.*component).data(), (referenceOut.*component).data(), count * sizeof(float_t)) == 0);
+			if (!bitEqual)
+			{
+				std::cout << "  FAIL  interpolate() doesn't match interpolateReference() bit for bit (alpha " << alpha << ")" << std::endl;
+				success = false;
+			}
+
+			size_t numMismatches = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				vec3 fromPos = { from.posX[i], from.posY[i], from.posZ[i] };
+				vec3 toPos = { to.posX[i], to.posY[i], to.posZ[i] };
+				versor fromRot = { from.rotX[i], from.rotY[i], from.rotZ[i], from.rotW[i] };
+				versor toRot = { to.rotX[i], to.rotY[i], to.rotZ[i], to.rotW[i] };
+				vec3 position;
+				versor rotation;
+				glm_vec3_lerp(fromPos, toPos, alpha, position);
+				glm_quat_nlerp(fromRot, toRot, alpha, rotation);
+
+				vec3 outPos = { referenceOut.posX[i], referenceOut.posY[i], referenceOut.posZ[i] };
+				versor outRot = { referenceOut.rotX[i], referenceOut.rotY[i], referenceOut.rotZ[i], referenceOut.rotW[i] };
+				if (!nearlyEqual(outPos, position, 3, 1e-5f) || !nearlyEqual(outRot, rotation, 4, 1e-5f))
+					numMismatches++;
+			}
+			if (numMismatches > 0)
+			{
+				std::cout << "  FAIL  " << numMismatches << " interpolated transforms don't match glm_vec3_lerp/glm_quat_nlerp (alpha " << alpha << ")" << std::endl;
+				success = false;
+			}
+		}
+
+		std::cout << (success ? "PASSED" : "FAILED") << std::endl;
+		return success;
+	}
+
+	void runBenchmark()
+	{
+		constexpr size_t count = RENDER_OBJECTS_MAX_CAPACITY;
+		constexpr size_t numRuns = 200;
+		using Clock = std::chrono::high_resolution_clock;
+		auto msPerRun = [](Clock::time_point start) {
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count() / (double)numRuns;
+		};
+
+		std::mt19937 rng(1234);
+		TRSArrays from, to, interpolated;
+		fillRandomTRS(from, count, rng);
+		fillRandomTRS(to, count, rng);
+		std::vector<mat4s> matrices(count);
+		float_t sink = 0.0f;
+
+		std::cout << "[BENCHMARK TRANSFORM BATCH]" << std::endl
+			<< count << " transforms, average of " << numRuns << " runs" << std::endl;
+
+		// Interpolate + compose, the same as the physics interpolation does each frame.
+		auto start = Clock::now();
+		for (size_t run = 0; run < numRuns; run++)
+		{
+			float_t alpha = (float_t)run / (float_t)numRuns;
+			for (size_t i = 0; i < count; i++)
+			{
+				vec3 fromPos = { from.posX[i], from.posY[i], from.posZ[i] };
+				vec3 toPos = { to.posX[i], to.posY[i], to.posZ[i] };
+				versor fromRot = { from.rotX[i], from.rotY[i], from.rotZ[i], from.rotW[i] };
+				versor toRot = { to.rotX[i], to.rotY[i], to.rotZ[i], to.rotW[i] };
+				vec3 fromSca = { from.scaX[i], from.scaY[i], from.scaZ[i] };
+				vec3 toSca = { to.scaX[i], to.scaY[i], to.scaZ[i] };
+				vec3 position, scale;
+				versor rotation;
+				glm_vec3_lerp(fromPos, toPos, alpha, position);
+				glm_quat_nlerp(fromRot, toRot, alpha, rotation);
+				glm_vec3_lerp(fromSca, toSca, alpha, scale);
+
+				mat4& out = matrices[i].raw;
+				glm_mat4_identity(out);
+				glm_translate(out, position);
+				glm_quat_rotate(out, rotation, out);
+				glm_scale(out, scale);
+			}
+			sink += matrices[run % count].raw[3][0];
+		}
+		double cglmMS = msPerRun(start);
+
+		start = Clock::now();
+		for (size_t run = 0; run < numRuns; run++)
+		{
+			interpolateReference(from, to, (float_t)run / (float_t)numRuns, interpolated);
+			composeReference(interpolated, (mat4*)matrices.data());
+			sink += matrices[run % count].raw[3][0];
+		}
+		double referenceMS = msPerRun(start);
+
+		start = Clock::now();
+		for (size_t run = 0; run < numRuns; run++)
+		{
+			interpolate(from, to, (float_t)run / (float_t)numRuns, interpolated);
+			compose(interpolated, (mat4*)matrices.data());
+			sink += matrices[run % count].raw[3][0];
+		}
+		double simdMS = msPerRun(start);
+
+		std::cout << "Interpolate + compose" << std::endl
+			<< "  cglm per object:  " << cglmMS << "ms" << std::endl
+			<< "  batch (scalar):   " << referenceMS << "ms" << std::endl
+			<< "  batch (SIMD):     " << simdMS << "ms  (" << (cglmMS / simdMS) << "x)" << std::endl;
+
+		volatile float_t keepSink = sink;  // So the work doesn't get optimized out.
+		(void)keepSink;
+	}
+#endif
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include "ImportGLM.h"
+
+
+// @NOTE: batched transform kernels. The TRS data is kept as SoA (one array per component), so the
+//        SSE kernels can push 4 transforms through each instruction. Every kernel has a scalar
+//        `...Reference()` twin that does the exact same float ops in the exact same order, so both
+//        produce bit for bit the same output (which is what `runSelfTest()` checks). For that reason
+//        there's no FMA in here either, since fused ops round differently.
+namespace transformbatch
+{
+	struct TRSArrays
+	{
+		std::vector<float_t> posX, posY, posZ;
+		std::vector<float_t> rotX, rotY, rotZ, rotW;
+		std::vector<float_t> scaX, scaY, scaZ;
+
+		size_t size() const { return posX.size(); }
+		void resize(size_t count);  // @NOTE: keeps the capacity when shrinking, so reuse these between frames.
+		void set(size_t index, vec3 position, versor rotation, vec3 scale);
+	};
+
+	// `outMatrices[i]` = translate(pos) * rotate(rot) * scale(sca), the same matrix as doing `glm_translate()`,
+	// `glm_quat_rotate()` and `glm_scale()` onto an identity matrix.
+	void compose(const TRSArrays& trs, mat4* outMatrices);
+	void composeReference(const TRSArrays& trs, mat4* outMatrices);
+
+	// Lerps the positions and scales and nlerps the rotations, like `glm_vec3_lerp()` and `glm_quat_nlerp()`.
+	void interpolate(const TRSArrays& from, const TRSArrays& to, float_t alpha, TRSArrays& out);
+	void interpolateReference(const TRSArrays& from, const TRSArrays& to, float_t alpha, TRSArrays& out);
+
+#ifdef _DEVELOP
+	bool runSelfTest();
+	void runBenchmark();
+#endif
+}
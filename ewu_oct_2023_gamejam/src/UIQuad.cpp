@@ -1,6 +1,8 @@
 #include "UIQuad.h"
 
 #include <array>
+#include <algorithm>
+#include <iostream>
 #include <functional>
 #include "TextMesh.h"
 #include "VulkanEngine.h"
@@ -17,10 +19,35 @@ namespace ui
     AllocatedBuffer indexBuffer;
     uint32_t indexCount;
 
-    VkPipeline texturedQuadPipeline;
-    VkPipelineLayout texturedQuadPipelineLayout;
-    VkPipeline colorQuadPipeline;
-    VkPipelineLayout colorQuadPipelineLayout;
+    // @NOTE: all visible quads get drawn with a single instanced draw. Each quad is one instance in
+    //        `instanceBuffers` and picks its texture out of a texture array by index, so there's no
+    //        per-quad descriptor sets or push constants. Must match `ui_quad_batched.vert/.frag`.
+    constexpr uint32_t MAX_UI_QUADS = 1024;
+    constexpr uint32_t MAX_UI_QUAD_TEXTURES = 64;
+
+    struct GPUUIQuadInstance
+    {
+        vec4 position;
+        versor rotation;
+        vec4 scale;
+        vec4 tint;
+        vec4 nineSlicingBounds;  // x1, x2, y1, y2
+        int32_t textureIndex;    // -1 is a flat color quad.
+        float_t useNineSlicing;
+        float_t padding0;
+        float_t padding1;
+    };
+
+    AllocatedBuffer instanceBuffers[FRAME_OVERLAP];
+    VkDescriptorSet quadSets[FRAME_OVERLAP];
+    VkDescriptorSetLayout quadSetLayout;
+
+    std::vector<Texture*> textureSlots;
+    uint32_t textureSlotsVersion = 0;
+    uint32_t quadSetTextureVersions[FRAME_OVERLAP] = {};
+
+    VkPipeline quadPipeline;
+    VkPipelineLayout quadPipelineLayout;
 
     void init(VulkanEngine* e)
     {
@@ -101,23 +128,99 @@ namespace ui
         vmaDestroyBuffer(engine->_allocator, indexStaging._buffer, indexStaging._allocation);
     }
 
-    void initDescriptor(UIQuad* uiQuad)
+    void fillTextureImageInfos(VkDescriptorImageInfo* imageInfos)
     {
-		VkDescriptorImageInfo imageInfo = {
-			.sampler = uiQuad->texture->sampler,
-			.imageView = uiQuad->texture->imageView,
-			.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-		};
-
-        vkutil::DescriptorBuilder::begin()
-            .bindImage(0, &imageInfo, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
-            .build(uiQuad->builtTextureSet);
+        // Unused slots just point at the empty texture, since every element of the array has to be valid.
+        Texture& emptyTexture = engine->_loadedTextures["empty"];
+        for (uint32_t i = 0; i < MAX_UI_QUAD_TEXTURES; i++)
+        {
+            Texture* texture = (i < textureSlots.size()) ? textureSlots[i] : &emptyTexture;
+            imageInfos[i] = {
+                .sampler = texture->sampler,
+                .imageView = texture->imageView,
+                .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+            };
+        }
+    }
+
+    void initQuadSets()
+    {
+        VkDescriptorImageInfo imageInfos[MAX_UI_QUAD_TEXTURES];
+        fillTextureImageInfos(imageInfos);
+
+        for (uint32_t i = 0; i < FRAME_OVERLAP; i++)
+        {
+            instanceBuffers[i] =
+                engine->createBuffer(
+                    sizeof(GPUUIQuadInstance) * MAX_UI_QUADS,
+                    VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                    VMA_MEMORY_USAGE_CPU_TO_GPU
+                );
+
+            VkDescriptorBufferInfo instanceBufferInfo = {
+                .buffer = instanceBuffers[i]._buffer,
+                .offset = 0,
+                .range = sizeof(GPUUIQuadInstance) * MAX_UI_QUADS,
+            };
+
+            vkutil::DescriptorBuilder::begin()
+                .bindBuffer(0, &instanceBufferInfo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
+                .bindImageArray(1, MAX_UI_QUAD_TEXTURES, imageInfos, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT)
+                .build(quadSets[i], quadSetLayout);
+            quadSetTextureVersions[i] = textureSlotsVersion;
+        }
+    }
+
+    void updateQuadSetTexturesIfStale(uint32_t frameIndex)
+    {
+        // @NOTE: this frame's set isn't in use by the gpu anymore (its render fence got waited on), so it can
+        //        get rewritten here without touching the other frame in flight's set.
+        if (quadSetTextureVersions[frameIndex] == textureSlotsVersion)
+            return;
+
+        VkDescriptorImageInfo imageInfos[MAX_UI_QUAD_TEXTURES];
+        fillTextureImageInfos(imageInfos);
+
+        VkWriteDescriptorSet write = {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+            .pNext = nullptr,
+            .dstSet = quadSets[frameIndex],
+            .dstBinding = 1,
+            .dstArrayElement = 0,
+            .descriptorCount = MAX_UI_QUAD_TEXTURES,
+            .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+            .pImageInfo = imageInfos,
+        };
+        vkUpdateDescriptorSets(engine->_device, 1, &write, 0, nullptr);
+        quadSetTextureVersions[frameIndex] = textureSlotsVersion;
+    }
+
+    int32_t getTextureSlot(Texture* texture)
+    {
+        for (size_t i = 0; i < textureSlots.size(); i++)
+            if (textureSlots[i] == texture)
+                return (int32_t)i;
+
+        if (textureSlots.size() >= MAX_UI_QUAD_TEXTURES)
+        {
+            std::cerr << "[UI QUAD]" << std::endl
+                << "ERROR: ran out of texture slots (MAX_UI_QUAD_TEXTURES = " << MAX_UI_QUAD_TEXTURES << "). Using texture slot 0 instead." << std::endl;
+            return 0;
+        }
+
+        textureSlots.push_back(texture);
+        textureSlotsVersion++;
+        return (int32_t)textureSlots.size() - 1;
     }
 
     void initPipeline(VkViewport& screenspaceViewport, VkRect2D& screenspaceScissor, DeletionQueue& deletionQueue)
     {
-        if (texturedQuadPipeline == VK_NULL_HANDLE)
-            initMesh();  // First time.
+        if (quadSetLayout == VK_NULL_HANDLE)
+        {
+            // First time.
+            initMesh();
+            initQuadSets();
+        }
 
         // Setup vertex descriptions
         // @COPYPASTA TextMesh.cpp
@@ -154,57 +257,11 @@ namespace ui
 
         // Build pipeline
         vkutil::pipelinebuilder::build(
-            {
-                VkPushConstantRange{
-                    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-                    .offset = 0,
-                    .size = sizeof(textmesh::GPUSDFFontPushConstants)
-                },
-                VkPushConstantRange{
-                    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-                    .offset = sizeof(textmesh::GPUSDFFontPushConstants),
-                    .size = sizeof(UIQuadSettingsConstBlock)
-                },
-            },
-            { textmesh::gpuUICameraSetLayout, engine->_singleTextureSetLayout },
-            {
-                { VK_SHADER_STAGE_VERTEX_BIT, "shader/sdf.vert.spv" },
-                { VK_SHADER_STAGE_FRAGMENT_BIT, "shader/textured_ui_quad.frag.spv" },
-            },
-            attributes,
-            bindings,
-            vkinit::inputAssemblyCreateInfo(VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST),
-            screenspaceViewport,
-            screenspaceScissor,
-            vkinit::rasterizationStateCreateInfo(VK_POLYGON_MODE_FILL, VK_CULL_MODE_BACK_BIT),
-            { blendAttachmentState },
-            vkinit::multisamplingStateCreateInfo(),
-            vkinit::depthStencilCreateInfo(false, false, VK_COMPARE_OP_NEVER),
             {},
-            engine->_uiRenderPass,
-            0,
-            texturedQuadPipeline,
-            texturedQuadPipelineLayout,
-            deletionQueue
-        );
-
-        vkutil::pipelinebuilder::build(
-            {
-                VkPushConstantRange{
-                    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-                    .offset = 0,
-                    .size = sizeof(textmesh::GPUSDFFontPushConstants)
-                },
-                VkPushConstantRange{
-                    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
-                    .offset = sizeof(textmesh::GPUSDFFontPushConstants),
-                    .size = sizeof(ColorPushConstBlock)
-                },
-            },
-            { textmesh::gpuUICameraSetLayout },
+            { textmesh::gpuUICameraSetLayout, quadSetLayout },
             {
-                { VK_SHADER_STAGE_VERTEX_BIT, "shader/sdf.vert.spv" },
-                { VK_SHADER_STAGE_FRAGMENT_BIT, "shader/color_ui_quad.frag.spv" },
+                { VK_SHADER_STAGE_VERTEX_BIT, "shader/ui_quad_batched.vert.spv" },
+                { VK_SHADER_STAGE_FRAGMENT_BIT, "shader/ui_quad_batched.frag.spv" },
             },
             attributes,
             bindings,
@@ -218,8 +275,8 @@ namespace ui
             {},
             engine->_uiRenderPass,
             0,
-            colorQuadPipeline,
-            colorQuadPipelineLayout,
+            quadPipeline,
+            quadPipelineLayout,
             deletionQueue
         );
     }
@@ -229,105 +286,133 @@ namespace ui
         // Destroy square mesh for rendering
         vmaDestroyBuffer(engine->_allocator, vertexBuffer._buffer, vertexBuffer._allocation);
         vmaDestroyBuffer(engine->_allocator, indexBuffer._buffer, indexBuffer._allocation);
+
+        for (uint32_t i = 0; i < FRAME_OVERLAP; i++)
+            vmaDestroyBuffer(engine->_allocator, instanceBuffers[i]._buffer, instanceBuffers[i]._allocation);
     }
 
+    // @NOTE: kept sorted by `renderOrder` (highest first, since those get drawn first) at all times, so
+    //        rendering never has to sort. Quads with the same `renderOrder` draw in registration order.
     std::vector<UIQuad*> registeredUIQuads;
+    uint32_t numReorders = 0;
+    uint32_t numReordersLastFrame = 0;
+
+    void insertSorted(UIQuad* uiQuad)
+    {
+        auto it =
+            std::upper_bound(
+                registeredUIQuads.begin(),
+                registeredUIQuads.end(),
+                uiQuad,
+                [](UIQuad* a, UIQuad* b) {
+                    return a->renderOrder > b->renderOrder;
+                }
+            );
+        registeredUIQuads.insert(it, uiQuad);
+        numReorders++;
+    }
+
+    void removeSorted(UIQuad* uiQuad)
+    {
+        auto it = std::find(registeredUIQuads.begin(), registeredUIQuads.end(), uiQuad);
+        if (it == registeredUIQuads.end())
+            return;
+        registeredUIQuads.erase(it);
+        numReorders++;
+    }
 
     UIQuad* registerUIQuad(Texture* texture)
     {
         UIQuad* ret = new UIQuad;
         ret->texture = texture;
         if (ret->texture)
-            initDescriptor(ret);
+            ret->textureIndex = getTextureSlot(ret->texture);
 
-        registeredUIQuads.push_back(ret);
+        insertSorted(ret);
         return ret;
     }
 
     void unregisterUIQuad(UIQuad* toDelete)
     {
-        registeredUIQuads.erase(
-            std::remove(
-                registeredUIQuads.begin(),
-                registeredUIQuads.end(),
-                toDelete
-            ),
-            registeredUIQuads.end()
-        );
+        removeSorted(toDelete);
+    }
+
+    void setRenderOrder(UIQuad* uiQuad, float_t renderOrder)
+    {
+        if (uiQuad->renderOrder == renderOrder)
+            return;
+
+        removeSorted(uiQuad);
+        uiQuad->renderOrder = renderOrder;
+        insertSorted(uiQuad);
+    }
+
+    uint32_t getNumReordersLastFrame()
+    {
+        return numReordersLastFrame;
     }
 
     void renderQuads(VkCommandBuffer cmd, const std::vector<UIQuad*>& sortedUIQuads)
     {
+        uint32_t frameIndex = engine->_frameNumber % FRAME_OVERLAP;
+        updateQuadSetTexturesIfStale(frameIndex);
 
-        textmesh::GPUSDFFontPushConstants pc = {
-            .renderInScreenspace = (float_t)true,
-        };
-        ColorPushConstBlock cpc = {};
-        UIQuadSettingsConstBlock uqspc = {};
-        
-        VkPipeline pipeline = texturedQuadPipeline;
-        VkPipelineLayout pipelineLayout = texturedQuadPipelineLayout;
-        bool prevIsTextured = false;
-        bool first = true;
-        for (size_t i = 0; i < sortedUIQuads.size(); i++)
+        // Write all visible quads into this frame's instance buffer.
+        // @NOTE: instances get rasterized in order, so they still blend in the sorted order even though
+        //        it's all one draw call.
+        uint32_t numInstances = 0;
+        void* data;
+        vmaMapMemory(engine->_allocator, instanceBuffers[frameIndex]._allocation, &data);
+        GPUUIQuadInstance* instances = (GPUUIQuadInstance*)data;
+        for (UIQuad* quad : sortedUIQuads)
         {
-            if (!sortedUIQuads[i]->visible)
+            if (!quad->visible)
                 continue;
-
-            bool isTextured = (sortedUIQuads[i]->texture != nullptr);
-            if (first || isTextured != prevIsTextured)
+            if (numInstances >= MAX_UI_QUADS)
             {
-                pipeline = isTextured ? texturedQuadPipeline : colorQuadPipeline;
-                pipelineLayout = isTextured ? texturedQuadPipelineLayout : colorQuadPipelineLayout;
-                vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &textmesh::gpuUICameraDescriptorSet, 0, nullptr);
-                first = false;
-                prevIsTextured = isTextured;
+                std::cerr << "[UI QUAD]" << std::endl
+                    << "ERROR: too many visible UI quads (MAX_UI_QUADS = " << MAX_UI_QUADS << "). Skipping the rest." << std::endl;
+                break;
             }
 
-            glm_vec4_copy(sortedUIQuads[i]->tint, (isTextured ? uqspc.tint : cpc.color));
-
-            glm_mat4_identity(pc.modelMatrix);
-            glm_translate(pc.modelMatrix, sortedUIQuads[i]->position);
-            glm_quat_rotate(pc.modelMatrix, sortedUIQuads[i]->rotation, pc.modelMatrix);
-            glm_scale(pc.modelMatrix, sortedUIQuads[i]->scale);
-
-            if (isTextured)
+            GPUUIQuadInstance& instance = instances[numInstances++];
+            glm_vec4(quad->position, 0.0f, instance.position);
+            glm_quat_copy(quad->rotation, instance.rotation);
+            glm_vec4(quad->scale, 0.0f, instance.scale);
+            glm_vec4_copy(quad->tint, instance.tint);
+            instance.textureIndex = (quad->texture != nullptr) ? quad->textureIndex : -1;
+            instance.useNineSlicing = (float_t)(quad->texture != nullptr && quad->useNineSlicing);
+            if (instance.useNineSlicing > 0.0f)
             {
-                uqspc.useNineSlicing = (float_t)sortedUIQuads[i]->useNineSlicing;
-                if (sortedUIQuads[i]->useNineSlicing)
-                {
-                    uqspc.nineSlicingBoundX1 = sortedUIQuads[i]->nineSlicingSizeX / sortedUIQuads[i]->scale[0];  // Scaling the nineslicing from units to uv coordinate units.
-                    uqspc.nineSlicingBoundY1 = sortedUIQuads[i]->nineSlicingSizeY / sortedUIQuads[i]->scale[1];
-                    uqspc.nineSlicingBoundX2 = 1.0f - uqspc.nineSlicingBoundX1;
-                    uqspc.nineSlicingBoundY2 = 1.0f - uqspc.nineSlicingBoundY1;
-                }
+                float_t boundX1 = quad->nineSlicingSizeX / quad->scale[0];  // Scaling the nineslicing from units to uv coordinate units.
+                float_t boundY1 = quad->nineSlicingSizeY / quad->scale[1];
+                instance.nineSlicingBounds[0] = boundX1;
+                instance.nineSlicingBounds[1] = 1.0f - boundX1;
+                instance.nineSlicingBounds[2] = boundY1;
+                instance.nineSlicingBounds[3] = 1.0f - boundY1;
             }
-
-            if (isTextured)
-                vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &sortedUIQuads[i]->builtTextureSet, 0, nullptr);
-            vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(textmesh::GPUSDFFontPushConstants), &pc);
-            if (isTextured)
-                vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(textmesh::GPUSDFFontPushConstants), sizeof(UIQuadSettingsConstBlock), &uqspc);
             else
-                vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(textmesh::GPUSDFFontPushConstants), sizeof(ColorPushConstBlock), &cpc);
-
-            const VkDeviceSize offsets[1] = { 0 };
-            vkCmdBindVertexBuffers(cmd, 0, 1, &vertexBuffer._buffer, offsets);
-            vkCmdBindIndexBuffer(cmd, indexBuffer._buffer, 0, VK_INDEX_TYPE_UINT32);
-            vkCmdDrawIndexed(cmd, indexCount, 1, 0, 0, 0);
+                glm_vec4_zero(instance.nineSlicingBounds);
         }
+        vmaUnmapMemory(engine->_allocator, instanceBuffers[frameIndex]._allocation);
+
+        if (numInstances == 0)
+            return;
+
+        VkDescriptorSet sets[] = { textmesh::gpuUICameraDescriptorSet, quadSets[frameIndex] };
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, quadPipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, quadPipelineLayout, 0, 2, sets, 0, nullptr);
+
+        const VkDeviceSize offsets[1] = { 0 };
+        vkCmdBindVertexBuffers(cmd, 0, 1, &vertexBuffer._buffer, offsets);
+        vkCmdBindIndexBuffer(cmd, indexBuffer._buffer, 0, VK_INDEX_TYPE_UINT32);
+        vkCmdDrawIndexed(cmd, indexCount, numInstances, 0, 0, 0);
     }
 
     void renderUIQuads(VkCommandBuffer cmd)
     {
-        std::sort(
-            registeredUIQuads.begin(),
-            registeredUIQuads.end(),
-            [&](UIQuad* a, UIQuad* b) {
-                return a->renderOrder > b->renderOrder;
-            }
-        );
+        numReordersLastFrame = numReorders;
+        numReorders = 0;
         renderQuads(cmd, registeredUIQuads);
     }
 }
\ No newline at end of file
@@ -17,7 +17,7 @@ namespace ui
     {
         bool visible     = true;
         Texture* texture = nullptr;
-        VkDescriptorSet builtTextureSet;
+        int32_t textureIndex = -1;  // Slot in the UI texture array. Set by `registerUIQuad()`.
         bool useNineSlicing = false;
         float_t nineSlicingSizeX = 1.0f;
         float_t nineSlicingSizeY = 1.0f;
@@ -26,7 +26,7 @@ namespace ui
         vec3 position = GLM_VEC3_ZERO_INIT;
         versor rotation = GLM_QUAT_IDENTITY_INIT;
         vec3 scale = GLM_VEC3_ONE_INIT;
-        float_t renderOrder = 0.0f;
+        float_t renderOrder = 0.0f;  // @NOTE: read-only. Change it with `setRenderOrder()` so the quad gets re-sorted.
     };
 
     void init(VulkanEngine* engine);
@@ -35,5 +35,7 @@ namespace ui
 
     UIQuad* registerUIQuad(Texture* texture);
     void unregisterUIQuad(UIQuad* toDelete);
+    void setRenderOrder(UIQuad* uiQuad, float_t renderOrder);
+    uint32_t getNumReordersLastFrame();  // Number of times a quad got (re)inserted into or removed from the sorted list.
     void renderUIQuads(VkCommandBuffer cmd);
 }
\ No newline at end of file
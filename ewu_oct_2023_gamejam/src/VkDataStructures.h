@@ -4,6 +4,7 @@
 #include <vma/vk_mem_alloc.h>
 #include <functional>
 #include <deque>
+#include "VkDeletionQueue.h"
 
 namespace vkglTF { struct Model; }
 
@@ -47,6 +48,11 @@ struct Material
 	VkPipelineLayout pipelineLayout;
 };
 
+// @NOTE: index into the engine's material list. Stays valid for the lifetime of the engine, so render
+//        code should look a material up by name once and keep the handle.
+using MaterialHandle = uint32_t;
+constexpr MaterialHandle INVALID_MATERIAL_HANDLE = ~0u;
+
 struct MeshCapturedInfo
 {
 	vkglTF::Model* model;
@@ -64,23 +70,3 @@ struct IndirectBatch
 	uint32_t count;
 };
 
-struct DeletionQueue
-{
-	std::deque<std::function<void()>> deletors;
-
-	void pushFunction(std::function<void()>&& function)
-	{
-		deletors.push_back(function);
-	}
-
-	void flush()
-	{
-		// Call deletor lambdas in reverse order
-		for (auto it = deletors.rbegin(); it != deletors.rend(); it++)
-		{
-			(*it)();
-		}
-
-		deletors.clear();
-	}
-};
@@ -0,0 +1,299 @@
+#include "VkDeletionQueue.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include "VkDataStructures.h"
+
+
+namespace
+{
+	template<typename T>
+	T toHandle(uint64_t handleValue)
+	{
+		if constexpr (std::is_pointer_v<T>)
+			return (T)(uintptr_t)handleValue;
+		else
+			return (T)handleValue;
+	}
+}
+
+void DeletionQueue::pushFunction(std::function<void()>&& function)
+{
+	pushEntry({
+		.type = EntryType::FUNCTION,
+		.functionIndex = (uint32_t)functions.size(),
+		.owner = nullptr,
+		.handle = 0,
+		.allocation = VK_NULL_HANDLE,
+	});
+	functions.push_back(std::move(function));
+}
+
+void DeletionQueue::pushImage(VmaAllocator allocator, const AllocatedImage& image)
+{
+	pushEntry({
+		.type = EntryType::VMA_IMAGE,
+		.functionIndex = 0,
+		.owner = allocator,
+		.handle = (uint64_t)(uintptr_t)image._image,
+		.allocation = image._allocation,
+	});
+}
+
+void DeletionQueue::pushBuffer(VmaAllocator allocator, const AllocatedBuffer& buffer)
+{
+	pushEntry({
+		.type = EntryType::VMA_BUFFER,
+		.functionIndex = 0,
+		.owner = allocator,
+		.handle = (uint64_t)(uintptr_t)buffer._buffer,
+		.allocation = buffer._allocation,
+	});
+}
+
+void DeletionQueue::pushTexture(VkDevice device, VmaAllocator allocator, const Texture& texture)
+{
+	pushImage(allocator, texture.image);
+	pushTextureViewAndSampler(device, texture);
+}
+
+void DeletionQueue::pushTextureViewAndSampler(VkDevice device, const Texture& texture)
+{
+	pushImageView(device, texture.imageView);
+	pushSampler(device, texture.sampler);
+}
+
+void DeletionQueue::pushEntry(const Entry& entry)
+{
+	if (numEntries < NUM_INLINE_ENTRIES)
+		inlineEntries[numEntries] = entry;
+	else
+		overflowEntries.push_back(entry);
+	numEntries++;
+}
+
+void DeletionQueue::flush()
+{
+	// Destroy in reverse order.
+	for (size_t i = numEntries; i > 0; i--)
+	{
+		Entry entry = entryAt(i - 1);
+#ifdef _DEVELOP
+		if (INTERNALrecordDestroy && entry.type != EntryType::FUNCTION)
+		{
+			INTERNALrecordDestroy(entry);
+			continue;
+		}
+#endif
+		VkDevice device = (VkDevice)entry.owner;
+		switch (entry.type)
+		{
+			case EntryType::FUNCTION:        functions[entry.functionIndex](); break;
+			case EntryType::SAMPLER:         vkDestroySampler(device, toHandle<VkSampler>(entry.handle), nullptr); break;
+			case EntryType::IMAGE_VIEW:      vkDestroyImageView(device, toHandle<VkImageView>(entry.handle), nullptr); break;
+			case EntryType::FRAMEBUFFER:     vkDestroyFramebuffer(device, toHandle<VkFramebuffer>(entry.handle), nullptr); break;
+			case EntryType::RENDER_PASS:     vkDestroyRenderPass(device, toHandle<VkRenderPass>(entry.handle), nullptr); break;
+			case EntryType::FENCE:           vkDestroyFence(device, toHandle<VkFence>(entry.handle), nullptr); break;
+			case EntryType::SEMAPHORE:       vkDestroySemaphore(device, toHandle<VkSemaphore>(entry.handle), nullptr); break;
+			case EntryType::COMMAND_POOL:    vkDestroyCommandPool(device, toHandle<VkCommandPool>(entry.handle), nullptr); break;
+			case EntryType::DESCRIPTOR_POOL: vkDestroyDescriptorPool(device, toHandle<VkDescriptorPool>(entry.handle), nullptr); break;
+			case EntryType::SWAPCHAIN:       vkDestroySwapchainKHR(device, toHandle<VkSwapchainKHR>(entry.handle), nullptr); break;
+			case EntryType::VMA_IMAGE:       vmaDestroyImage((VmaAllocator)entry.owner, toHandle<VkImage>(entry.handle), entry.allocation); break;
+			case EntryType::VMA_BUFFER:      vmaDestroyBuffer((VmaAllocator)entry.owner, toHandle<VkBuffer>(entry.handle), entry.allocation); break;
+		}
+	}
+
+	numEntries = 0;
+	overflowEntries.clear();
+	functions.clear();
+}
+
+#ifdef _DEVELOP
+//
+// Allocation counting
+// @NOTE: replaces the global operator new for the whole _DEVELOP build, so that the self test can count
+//        every heap allocation (the `functions` vector, `std::function`'s own storage, etc.), not just
+//        the ones it knows about. The count is per thread, so it's only a thread local increment.
+//
+namespace
+{
+	thread_local size_t numAllocations = 0;
+}
+
+void* operator new(size_t size)
+{
+	numAllocations++;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t size) noexcept
+{
+	std::free(ptr);
+}
+
+namespace vkdeletionqueue
+{
+	size_t getNumAllocations()
+	{
+		return numAllocations;
+	}
+
+	// Records the order `flush()` runs through the entries in. Callbacks record their own id, and
+	// handle entries record their handle (the tests push the id as a fake handle).
+	struct FlushRecorder
+	{
+		std::vector<uint64_t> order;
+
+		FlushRecorder(DeletionQueue& deletionQueue)
+		{
+			order.reserve(256);
+			deletionQueue.INTERNALrecordDestroy = [this](const DeletionQueue::Entry& entry) { order.push_back(entry.handle); };
+		}
+
+		bool isReverseOf(const std::vector<uint64_t>& pushed) const
+		{
+			return (order.size() == pushed.size() && std::equal(order.begin(), order.end(), pushed.rbegin()));
+		}
+	};
+
+	bool runSelfTest()
+	{
+		std::cout << "[DELETION QUEUE SELF TEST]" << std::endl;
+		bool success = true;
+
+		// Past the inline entries, so both the inline and the overflow entries get used.
+		constexpr uint64_t numPushes = DeletionQueue::NUM_INLINE_ENTRIES * 3;
+		std::vector<uint64_t> pushed;
+		pushed.reserve(256);
+
+		//
+		// Callbacks only.
+		//
+		{
+			DeletionQueue deletionQueue;
+			FlushRecorder recorder(deletionQueue);
+			pushed.clear();
+			for (uint64_t i = 1; i <= numPushes; i++)
+			{
+				deletionQueue.pushFunction([&recorder, i]() { recorder.order.push_back(i); });
+				pushed.push_back(i);
+			}
+			if (deletionQueue.size() != numPushes)
+			{
+				std::cout << "  FAIL  callbacks: " << deletionQueue.size() << " entries, expected " << numPushes << std::endl;
+				success = false;
+			}
+
+			deletionQueue.flush();
+			if (!recorder.isReverseOf(pushed) || deletionQueue.size() != 0)
+			{
+				std::cout << "  FAIL  callbacks didn't run exactly once in reverse order" << std::endl;
+				success = false;
+			}
+		}
+
+		//
+		// Callbacks interleaved with handles (including the multi-entry pushes), so that the
+		// callbacks' indices into `functions` and the handle entries have to stay in one order.
+		//
+		{
+			DeletionQueue deletionQueue;
+			FlushRecorder recorder(deletionQueue);
+			pushed.clear();
+			uint64_t id = 1;
+			auto nextHandle = [&]() { pushed.push_back(id); return id++; };
+			for (uint64_t i = 0; i < numPushes / 4; i++)
+			{
+				uint64_t functionId = nextHandle();
+				deletionQueue.pushFunction([&recorder, functionId]() { recorder.order.push_back(functionId); });
+				deletionQueue.pushSampler(VK_NULL_HANDLE, (VkSampler)nextHandle());
+
+				AllocatedBuffer buffer = {};
+				buffer._buffer = (VkBuffer)nextHandle();
+				deletionQueue.pushBuffer(VK_NULL_HANDLE, buffer);
+
+				Texture texture = {};
+				texture.image._image = (VkImage)nextHandle();
+				texture.imageView = (VkImageView)nextHandle();
+				texture.sampler = (VkSampler)nextHandle();
+				deletionQueue.pushTexture(VK_NULL_HANDLE, VK_NULL_HANDLE, texture);
+			}
+
+			deletionQueue.flush();
+			if (!recorder.isReverseOf(pushed) || deletionQueue.size() != 0)
+			{
+				std::cout << "  FAIL  callbacks and handles didn't get flushed exactly once in reverse order" << std::endl;
+				success = false;
+			}
+		}
+
+		//
+		// Refilling after a flush must reuse the storage from before (the overflow entries and `functions`).
+		//
+		{
+			DeletionQueue deletionQueue;
+			FlushRecorder recorder(deletionQueue);
+			for (int32_t round = 0; round < 2; round++)
+			{
+				recorder.order.clear();
+				size_t allocationsBefore = getNumAllocations();
+				for (uint64_t i = 1; i <= numPushes; i++)
+				{
+					if (i % 2 == 0)
+						deletionQueue.pushFunction([&recorder, i]() { recorder.order.push_back(i); });
+					else
+						deletionQueue.pushFence(VK_NULL_HANDLE, (VkFence)i);
+				}
+				deletionQueue.flush();
+				size_t allocations = getNumAllocations() - allocationsBefore;
+
+				if (round == 1 && allocations != 0)
+				{
+					std::cout << "  FAIL  refilling after a flush made " << allocations << " heap allocation(s)" << std::endl;
+					success = false;
+				}
+			}
+		}
+
+		//
+		// Handles that fit in the inline entries never touch the heap.
+		//
+		{
+			DeletionQueue smallQueue;
+			FlushRecorder recorder(smallQueue);
+			pushed.clear();
+			size_t allocationsBefore = getNumAllocations();
+			for (uint64_t i = 1; i <= DeletionQueue::NUM_INLINE_ENTRIES; i++)
+			{
+				smallQueue.pushSampler(VK_NULL_HANDLE, (VkSampler)i);
+				pushed.push_back(i);
+			}
+			smallQueue.flush();
+			size_t allocations = getNumAllocations() - allocationsBefore;
+
+			if (allocations != 0)
+			{
+				std::cout << "  FAIL  pushing and flushing " << DeletionQueue::NUM_INLINE_ENTRIES << " handles made " << allocations << " heap allocation(s)" << std::endl;
+				success = false;
+			}
+			if (!recorder.isReverseOf(pushed))
+			{
+				std::cout << "  FAIL  inline handles didn't get flushed exactly once in reverse order" << std::endl;
+				success = false;
+			}
+		}
+
+		std::cout << (success ? "PASSED" : "FAILED") << std::endl;
+		return success;
+	}
+}
+#endif
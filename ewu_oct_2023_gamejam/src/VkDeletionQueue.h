@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vma/vk_mem_alloc.h>
+#include <functional>
+#include <vector>
+#include <cstdint>
+#include <type_traits>
+struct AllocatedBuffer;
+struct AllocatedImage;
+struct Texture;
+
+
+// @NOTE: the Vulkan handles (or VMA allocations) to destroy get recorded as plain entries, and the first
+//        `NUM_INLINE_ENTRIES` of them live inside the queue itself, so pushing a handle doesn't allocate.
+//        Anything else (e.g. destroying a pipeline that can get hot reloaded) can still go in as a callback.
+//        `flush()` destroys everything in reverse order of being pushed (so push an image before its
+//        image view, i.e. in creation order).
+struct DeletionQueue
+{
+	enum class EntryType : uint8_t
+	{
+		FUNCTION = 0,
+		SAMPLER,
+		IMAGE_VIEW,
+		FRAMEBUFFER,
+		RENDER_PASS,
+		FENCE,
+		SEMAPHORE,
+		COMMAND_POOL,
+		DESCRIPTOR_POOL,
+		SWAPCHAIN,
+		VMA_IMAGE,
+		VMA_BUFFER,
+	};
+
+	struct Entry
+	{
+		EntryType type;
+		uint32_t functionIndex;  // Into `functions` (FUNCTION only).
+		void* owner;             // VkDevice, or VmaAllocator for the VMA_* types.
+		uint64_t handle;
+		VmaAllocation allocation;
+	};
+
+	static constexpr size_t NUM_INLINE_ENTRIES = 32;
+
+	void pushFunction(std::function<void()>&& function);
+
+	void pushSampler(VkDevice device, VkSampler sampler)                      { pushHandle(EntryType::SAMPLER, device, sampler); }
+	void pushImageView(VkDevice device, VkImageView imageView)                { pushHandle(EntryType::IMAGE_VIEW, device, imageView); }
+	void pushFramebuffer(VkDevice device, VkFramebuffer framebuffer)          { pushHandle(EntryType::FRAMEBUFFER, device, framebuffer); }
+	void pushRenderPass(VkDevice device, VkRenderPass renderPass)             { pushHandle(EntryType::RENDER_PASS, device, renderPass); }
+	void pushFence(VkDevice device, VkFence fence)                            { pushHandle(EntryType::FENCE, device, fence); }
+	void pushSemaphore(VkDevice device, VkSemaphore semaphore)                { pushHandle(EntryType::SEMAPHORE, device, semaphore); }
+	void pushCommandPool(VkDevice device, VkCommandPool commandPool)          { pushHandle(EntryType::COMMAND_POOL, device, commandPool); }
+	void pushDescriptorPool(VkDevice device, VkDescriptorPool descriptorPool) { pushHandle(EntryType::DESCRIPTOR_POOL, device, descriptorPool); }
+	void pushSwapchain(VkDevice device, VkSwapchainKHR swapchain)             { pushHandle(EntryType::SWAPCHAIN, device, swapchain); }
+	void pushImage(VmaAllocator allocator, const AllocatedImage& image);
+	void pushBuffer(VmaAllocator allocator, const AllocatedBuffer& buffer);
+	void pushTexture(VkDevice device, VmaAllocator allocator, const Texture& texture);  // Image, image view and sampler.
+	void pushTextureViewAndSampler(VkDevice device, const Texture& texture);           // When the image is owned by someone else.
+
+	void flush();
+	size_t size() const { return numEntries; }
+
+#ifdef _DEVELOP
+	// @NOTE: only for the self test. When set, `flush()` hands the handle entries to this instead of destroying them.
+	std::function<void(const Entry&)> INTERNALrecordDestroy;
+#endif
+
+private:
+	template<typename T>
+	void pushHandle(EntryType type, VkDevice device, T handle)
+	{
+		uint64_t handleValue;
+		if constexpr (std::is_pointer_v<T>)
+			handleValue = (uint64_t)(uintptr_t)handle;
+		else
+			handleValue = (uint64_t)handle;
+		pushEntry({
+			.type = type,
+			.functionIndex = 0,
+			.owner = device,
+			.handle = handleValue,
+			.allocation = VK_NULL_HANDLE,
+		});
+	}
+
+	void pushEntry(const Entry& entry);
+	Entry& entryAt(size_t index) { return (index < NUM_INLINE_ENTRIES ? inlineEntries[index] : overflowEntries[index - NUM_INLINE_ENTRIES]); }
+
+	Entry inlineEntries[NUM_INLINE_ENTRIES];
+	std::vector<Entry> overflowEntries;           // @NOTE: keeps its capacity after a flush, so refilling the queue (e.g. recreating the swapchain) doesn't allocate again.
+	std::vector<std::function<void()>> functions;
+	size_t numEntries = 0;
+};
+
+#ifdef _DEVELOP
+namespace vkdeletionqueue
+{
+	size_t getNumAllocations();  // Heap allocations made by this thread so far.
+	bool runSelfTest();
+}
+#endif
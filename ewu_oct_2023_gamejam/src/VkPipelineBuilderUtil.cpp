@@ -2,6 +2,14 @@
 
 #include <iostream>
 #include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <algorithm>
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/for_each.hpp>
 #include "VkDataStructures.h"
 #include "VkInitializers.h"
 
@@ -34,17 +42,153 @@ namespace vkutil
         }
     }
 
+    namespace pipelinecache
+    {
+        const std::string PIPELINE_CACHE_PATH = "cache/pipeline_cache.bin";
+        constexpr char     PIPELINE_CACHE_MAGIC[4] = { 'H', 'P', 'L', 'C' };
+        constexpr uint32_t PIPELINE_CACHE_VERSION  = 1;
+
+        struct PipelineCacheFileHeader
+        {
+            char     magic[4];
+            uint32_t version;
+            uint32_t vendorID;
+            uint32_t deviceID;
+            uint32_t driverVersion;
+            uint8_t  pipelineCacheUUID[VK_UUID_SIZE];
+            uint64_t dataSize;
+        };
+
+        VkDevice device;
+        VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+        PipelineCacheFileHeader deviceHeader;  // What a saved cache has to match to be used.
+
+        void init(VkDevice newDevice, const VkPhysicalDeviceProperties& gpuProperties)
+        {
+            device = newDevice;
+
+            deviceHeader = {
+                .version = PIPELINE_CACHE_VERSION,
+                .vendorID = gpuProperties.vendorID,
+                .deviceID = gpuProperties.deviceID,
+                .driverVersion = gpuProperties.driverVersion,
+                .dataSize = 0,
+            };
+            memcpy(deviceHeader.magic, PIPELINE_CACHE_MAGIC, sizeof(PIPELINE_CACHE_MAGIC));
+            memcpy(deviceHeader.pipelineCacheUUID, gpuProperties.pipelineCacheUUID, VK_UUID_SIZE);
+
+            //
+            // Load the saved cache
+            //
+            std::vector<char> initialData;
+            std::string status;
+            std::ifstream file(PIPELINE_CACHE_PATH, std::ios::in | std::ios::binary);
+            PipelineCacheFileHeader header;
+            if (!file.is_open())
+                status = "No saved pipeline cache. Starting with an empty one.";
+            else if (!file.read((char*)&header, sizeof(header)) ||
+                memcmp(header.magic, PIPELINE_CACHE_MAGIC, sizeof(PIPELINE_CACHE_MAGIC)) != 0 ||
+                header.version != PIPELINE_CACHE_VERSION)
+                status = "Saved pipeline cache is invalid. Starting with an empty one.";
+            else if (header.vendorID != deviceHeader.vendorID ||
+                header.deviceID != deviceHeader.deviceID ||
+                header.driverVersion != deviceHeader.driverVersion ||
+                memcmp(header.pipelineCacheUUID, deviceHeader.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+                status = "Saved pipeline cache is from a different device or driver. Starting with an empty one.";
+            else
+            {
+                initialData.resize(header.dataSize);
+                if (file.read(initialData.data(), header.dataSize))
+                    status = "Loaded saved pipeline cache (" + std::to_string(header.dataSize / 1024) + " KB).";
+                else
+                {
+                    initialData.clear();
+                    status = "Saved pipeline cache is truncated. Starting with an empty one.";
+                }
+            }
+
+            VkPipelineCacheCreateInfo cacheInfo = {
+                .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+                .pNext = nullptr,
+                .flags = 0,
+                .initialDataSize = initialData.size(),
+                .pInitialData = initialData.data(),
+            };
+            if (vkCreatePipelineCache(device, &cacheInfo, nullptr, &pipelineCache) != VK_SUCCESS)
+            {
+                // The driver rejected the data, so just start fresh.
+                status = "Driver rejected the saved pipeline cache. Starting with an empty one.";
+                cacheInfo.initialDataSize = 0;
+                cacheInfo.pInitialData = nullptr;
+                VK_CHECK(vkCreatePipelineCache(device, &cacheInfo, nullptr, &pipelineCache));
+            }
+
+            std::cout << "[LOAD PIPELINE CACHE]" << std::endl
+                << status << std::endl;
+        }
+
+        void saveAndCleanup()
+        {
+            if (pipelineCache == VK_NULL_HANDLE)
+                return;
+
+            size_t dataSize = 0;
+            std::vector<char> data;
+            if (vkGetPipelineCacheData(device, pipelineCache, &dataSize, nullptr) == VK_SUCCESS)
+            {
+                data.resize(dataSize);
+                if (vkGetPipelineCacheData(device, pipelineCache, &dataSize, data.data()) != VK_SUCCESS)
+                    data.clear();
+                data.resize(std::min(dataSize, data.size()));
+            }
+
+            if (!data.empty())
+            {
+                std::filesystem::create_directories(std::filesystem::path(PIPELINE_CACHE_PATH).parent_path());
+                std::ofstream file(PIPELINE_CACHE_PATH, std::ios::out | std::ios::binary | std::ios::trunc);
+                if (file.is_open())
+                {
+                    PipelineCacheFileHeader header = deviceHeader;
+                    header.dataSize = data.size();
+                    file.write((const char*)&header, sizeof(header));
+                    file.write(data.data(), data.size());
+                    std::cout << "[SAVE PIPELINE CACHE]" << std::endl
+                        << "Saved " << (data.size() / 1024) << " KB to \"" << PIPELINE_CACHE_PATH << "\"" << std::endl;
+                }
+                else
+                    std::cerr << "[SAVE PIPELINE CACHE]" << std::endl
+                        << "ERROR: could not open \"" << PIPELINE_CACHE_PATH << "\" for writing" << std::endl;
+            }
+
+            vkDestroyPipelineCache(device, pipelineCache, nullptr);
+            pipelineCache = VK_NULL_HANDLE;
+        }
+
+        VkPipelineCache getPipelineCache()
+        {
+            return pipelineCache;
+        }
+    }
+
     namespace pipelinebuilder
     {
-        bool loadShaderModule(const char* filePath, VkShaderModule& outShaderModule)
+        std::mutex printMutex;  // @NOTE: pipelines (and their shader modules) get built on multiple threads.
+        tf::Executor* executor = nullptr;
+
+        void init(tf::Executor& newExecutor)
         {
-            std::cout << "[LOAD SHADER MODULE]" << std::endl;
+            executor = &newExecutor;
+        }
 
+        bool loadShaderModule(const char* filePath, VkShaderModule& outShaderModule)
+        {
             // Open SPIRV file
             std::ifstream file(filePath, std::ios::ate | std::ios::binary);
             if (!file.is_open())
             {
-                std::cerr << "ERROR: could not open file " << filePath << std::endl;
+                std::lock_guard<std::mutex> lg(printMutex);
+                std::cerr << "[LOAD SHADER MODULE]" << std::endl
+                    << "ERROR: could not open file " << filePath << std::endl;
                 return false;
             }
 
@@ -70,17 +214,176 @@ namespace vkutil
             VkShaderModule shaderModule;
             if (vkCreateShaderModule(pipelinelayoutcache::device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS)
             {
-                std::cerr << "ERROR: could not create shader module for shader file " << filePath << std::endl;
+                std::lock_guard<std::mutex> lg(printMutex);
+                std::cerr << "[LOAD SHADER MODULE]" << std::endl
+                    << "ERROR: could not create shader module for shader file " << filePath << std::endl;
                 return false;
             }
 
             // Successful shader creation!
             outShaderModule = shaderModule;
-
-            std::cout << "Successfully created shader module for shader file " << filePath << std::endl;
             return true;
         }
 
+        //
+        // Pipeline building
+        // @NOTE: every pipeline that's alive stays registered with everything it was built from, so that
+        //        it can get rebuilt by itself when one of its shaders changes.
+        //
+        struct ShaderStage
+        {
+            VkShaderStageFlagBits stage;
+            std::string filePath;
+        };
+
+        struct PipelineBuildJob
+        {
+            std::vector<ShaderStage>                         shaderStages;
+            std::vector<VkVertexInputAttributeDescription>   vertexAttributes;
+            std::vector<VkVertexInputBindingDescription>     vertexInputBindings;
+            VkPipelineInputAssemblyStateCreateInfo           inputAssembly;
+            VkViewport                                       viewport;
+            VkRect2D                                         scissor;
+            VkPipelineRasterizationStateCreateInfo           rasterizationState;
+            std::vector<VkPipelineColorBlendAttachmentState> colorBlendStates;
+            VkPipelineMultisampleStateCreateInfo             multisampling;
+            VkPipelineDepthStencilStateCreateInfo            depthStencilState;
+            std::vector<VkDynamicState>                      dynamicStates;
+            VkRenderPass                                     renderPass;
+            uint32_t                                         subpass;
+            VkPipelineLayout                                 layout;
+            bool                                             isCompute = false;  // Only uses `shaderStages` and `layout`.
+
+            VkPipeline*    outPipeline;
+            DeletionQueue* deletionQueue;
+            VkPipeline     pipeline = VK_NULL_HANDLE;     // The alive one.
+            VkPipeline     newPipeline = VK_NULL_HANDLE;  // Result of the latest `createPipeline()`.
+        };
+        using PipelineBuildJobIter = std::list<PipelineBuildJob>::iterator;
+
+        std::list<PipelineBuildJob>       registeredPipelines;
+        std::vector<PipelineBuildJobIter> pendingPipelines;
+        bool                              isBatchOpen = false;
+
+        void createPipeline(PipelineBuildJob& job)
+        {
+            job.newPipeline = VK_NULL_HANDLE;
+
+            // Load shaders
+            std::vector<VkPipelineShaderStageCreateInfo> compiledShaderStages;
+            bool shadersLoaded = true;
+            for (auto& stage : job.shaderStages)
+            {
+                VkShaderModule sm;
+                if (!loadShaderModule(stage.filePath.c_str(), sm))
+                {
+                    shadersLoaded = false;
+                    continue;
+                }
+                compiledShaderStages.push_back(
+                    vkinit::pipelineShaderStageCreateInfo(stage.stage, sm));
+            }
+
+            if (shadersLoaded && job.isCompute)
+            {
+                VkComputePipelineCreateInfo pipelineInfo = {
+                    .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+                    .pNext = nullptr,
+                    .stage = compiledShaderStages[0],
+                    .layout = job.layout,
+                    .basePipelineHandle = VK_NULL_HANDLE,
+                };
+                if (vkCreateComputePipelines(pipelinelayoutcache::device, pipelinecache::getPipelineCache(), 1, &pipelineInfo, nullptr, &job.newPipeline) != VK_SUCCESS)
+                    job.newPipeline = VK_NULL_HANDLE;
+            }
+            else if (shadersLoaded)
+            {
+                // Create pipeline
+                VkPipelineViewportStateCreateInfo viewportState = {
+                    .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+                    .pNext = nullptr,
+                    .viewportCount = 1,
+                    .pViewports = &job.viewport,
+                    .scissorCount = 1,
+                    .pScissors = &job.scissor,
+                };
+
+                VkPipelineColorBlendStateCreateInfo colorBlending = {
+                    .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+                    .pNext = nullptr,
+                    .logicOpEnable = VK_FALSE,
+                    .logicOp = VK_LOGIC_OP_COPY,
+                    .attachmentCount = (uint32_t)job.colorBlendStates.size(),
+                    .pAttachments = job.colorBlendStates.data(),
+                };
+
+                VkPipelineVertexInputStateCreateInfo vertexInputInfo = vkinit::vertexInputStateCreateInfo();
+                vertexInputInfo.pVertexAttributeDescriptions = job.vertexAttributes.data();
+                vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)job.vertexAttributes.size();
+                vertexInputInfo.pVertexBindingDescriptions = job.vertexInputBindings.data();
+                vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)job.vertexInputBindings.size();
+
+                VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo = {
+                    .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+                    .dynamicStateCount = (uint32_t)job.dynamicStates.size(),
+                    .pDynamicStates = job.dynamicStates.data(),
+                };
+
+                VkGraphicsPipelineCreateInfo pipelineInfo = {
+                    .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+                    .pNext = nullptr,
+                    .stageCount = (uint32_t)compiledShaderStages.size(),
+                    .pStages = compiledShaderStages.data(),
+                    .pVertexInputState = &vertexInputInfo,
+                    .pInputAssemblyState = &job.inputAssembly,
+                    .pViewportState = &viewportState,
+                    .pRasterizationState = &job.rasterizationState,
+                    .pMultisampleState = &job.multisampling,
+                    .pDepthStencilState = &job.depthStencilState,
+                    .pColorBlendState = &colorBlending,
+                    .pDynamicState = &dynamicStateCreateInfo,
+                    .layout = job.layout,
+                    .renderPass = job.renderPass,
+                    .subpass = job.subpass,
+                    .basePipelineHandle = VK_NULL_HANDLE,
+                };
+
+                // Check for errors while creating gfx pipelines
+                if (vkCreateGraphicsPipelines(pipelinelayoutcache::device, pipelinecache::getPipelineCache(), 1, &pipelineInfo, nullptr, &job.newPipeline) != VK_SUCCESS)
+                    job.newPipeline = VK_NULL_HANDLE;
+            }
+
+            if (job.newPipeline == VK_NULL_HANDLE)
+            {
+                std::lock_guard<std::mutex> lg(printMutex);
+                std::cerr << "[BUILD GRAPHICS PIPELINE]" << std::endl
+                    << "FAILED: creating pipeline with shaders";
+                for (auto& stage : job.shaderStages)
+                    std::cerr << " " << stage.filePath;
+                std::cerr << std::endl;
+            }
+
+            // Cleanup
+            for (auto shaderStage : compiledShaderStages)
+                vkDestroyShaderModule(pipelinelayoutcache::device, shaderStage.module, nullptr);
+        }
+
+        void createPipelinesInParallel(const std::vector<PipelineBuildJobIter>& jobs)
+        {
+            if (jobs.size() == 1 || executor == nullptr)
+            {
+                for (PipelineBuildJobIter it : jobs)
+                    createPipeline(*it);
+                return;
+            }
+
+            tf::Taskflow taskflow;
+            taskflow.for_each(jobs.begin(), jobs.end(), [&](PipelineBuildJobIter it) {
+                createPipeline(*it);
+            });
+            executor->run(taskflow).wait();
+        }
+
         bool build(
             std::vector<VkPushConstantRange>                 pushConstantRanges,
             std::vector<VkDescriptorSetLayout>               setLayouts,
@@ -109,88 +412,148 @@ namespace vkutil
             layoutInfo.setLayoutCount = (uint32_t)setLayouts.size();
             outPipelineLayout = pipelinelayoutcache::createPipelineLayout(&layoutInfo);
 
-            // Load shaders
-            std::vector<VkPipelineShaderStageCreateInfo> compiledShaderStages;
+            // Queue up the pipeline
+            std::vector<ShaderStage> jobShaderStages;
             for (auto& stage : shaderStages)
+                jobShaderStages.push_back({ stage.stage, stage.filePath });
+
+            registeredPipelines.push_back({
+                .shaderStages = std::move(jobShaderStages),
+                .vertexAttributes = std::move(vertexAttributes),
+                .vertexInputBindings = std::move(vertexInputBindings),
+                .inputAssembly = inputAssembly,
+                .viewport = viewport,
+                .scissor = scissor,
+                .rasterizationState = rasterizationState,
+                .colorBlendStates = std::move(colorBlendStates),
+                .multisampling = multisampling,
+                .depthStencilState = depthStencilState,
+                .dynamicStates = std::move(dynamicStates),
+                .renderPass = renderPass,
+                .subpass = subpass,
+                .layout = outPipelineLayout,
+                .outPipeline = &outPipeline,
+                .deletionQueue = &deletionQueue,
+            });
+            pendingPipelines.push_back(std::prev(registeredPipelines.end()));
+
+            if (isBatchOpen)
+                return true;
+            return flushBatch();
+        }
+
+        bool buildCompute(
+            std::vector<VkPushConstantRange>   pushConstantRanges,
+            std::vector<VkDescriptorSetLayout> setLayouts,
+            const char*                        computeShaderFilePath,
+            VkPipeline&                        outPipeline,
+            VkPipelineLayout&                  outPipelineLayout,
+            DeletionQueue&                     deletionQueue)
+        {
+            // Create pipeline layout
+            VkPipelineLayoutCreateInfo layoutInfo = vkinit::pipelineLayoutCreateInfo();
+            layoutInfo.pPushConstantRanges = pushConstantRanges.data();
+            layoutInfo.pushConstantRangeCount = (uint32_t)pushConstantRanges.size();
+            layoutInfo.pSetLayouts = setLayouts.data();
+            layoutInfo.setLayoutCount = (uint32_t)setLayouts.size();
+            outPipelineLayout = pipelinelayoutcache::createPipelineLayout(&layoutInfo);
+
+            // Queue up the pipeline
+            registeredPipelines.push_back({
+                .shaderStages = { { VK_SHADER_STAGE_COMPUTE_BIT, computeShaderFilePath } },
+                .layout = outPipelineLayout,
+                .isCompute = true,
+                .outPipeline = &outPipeline,
+                .deletionQueue = &deletionQueue,
+            });
+            pendingPipelines.push_back(std::prev(registeredPipelines.end()));
+
+            if (isBatchOpen)
+                return true;
+            return flushBatch();
+        }
+
+        void beginBatch()
+        {
+            isBatchOpen = true;
+        }
+
+        bool flushBatch()
+        {
+            isBatchOpen = false;
+            if (pendingPipelines.empty())
+                return true;
+
+            auto timeStart = std::chrono::high_resolution_clock::now();
+            createPipelinesInParallel(pendingPipelines);
+
+            size_t numFailed = 0;
+            for (PipelineBuildJobIter it : pendingPipelines)
             {
-                VkShaderModule sm;
-                loadShaderModule(stage.filePath, sm);
-                compiledShaderStages.push_back(
-                    vkinit::pipelineShaderStageCreateInfo(stage.stage, sm));
-            }
+                if (it->newPipeline == VK_NULL_HANDLE)
+                {
+                    numFailed++;
+                    registeredPipelines.erase(it);
+                    continue;
+                }
 
-            // Create pipeline
-            VkPipelineViewportStateCreateInfo viewportState = {
-                .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-                .pNext = nullptr,
-                .viewportCount = 1,
-                .pViewports = &viewport,
-                .scissorCount = 1,
-                .pScissors = &scissor,
-            };
+                it->pipeline = it->newPipeline;
+                *it->outPipeline = it->pipeline;
 
-            VkPipelineColorBlendStateCreateInfo colorBlending = {
-                .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-                .pNext = nullptr,
-                .logicOpEnable = VK_FALSE,
-                .logicOp = VK_LOGIC_OP_COPY,
-                .attachmentCount = (uint32_t)colorBlendStates.size(),
-                .pAttachments = colorBlendStates.data(),
-            };
+                // Add pipeline to deletion queue.
+                // @NOTE: it destroys whichever version of the pipeline is alive by then (it could've been rebuilt).
+                it->deletionQueue->pushFunction([=]() {
+                    vkDestroyPipeline(pipelinelayoutcache::device, it->pipeline, nullptr);
+                    registeredPipelines.erase(it);
+                });
+            }
 
-            VkPipelineVertexInputStateCreateInfo vertexInputInfo = vkinit::vertexInputStateCreateInfo();
-            vertexInputInfo.pVertexAttributeDescriptions = vertexAttributes.data();
-            vertexInputInfo.vertexAttributeDescriptionCount = (uint32_t)vertexAttributes.size();
-            vertexInputInfo.pVertexBindingDescriptions = vertexInputBindings.data();
-            vertexInputInfo.vertexBindingDescriptionCount = (uint32_t)vertexInputBindings.size();
+            if (pendingPipelines.size() > 1 || numFailed > 0)
+                std::cout << "[BUILD GRAPHICS PIPELINES]" << std::endl
+                    << "Built " << (pendingPipelines.size() - numFailed) << " pipelines (" << numFailed << " failed) in "
+                    << std::chrono::duration<double_t, std::milli>(std::chrono::high_resolution_clock::now() - timeStart).count() << " ms" << std::endl;
 
-            VkPipelineDynamicStateCreateInfo dynamicStateCreateInfo = {
-                .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-                .dynamicStateCount = (uint32_t)dynamicStates.size(),
-                .pDynamicStates = dynamicStates.data(),
-            };
+            pendingPipelines.clear();
+            return (numFailed == 0);
+        }
 
-            VkGraphicsPipelineCreateInfo pipelineInfo = {
-                .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-                .pNext = nullptr,
-                .stageCount = (uint32_t)compiledShaderStages.size(),
-                .pStages = compiledShaderStages.data(),
-                .pVertexInputState = &vertexInputInfo,
-                .pInputAssemblyState = &inputAssembly,
-                .pViewportState = &viewportState,
-                .pRasterizationState = &rasterizationState,
-                .pMultisampleState = &multisampling,
-                .pDepthStencilState = &depthStencilState,
-                .pColorBlendState = &colorBlending,
-                .pDynamicState = &dynamicStateCreateInfo,
-                .layout = outPipelineLayout,
-                .renderPass = renderPass,
-                .subpass = subpass,
-                .basePipelineHandle = VK_NULL_HANDLE,
-            };
+        size_t rebuildPipelinesUsingShaders(const std::vector<std::string>& changedShaderFilenames)
+        {
+            auto timeStart = std::chrono::high_resolution_clock::now();
 
-            // Check for errors while creating gfx pipelines
-            std::cout << "[BUILD GRAPHICS PIPELINE]" << std::endl;
-            if (vkCreateGraphicsPipelines(pipelinelayoutcache::device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &outPipeline) != VK_SUCCESS)
+            std::vector<PipelineBuildJobIter> jobs;
+            for (auto it = registeredPipelines.begin(); it != registeredPipelines.end(); it++)
             {
-                std::cout << "FAILED: creating pipeline" << std::endl;
-                return false;
+                bool usesChangedShader = false;
+                for (auto& stage : it->shaderStages)
+                    usesChangedShader |=
+                        (std::find(changedShaderFilenames.begin(), changedShaderFilenames.end(), std::filesystem::path(stage.filePath).filename().string()) != changedShaderFilenames.end());
+                if (usesChangedShader && it->pipeline != VK_NULL_HANDLE)
+                    jobs.push_back(it);
             }
 
-            std::cout << "Successfully built graphics pipeline" << std::endl;
+            if (jobs.empty())
+                return 0;
 
-            // Cleanup
-            for (auto shaderStage : compiledShaderStages)
-                vkDestroyShaderModule(pipelinelayoutcache::device, shaderStage.module, nullptr);
+            createPipelinesInParallel(jobs);
+
+            size_t numRebuilt = 0;
+            for (PipelineBuildJobIter it : jobs)
+            {
+                if (it->newPipeline == VK_NULL_HANDLE)
+                    continue;  // Keep the old version alive.
 
-            std::cout << "Cleaned up used shader modules (count: " << compiledShaderStages.size() << ")" << std::endl;
+                vkDestroyPipeline(pipelinelayoutcache::device, it->pipeline, nullptr);
+                it->pipeline = it->newPipeline;
+                *it->outPipeline = it->pipeline;
+                numRebuilt++;
+            }
 
-            // Add pipeline to deletion queue.
-            deletionQueue.pushFunction([=]() {
-                vkDestroyPipeline(pipelinelayoutcache::device, outPipeline, nullptr);
-            });
+            std::cout << "[REBUILD GRAPHICS PIPELINES]" << std::endl
+                << "Rebuilt " << numRebuilt << " of " << registeredPipelines.size() << " pipelines in "
+                << std::chrono::duration<double_t, std::milli>(std::chrono::high_resolution_clock::now() - timeStart).count() << " ms" << std::endl;
 
-            return true;
+            return numRebuilt;
         }
     }
-}
\ No newline at end of file
+}
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <vector>
+#include <string>
 #include <vulkan/vulkan.h>
 struct DeletionQueue;
+namespace tf { class Executor; }
 
 
 namespace vkutil
@@ -15,6 +17,17 @@ namespace vkutil
         VkPipelineLayout createPipelineLayout(VkPipelineLayoutCreateInfo* info);
     }
 
+    namespace pipelinecache
+    {
+        // @NOTE: one VkPipelineCache for all pipeline creation, saved to disk between runs. The saved cache
+        //        only gets loaded back if it came from the same device (vendor, device and pipeline cache UUID)
+        //        and the same driver version. Otherwise it starts out empty.
+        void init(VkDevice newDevice, const VkPhysicalDeviceProperties& gpuProperties);
+        void saveAndCleanup();
+
+        VkPipelineCache getPipelineCache();
+    }
+
     namespace pipelinebuilder
     {
         struct ShaderStageInfo
@@ -23,6 +36,9 @@ namespace vkutil
             const char* filePath;
         };
 
+        // Batches and shader rebuilds create their pipelines on `newExecutor`'s threads. It has to outlive every build.
+        void init(tf::Executor& newExecutor);
+
         bool loadShaderModule(const char* filePath, VkShaderModule& outShaderModule);
 
         bool build(
@@ -44,5 +60,26 @@ namespace vkutil
             VkPipeline&                                      outPipeline,
             VkPipelineLayout&                                outPipelineLayout,
             DeletionQueue&                                   deletionQueue);
+
+        // Same as `build()` but for a compute pipeline, so there's only the one shader stage.
+        bool buildCompute(
+            std::vector<VkPushConstantRange>   pushConstantRanges,
+            std::vector<VkDescriptorSetLayout> setLayouts,
+            const char*                        computeShaderFilePath,
+            VkPipeline&                        outPipeline,
+            VkPipelineLayout&                  outPipelineLayout,
+            DeletionQueue&                     deletionQueue);
+
+        // @NOTE: while a batch is open, `build()` creates the pipeline layout right away but only queues up the
+        //        pipeline itself (and returns true). `flushBatch()` then creates all the queued pipelines in
+        //        parallel. Outside of a batch `build()` creates the pipeline immediately.
+        //        Either way, `outPipeline` has to stay valid for as long as the pipeline is alive (i.e. not a
+        //        local), since it gets written to again when a changed shader rebuilds the pipeline.
+        void beginBatch();
+        bool flushBatch();
+
+        // Rebuilds every alive pipeline that uses one of the shaders (by filename, e.g. "pbr.vert.spv").
+        // The device has to be idle. Returns the number of rebuilt pipelines.
+        size_t rebuildPipelinesUsingShaders(const std::vector<std::string>& changedShaderFilenames);
     }
 }
\ No newline at end of file
@@ -1,148 +1,40 @@
 #include "VkTextures.h"
 
 #include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <unordered_map>
 #include <stb_image.h>
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/for_each.hpp>
 #include "VkInitializers.h"
 #include "VkDataStructures.h"
 #include "VulkanEngine.h"
+#include "TextureCooker.h"
+#include "Profiler.h"
 
 
-bool vkutil::loadImageFromFile(VulkanEngine& engine, const char* fname, VkFormat imageFormat, uint32_t mipLevels, AllocatedImage& outImage)
+namespace vkutil
 {
-	int32_t width, height;
-	return loadImageFromFile(engine, fname, imageFormat, mipLevels, width, height, outImage);
-}
+	constexpr VkDeviceSize STAGING_ARENA_MAX_SIZE  = 256 * 1024 * 1024;  // @NOTE: a batch gets split into more submits past this. A single texture bigger than this still gets its own arena.
+	constexpr VkDeviceSize STAGING_ARENA_ALIGNMENT = 16;                 // Covers the RGBA8 texel size, the BC block sizes, and the usual optimalBufferCopyOffsetAlignment.
 
-bool vkutil::loadImageFromFile(VulkanEngine& engine, const char* fname, VkFormat imageFormat, uint32_t mipLevels, int32_t& outWidth, int32_t& outHeight, AllocatedImage& outImage)
-{
-	//
-	// Load image from file
-	//
-	int32_t texChannels;
-	stbi_uc* pixels = stbi_load(fname, &outWidth, &outHeight, &texChannels, STBI_rgb_alpha);
-
-	if (!pixels)
+	uint32_t calculateMipLevels(int32_t texWidth, int32_t texHeight, uint32_t mipLevels)
 	{
-		std::cerr << "ERROR: failed to load texture " << fname << std::endl;
-		return false;
+		const uint32_t maxMipmaps = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
+		return mipLevels == 0 ? maxMipmaps : std::min(mipLevels, maxMipmaps);
 	}
 
-	void* pixelPtr = pixels;
-	VkDeviceSize imageSize = outWidth * outHeight * 4;		// @HARDCODED: bc planning on having the alpha channel in here too
-
-	bool ret = loadImageFromBuffer(engine, outWidth, outHeight, imageSize, imageFormat, pixelPtr, mipLevels, outImage);
-	stbi_image_free(pixels);
-
-	std::cout << "Texture (mips=" << outImage._mipLevels << ")" << std::endl << "\t" << fname << std::endl << "\tloaded successfully" << std::endl;
-
-	return ret;
-}
-
-bool vkutil::loadImageFromBuffer(VulkanEngine& engine, int texWidth, int texHeight, VkDeviceSize imageSize, VkFormat imageFormat, void* pixels, uint32_t mipLevels, AllocatedImage& outImage)
-{
-	//
-	// Copy image to CPU-side buffer
-	//
-	AllocatedBuffer stagingBuffer = engine.createBuffer(imageSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
-
-	void* data;
-	vmaMapMemory(engine._allocator, stagingBuffer._allocation, &data);
-	memcpy(data, pixels, static_cast<size_t>(imageSize));
-	vmaUnmapMemory(engine._allocator, stagingBuffer._allocation);
-
-	//
-	// Create GPU-side buffer
-	//
-	const uint32_t maxMipmaps = static_cast<uint32_t>(std::floor(std::log2(std::max(texWidth, texHeight)))) + 1;
-	AllocatedImage newImage;
-	newImage._mipLevels = mipLevels == 0 ? maxMipmaps : std::min(mipLevels, maxMipmaps);
-
-	VkExtent3D imageExtent = {
-		.width = static_cast<uint32_t>(texWidth),
-		.height = static_cast<uint32_t>(texHeight),
-		.depth = 1,
-	};
-	VkImageCreateInfo dstImageInfo =
-		vkinit::imageCreateInfo(
-			imageFormat,
-			VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-			imageExtent,
-			newImage._mipLevels
-		);
-
-	VmaAllocationCreateInfo dstImageAllocInfo = {
-		.usage = VMA_MEMORY_USAGE_GPU_ONLY,
-	};
-	vmaCreateImage(engine._allocator, &dstImageInfo, &dstImageAllocInfo, &newImage._image, &newImage._allocation, nullptr);
-
-	//
-	// Copy image data to GPU
-	//
-	engine.immediateSubmit([&](VkCommandBuffer cmd) {
-		// Image layout for copying optimal
-		VkImageMemoryBarrier imageBarrierToTransfer = {
-			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-			.srcAccessMask = 0,
-			.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
-			.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
-			.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-			.image = newImage._image,
-			.subresourceRange = {
-				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-				.baseMipLevel = 0,
-				.levelCount = newImage._mipLevels,
-				.baseArrayLayer = 0,
-				.layerCount = 1,
-			},
-		};
-		vkCmdPipelineBarrier(cmd,
-			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
-			0, nullptr,
-			0, nullptr,
-			1, &imageBarrierToTransfer
-		);
-
-		// Copy pixel data into image
-		VkBufferImageCopy copyRegion = {
-			.bufferOffset = 0,
-			.bufferRowLength = 0,
-			.bufferImageHeight = 0,
-			.imageSubresource = {
-				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-				.mipLevel = 0,
-				.baseArrayLayer = 0,
-				.layerCount = 1,
-			},
-			.imageExtent = imageExtent,
-		};
-		vkCmdCopyBufferToImage(cmd, stagingBuffer._buffer, newImage._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
-
-		// @NOTE: the transform to SHADER_READ_ONLY_OPTIMAL is missing bc the next part
-		// when mipmapping is generated is when the transformation will happen  -Timo
-	});
-
-	//
-	// Check if linear blitting is supported for mipmap generation
-	//
-	VkFormatProperties formatProperties;
-	vkGetPhysicalDeviceFormatProperties(engine._chosenGPU, imageFormat, &formatProperties);
-	if (!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+	// Expects all mips of `image` to be in TRANSFER_DST_OPTIMAL with mip 0 already filled in. Leaves all mips in SHADER_READ_ONLY_OPTIMAL.
+	void recordMipmapGeneration(VkCommandBuffer cmd, VkImage image, int32_t texWidth, int32_t texHeight, uint32_t mipLevels)
 	{
-		std::cerr << "ERROR: texture image format doesn't support linear blitting" << std::endl;
-		return false;
-	}
-
-	//
-	// Loop thru and upload mips to GPU
-	//
-	engine.immediateSubmit([&](VkCommandBuffer cmd) {
 		VkImageMemoryBarrier imageBarrier = {
 			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
 			.srcAccessMask = 0,
 			.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
 			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
 			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-			.image = newImage._image,
+			.image = image,
 			.subresourceRange = {
 				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
 				.baseMipLevel = 0,
@@ -155,7 +47,7 @@ bool vkutil::loadImageFromBuffer(VulkanEngine& engine, int texWidth, int texHeig
 		int32_t mipWidth = texWidth;
 		int32_t mipHeight = texHeight;
 
-		for (uint32_t mipLevel = 1; mipLevel < newImage._mipLevels; mipLevel++)		// @NOTE: start at mipLevel=1 bc the first mipLevel (0) gets copied into the buffer instead of blitted like in this section
+		for (uint32_t mipLevel = 1; mipLevel < mipLevels; mipLevel++)		// @NOTE: start at mipLevel=1 bc the first mipLevel (0) gets copied into the buffer instead of blitted like in this section
 		{
 			// Pipeline barrier for changing prev mip to a src optimal image
 			imageBarrier.subresourceRange.baseMipLevel = mipLevel - 1;
@@ -195,8 +87,8 @@ bool vkutil::loadImageFromBuffer(VulkanEngine& engine, int texWidth, int texHeig
 				},
 			};
 			vkCmdBlitImage(cmd,
-				newImage._image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-				newImage._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+				image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 				1, &blitRegion,
 				VK_FILTER_LINEAR
 			);
@@ -220,10 +112,10 @@ bool vkutil::loadImageFromBuffer(VulkanEngine& engine, int texWidth, int texHeig
 		}
 
 		// Pipeline barrier for changing FINAL prev mip to shader reading optimal image
-		imageBarrier.subresourceRange.baseMipLevel = newImage._mipLevels - 1;
+		imageBarrier.subresourceRange.baseMipLevel = mipLevels - 1;
 		imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
 		imageBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-		imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
 		imageBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
 		vkCmdPipelineBarrier(
 			cmd,
@@ -232,19 +124,449 @@ bool vkutil::loadImageFromBuffer(VulkanEngine& engine, int texWidth, int texHeig
 			0, nullptr,
 			1, &imageBarrier
 		);
-	});
+	}
+
+	VkFormat getCookedVkFormat(const texturecooker::CookedTexture& cookedTexture)
+	{
+		bool srgb = cookedTexture.isSRGB;
+		switch (cookedTexture.format)
+		{
+		case texturecooker::CookedFormat::RGBA8: return srgb ? VK_FORMAT_R8G8B8A8_SRGB : VK_FORMAT_R8G8B8A8_UNORM;
+		case texturecooker::CookedFormat::BC1:   return srgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+		case texturecooker::CookedFormat::BC3:   return srgb ? VK_FORMAT_BC3_SRGB_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+		case texturecooker::CookedFormat::BC4:   return srgb ? VK_FORMAT_UNDEFINED : VK_FORMAT_BC4_UNORM_BLOCK;  // No sRGB BC4 in Vulkan.
+		case texturecooker::CookedFormat::BC7:   return srgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK;
+		}
+		return VK_FORMAT_UNDEFINED;
+	}
+
+	bool isSRGBFormat(VkFormat format)
+	{
+		switch (format)
+		{
+		case VK_FORMAT_R8G8B8A8_SRGB:
+		case VK_FORMAT_B8G8R8A8_SRGB:
+		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+		case VK_FORMAT_BC3_SRGB_BLOCK:
+		case VK_FORMAT_BC7_SRGB_BLOCK:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	struct StagedUpload
+	{
+		size_t requestIndex;
+		const texturecooker::CookedTexture* cookedTexture;  // nullptr means RGB/RGBA pixels in the request and the mips get blitted.
+		uint32_t mipLevels;
+		VkDeviceSize offset;
+	};
+
+	// Packs `uploads` into a single staging buffer and uploads them with one submit.
+	void uploadStagingArena(VulkanEngine& engine, std::vector<TextureUploadRequest>& requests, const std::vector<StagedUpload>& uploads, VkDeviceSize arenaSize)
+	{
+		//
+		// Copy images to CPU-side buffer
+		//
+		AllocatedBuffer stagingBuffer = engine.createBuffer(arenaSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+
+		unsigned char* data;
+		vmaMapMemory(engine._allocator, stagingBuffer._allocation, (void**)&data);
+		for (const StagedUpload& upload : uploads)
+		{
+			const TextureUploadRequest& request = requests[upload.requestIndex];
+			unsigned char* dst = data + upload.offset;
+			if (upload.cookedTexture != nullptr)
+			{
+				const texturecooker::HTexMip& lastMip = upload.cookedTexture->mips[upload.mipLevels - 1];
+				memcpy(dst, upload.cookedTexture->data.data(), lastMip.offset + lastMip.byteSize);
+				continue;
+			}
+
+			size_t numPixels = (size_t)request.width * (size_t)request.height;
+			if (request.numComponents == 4)
+				memcpy(dst, request.pixels, numPixels * 4);
+			else
+			{
+				// Most devices don't support RGB only on Vulkan so convert
+				const unsigned char* rgb = request.pixels;
+				for (size_t p = 0; p < numPixels; p++)
+				{
+					dst[0] = rgb[0];
+					dst[1] = rgb[1];
+					dst[2] = rgb[2];
+					dst[3] = 255;
+					dst += 4;
+					rgb += 3;
+				}
+			}
+		}
+		vmaUnmapMemory(engine._allocator, stagingBuffer._allocation);
+
+		//
+		// Create GPU-side images
+		//
+		std::vector<AllocatedImage> newImages(uploads.size());
+		for (size_t i = 0; i < uploads.size(); i++)
+		{
+			const TextureUploadRequest& request = requests[uploads[i].requestIndex];
+			newImages[i]._mipLevels = uploads[i].mipLevels;
+
+			VkExtent3D imageExtent = {
+				.width = static_cast<uint32_t>(request.width),
+				.height = static_cast<uint32_t>(request.height),
+				.depth = 1,
+			};
+			VkImageUsageFlags usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+			if (uploads[i].cookedTexture == nullptr)
+				usage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;  // For blitting the mips.
+			VkImageCreateInfo dstImageInfo =
+				vkinit::imageCreateInfo(
+					request.imageFormat,
+					usage,
+					imageExtent,
+					newImages[i]._mipLevels
+				);
+
+			VmaAllocationCreateInfo dstImageAllocInfo = {
+				.usage = VMA_MEMORY_USAGE_GPU_ONLY,
+			};
+			vmaCreateImage(engine._allocator, &dstImageInfo, &dstImageAllocInfo, &newImages[i]._image, &newImages[i]._allocation, nullptr);
+		}
+
+		//
+		// Copy image data to GPU and generate mips (all in one go)
+		//
+		engine.immediateSubmit([&](VkCommandBuffer cmd) {
+			// Image layout for copying optimal
+			std::vector<VkImageMemoryBarrier> imageBarriersToTransfer;
+			imageBarriersToTransfer.reserve(newImages.size());
+			for (AllocatedImage& newImage : newImages)
+				imageBarriersToTransfer.push_back({
+					.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+					.srcAccessMask = 0,
+					.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+					.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+					.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					.image = newImage._image,
+					.subresourceRange = {
+						.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+						.baseMipLevel = 0,
+						.levelCount = newImage._mipLevels,
+						.baseArrayLayer = 0,
+						.layerCount = 1,
+					},
+				});
+			vkCmdPipelineBarrier(cmd,
+				VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+				0, nullptr,
+				0, nullptr,
+				static_cast<uint32_t>(imageBarriersToTransfer.size()), imageBarriersToTransfer.data()
+			);
+
+			std::vector<VkImageMemoryBarrier> cookedBarriersToShaderRead;
+			for (size_t i = 0; i < uploads.size(); i++)
+			{
+				const StagedUpload& upload = uploads[i];
+				const TextureUploadRequest& request = requests[upload.requestIndex];
+
+				if (upload.cookedTexture != nullptr)
+				{
+					// Copy every mip straight in. No blitting needed.
+					std::vector<VkBufferImageCopy> copyRegions;
+					copyRegions.reserve(upload.mipLevels);
+					for (uint32_t mipLevel = 0; mipLevel < upload.mipLevels; mipLevel++)
+					{
+						const texturecooker::HTexMip& mip = upload.cookedTexture->mips[mipLevel];
+						copyRegions.push_back({
+							.bufferOffset = upload.offset + mip.offset,
+							.bufferRowLength = 0,
+							.bufferImageHeight = 0,
+							.imageSubresource = {
+								.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+								.mipLevel = mipLevel,
+								.baseArrayLayer = 0,
+								.layerCount = 1,
+							},
+							.imageExtent = {
+								.width = mip.width,
+								.height = mip.height,
+								.depth = 1,
+							},
+						});
+					}
+					vkCmdCopyBufferToImage(cmd, stagingBuffer._buffer, newImages[i]._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+					VkImageMemoryBarrier barrier = imageBarriersToTransfer[i];
+					barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+					barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					cookedBarriersToShaderRead.push_back(barrier);
+					continue;
+				}
+
+				// Copy pixel data into image
+				VkBufferImageCopy copyRegion = {
+					.bufferOffset = upload.offset,
+					.bufferRowLength = 0,
+					.bufferImageHeight = 0,
+					.imageSubresource = {
+						.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+						.mipLevel = 0,
+						.baseArrayLayer = 0,
+						.layerCount = 1,
+					},
+					.imageExtent = {
+						.width = static_cast<uint32_t>(request.width),
+						.height = static_cast<uint32_t>(request.height),
+						.depth = 1,
+					},
+				};
+				vkCmdCopyBufferToImage(cmd, stagingBuffer._buffer, newImages[i]._image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copyRegion);
+
+				recordMipmapGeneration(cmd, newImages[i]._image, request.width, request.height, newImages[i]._mipLevels);
+			}
+
+			if (!cookedBarriersToShaderRead.empty())
+				vkCmdPipelineBarrier(cmd,
+					VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+					0, nullptr,
+					0, nullptr,
+					static_cast<uint32_t>(cookedBarriersToShaderRead.size()), cookedBarriersToShaderRead.data()
+				);
+		});
+
+		//
+		// Cleanup
+		//
+		for (size_t i = 0; i < uploads.size(); i++)
+		{
+			AllocatedImage newImage = newImages[i];
+			engine._mainDeletionQueue.pushImage(engine._allocator, newImage);
+
+			TextureUploadRequest& request = requests[uploads[i].requestIndex];
+			*request.outImage = newImage;
+			request.success = true;
+
+			if (!request.fname.empty())
+				std::cout << "Texture (mips=" << newImage._mipLevels << (uploads[i].cookedTexture != nullptr ? ", cooked" : "") << ")" << std::endl << "\t" << request.fname << std::endl << "\tloaded successfully" << std::endl;
+		}
+		vmaDestroyBuffer(engine._allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+	}
+}
+
+bool vkutil::loadImagesBatched(VulkanEngine& engine, std::vector<TextureUploadRequest>& requests, TextureBatchTimings* outTimings)
+{
+	auto decodeStart = std::chrono::high_resolution_clock::now();
 
 	//
-	// Cleanup
+	// Decode images from files (in parallel)
 	//
-	auto engineAllocator = engine._allocator;
-	engine._mainDeletionQueue.pushFunction([=]() {
-		vmaDestroyImage(engineAllocator, newImage._image, newImage._allocation);
-	});
-	vmaDestroyBuffer(engine._allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+	std::vector<stbi_uc*> decodedPixels(requests.size(), nullptr);
+	std::vector<texturecooker::CookedTexture> cookedTextures(requests.size());  // @NOTE: an empty `mips` means it's not cooked.
+	bool needsDecoding = false;
+	for (TextureUploadRequest& request : requests)
+		needsDecoding |= (request.pixels == nullptr);
 
-	outImage = newImage;
-	return true;
+	if (needsDecoding)
+	{
+		tf::Taskflow taskflow;
+		taskflow.for_each_index((size_t)0, requests.size(), (size_t)1, [&](size_t i) {
+			TextureUploadRequest& request = requests[i];
+			if (request.pixels != nullptr)
+				return;
+
+			PROFILE_ZONE("Decode Texture");
+
+			if (request.allowCooked)
+			{
+				std::filesystem::path cookedPath = request.fname + ".htex";
+				std::error_code ec;
+				auto cookedTime = std::filesystem::last_write_time(cookedPath, ec);
+				if (!ec &&
+					cookedTime >= std::filesystem::last_write_time(request.fname, ec) &&  // @NOTE: if the source got deleted, ec gets set and the cooked one still gets used.
+					texturecooker::loadCookedTexture(cookedPath.string(), cookedTextures[i]))
+				{
+					bool formatSupported = (cookedTextures[i].format == texturecooker::CookedFormat::RGBA8 || engine._supportsTextureCompressionBC);
+					if (cookedTextures[i].isSRGB == isSRGBFormat(request.imageFormat) && formatSupported)
+					{
+						request.width = (int32_t)cookedTextures[i].width;
+						request.height = (int32_t)cookedTextures[i].height;
+						return;
+					}
+					cookedTextures[i] = {};  // Color space doesn't match what was asked for (or the GPU can't sample BC), so fall back to the source.
+				}
+			}
+
+			int32_t texChannels;
+			decodedPixels[i] = stbi_load(request.fname.c_str(), &request.width, &request.height, &texChannels, STBI_rgb_alpha);
+			request.pixels = decodedPixels[i];
+			request.numComponents = 4;
+		});
+		engine._loadingExecutor.run(taskflow).wait();
+	}
+
+	double decodeMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - decodeStart).count();
+	auto uploadStart = std::chrono::high_resolution_clock::now();
+
+	//
+	// Pack into staging arenas and upload
+	//
+	std::unordered_map<VkFormat, VkFormatFeatureFlags> formatFeatures;
+	auto getFormatFeatures = [&](VkFormat format) {
+		auto it = formatFeatures.find(format);
+		if (it == formatFeatures.end())
+		{
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(engine._chosenGPU, format, &formatProperties);
+			it = formatFeatures.emplace(format, formatProperties.optimalTilingFeatures).first;
+		}
+		return it->second;
+	};
+
+	std::vector<StagedUpload> arenaUploads;
+	VkDeviceSize arenaSize = 0;
+	size_t numSubmits = 0;
+	size_t stagingBytes = 0;
+	bool allSucceeded = true;
+
+	for (size_t i = 0; i < requests.size(); i++)
+	{
+		TextureUploadRequest& request = requests[i];
+		request.success = false;
+
+		StagedUpload upload = {
+			.requestIndex = i,
+			.cookedTexture = nullptr,
+		};
+		VkDeviceSize imageSize;
+
+		if (!cookedTextures[i].mips.empty())
+		{
+			const texturecooker::CookedTexture& cookedTexture = cookedTextures[i];
+			VkFormat cookedFormat = getCookedVkFormat(cookedTexture);
+			if (cookedFormat == VK_FORMAT_UNDEFINED ||
+				!(getFormatFeatures(cookedFormat) & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT))
+			{
+				std::cerr << "ERROR: cooked texture " << request.fname << ".htex has a format this device can't sample" << std::endl;
+				allSucceeded = false;
+				continue;
+			}
+
+			request.imageFormat = cookedFormat;
+			upload.cookedTexture = &cookedTexture;
+			upload.mipLevels = (request.mipLevels == 0 ? (uint32_t)cookedTexture.mips.size() : std::min(request.mipLevels, (uint32_t)cookedTexture.mips.size()));
+			const texturecooker::HTexMip& lastMip = cookedTexture.mips[upload.mipLevels - 1];
+			imageSize = lastMip.offset + lastMip.byteSize;
+		}
+		else
+		{
+			if (request.pixels == nullptr)
+			{
+				std::cerr << "ERROR: failed to load texture " << request.fname << std::endl;
+				allSucceeded = false;
+				continue;
+			}
+			if (request.numComponents != 3 && request.numComponents != 4)
+			{
+				std::cerr << "ERROR: texture " << request.fname << " has " << request.numComponents << " components. Only RGB and RGBA are supported" << std::endl;
+				allSucceeded = false;
+				continue;
+			}
+
+			// Check if linear blitting is supported for mipmap generation
+			if (!(getFormatFeatures(request.imageFormat) & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+			{
+				std::cerr << "ERROR: texture image format doesn't support linear blitting" << std::endl;
+				allSucceeded = false;
+				continue;
+			}
+
+			upload.mipLevels = calculateMipLevels(request.width, request.height, request.mipLevels);
+			imageSize = (VkDeviceSize)request.width * (VkDeviceSize)request.height * 4;		// @HARDCODED: bc planning on having the alpha channel in here too
+		}
+
+		VkDeviceSize offset = (arenaSize + STAGING_ARENA_ALIGNMENT - 1) & ~(STAGING_ARENA_ALIGNMENT - 1);
+		if (!arenaUploads.empty() && offset + imageSize > STAGING_ARENA_MAX_SIZE)
+		{
+			uploadStagingArena(engine, requests, arenaUploads, arenaSize);
+			numSubmits++;
+			stagingBytes += arenaSize;
+			arenaUploads.clear();
+			offset = 0;
+		}
+
+		upload.offset = offset;
+		arenaUploads.push_back(upload);
+		arenaSize = offset + imageSize;
+	}
+
+	if (!arenaUploads.empty())
+	{
+		uploadStagingArena(engine, requests, arenaUploads, arenaSize);
+		numSubmits++;
+		stagingBytes += arenaSize;
+	}
+
+	for (size_t i = 0; i < requests.size(); i++)
+		if (decodedPixels[i] != nullptr)
+		{
+			stbi_image_free(decodedPixels[i]);
+			requests[i].pixels = nullptr;
+		}
+
+	if (outTimings != nullptr)
+		*outTimings = {
+			.numTextures = requests.size(),
+			.numSubmits = numSubmits,
+			.stagingBytes = stagingBytes,
+			.decodeMS = decodeMS,
+			.uploadMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - uploadStart).count(),
+		};
+
+	return allSucceeded;
+}
+
+bool vkutil::loadImageFromFile(VulkanEngine& engine, const char* fname, VkFormat imageFormat, uint32_t mipLevels, AllocatedImage& outImage)
+{
+	int32_t width, height;
+	return loadImageFromFile(engine, fname, imageFormat, mipLevels, width, height, outImage);
+}
+
+bool vkutil::loadImageFromFile(VulkanEngine& engine, const char* fname, VkFormat imageFormat, uint32_t mipLevels, int32_t& outWidth, int32_t& outHeight, AllocatedImage& outImage)
+{
+	std::vector<TextureUploadRequest> requests = {
+		{
+			.fname = fname,
+			.imageFormat = imageFormat,
+			.mipLevels = mipLevels,
+			.outImage = &outImage,
+		},
+	};
+	bool ret = loadImagesBatched(engine, requests);
+	outWidth = requests[0].width;
+	outHeight = requests[0].height;
+	return ret;
+}
+
+bool vkutil::loadImageFromBuffer(VulkanEngine& engine, int texWidth, int texHeight, VkDeviceSize imageSize, VkFormat imageFormat, void* pixels, uint32_t mipLevels, AllocatedImage& outImage)
+{
+	// @NOTE: `pixels` is expected to be RGBA8 (imageSize == texWidth * texHeight * 4).
+	std::vector<TextureUploadRequest> requests = {
+		{
+			.pixels = (const unsigned char*)pixels,
+			.numComponents = 4,
+			.width = texWidth,
+			.height = texHeight,
+			.imageFormat = imageFormat,
+			.mipLevels = mipLevels,
+			.outImage = &outImage,
+		},
+	};
+	return loadImagesBatched(engine, requests);
 }
 
 bool vkutil::loadImage3DFromFile(VulkanEngine& engine, std::vector<const char*> fnames, VkFormat imageFormat, AllocatedImage& outImage)
@@ -395,10 +717,7 @@ bool vkutil::loadImage3DFromBuffer(VulkanEngine& engine, int texWidth, int texHe
 	//
 	// Cleanup
 	//
-	auto engineAllocator = engine._allocator;
-	engine._mainDeletionQueue.pushFunction([=]() {
-		vmaDestroyImage(engineAllocator, newImage._image, newImage._allocation);
-	});
+	engine._mainDeletionQueue.pushImage(engine._allocator, newImage);
 	vmaDestroyBuffer(engine._allocator, stagingBuffer._buffer, stagingBuffer._allocation);
 
 	outImage = newImage;
@@ -613,10 +932,7 @@ bool vkutil::loadImageCubemapFromFile(VulkanEngine& engine, std::vector<const ch
 	//
 	// Cleanup
 	//
-	auto engineAllocator = engine._allocator;
-	engine._mainDeletionQueue.pushFunction([=]() {
-		vmaDestroyImage(engineAllocator, newImage._image, newImage._allocation);
-		});
+	engine._mainDeletionQueue.pushImage(engine._allocator, newImage);
 	vmaDestroyBuffer(engine._allocator, stagingBuffer._buffer, stagingBuffer._allocation);
 
 	std::string combinedFnames = "";
@@ -628,3 +944,160 @@ bool vkutil::loadImageCubemapFromFile(VulkanEngine& engine, std::vector<const ch
 	outImage = newImage;
 	return true;
 }
+
+size_t vkutil::calculateImageLayersByteSize(uint32_t texelSize, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount)
+{
+	size_t byteSize = 0;
+	for (uint32_t mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+		byteSize += (size_t)std::max(1u, width >> mipLevel) * (size_t)std::max(1u, height >> mipLevel) * texelSize * layerCount;
+	return byteSize;
+}
+
+namespace vkutil
+{
+	// One region per mip, each one covering all the layers.
+	std::vector<VkBufferImageCopy> calculateImageLayersCopyRegions(uint32_t texelSize, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount)
+	{
+		std::vector<VkBufferImageCopy> copyRegions;
+		VkDeviceSize offset = 0;
+		for (uint32_t mipLevel = 0; mipLevel < mipLevels; mipLevel++)
+		{
+			uint32_t mipWidth = std::max(1u, width >> mipLevel);
+			uint32_t mipHeight = std::max(1u, height >> mipLevel);
+			copyRegions.push_back({
+				.bufferOffset = offset,
+				.bufferRowLength = 0,
+				.bufferImageHeight = 0,
+				.imageSubresource = {
+					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+					.mipLevel = mipLevel,
+					.baseArrayLayer = 0,
+					.layerCount = layerCount,
+				},
+				.imageExtent = {
+					.width = mipWidth,
+					.height = mipHeight,
+					.depth = 1,
+				},
+			});
+			offset += (VkDeviceSize)mipWidth * mipHeight * texelSize * layerCount;
+		}
+		return copyRegions;
+	}
+}
+
+bool vkutil::readbackImage(VulkanEngine& engine, VkImage image, VkImageLayout layout, uint32_t texelSize, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, std::vector<uint8_t>& outData)
+{
+	size_t byteSize = calculateImageLayersByteSize(texelSize, width, height, mipLevels, layerCount);
+	AllocatedBuffer readbackBuffer = engine.createBuffer(byteSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_MEMORY_USAGE_GPU_TO_CPU);
+	std::vector<VkBufferImageCopy> copyRegions = calculateImageLayersCopyRegions(texelSize, width, height, mipLevels, layerCount);
+
+	engine.immediateSubmit([&](VkCommandBuffer cmd) {
+		VkImageMemoryBarrier imageBarrier = {
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT,
+			.oldLayout = layout,
+			.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image = image,
+			.subresourceRange = {
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.baseMipLevel = 0,
+				.levelCount = mipLevels,
+				.baseArrayLayer = 0,
+				.layerCount = layerCount,
+			},
+		};
+		vkCmdPipelineBarrier(cmd,
+			VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+			0, nullptr,
+			0, nullptr,
+			1, &imageBarrier
+		);
+
+		vkCmdCopyImageToBuffer(cmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffer._buffer, static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+		imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+		imageBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+		imageBarrier.newLayout = layout;
+		vkCmdPipelineBarrier(cmd,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0,
+			0, nullptr,
+			0, nullptr,
+			1, &imageBarrier
+		);
+	});
+
+	void* data;
+	vmaMapMemory(engine._allocator, readbackBuffer._allocation, &data);
+	vmaInvalidateAllocation(engine._allocator, readbackBuffer._allocation, 0, VK_WHOLE_SIZE);
+	outData.resize(byteSize);
+	memcpy(outData.data(), data, byteSize);
+	vmaUnmapMemory(engine._allocator, readbackBuffer._allocation);
+
+	vmaDestroyBuffer(engine._allocator, readbackBuffer._buffer, readbackBuffer._allocation);
+	return true;
+}
+
+bool vkutil::uploadImageLayers(VulkanEngine& engine, VkImage image, uint32_t texelSize, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, const std::vector<uint8_t>& data)
+{
+	size_t byteSize = calculateImageLayersByteSize(texelSize, width, height, mipLevels, layerCount);
+	if (data.size() != byteSize)
+	{
+		std::cerr << "ERROR: image layer data is " << data.size() << " bytes. Expected " << byteSize << " bytes" << std::endl;
+		return false;
+	}
+
+	AllocatedBuffer stagingBuffer = engine.createBuffer(byteSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY);
+	void* mapped;
+	vmaMapMemory(engine._allocator, stagingBuffer._allocation, &mapped);
+	memcpy(mapped, data.data(), byteSize);
+	vmaUnmapMemory(engine._allocator, stagingBuffer._allocation);
+
+	std::vector<VkBufferImageCopy> copyRegions = calculateImageLayersCopyRegions(texelSize, width, height, mipLevels, layerCount);
+
+	engine.immediateSubmit([&](VkCommandBuffer cmd) {
+		VkImageMemoryBarrier imageBarrier = {
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.srcAccessMask = 0,
+			.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image = image,
+			.subresourceRange = {
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.baseMipLevel = 0,
+				.levelCount = mipLevels,
+				.baseArrayLayer = 0,
+				.layerCount = layerCount,
+			},
+		};
+		vkCmdPipelineBarrier(cmd,
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0,
+			0, nullptr,
+			0, nullptr,
+			1, &imageBarrier
+		);
+
+		vkCmdCopyBufferToImage(cmd, stagingBuffer._buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(copyRegions.size()), copyRegions.data());
+
+		imageBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		imageBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		vkCmdPipelineBarrier(cmd,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0,
+			0, nullptr,
+			0, nullptr,
+			1, &imageBarrier
+		);
+	});
+
+	vmaDestroyBuffer(engine._allocator, stagingBuffer._buffer, stagingBuffer._allocation);
+	return true;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <string>
 #include <vulkan/vulkan.h>
 class VulkanEngine;
 struct AllocatedImage;
@@ -7,10 +8,45 @@ struct AllocatedImage;
 
 namespace vkutil
 {
+	struct TextureUploadRequest
+	{
+		std::string fname;                   // Gets decoded with stb_image if `pixels` is nullptr.
+		const unsigned char* pixels = nullptr;  // Already decoded pixels (ex. glTF images). Either RGB or RGBA.
+		int32_t numComponents = 4;
+		int32_t width = 0;
+		int32_t height = 0;
+		VkFormat imageFormat = VK_FORMAT_R8G8B8A8_SRGB;
+		uint32_t mipLevels = 0;              // @NOTE: mipLevels set to 0 will generate all mipmaps
+		bool allowCooked = false;            // Loads "<fname>.htex" instead if it's there and up to date. @NOTE: `imageFormat` gets overwritten with the cooked format (ex. BC7), so create the image view off of it after loading.
+		AllocatedImage* outImage = nullptr;
+		bool success = false;
+	};
+
+	struct TextureBatchTimings
+	{
+		size_t numTextures = 0;
+		size_t numSubmits = 0;
+		size_t stagingBytes = 0;
+		double decodeMS = 0.0;
+		double uploadMS = 0.0;
+	};
+
+	// Decodes all the requests in parallel, then packs them into shared staging buffers and records all
+	// the copies + mip blits together, so there's only one fence wait per staging buffer instead of two per texture.
+	// Cooked textures skip the decode and the blits, since all their mips are already in the file.
+	bool loadImagesBatched(VulkanEngine& engine, std::vector<TextureUploadRequest>& requests, TextureBatchTimings* outTimings = nullptr);
+
 	bool loadImageFromFile(VulkanEngine& engine, const char* fname, VkFormat imageFormat, uint32_t mipLevels, AllocatedImage& outImage);
 	bool loadImageFromFile(VulkanEngine& engine, const char* fname, VkFormat imageFormat, uint32_t mipLevels, int32_t& outWidth, int32_t& outHeight, AllocatedImage& outImage);		// @NOTE: mipLevels set to 0 will generate all mipmaps
 	bool loadImageFromBuffer(VulkanEngine& engine, int texWidth, int texHeight, VkDeviceSize imageSize, VkFormat imageFormat, void* pixels, uint32_t mipLevels, AllocatedImage& outImage);
 	bool loadImage3DFromFile(VulkanEngine& engine, std::vector<const char*> fnames, VkFormat imageFormat, AllocatedImage& outImage);  // @NOTE: as of right now, there are no mipmaps being created, since this is mainly meant for uploading lightmaps.
 	bool loadImage3DFromBuffer(VulkanEngine& engine, int texWidth, int texHeight, int texDepth, VkDeviceSize imageSize, VkFormat imageFormat, void* pixels, AllocatedImage& outImage);  // @NOTE: as of right now, there are no mipmaps being created, since this is mainly meant for uploading lightmaps.
 	bool loadImageCubemapFromFile(VulkanEngine& engine, std::vector<const char*> fnames, bool isHDR, VkFormat imageFormat, uint32_t mipLevels, AllocatedImage& outImage);		// @NOTE: fnames order is ...
+
+	// Tightly packed size of every mip and layer of an uncompressed image (the layout `readbackImage()` and `uploadImageLayers()` use: mip major, then layer).
+	size_t calculateImageLayersByteSize(uint32_t texelSize, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount);
+	// Copies every mip and layer of `image` back to the CPU. The image has to be in `layout` (and have TRANSFER_SRC usage), and it gets put back into `layout` afterwards.
+	bool readbackImage(VulkanEngine& engine, VkImage image, VkImageLayout layout, uint32_t texelSize, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, std::vector<uint8_t>& outData);
+	// The reverse of `readbackImage()`. `image` needs TRANSFER_DST usage and ends up in SHADER_READ_ONLY_OPTIMAL.
+	bool uploadImageLayers(VulkanEngine& engine, VkImage image, uint32_t texelSize, uint32_t width, uint32_t height, uint32_t mipLevels, uint32_t layerCount, const std::vector<uint8_t>& data);
 }
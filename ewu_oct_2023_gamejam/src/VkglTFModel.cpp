@@ -218,6 +218,7 @@ namespace vkglTF
 		{
 			vmaDestroyBuffer(allocator, vertices.buffer, vertices.allocation);
 			vertices.buffer = VK_NULL_HANDLE;
+			vertices.skinningDescriptor = VK_NULL_HANDLE;
 		}
 		if (indices.buffer != VK_NULL_HANDLE)
 		{
@@ -660,10 +661,20 @@ namespace vkglTF
 
 	void Model::loadTextures(tinygltf::Model& gltfModel)
 	{
-		for (tinygltf::Texture& tex : gltfModel.textures)
+		//
+		// Gather all the images so they upload in one batch
+		//
+		const VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+		std::vector<Texture> newTextures(gltfModel.textures.size());
+		std::vector<vkglTF::TextureSampler> newTextureSamplers(gltfModel.textures.size());
+		std::vector<vkutil::TextureUploadRequest> requests;
+		requests.reserve(gltfModel.textures.size());
+
+		for (size_t i = 0; i < gltfModel.textures.size(); i++)
 		{
-			tinygltf::Image image = gltfModel.images[tex.source];
-			vkglTF::TextureSampler textureSampler;
+			tinygltf::Texture& tex = gltfModel.textures[i];
+			const tinygltf::Image& image = gltfModel.images[tex.source];
+			vkglTF::TextureSampler& textureSampler = newTextureSamplers[i];
 			if (tex.sampler > -1)
 			{
 				textureSampler = textureSamplers[tex.sampler];
@@ -679,44 +690,34 @@ namespace vkglTF
 				textureSampler.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
 			}
 
-			//
-			// Load texture
-			//
-			unsigned char* buffer = nullptr;
-			VkDeviceSize bufferSize = 0;
-			bool deleteBuffer = false;
-			if (image.component == 3)
-			{
-				// Most devices don't support RGB only on Vulkan so convert
-				// TODO: Check actual format support and transform only if required
-				bufferSize = image.width * image.height * 4;
-				buffer = new unsigned char[bufferSize];
-				unsigned char* rgba = buffer;
-				unsigned char* rgb = &image.image[0];
-				for (int32_t i = 0; i < image.width * image.height; i++)
-				{
-					for (int32_t j = 0; j < 3; ++j)
-					{
-						rgba[j] = rgb[j];
-					}
-					rgba += 4;
-					rgb += 3;
-				}
-				deleteBuffer = true;
-			}
-			else
-			{
-				buffer = &image.image[0];
-				bufferSize = image.image.size();
-			}
-
-			VkFormat format = VK_FORMAT_R8G8B8A8_UNORM;
+			// @NOTE: RGB images get expanded to RGBA while being packed into the staging buffer.
+			requests.push_back({
+				.pixels = image.image.data(),
+				.numComponents = image.component,
+				.width = image.width,
+				.height = image.height,
+				.imageFormat = format,
+				.mipLevels = 0,
+				.outImage = &newTextures[i].image,
+			});
+		}
 
-			Texture texture;
-			vkutil::loadImageFromBuffer(*engine, image.width, image.height, bufferSize, format, buffer, 0, texture.image);
+		if (requests.empty())
+			return;
+		vkutil::loadImagesBatched(*engine, requests);
 
-			if (deleteBuffer)
-				delete[] buffer;
+		//
+		// Create views and samplers
+		//
+		for (size_t i = 0; i < newTextures.size(); i++)
+		{
+			Texture& texture = newTextures[i];
+			const vkglTF::TextureSampler& textureSampler = newTextureSamplers[i];
+			if (!requests[i].success)
+			{
+				textures.push_back(engine->_loadedTextures.at("empty"));  // @NOTE: keep the indices lined up with the gltf texture indices.
+				continue;
+			}
 
 			VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(format, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
 			vkCreateImageView(engine->_device, &imageInfo, nullptr, &texture.imageView);
@@ -742,10 +743,7 @@ namespace vkglTF
 			};
 			vkCreateSampler(engine->_device, &samplerInfo, nullptr, &texture.sampler);
 
-			engine->_mainDeletionQueue.pushFunction([=]() {  // @NOTE: images are already destroyed and handled by VkTextures.h/.cpp so only the sampler and imageview get destroyed here.
-				vkDestroySampler(engine->_device, texture.sampler, nullptr);
-				vkDestroyImageView(engine->_device, texture.imageView, nullptr);
-				});
+			engine->_mainDeletionQueue.pushTextureViewAndSampler(engine->_device, texture);  // @NOTE: images are already destroyed and handled by VkTextures.h/.cpp so only the sampler and imageview get destroyed here.
 
 			textures.push_back(texture);
 		}
@@ -1594,7 +1592,42 @@ namespace vkglTF
 		animStateMachine.loaded = true;
 	}
 
+	bool Model::parseGltfFile(const std::string& filename, tinygltf::Model& outGltfModel)
+	{
+		tinygltf::TinyGLTF gltfContext;
+
+		std::string error;
+		std::string warning;
+
+		bool binary = false;
+		size_t extpos = filename.rfind('.', filename.length());
+		if (extpos != std::string::npos)
+			binary = (filename.substr(extpos + 1, filename.length() - extpos) == "glb");
+
+		bool fileLoaded = binary ? gltfContext.LoadBinaryFromFile(&outGltfModel, &error, &warning, filename.c_str()) : gltfContext.LoadASCIIFromFile(&outGltfModel, &error, &warning, filename.c_str());
+		if (!fileLoaded)
+		{
+			std::cerr << "Could not load gltf file: " << error << std::endl;
+			return false;
+		}
+		return true;
+	}
+
 	void Model::loadFromFile(VulkanEngine* engine, std::string filename, float scale)
+	{
+		//
+		// Load in data from file
+		//
+		auto parseStart = std::chrono::high_resolution_clock::now();
+		tinygltf::Model gltfModel;
+		if (!parseGltfFile(filename, gltfModel))
+			return;
+		double_t parseDurationMS = std::chrono::duration<double_t, std::milli>(std::chrono::high_resolution_clock::now() - parseStart).count();
+
+		loadFromParsedGltf(engine, filename, gltfModel, scale, parseDurationMS);
+	}
+
+	void Model::loadFromParsedGltf(VulkanEngine* engine, const std::string& filename, tinygltf::Model& gltfModel, float scale, double_t parseDurationMS)
 	{
 		this->engine = engine;
 
@@ -1606,24 +1639,7 @@ namespace vkglTF
 		#define GET_PERF_TDIFF_MS(x) perfsAsMS[x]
 
 		PERF_TSTART(0);
-
-		//
-		// Load in data from file
-		//
-		tinygltf::Model gltfModel;
-		tinygltf::TinyGLTF gltfContext;
-
-		std::string error;
-		std::string warning;
-
-		bool binary = false;
-		size_t extpos = filename.rfind('.', filename.length());
-		if (extpos != std::string::npos)
-			binary = (filename.substr(extpos + 1, filename.length() - extpos) == "glb");
-
-		PERF_TSTART(8);
-		bool fileLoaded = binary ? gltfContext.LoadBinaryFromFile(&gltfModel, &error, &warning, filename.c_str()) : gltfContext.LoadASCIIFromFile(&gltfModel, &error, &warning, filename.c_str());
-		PERF_TEND(8);
+		perfsAsMS[8] = parseDurationMS;  // @NOTE: parsing happens before this (and maybe on a different thread), so it's not part of the total.
 
 		// LoaderInfo loaderInfo{ };  @TODO: @IMPROVE: @MEMORY: See below
 		loaderInfo = {};
@@ -1631,12 +1647,6 @@ namespace vkglTF
 		size_t vertexCount = 0;
 		size_t indexCount = 0;
 
-		if (!fileLoaded)
-		{
-			std::cerr << "Could not load gltf file: " << error << std::endl;
-			return;
-		}
-
 		//
 		// Load gltf data into data structures
 		//
@@ -1696,9 +1706,98 @@ namespace vkglTF
 		PERF_TSTART(6);
 		extensions = gltfModel.extensionsUsed;
 
+		uploadVertexAndIndexBuffers(loaderInfo.vertexBuffer, vertexCount, loaderInfo.indexBuffer, indexCount);
+		PERF_TEND(6);
+
+		// @TODO: @IMPROVE: @MEMORY: figure out how to fetch the loader information bc it really should get deleted right here... or later once stuff is loaded up
+		/*delete[] loaderInfo.vertexBuffer;
+		delete[] loaderInfo.indexBuffer;*/
+
+		PERF_TSTART(7);
+		getSceneDimensions();
+		PERF_TEND(7);
+
+		PERF_TEND(0);
+
+		// Report time it took to load
+		static std::mutex reportModelMutex;
+		std::lock_guard<std::mutex> lg(reportModelMutex);
+		std::cout << "[LOAD glTF MODEL FROM FILE]" << std::endl
+			<< "filename:                      " << filename << std::endl
+			<< "meshes:                        " << gltfModel.meshes.size() << std::endl
+			<< "animations:                    " << gltfModel.animations.size() << std::endl
+			<< "materials:                     " << gltfModel.materials.size() << std::endl
+			<< "images:                        " << gltfModel.images.size() << std::endl
+			<< "total vertices:                " << vertexCount << std::endl
+			<< "total indices:                 " << indexCount << std::endl
+			<< "load data from file duration:  " << GET_PERF_TDIFF_MS(8) << " ms" << std::endl
+			<< "allocate samplers duration:    " << GET_PERF_TDIFF_MS(1) << " ms" << std::endl
+			<< "allocate textures duration:    " << GET_PERF_TDIFF_MS(9) << " ms" << std::endl
+			<< "allocate materials duration:   " << GET_PERF_TDIFF_MS(10) << " ms" << std::endl
+			<< "init scene duration:           " << GET_PERF_TDIFF_MS(2) << " ms" << std::endl
+			<< "get node props duration:       " << GET_PERF_TDIFF_MS(3) << " ms" << std::endl
+			<< "load nodes duration:           " << GET_PERF_TDIFF_MS(4) << " ms" << std::endl
+			<< "load animations duration:      " << GET_PERF_TDIFF_MS(5) << " ms" << std::endl
+			<< "load vert/ind buffer duration: " << GET_PERF_TDIFF_MS(6) << " ms" << std::endl
+			<< "get scene dimensions duration: " << GET_PERF_TDIFF_MS(7) << " ms" << std::endl
+			<< "total execution duration:      " << GET_PERF_TDIFF_MS(0) << " ms" << std::endl
+			<< std::endl;
+	}
+
+	void Model::loadFromRawData(VulkanEngine* engine, const std::string& name, const std::vector<Vertex>& vertexData, const std::vector<uint32_t>& indexData, const std::vector<PrimitiveRange>& primitiveRanges)
+	{
+		this->engine = engine;
+		loaderInfo = {};
+
+		vkglTF::Node* newNode = new Node{};
+		newNode->index = 0;
+		newNode->parent = nullptr;
+		newNode->name = name;
+		glm_mat4_identity(newNode->matrix);
+
+		Mesh* newMesh = new Mesh();
+		for (const PrimitiveRange& range : primitiveRanges)
+		{
+			// Bounding box and vertex count from the vertices the range actually uses.
+			vec3 posMin = { FLT_MAX, FLT_MAX, FLT_MAX };
+			vec3 posMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+			uint32_t minIndex = std::numeric_limits<uint32_t>::max();
+			uint32_t maxIndex = 0;
+			for (uint32_t i = range.firstIndex; i < range.firstIndex + range.indexCount; i++)
+			{
+				uint32_t index = indexData[i];
+				glm_vec3_minv(posMin, (float_t*)vertexData[index].pos, posMin);
+				glm_vec3_maxv(posMax, (float_t*)vertexData[index].pos, posMax);
+				minIndex = std::min(minIndex, index);
+				maxIndex = std::max(maxIndex, index);
+			}
+			if (range.indexCount == 0)
+				continue;
+
+			Primitive* newPrimitive = new Primitive(range.firstIndex, range.indexCount, maxIndex - minIndex + 1, range.materialID);
+			newPrimitive->setBoundingBox(posMin, posMax);
+			newMesh->primitives.push_back(newPrimitive);
+
+			if (!newMesh->bb.valid)
+				newMesh->setBoundingBox(posMin, posMax);
+			glm_vec3_minv(newMesh->bb.min, posMin, newMesh->bb.min);
+			glm_vec3_maxv(newMesh->bb.max, posMax, newMesh->bb.max);
+		}
+		newNode->mesh = newMesh;
+		nodes.push_back(newNode);
+		linearNodes.push_back(newNode);
+
+		uploadVertexAndIndexBuffers(vertexData.data(), vertexData.size(), indexData.data(), indexData.size());
+		getSceneDimensions();
+	}
+
+	void Model::uploadVertexAndIndexBuffers(const Vertex* vertexData, size_t vertexCount, const uint32_t* indexData, size_t indexCount)
+	{
 		size_t vertexBufferSize = vertexCount * sizeof(Vertex);
 		size_t indexBufferSize = indexCount * sizeof(uint32_t);
 		indices.count = static_cast<int32_t>(indexCount);
+		vertices.count = static_cast<uint32_t>(vertexCount);
+		vertices.skinningDescriptor = VK_NULL_HANDLE;  // It would point at the old vertex buffer.
 
 		assert(vertexBufferSize > 0);
 
@@ -1719,7 +1818,7 @@ namespace vkglTF
 		// Copy mesh to vertex staging buffer
 		void* data;
 		vmaMapMemory(engine->_allocator, vertexStaging._allocation, &data);
-		memcpy(data, loaderInfo.vertexBuffer, vertexBufferSize);
+		memcpy(data, vertexData, vertexBufferSize);
 		vmaUnmapMemory(engine->_allocator, vertexStaging._allocation);
 
 		// Index data
@@ -1734,7 +1833,7 @@ namespace vkglTF
 
 			// Copy indices to index staging buffer
 			vmaMapMemory(engine->_allocator, indexStaging._allocation, &data);
-			memcpy(data, loaderInfo.indexBuffer, indexBufferSize);
+			memcpy(data, indexData, indexBufferSize);
 			vmaUnmapMemory(engine->_allocator, indexStaging._allocation);
 		}
 
@@ -1743,7 +1842,7 @@ namespace vkglTF
 		AllocatedBuffer vertexGPUSide =
 			engine->createBuffer(
 				vertexBufferSize,
-				VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,  // @NOTE: storage buffer for `skinning.comp`.
 				VMA_MEMORY_USAGE_GPU_ONLY
 			);
 		vertices.buffer = vertexGPUSide._buffer;
@@ -1782,41 +1881,6 @@ namespace vkglTF
 		vmaDestroyBuffer(engine->_allocator, vertexStaging._buffer, vertexStaging._allocation);
 		if (indexBufferSize > 0)
 			vmaDestroyBuffer(engine->_allocator, indexStaging._buffer, indexStaging._allocation);
-		PERF_TEND(6);
-
-		// @TODO: @IMPROVE: @MEMORY: figure out how to fetch the loader information bc it really should get deleted right here... or later once stuff is loaded up
-		/*delete[] loaderInfo.vertexBuffer;
-		delete[] loaderInfo.indexBuffer;*/
-
-		PERF_TSTART(7);
-		getSceneDimensions();
-		PERF_TEND(7);
-
-		PERF_TEND(0);
-
-		// Report time it took to load
-		static std::mutex reportModelMutex;
-		std::lock_guard<std::mutex> lg(reportModelMutex);
-		std::cout << "[LOAD glTF MODEL FROM FILE]" << std::endl
-			<< "filename:                      " << filename << std::endl
-			<< "meshes:                        " << gltfModel.meshes.size() << std::endl
-			<< "animations:                    " << gltfModel.animations.size() << std::endl
-			<< "materials:                     " << gltfModel.materials.size() << std::endl
-			<< "images:                        " << gltfModel.images.size() << std::endl
-			<< "total vertices:                " << vertexCount << std::endl
-			<< "total indices:                 " << indexCount << std::endl
-			<< "load data from file duration:  " << GET_PERF_TDIFF_MS(8) << " ms" << std::endl
-			<< "allocate samplers duration:    " << GET_PERF_TDIFF_MS(1) << " ms" << std::endl
-			<< "allocate textures duration:    " << GET_PERF_TDIFF_MS(9) << " ms" << std::endl
-			<< "allocate materials duration:   " << GET_PERF_TDIFF_MS(10) << " ms" << std::endl
-			<< "init scene duration:           " << GET_PERF_TDIFF_MS(2) << " ms" << std::endl
-			<< "get node props duration:       " << GET_PERF_TDIFF_MS(3) << " ms" << std::endl
-			<< "load nodes duration:           " << GET_PERF_TDIFF_MS(4) << " ms" << std::endl
-			<< "load animations duration:      " << GET_PERF_TDIFF_MS(5) << " ms" << std::endl
-			<< "load vert/ind buffer duration: " << GET_PERF_TDIFF_MS(6) << " ms" << std::endl
-			<< "get scene dimensions duration: " << GET_PERF_TDIFF_MS(7) << " ms" << std::endl
-			<< "total execution duration:      " << GET_PERF_TDIFF_MS(0) << " ms" << std::endl
-			<< std::endl;
 	}
 
 	void Model::bind(VkCommandBuffer commandBuffer)
@@ -1841,7 +1905,7 @@ namespace vkglTF
 		}
 	}
 
-	void Model::appendPrimitiveDraws(std::vector<MeshCapturedInfo>& draws, uint32_t& appendedCount)
+	void Model::appendPrimitiveDraws(FrameVector<MeshCapturedInfo>& draws, uint32_t& appendedCount)
 	{
 		for (auto& node : nodes)
 		{
@@ -1864,7 +1928,7 @@ namespace vkglTF
 		}
 	}
 
-	void Model::appendPrimitiveDrawNode(Node* node, std::vector<MeshCapturedInfo>& draws, uint32_t& appendedCount)
+	void Model::appendPrimitiveDrawNode(Node* node, FrameVector<MeshCapturedInfo>& draws, uint32_t& appendedCount)
 	{
 		if (node->mesh)
 		{
@@ -2128,8 +2192,17 @@ namespace vkglTF
 				.range = sizeof(GPUAnimatorNode) * RENDER_OBJECTS_MAX_CAPACITY,
 			};
 
+			nodeCollectionBuffers[i].skinnedVertexBuffer = engine->createBuffer(sizeof(GPUSkinnedVertex) * MAX_NUM_PRESKINNED_VERTICES, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY);
+
+			VkDescriptorBufferInfo skinnedVertexBufferInfo = {
+				.buffer = nodeCollectionBuffers[i].skinnedVertexBuffer._buffer,
+				.offset = 0,
+				.range = sizeof(GPUSkinnedVertex) * MAX_NUM_PRESKINNED_VERTICES,
+			};
+
 			vkutil::DescriptorBuilder::begin()
-				.bindBuffer(0, &nodeCollectionBufferInfo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT)
+				.bindBuffer(0, &nodeCollectionBufferInfo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT)
+				.bindBuffer(1, &skinnedVertexBufferInfo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT)
 				.build(nodeCollectionBuffers[i].descriptorSet, engine->_skeletalAnimationSetLayout);
 
 			// Copy non-skinned default animator
@@ -2151,6 +2224,7 @@ namespace vkglTF
 		{
 			vmaUnmapMemory(engine->_allocator, nodeCollectionBuffers[i].buffer._allocation);
 			vmaDestroyBuffer(engine->_allocator, nodeCollectionBuffers[i].buffer._buffer, nodeCollectionBuffers[i].buffer._allocation);
+			vmaDestroyBuffer(engine->_allocator, nodeCollectionBuffers[i].skinnedVertexBuffer._buffer, nodeCollectionBuffers[i].skinnedVertexBuffer._allocation);
 		}
 	}
 
@@ -2159,6 +2233,102 @@ namespace vkglTF
 		return &nodeCollectionBuffers[engine->_frameNumber % FRAME_OVERLAP].descriptorSet;
 	}
 
+	void Animator::clearPreskinningJobs(VulkanEngine* engine)
+	{
+		// Put back the nodes that got pre-skinned the last time this frame got used. Otherwise a node that
+		// doesn't get drawn (or pre-skinned) this time would point at someone else's skinned vertices.
+		auto& collection = nodeCollectionBuffers[engine->_frameNumber % FRAME_OVERLAP];
+		for (auto& job : collection.preskinningJobs)
+			collection.mapped[job.animatorNodeID].skinnedVertexBase = NOT_PRESKINNED;
+		collection.preskinningJobs.clear();
+		collection.numPreskinnedVertices = 0;
+	}
+
+	void Animator::addPreskinningJob(VulkanEngine* engine, size_t animatorNodeID, vkglTF::Model* model)
+	{
+		if (animatorNodeID == 0 || uniformBlocks[animatorNodeID].jointcount <= 0.0f)
+			return;  // Not skinned, so there's nothing to save.
+
+		auto& collection = nodeCollectionBuffers[engine->_frameNumber % FRAME_OVERLAP];
+		for (auto it = collection.preskinningJobs.rbegin(); it != collection.preskinningJobs.rend(); it++)
+			if (it->animatorNodeID == animatorNodeID)
+				return;  // Already added (a model's meshes usually all share the same node).
+
+		if (collection.numPreskinnedVertices + model->vertices.count > MAX_NUM_PRESKINNED_VERTICES)
+			return;  // No room. This node just gets skinned in the vertex shaders.
+
+		if (model->vertices.skinningDescriptor == VK_NULL_HANDLE)
+		{
+			VkDescriptorBufferInfo vertexBufferInfo = {
+				.buffer = model->vertices.buffer,
+				.offset = 0,
+				.range = sizeof(Model::Vertex) * model->vertices.count,
+			};
+			vkutil::DescriptorBuilder::begin()
+				.bindBuffer(0, &vertexBufferInfo, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT)
+				.build(model->vertices.skinningDescriptor);
+		}
+
+		// @NOTE: the whole vertex buffer gets skinned, since the indices in the model are absolute. So `gl_VertexIndex`
+		//        in the passes lines up with `skinnedVertexBase` + the model's vertex index.
+		collection.mapped[animatorNodeID].skinnedVertexBase = collection.numPreskinnedVertices;
+		collection.preskinningJobs.push_back({
+			.animatorNodeID = animatorNodeID,
+			.model = model,
+		});
+		collection.numPreskinnedVertices += model->vertices.count;
+	}
+
+	void Animator::recordPreskinningJobs(VulkanEngine* engine, VkCommandBuffer cmd, VkPipeline pipeline, VkPipelineLayout pipelineLayout)
+	{
+		auto& collection = nodeCollectionBuffers[engine->_frameNumber % FRAME_OVERLAP];
+		if (collection.preskinningJobs.empty())
+			return;
+
+		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &collection.descriptorSet, 0, nullptr);
+		for (auto& job : collection.preskinningJobs)
+		{
+			GPUPreskinningPushConstants pc = {
+				.animatorNodeID = (uint32_t)job.animatorNodeID,
+				.vertexCount = job.model->vertices.count,
+				.vertexStride = (uint32_t)(sizeof(Model::Vertex) / sizeof(float_t)),
+				.posOffset = (uint32_t)(offsetof(Model::Vertex, pos) / sizeof(float_t)),
+				.normalOffset = (uint32_t)(offsetof(Model::Vertex, normal) / sizeof(float_t)),
+				.joint0Offset = (uint32_t)(offsetof(Model::Vertex, joint0) / sizeof(float_t)),
+				.weight0Offset = (uint32_t)(offsetof(Model::Vertex, weight0) / sizeof(float_t)),
+			};
+			vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 1, 1, &job.model->vertices.skinningDescriptor, 0, nullptr);
+			vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(GPUPreskinningPushConstants), &pc);
+			vkCmdDispatch(cmd, (pc.vertexCount + 63) / 64, 1, 1);  // @NOTE: 64 is `local_size_x` in skinning.comp.
+		}
+
+		// Wait for the skinned vertices before any of the passes' vertex shaders read them.
+		recordPreskinnedVerticesBarrier(engine, cmd);
+	}
+
+	void Animator::recordPreskinnedVerticesBarrier(VulkanEngine* engine, VkCommandBuffer cmd)
+	{
+		auto& collection = nodeCollectionBuffers[engine->_frameNumber % FRAME_OVERLAP];
+		VkBufferMemoryBarrier barrier = {
+			.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.buffer = collection.skinnedVertexBuffer._buffer,
+			.offset = 0,
+			.size = VK_WHOLE_SIZE,
+		};
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+	}
+
+	uint32_t Animator::getNumPreskinnedVertices(VulkanEngine* engine)
+	{
+		return nodeCollectionBuffers[engine->_frameNumber % FRAME_OVERLAP].numPreskinnedVertices;
+	}
+
 	void Animator::playAnimation(size_t maskIndex, uint32_t animationIndex, bool loop, float_t time)
 	{
 		if (model->animations.empty())
@@ -13,6 +13,7 @@
 #include <taskflow/taskflow.hpp>
 #include "VkDataStructures.h"
 #include "Settings.h"
+#include "FrameArena.h"
 
 class VulkanEngine;
 
@@ -304,8 +305,10 @@ namespace vkglTF
 
 		struct Vertices
 		{
+			uint32_t count = 0;
 			VkBuffer buffer = VK_NULL_HANDLE;
 			VmaAllocation allocation;
+			VkDescriptorSet skinningDescriptor = VK_NULL_HANDLE;  // @NOTE: for reading the vertices in `skinning.comp`. Only gets built once the model gets pre-skinned.
 		} vertices;
 
 		struct Indices
@@ -358,14 +361,26 @@ namespace vkglTF
 		void loadAnimations(tinygltf::Model& gltfModel);
 		void loadAnimationStateMachine(const std::string& filename, tinygltf::Model& gltfModel);
 	public:
+		static bool parseGltfFile(const std::string& filename, tinygltf::Model& outGltfModel);  // @NOTE: doesn't touch the GPU, so this can be done on any thread ahead of time.
 		void loadFromFile(VulkanEngine* engine, std::string filename, float scale = 1.0f);
+		void loadFromParsedGltf(VulkanEngine* engine, const std::string& filename, tinygltf::Model& gltfModel, float scale = 1.0f, double_t parseDurationMS = 0.0);
+
+		// @NOTE: for generated geometry (e.g. voxel field meshes). Everything goes under a single node, and each range becomes its own primitive.
+		struct PrimitiveRange
+		{
+			uint32_t firstIndex;
+			uint32_t indexCount;
+			uint32_t materialID;
+		};
+		void loadFromRawData(VulkanEngine* engine, const std::string& name, const std::vector<Vertex>& vertexData, const std::vector<uint32_t>& indexData, const std::vector<PrimitiveRange>& primitiveRanges);
 		void bind(VkCommandBuffer commandBuffer);
 		void draw(VkCommandBuffer commandBuffer);
 		void draw(VkCommandBuffer commandBuffer, uint32_t& inOutInstanceID);
-		void appendPrimitiveDraws(std::vector<MeshCapturedInfo>& draws, uint32_t& appendedCount);
+		void appendPrimitiveDraws(FrameVector<MeshCapturedInfo>& draws, uint32_t& appendedCount);
 	private:
+		void uploadVertexAndIndexBuffers(const Vertex* vertexData, size_t vertexCount, const uint32_t* indexData, size_t indexCount);
 		void drawNode(Node* node, VkCommandBuffer commandBuffer, uint32_t& inOutInstanceID);
-		void appendPrimitiveDrawNode(Node* node, std::vector<MeshCapturedInfo>& draws, uint32_t& appendedCount);
+		void appendPrimitiveDrawNode(Node* node, FrameVector<MeshCapturedInfo>& draws, uint32_t& appendedCount);
 		void calculateBoundingBox(Node* node, Node* parent);
 	public:
 		void getSceneDimensions();
@@ -399,6 +414,28 @@ namespace vkglTF
 		static void destroyEmpty(VulkanEngine* engine);
 		static VkDescriptorSet* getGlobalAnimatorNodeCollectionDescriptorSet(VulkanEngine* engine);  // For binding to represent a non-skinned mesh
 
+		// Pre-skinning
+		// @NOTE: every skinned animator node that gets drawn this frame has its model's vertices skinned once
+		//        by `skinning.comp` into the frame's skinned vertex buffer. The shadow, z-prepass, main, picking
+		//        and wireframe passes all read the skinned vertices from there instead of each doing the skinning
+		//        again. Any node that didn't get pre-skinned (e.g. the skinned vertex buffer is full) just falls
+		//        back to skinning in the vertex shader.
+		struct GPUPreskinningPushConstants
+		{
+			uint32_t animatorNodeID;
+			uint32_t vertexCount;
+			uint32_t vertexStride;  // This and the offsets are in floats, not bytes.
+			uint32_t posOffset;
+			uint32_t normalOffset;
+			uint32_t joint0Offset;
+			uint32_t weight0Offset;
+		};
+		static void clearPreskinningJobs(VulkanEngine* engine);
+		static void addPreskinningJob(VulkanEngine* engine, size_t animatorNodeID, vkglTF::Model* model);
+		static void recordPreskinningJobs(VulkanEngine* engine, VkCommandBuffer cmd, VkPipeline pipeline, VkPipelineLayout pipelineLayout);  // Includes the barrier before the vertex shaders read the skinned vertices.
+		static void recordPreskinnedVerticesBarrier(VulkanEngine* engine, VkCommandBuffer cmd);  // For command buffers submitted separately from the one the preskinning jobs are in.
+		static uint32_t getNumPreskinnedVertices(VulkanEngine* engine);
+
 		void playAnimation(size_t maskIndex, uint32_t animationIndex, bool loop, float_t time = 0.0f);  // This is for direct control of the animation index
 		void update(const float_t& deltaTime);
 
@@ -426,19 +463,37 @@ namespace vkglTF
 		size_t skinIndexToGlobalReservedNodeIndex(size_t skinIndex);
 	private:
 
+		static constexpr uint32_t NOT_PRESKINNED = 0xFFFFFFFF;  // @NOTE: must match `NOT_PRESKINNED` in the skinning shaders.
+
 		struct GPUAnimatorNode
 		{
 			mat4 matrix = GLM_MAT4_IDENTITY_INIT;
 			mat4 jointMatrix[MAX_NUM_JOINTS]{};
 			float_t jointcount{ 0 };
+			uint32_t skinnedVertexBase = NOT_PRESKINNED;  // Only ever set in the mapped buffers, by `addPreskinningJob()`.
 		};
 		static GPUAnimatorNode uniformBlocks[];
 
+		struct GPUSkinnedVertex
+		{
+			vec4 pos;
+			vec4 normal;
+		};
+
+		struct PreskinningJob
+		{
+			size_t animatorNodeID;
+			vkglTF::Model* model;
+		};
+
 		struct AnimatorNodeCollectionBuffer
 		{
 			AllocatedBuffer buffer;
 			VkDescriptorSet descriptorSet;
 			GPUAnimatorNode* mapped;
+			AllocatedBuffer skinnedVertexBuffer;
+			std::vector<PreskinningJob> preskinningJobs;
+			uint32_t numPreskinnedVertices = 0;
 		};
 		static AnimatorNodeCollectionBuffer nodeCollectionBuffers[FRAME_OVERLAP];  // @NOTE: The buffer size created in this is 78mb per AnimatorNodeCollectionBuffer... pretty big. Especially since very few render objects are animator attached ones.
 		static std::vector<size_t> reservedNodeCollectionIndices;
@@ -2,6 +2,7 @@
 
 #include <stb_image_write.h>
 #include <mutex>
+#include <chrono>
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Body/Body.h>
 #include "Imports.h"
@@ -11,6 +12,7 @@
 #include "RenderObject.h"
 #include "PhysicsEngine.h"
 #include "PhysUtil.h"
+#include "VoxelMesher.h"
 #include "DataSerialization.h"
 #include "InputManager.h"
 #include "VulkanEngine.h"
@@ -26,11 +28,25 @@ struct VoxelField_XData
     VulkanEngine* engine;
     RenderObjectManager* rom;
     Camera* camera;
-    vkglTF::Model* voxelModel;
+    vkglTF::Model* voxelModel;  // Only used for its material now. The voxels get rendered with `voxelMeshModel`.
     vkglTF::Model* triggerModel;
     std::vector<RenderObject*> voxelRenderObjs;
     std::vector<mat4s> voxelRenderObjLocalTransforms;
 
+    // @NOTE: the voxels get meshed into one model (instead of a render object per collision box). When the
+    //        voxels change, a new model gets built and the old one gets retired until the frames in flight
+    //        are done with it. Retired models get recycled so the render object manager doesn't keep seeing
+    //        new model pointers.
+    voxelmesher::VoxelMesh voxelMesh;
+    vkglTF::Model* voxelMeshModel = nullptr;
+    struct RetiredVoxelMeshModel
+    {
+        vkglTF::Model* model;
+        uint32_t retiredFrameNumber;
+    };
+    std::vector<RetiredVoxelMeshModel> retiredVoxelMeshModels;
+    std::vector<vkglTF::Model*> spareVoxelMeshModels;
+
     RenderObject* displayModelRO = nullptr;
     std::string displayModelFname = "NULL";
     mat4 displayModelTransform = GLM_MAT4_IDENTITY_INIT;
@@ -59,12 +75,18 @@ struct VoxelField_XData
         ivec3 editEndPosition = { 0, 0, 0 };
         std::mutex* editingVoxelRenderObjsMutex;  // Making this not a pointer deletes the struct's default constructor for some reason. I guess mutexes don't want to be double-referenced.
     } editorState;
+
+    // @NOTE: edits happen in `physicsUpdate()`, but the render objects (and the voxel mesh upload) have to get
+    //        rebuilt on the main thread, so the physics thread just flags them here (under `editingVoxelRenderObjsMutex`).
+    bool isRenderObjsDirty = false;
+    std::vector<physengine::VoxelFieldCollisionShape> dirtyTriggerShapes;
     bool isLightingDirty = true;  // True unless built lighting was loaded in automatically.
 };
 
 inline void buildDefaultVoxelData(VoxelField_XData& data, const std::string& myGuid);
-inline void assembleVoxelRenderObjects(VoxelField_XData& data, const std::string& attachedEntityGuid, std::vector<physengine::VoxelFieldCollisionShape>& inCollisionShapes, std::vector<physengine::VoxelFieldCollisionShape>& inTriggerShapes);
+inline void assembleVoxelRenderObjects(VoxelField_XData& data, const std::string& attachedEntityGuid, std::vector<physengine::VoxelFieldCollisionShape>& inTriggerShapes);
 inline void deleteVoxelRenderObjects(VoxelField_XData& data);
+void destroyVoxelMeshModels(VoxelField_XData& data);
 void triggerLoadLightingIfExists(VoxelField_XData& d, const std::string& guid);
 
 void createAndAssignDisplayModel(VoxelField_XData* d, VoxelField* _this, const std::string& myGuid)
@@ -112,7 +134,10 @@ VoxelField::VoxelField(VulkanEngine* engine, EntityManager* em, RenderObjectMana
     std::vector<physengine::VoxelFieldCollisionShape> shapes;
     std::vector<physengine::VoxelFieldCollisionShape> triggers;
     physengine::cookVoxelDataIntoShape(*_data->vfpd, getGUID(), shapes, triggers);
-    assembleVoxelRenderObjects(*_data, getGUID(), shapes, triggers);
+    {
+        std::lock_guard<std::mutex> lg(*_data->editorState.editingVoxelRenderObjsMutex);
+        assembleVoxelRenderObjects(*_data, getGUID(), triggers);
+    }
     triggerLoadLightingIfExists(*_data, getGUID());
     createAndAssignDisplayModel(_data, this, getGUID());
 }
@@ -123,6 +148,7 @@ VoxelField::~VoxelField()
         _data->rom->unregisterRenderObjects({ _data->displayModelRO });
     delete _data->editorState.editingVoxelRenderObjsMutex;
     deleteVoxelRenderObjects(*_data);
+    destroyVoxelMeshModels(*_data);
     physengine::destroyVoxelField(_data->vfpd);
     delete _data;
 }
@@ -178,10 +204,7 @@ void triggerLoadLightingIfExists(VoxelField_XData& d, const std::string& guid)
     VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(lightgridTexture.image._mipLevels), VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
     vkCreateSampler(d.engine->_device, &samplerInfo, nullptr, &lightgridTexture.sampler);
 
-    d.engine->_mainDeletionQueue.pushFunction([=]() {
-        vkDestroySampler(d.engine->_device, lightgridTexture.sampler, nullptr);
-        vkDestroyImageView(d.engine->_device, lightgridTexture.imageView, nullptr);
-    });
+    d.engine->_mainDeletionQueue.pushTextureViewAndSampler(d.engine->_device, lightgridTexture);
 
     d.engine->_loadedTextures["vf_lightgrid_" + guid] = lightgridTexture;
 
@@ -440,16 +463,19 @@ void VoxelField::physicsUpdate(const float_t& physicsDeltaTime)
     if (_data->isPicked)  // @NOTE: this picked checking system, bc physicsupdate() runs outside of the render thread, could easily get out of sync, but as long as the render thread is >40fps it should be fine.
     {
         // Render relations with camera rails and triggers.
-        for (auto& vptcrg : _data->voxelPosToCameraRailGuid)
         {
-            CameraRail* cameraRail = dynamic_cast<CameraRail*>(_em->getEntityViaGUID(vptcrg.camRailGuid));
-            if (cameraRail)
+            std::lock_guard<std::mutex> lg(*_data->editorState.editingVoxelRenderObjsMutex);  // @NOTE: `lateUpdate()` rebuilds these along with the render objects.
+            for (auto& vptcrg : _data->voxelPosToCameraRailGuid)
             {
-                vec3 triggerPosWS;
-                glm_mat4_mulv3(_data->vfpd->transform, vptcrg.triggerOrigin, 1.0f, triggerPosWS);
-                vec3 railPos;
-                cameraRail->getPosition(railPos);
-                physengine::drawDebugVisLine(triggerPosWS, railPos, physengine::DebugVisLineType::VELOCITY);
+                CameraRail* cameraRail = dynamic_cast<CameraRail*>(_em->getEntityViaGUID(vptcrg.camRailGuid));
+                if (cameraRail)
+                {
+                    vec3 triggerPosWS;
+                    glm_mat4_mulv3(_data->vfpd->transform, vptcrg.triggerOrigin, 1.0f, triggerPosWS);
+                    vec3 railPos;
+                    cameraRail->getPosition(railPos);
+                    physengine::drawDebugVisLine(triggerPosWS, railPos, physengine::DebugVisLineType::VELOCITY);
+                }
             }
         }
 
@@ -469,6 +495,8 @@ void VoxelField::physicsUpdate(const float_t& physicsDeltaTime)
             else if (input::keyEnterPressed || (!prevCorXorVPressed && (input::keyCPressed || input::keyXPressed || input::keyVPressed || input::keyBPressed)))
             {
                 // Exit editing, saving changes
+                // @NOTE: the lock keeps the main thread from meshing the voxels while they're getting edited.
+                std::lock_guard<std::mutex> lg(*_data->editorState.editingVoxelRenderObjsMutex);
                 bool rebuildRenderObjs = false;
                 vec3 projectedPosition;
                 if (calculatePositionOnVoxelPlane(
@@ -644,7 +672,8 @@ void VoxelField::physicsUpdate(const float_t& physicsDeltaTime)
                     std::vector<physengine::VoxelFieldCollisionShape> shapes;
                     std::vector<physengine::VoxelFieldCollisionShape> triggers;
                     physengine::cookVoxelDataIntoShape(*_data->vfpd, getGUID(), shapes, triggers);
-                    assembleVoxelRenderObjects(*_data, getGUID(), shapes, triggers);
+                    _data->dirtyTriggerShapes = std::move(triggers);
+                    _data->isRenderObjsDirty = true;  // Rebuilt in `lateUpdate()`.
                     _data->isLightingDirty = true;
                 }
             }
@@ -711,8 +740,28 @@ void VoxelField::lateUpdate(const float_t& deltaTime)
     {
         std::lock_guard<std::mutex> lg(*_data->editorState.editingVoxelRenderObjsMutex);
 
+        // Rebuild the render objects (and re-mesh and upload the voxels) after an edit in `physicsUpdate()`.
+        if (_data->isRenderObjsDirty)
+        {
+            assembleVoxelRenderObjects(*_data, getGUID(), _data->dirtyTriggerShapes);
+            _data->dirtyTriggerShapes.clear();
+            _data->isRenderObjsDirty = false;
+        }
+
         for (size_t i = 0; i < _data->voxelRenderObjs.size(); i++)
             glm_mat4_mul(_data->vfpd->interpolTransform, _data->voxelRenderObjLocalTransforms[i].raw, _data->voxelRenderObjs[i]->transformMatrix);
+
+        // Free up the retired voxel meshes that no frame in flight could still be drawing.
+        std::erase_if(
+            _data->retiredVoxelMeshModels,
+            [&](VoxelField_XData::RetiredVoxelMeshModel x) {
+                if (_data->engine->_frameNumber <= x.retiredFrameNumber + FRAME_OVERLAP)
+                    return false;
+                x.model->destroy(_data->engine->_allocator);
+                _data->spareVoxelMeshModels.push_back(x.model);
+                return true;
+            }
+        );
     }
 }
 
@@ -723,7 +772,9 @@ void VoxelField::dump(DataSerializer& ds)
     vec3 sizeXYZ = { _data->vfpd->sizeX, _data->vfpd->sizeY, _data->vfpd->sizeZ };
     ds.dumpVec3(sizeXYZ);
 
-    size_t totalSize = _data->vfpd->sizeX * _data->vfpd->sizeY * _data->vfpd->sizeZ;
+    std::vector<uint8_t> voxelData;
+    voxelstorage::exportDense(_data->vfpd->voxelStorage, _data->vfpd->sizeX, _data->vfpd->sizeY, _data->vfpd->sizeZ, voxelData);
+    size_t totalSize = voxelData.size();
 
     //
     // Write out voxel data.
@@ -736,7 +787,7 @@ void VoxelField::dump(DataSerializer& ds)
     std::string voxelDataStringified;
     for (size_t i = 0; i < totalSize; i++)
     {
-        int8_t currentVoxelType = (int8_t)_data->vfpd->voxelData[i];
+        int8_t currentVoxelType = (int8_t)voxelData[i];
         if (i == 0)
         {
             // Start new chunk.
@@ -793,14 +844,18 @@ void VoxelField::load(DataSerialized& ds)
     vec3 load_size;
     ds.loadVec3(load_size);
 
-    size_t    totalSize      = (size_t)load_size[0] * (size_t)load_size[1] * (size_t)load_size[2];
+    size_t    load_sizeY     = (size_t)load_size[1];
+    size_t    load_sizeZ     = (size_t)load_size[2];
     std::string load_voxelDataStringified;
     ds.loadString(load_voxelDataStringified);
 
+    // Create Voxel Field Physics Data
+    _data->vfpd = physengine::createVoxelField(getGUID(), load_transform, load_size[0], load_size[1], load_size[2], nullptr);
+
     //
     // Load in voxel data.
+    // @NOTE: written straight into the voxel field's storage so that the empty runs don't take up any memory.
     //
-    uint8_t*  load_voxelData = new uint8_t[totalSize];
     size_t writeIndex = 0;
     for (size_t i = 0; i < load_voxelDataStringified.length(); i += 2)
     {
@@ -811,13 +866,17 @@ void VoxelField::load(DataSerialized& ds)
         count -= 33;
         voxelType -= 33;
         
-        for (size_t j = 0; j < count; j++)
-            load_voxelData[writeIndex++] = (uint8_t)voxelType;
+        for (size_t j = 0; j < count; j++, writeIndex++)
+            if (voxelType != 0)
+                physengine::setVoxelDataAtPosition(
+                    *_data->vfpd,
+                    (int32_t)(writeIndex / (load_sizeY * load_sizeZ)),
+                    (int32_t)(writeIndex / load_sizeZ % load_sizeY),
+                    (int32_t)(writeIndex % load_sizeZ),
+                    (uint8_t)voxelType
+                );
     }
 
-    // Create Voxel Field Physics Data
-    _data->vfpd = physengine::createVoxelField(getGUID(), load_transform, load_size[0], load_size[1], load_size[2], load_voxelData);
-
     // Load in camera rail relations.
     if (ds.getSerializedValuesCount() >= 1)
     {
@@ -1436,19 +1495,123 @@ inline void createInRO(VoxelField_XData& data, vkglTF::Model* model, RenderLayer
     inROs.push_back(newRO);
 }
 
-inline void assembleVoxelRenderObjects(VoxelField_XData& data, const std::string& attachedEntityGuid, std::vector<physengine::VoxelFieldCollisionShape>& inCollisionShapes, std::vector<physengine::VoxelFieldCollisionShape>& inTriggerShapes)
+void rebuildVoxelMeshModel(VoxelField_XData& data)
+{
+    auto timeStart = std::chrono::high_resolution_clock::now();
+    size_t numRemeshed = voxelmesher::updateMesh(data.voxelMesh, data.vfpd->voxelStorage);
+    if (numRemeshed == 0)
+        return;  // Nothing changed since the current model was built.
+
+    if (data.voxelMeshModel != nullptr)
+    {
+        data.retiredVoxelMeshModels.push_back({
+            .model = data.voxelMeshModel,
+            .retiredFrameNumber = data.engine->_frameNumber,
+        });
+        data.voxelMeshModel = nullptr;
+    }
+    if (data.voxelMesh.indices.empty())
+        return;
+
+    uint32_t materialID = 0;
+    auto voxelModelPrimitives = data.voxelModel->getAllPrimitivesInOrder();
+    if (!voxelModelPrimitives.empty())
+        materialID = voxelModelPrimitives[0]->materialID;
+
+    std::vector<vkglTF::Model::Vertex> vertices;
+    vertices.reserve(data.voxelMesh.vertices.size());
+    for (auto& mv : data.voxelMesh.vertices)
+    {
+        vkglTF::Model::Vertex vertex = {
+            .pos = { mv.pos[0], mv.pos[1], mv.pos[2] },
+            .normal = { mv.normal[0], mv.normal[1], mv.normal[2] },
+            .uv0 = { mv.uv[0], mv.uv[1] },
+            .uv1 = { 0.0f, 0.0f },
+            .joint0 = { 0.0f, 0.0f, 0.0f, 0.0f },
+            .weight0 = { 1.0f, 0.0f, 0.0f, 0.0f },
+            .color = { 1.0f, 1.0f, 1.0f, 1.0f },
+        };
+        vertices.push_back(vertex);
+    }
+
+    std::vector<vkglTF::Model::PrimitiveRange> primitiveRanges;
+    primitiveRanges.reserve(data.voxelMesh.chunkRanges.size());
+    for (auto& chunkRange : data.voxelMesh.chunkRanges)
+        primitiveRanges.push_back({
+            .firstIndex = chunkRange.firstIndex,
+            .indexCount = chunkRange.indexCount,
+            .materialID = materialID,
+        });
+
+    vkglTF::Model* model;
+    if (data.spareVoxelMeshModels.empty())
+        model = new vkglTF::Model();
+    else
+    {
+        model = data.spareVoxelMeshModels.back();
+        data.spareVoxelMeshModels.pop_back();
+    }
+    model->loadFromRawData(data.engine, "VoxelFieldMesh", vertices, data.voxelMesh.indices, primitiveRanges);
+    data.voxelMeshModel = model;
+
+    std::cout << "[BUILD VOXEL FIELD MESH]" << std::endl
+        << "chunks re-meshed:  " << numRemeshed << std::endl
+        << "chunks:            " << data.voxelMesh.chunkMeshes.size() << std::endl
+        << "triangles:         " << data.voxelMesh.indices.size() / 3 << std::endl
+        << "duration:          " << std::chrono::duration<double_t, std::milli>(std::chrono::high_resolution_clock::now() - timeStart).count() << " ms" << std::endl;
+}
+
+void destroyVoxelMeshModels(VoxelField_XData& data)
 {
-    std::lock_guard<std::mutex> lg(*data.editorState.editingVoxelRenderObjsMutex);
+    if (data.voxelMeshModel == nullptr && data.retiredVoxelMeshModels.empty() && data.spareVoxelMeshModels.empty())
+        return;
 
+    vkDeviceWaitIdle(data.engine->_device);  // @NOTE: the render object was just unregistered, so frames in flight could still be using these.
+    if (data.voxelMeshModel != nullptr)
+        data.retiredVoxelMeshModels.push_back({ .model = data.voxelMeshModel });
+    for (auto& retired : data.retiredVoxelMeshModels)
+    {
+        retired.model->destroy(data.engine->_allocator);
+        delete retired.model;
+    }
+    for (vkglTF::Model* model : data.spareVoxelMeshModels)
+        delete model;
+    data.voxelMeshModel = nullptr;
+    data.retiredVoxelMeshModels.clear();
+    data.spareVoxelMeshModels.clear();
+}
+
+// @NOTE: expects `editingVoxelRenderObjsMutex` to already be locked, and has to run on the main thread (it uploads the voxel mesh).
+inline void assembleVoxelRenderObjects(VoxelField_XData& data, const std::string& attachedEntityGuid, std::vector<physengine::VoxelFieldCollisionShape>& inTriggerShapes)
+{
     deleteVoxelRenderObjects(data);
     for (auto& vptcrg : data.voxelPosToCameraRailGuid)
         vptcrg.correspondingROIdx = (size_t)-1;
 
-    // Iterate thru each shape, adding it.
     std::vector<RenderObject> inROs;
     std::vector<RenderObject**> outRORefs;
-    for (auto& shape : inCollisionShapes)
-        createInRO(data, data.voxelModel, /*RenderLayer::VISIBLE @NOTE: for EWU Game Jam.*/RenderLayer::BUILDER, attachedEntityGuid, shape, inROs);
+
+    // Voxel mesh.
+    rebuildVoxelMeshModel(data);
+    if (data.voxelMeshModel != nullptr)
+    {
+        RenderObject newRO = {
+            .model = data.voxelMeshModel,
+            .renderLayer = /*RenderLayer::VISIBLE @NOTE: for EWU Game Jam.*/RenderLayer::BUILDER,
+            .attachedEntityGuid = attachedEntityGuid,
+        };
+
+        // Mesh is in storage space, so move it back into the voxel field's space.
+        mat4s localTransform;
+        glm_mat4_identity(localTransform.raw);
+        glm_translate(localTransform.raw, vec3{ -(float_t)data.vfpd->voxelStorage.origin[0], -(float_t)data.vfpd->voxelStorage.origin[1], -(float_t)data.vfpd->voxelStorage.origin[2] });
+        data.voxelRenderObjLocalTransforms.push_back(localTransform);
+
+        glm_mat4_mul(data.vfpd->transform, localTransform.raw, newRO.transformMatrix);
+        inROs.push_back(newRO);
+    }
+
+    // Camera trigger volumes stay as their own render objects (camera rail assignments point at them).
     for (auto& shape : inTriggerShapes)
     {
         createInRO(data, data.triggerModel, RenderLayer::BUILDER, attachedEntityGuid, shape, inROs);
@@ -0,0 +1,712 @@
+#include "VoxelMesher.h"
+
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <cstring>
+
+
+namespace voxelmesher
+{
+    using namespace voxelstorage;
+
+    constexpr int32_t PADDED_SIZE = BRICK_SIZE + 2;  // Brick plus a 1 voxel border from its neighbors.
+
+    // Directions are ordered +x, -x, +y, -y, +z, -z.
+    constexpr int32_t NUM_DIRECTIONS = 6;
+    constexpr int32_t DIRECTION_OFFSETS[NUM_DIRECTIONS][3] = {
+        {  1,  0,  0 }, { -1,  0,  0 },
+        {  0,  1,  0 }, {  0, -1,  0 },
+        {  0,  0,  1 }, {  0,  0, -1 },
+    };
+
+    inline int32_t oppositeDirection(int32_t dir)
+    {
+        return dir ^ 1;
+    }
+
+    // How much of a voxel's side is solid. Two neighboring sides only get culled if they match exactly, so the
+    // surface stays closed (a slope's triangle next to a full block keeps both faces).
+    enum FaceCoverage : uint8_t
+    {
+        COVERAGE_NONE = 0,
+        COVERAGE_FULL,
+        COVERAGE_TRI_POS,  // Triangle under the diagonal that rises towards the positive end of the face's other horizontal axis.
+        COVERAGE_TRI_NEG,  // Triangle under the diagonal that rises towards the negative end.
+    };
+
+    constexpr uint8_t NUM_SHAPE_TYPES = 6;
+    constexpr uint8_t FACE_COVERAGE[NUM_SHAPE_TYPES][NUM_DIRECTIONS] = {
+        // +x               -x               +y             -y             +z               -z
+        { COVERAGE_NONE,    COVERAGE_NONE,    COVERAGE_NONE, COVERAGE_NONE, COVERAGE_NONE,    COVERAGE_NONE    },  // 0: empty
+        { COVERAGE_FULL,    COVERAGE_FULL,    COVERAGE_FULL, COVERAGE_FULL, COVERAGE_FULL,    COVERAGE_FULL    },  // 1: filled
+        { COVERAGE_TRI_POS, COVERAGE_TRI_POS, COVERAGE_NONE, COVERAGE_FULL, COVERAGE_FULL,    COVERAGE_NONE    },  // 2: slope rising towards +z
+        { COVERAGE_FULL,    COVERAGE_NONE,    COVERAGE_NONE, COVERAGE_FULL, COVERAGE_TRI_POS, COVERAGE_TRI_POS },  // 3: slope rising towards +x
+        { COVERAGE_TRI_NEG, COVERAGE_TRI_NEG, COVERAGE_NONE, COVERAGE_FULL, COVERAGE_NONE,    COVERAGE_FULL    },  // 4: slope rising towards -z
+        { COVERAGE_NONE,    COVERAGE_FULL,    COVERAGE_NONE, COVERAGE_FULL, COVERAGE_TRI_NEG, COVERAGE_TRI_NEG },  // 5: slope rising towards -x
+    };
+
+    constexpr float INV_SQRT2 = 0.70710678118f;
+    constexpr float SLANTED_NORMALS[4][3] = {
+        { 0.0f,       INV_SQRT2, -INV_SQRT2 },  // 2
+        { -INV_SQRT2, INV_SQRT2, 0.0f       },  // 3
+        { 0.0f,       INV_SQRT2, INV_SQRT2  },  // 4
+        { INV_SQRT2,  INV_SQRT2, 0.0f       },  // 5
+    };
+
+    inline uint8_t toShapeType(uint8_t type)
+    {
+        return (type >= 1 && type <= 5) ? type : 0;  // Camera trigger volumes (and unknown types) don't get rendered.
+    }
+
+    inline bool isFaceCulled(uint8_t shapeType, uint8_t neighborShapeType, int32_t dir)
+    {
+        uint8_t coverage = FACE_COVERAGE[shapeType][dir];
+        return coverage == COVERAGE_NONE || coverage == FACE_COVERAGE[neighborShapeType][oppositeDirection(dir)];
+    }
+
+    inline size_t toPaddedIndex(int32_t px, int32_t py, int32_t pz)
+    {
+        return ((size_t)px * PADDED_SIZE + (size_t)py) * PADDED_SIZE + (size_t)pz;
+    }
+
+    void fillPaddedShapeTypes(const VoxelStorage& storage, int32_t bx, int32_t by, int32_t bz, uint8_t* outShapeTypes)
+    {
+        memset(outShapeTypes, 0, (size_t)PADDED_SIZE * PADDED_SIZE * PADDED_SIZE);
+
+        for (int32_t ox = -1; ox <= 1; ox++)
+        for (int32_t oy = -1; oy <= 1; oy++)
+        for (int32_t oz = -1; oz <= 1; oz++)
+        {
+            const Brick* brick = findBrick(storage, bx + ox, by + oy, bz + oz);
+            if (brick == nullptr)
+                continue;
+
+            // Range of the neighbor's local voxels that land inside the padded border.
+            int32_t offsets[3] = { ox, oy, oz };
+            int32_t localMin[3], localMax[3];  // Inclusive.
+            for (size_t a = 0; a < 3; a++)
+            {
+                localMin[a] = (offsets[a] == 1 ? 0 : (offsets[a] == -1 ? BRICK_MASK : 0));
+                localMax[a] = (offsets[a] == -1 ? BRICK_MASK : (offsets[a] == 1 ? 0 : BRICK_MASK));
+            }
+
+            for (int32_t lx = localMin[0]; lx <= localMax[0]; lx++)
+            for (int32_t ly = localMin[1]; ly <= localMax[1]; ly++)
+            for (int32_t lz = localMin[2]; lz <= localMax[2]; lz++)
+            {
+                int32_t px = lx + 1 + ox * BRICK_SIZE;
+                int32_t py = ly + 1 + oy * BRICK_SIZE;
+                int32_t pz = lz + 1 + oz * BRICK_SIZE;
+                outShapeTypes[toPaddedIndex(px, py, pz)] = toShapeType(readBrickVoxel(*brick, lx, ly, lz));
+            }
+        }
+    }
+
+    //
+    // Geometry emission
+    //
+    inline void calculatePlanarUV(const float pos[3], const float normal[3], float outUV[2])
+    {
+        float ax = std::abs(normal[0]);
+        float ay = std::abs(normal[1]);
+        float az = std::abs(normal[2]);
+        if (ax >= ay && ax >= az)
+        {
+            outUV[0] = pos[2];
+            outUV[1] = pos[1];
+        }
+        else if (az >= ay)
+        {
+            outUV[0] = pos[0];
+            outUV[1] = pos[1];
+        }
+        else
+        {
+            outUV[0] = pos[0];
+            outUV[1] = pos[2];
+        }
+    }
+
+    inline void pushVertex(ChunkMesh& chunkMesh, const float pos[3], const float normal[3])
+    {
+        MeshVertex vertex;
+        for (size_t a = 0; a < 3; a++)
+        {
+            vertex.pos[a] = pos[a];
+            vertex.normal[a] = normal[a];
+        }
+        calculatePlanarUV(pos, normal, vertex.uv);
+        chunkMesh.vertices.push_back(vertex);
+    }
+
+    // Winds the polygon so it's counter-clockwise when looking against `normal` (front face for the main pipelines).
+    inline bool needsFlip(const float p0[3], const float p1[3], const float p2[3], const float normal[3])
+    {
+        float e0[3] = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+        float e1[3] = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+        float cross[3] = {
+            e0[1] * e1[2] - e0[2] * e1[1],
+            e0[2] * e1[0] - e0[0] * e1[2],
+            e0[0] * e1[1] - e0[1] * e1[0],
+        };
+        return (cross[0] * normal[0] + cross[1] * normal[1] + cross[2] * normal[2]) < 0.0f;
+    }
+
+    void emitTriangle(ChunkMesh& chunkMesh, const float p0[3], const float p1[3], const float p2[3], const float normal[3])
+    {
+        uint32_t base = (uint32_t)chunkMesh.vertices.size();
+        pushVertex(chunkMesh, p0, normal);
+        pushVertex(chunkMesh, p1, normal);
+        pushVertex(chunkMesh, p2, normal);
+        if (needsFlip(p0, p1, p2, normal))
+            chunkMesh.indices.insert(chunkMesh.indices.end(), { base, base + 2, base + 1 });
+        else
+            chunkMesh.indices.insert(chunkMesh.indices.end(), { base, base + 1, base + 2 });
+    }
+
+    void emitQuad(ChunkMesh& chunkMesh, const float p0[3], const float p1[3], const float p2[3], const float p3[3], const float normal[3])
+    {
+        uint32_t base = (uint32_t)chunkMesh.vertices.size();
+        pushVertex(chunkMesh, p0, normal);
+        pushVertex(chunkMesh, p1, normal);
+        pushVertex(chunkMesh, p2, normal);
+        pushVertex(chunkMesh, p3, normal);
+        if (needsFlip(p0, p1, p2, normal))
+            chunkMesh.indices.insert(chunkMesh.indices.end(), { base, base + 2, base + 1, base, base + 3, base + 2 });
+        else
+            chunkMesh.indices.insert(chunkMesh.indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+
+    void meshChunk(const VoxelStorage& storage, int32_t bx, int32_t by, int32_t bz, ChunkMesh& outChunkMesh)
+    {
+        outChunkMesh.vertices.clear();
+        outChunkMesh.indices.clear();
+        if (findBrick(storage, bx, by, bz) == nullptr)
+            return;
+
+        uint8_t shapeTypes[PADDED_SIZE * PADDED_SIZE * PADDED_SIZE];
+        fillPaddedShapeTypes(storage, bx, by, bz, shapeTypes);
+
+        const float brickOrigin[3] = {
+            (float)(bx * BRICK_SIZE),
+            (float)(by * BRICK_SIZE),
+            (float)(bz * BRICK_SIZE),
+        };
+
+        // Full faces. Greedy merge them into rectangles, one slice at a time.
+        for (int32_t dir = 0; dir < NUM_DIRECTIONS; dir++)
+        {
+            const int32_t axis = dir / 2;
+            const int32_t uAxis = (axis + 1) % 3;
+            const int32_t vAxis = (axis + 2) % 3;
+            const int32_t* offset = DIRECTION_OFFSETS[dir];
+            const float normal[3] = { (float)offset[0], (float)offset[1], (float)offset[2] };
+
+            for (int32_t slice = 0; slice < BRICK_SIZE; slice++)
+            {
+                bool mask[BRICK_SIZE][BRICK_SIZE];
+                bool anyVisible = false;
+                for (int32_t u = 0; u < BRICK_SIZE; u++)
+                for (int32_t v = 0; v < BRICK_SIZE; v++)
+                {
+                    int32_t p[3];
+                    p[axis] = slice + 1;
+                    p[uAxis] = u + 1;
+                    p[vAxis] = v + 1;
+                    uint8_t shapeType = shapeTypes[toPaddedIndex(p[0], p[1], p[2])];
+                    uint8_t neighborShapeType = shapeTypes[toPaddedIndex(p[0] + offset[0], p[1] + offset[1], p[2] + offset[2])];
+                    mask[u][v] =
+                        FACE_COVERAGE[shapeType][dir] == COVERAGE_FULL &&
+                        !isFaceCulled(shapeType, neighborShapeType, dir);
+                    anyVisible |= mask[u][v];
+                }
+                if (!anyVisible)
+                    continue;
+
+                for (int32_t u = 0; u < BRICK_SIZE; u++)
+                for (int32_t v = 0; v < BRICK_SIZE; v++)
+                {
+                    if (!mask[u][v])
+                        continue;
+
+                    int32_t height = 1;
+                    while (v + height < BRICK_SIZE && mask[u][v + height])
+                        height++;
+
+                    int32_t width = 1;
+                    for (; u + width < BRICK_SIZE; width++)
+                    {
+                        bool rowFull = true;
+                        for (int32_t h = 0; h < height; h++)
+                            if (!mask[u + width][v + h])
+                            {
+                                rowFull = false;
+                                break;
+                            }
+                        if (!rowFull)
+                            break;
+                    }
+
+                    for (int32_t w = 0; w < width; w++)
+                    for (int32_t h = 0; h < height; h++)
+                        mask[u + w][v + h] = false;
+
+                    float corners[4][3];
+                    const int32_t cornerUV[4][2] = { { 0, 0 }, { width, 0 }, { width, height }, { 0, height } };
+                    for (size_t c = 0; c < 4; c++)
+                    {
+                        corners[c][axis] = brickOrigin[axis] + (float)(slice + (offset[axis] > 0 ? 1 : 0));
+                        corners[c][uAxis] = brickOrigin[uAxis] + (float)(u + cornerUV[c][0]);
+                        corners[c][vAxis] = brickOrigin[vAxis] + (float)(v + cornerUV[c][1]);
+                    }
+                    emitQuad(outChunkMesh, corners[0], corners[1], corners[2], corners[3], normal);
+                }
+            }
+        }
+
+        // Slopes. Triangle sides go in as is, and the slanted faces get merged into runs along the slope's width.
+        for (int32_t lx = 0; lx < BRICK_SIZE; lx++)
+        for (int32_t ly = 0; ly < BRICK_SIZE; ly++)
+        for (int32_t lz = 0; lz < BRICK_SIZE; lz++)
+        {
+            const size_t index = toPaddedIndex(lx + 1, ly + 1, lz + 1);
+            const uint8_t shapeType = shapeTypes[index];
+            if (shapeType < 2)
+                continue;
+
+            const float x = brickOrigin[0] + (float)lx;
+            const float y = brickOrigin[1] + (float)ly;
+            const float z = brickOrigin[2] + (float)lz;
+
+            for (int32_t dir = 0; dir < NUM_DIRECTIONS; dir++)
+            {
+                uint8_t coverage = FACE_COVERAGE[shapeType][dir];
+                if (coverage != COVERAGE_TRI_POS && coverage != COVERAGE_TRI_NEG)
+                    continue;
+
+                const int32_t* offset = DIRECTION_OFFSETS[dir];
+                uint8_t neighborShapeType = shapeTypes[toPaddedIndex(lx + 1 + offset[0], ly + 1 + offset[1], lz + 1 + offset[2])];
+                if (isFaceCulled(shapeType, neighborShapeType, dir))
+                    continue;
+
+                const float normal[3] = { (float)offset[0], (float)offset[1], (float)offset[2] };
+                const bool rising = (coverage == COVERAGE_TRI_POS);
+                if (dir / 2 == 0)
+                {
+                    // Side of a slope along z.
+                    float sx = x + (offset[0] > 0 ? 1.0f : 0.0f);
+                    float p0[3] = { sx, y, z };
+                    float p1[3] = { sx, y, z + 1.0f };
+                    float p2[3] = { sx, y + 1.0f, rising ? z + 1.0f : z };
+                    emitTriangle(outChunkMesh, p0, p1, p2, normal);
+                }
+                else
+                {
+                    // Side of a slope along x.
+                    float sz = z + (offset[2] > 0 ? 1.0f : 0.0f);
+                    float p0[3] = { x, y, sz };
+                    float p1[3] = { x + 1.0f, y, sz };
+                    float p2[3] = { rising ? x + 1.0f : x, y + 1.0f, sz };
+                    emitTriangle(outChunkMesh, p0, p1, p2, normal);
+                }
+            }
+
+            // Slanted face. Only the first voxel of a run emits it.
+            const bool alongZ = (shapeType == 2 || shapeType == 4);  // Rises along z, so the run goes along x.
+            const int32_t runAxis = alongZ ? 0 : 2;
+            const int32_t local[3] = { lx, ly, lz };
+            if (local[runAxis] > 0)
+            {
+                size_t prevIndex = alongZ ? toPaddedIndex(lx, ly + 1, lz + 1) : toPaddedIndex(lx + 1, ly + 1, lz);
+                if (shapeTypes[prevIndex] == shapeType)
+                    continue;
+            }
+
+            int32_t runLength = 1;
+            while (local[runAxis] + runLength < BRICK_SIZE)
+            {
+                size_t nextIndex = alongZ ?
+                    toPaddedIndex(lx + 1 + runLength, ly + 1, lz + 1) :
+                    toPaddedIndex(lx + 1, ly + 1, lz + 1 + runLength);
+                if (shapeTypes[nextIndex] != shapeType)
+                    break;
+                runLength++;
+            }
+
+            const float* normal = SLANTED_NORMALS[shapeType - 2];
+            const float length = (float)runLength;
+            switch (shapeType)
+            {
+                case 2:
+                {
+                    float p0[3] = { x, y, z };
+                    float p1[3] = { x + length, y, z };
+                    float p2[3] = { x + length, y + 1.0f, z + 1.0f };
+                    float p3[3] = { x, y + 1.0f, z + 1.0f };
+                    emitQuad(outChunkMesh, p0, p1, p2, p3, normal);
+                } break;
+
+                case 3:
+                {
+                    float p0[3] = { x, y, z };
+                    float p1[3] = { x, y, z + length };
+                    float p2[3] = { x + 1.0f, y + 1.0f, z + length };
+                    float p3[3] = { x + 1.0f, y + 1.0f, z };
+                    emitQuad(outChunkMesh, p0, p1, p2, p3, normal);
+                } break;
+
+                case 4:
+                {
+                    float p0[3] = { x, y, z + 1.0f };
+                    float p1[3] = { x + length, y, z + 1.0f };
+                    float p2[3] = { x + length, y + 1.0f, z };
+                    float p3[3] = { x, y + 1.0f, z };
+                    emitQuad(outChunkMesh, p0, p1, p2, p3, normal);
+                } break;
+
+                case 5:
+                {
+                    float p0[3] = { x + 1.0f, y, z };
+                    float p1[3] = { x + 1.0f, y, z + length };
+                    float p2[3] = { x, y + 1.0f, z + length };
+                    float p3[3] = { x, y + 1.0f, z };
+                    emitQuad(outChunkMesh, p0, p1, p2, p3, normal);
+                } break;
+            }
+        }
+    }
+
+    size_t updateMesh(VoxelMesh& mesh, VoxelStorage& storage)
+    {
+        size_t numRemeshed = 0;
+        for (uint64_t key : storage.dirtyBricks)
+        {
+            int32_t bx, by, bz;
+            fromBrickKey(key, bx, by, bz);
+
+            ChunkMesh chunkMesh;
+            meshChunk(storage, bx, by, bz, chunkMesh);
+            if (chunkMesh.indices.empty())
+                mesh.chunkMeshes.erase(key);
+            else
+                mesh.chunkMeshes[key] = std::move(chunkMesh);
+            numRemeshed++;
+        }
+        storage.dirtyBricks.clear();
+
+        if (numRemeshed == 0)
+            return 0;
+
+        // Repack the shared buffer. Sorted by key so the same voxels always give the same buffer.
+        std::vector<uint64_t> keys;
+        keys.reserve(mesh.chunkMeshes.size());
+        size_t numVertices = 0;
+        size_t numIndices = 0;
+        for (auto& [key, chunkMesh] : mesh.chunkMeshes)
+        {
+            keys.push_back(key);
+            numVertices += chunkMesh.vertices.size();
+            numIndices += chunkMesh.indices.size();
+        }
+        std::sort(keys.begin(), keys.end());
+
+        mesh.vertices.clear();
+        mesh.indices.clear();
+        mesh.chunkRanges.clear();
+        mesh.vertices.reserve(numVertices);
+        mesh.indices.reserve(numIndices);
+        mesh.chunkRanges.reserve(keys.size());
+        for (uint64_t key : keys)
+        {
+            const ChunkMesh& chunkMesh = mesh.chunkMeshes[key];
+            uint32_t baseVertex = (uint32_t)mesh.vertices.size();
+            ChunkRange range = {
+                .brickKey = key,
+                .firstIndex = (uint32_t)mesh.indices.size(),
+                .indexCount = (uint32_t)chunkMesh.indices.size(),
+            };
+            mesh.vertices.insert(mesh.vertices.end(), chunkMesh.vertices.begin(), chunkMesh.vertices.end());
+            for (uint32_t index : chunkMesh.indices)
+                mesh.indices.push_back(baseVertex + index);
+            mesh.chunkRanges.push_back(range);
+        }
+
+        return numRemeshed;
+    }
+
+    //
+    // Validation
+    //
+    constexpr size_t NUM_NORMAL_BUCKETS = NUM_DIRECTIONS + 4;  // Axis faces, then the slanted faces of types 2-5.
+
+    void getBucketNormal(size_t bucket, double outNormal[3])
+    {
+        for (size_t a = 0; a < 3; a++)
+            outNormal[a] = (bucket < NUM_DIRECTIONS ?
+                (double)DIRECTION_OFFSETS[bucket][a] :
+                (double)SLANTED_NORMALS[bucket - NUM_DIRECTIONS][a]);
+    }
+
+    MeshValidation validateMesh(const VoxelMesh& mesh, const VoxelStorage& storage)
+    {
+        MeshValidation validation;
+        validation.numTriangles = mesh.indices.size() / 3;
+
+        // What the voxels expose, counted voxel by voxel.
+        double expectedAreas[NUM_NORMAL_BUCKETS] = {};
+        auto getShapeType = [&](int32_t sx, int32_t sy, int32_t sz) {
+            return toShapeType(getVoxel(storage, sx - storage.origin[0], sy - storage.origin[1], sz - storage.origin[2]));
+        };
+        for (auto& [key, brick] : storage.bricks)
+        {
+            int32_t brickPos[3];
+            fromBrickKey(key, brickPos[0], brickPos[1], brickPos[2]);
+
+            for (int32_t lx = 0; lx < BRICK_SIZE; lx++)
+            for (int32_t ly = 0; ly < BRICK_SIZE; ly++)
+            for (int32_t lz = 0; lz < BRICK_SIZE; lz++)
+            {
+                uint8_t shapeType = toShapeType(readBrickVoxel(brick, lx, ly, lz));
+                if (shapeType == 0)
+                    continue;
+
+                int32_t sx = brickPos[0] * BRICK_SIZE + lx;
+                int32_t sy = brickPos[1] * BRICK_SIZE + ly;
+                int32_t sz = brickPos[2] * BRICK_SIZE + lz;
+                for (int32_t dir = 0; dir < NUM_DIRECTIONS; dir++)
+                {
+                    const int32_t* offset = DIRECTION_OFFSETS[dir];
+                    if (isFaceCulled(shapeType, getShapeType(sx + offset[0], sy + offset[1], sz + offset[2]), dir))
+                        continue;
+                    bool full = (FACE_COVERAGE[shapeType][dir] == COVERAGE_FULL);
+                    expectedAreas[dir] += (full ? 1.0 : 0.5);
+                    validation.numUnmergedTriangles += (full ? 2 : 1);
+                }
+
+                if (shapeType == 1)
+                    validation.expectedVolume += 1.0;
+                else
+                {
+                    expectedAreas[NUM_DIRECTIONS + shapeType - 2] += std::sqrt(2.0);
+                    validation.numUnmergedTriangles += 2;
+                    validation.expectedVolume += 0.5;
+                }
+            }
+        }
+
+        // What the mesh actually covers.
+        double meshAreas[NUM_NORMAL_BUCKETS] = {};
+        double normalSum[3] = { 0.0, 0.0, 0.0 };
+        double unbucketedArea = 0.0;
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3)
+        {
+            const MeshVertex& v0 = mesh.vertices[mesh.indices[i + 0]];
+            const MeshVertex& v1 = mesh.vertices[mesh.indices[i + 1]];
+            const MeshVertex& v2 = mesh.vertices[mesh.indices[i + 2]];
+
+            double e0[3], e1[3];
+            for (size_t a = 0; a < 3; a++)
+            {
+                e0[a] = (double)v1.pos[a] - (double)v0.pos[a];
+                e1[a] = (double)v2.pos[a] - (double)v0.pos[a];
+            }
+            double cross[3] = {
+                e0[1] * e1[2] - e0[2] * e1[1],
+                e0[2] * e1[0] - e0[0] * e1[2],
+                e0[0] * e1[1] - e0[1] * e1[0],
+            };
+            double crossLength = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+            double area = crossLength * 0.5;
+
+            for (size_t a = 0; a < 3; a++)
+                normalSum[a] += cross[a] * 0.5;
+
+            // Signed volume of the tetrahedron to the origin.
+            validation.volume += (
+                (double)v0.pos[0] * ((double)v1.pos[1] * v2.pos[2] - (double)v1.pos[2] * v2.pos[1]) -
+                (double)v0.pos[1] * ((double)v1.pos[0] * v2.pos[2] - (double)v1.pos[2] * v2.pos[0]) +
+                (double)v0.pos[2] * ((double)v1.pos[0] * v2.pos[1] - (double)v1.pos[1] * v2.pos[0])) / 6.0;
+
+            if (crossLength <= 0.0)
+                continue;
+
+            double vertexNormalDot = (cross[0] * v0.normal[0] + cross[1] * v0.normal[1] + cross[2] * v0.normal[2]) / crossLength;
+            if (vertexNormalDot < 0.999)
+                validation.windingMatchesNormals = false;
+
+            bool bucketed = false;
+            for (size_t bucket = 0; bucket < NUM_NORMAL_BUCKETS; bucket++)
+            {
+                double bucketNormal[3];
+                getBucketNormal(bucket, bucketNormal);
+                double dot = (cross[0] * bucketNormal[0] + cross[1] * bucketNormal[1] + cross[2] * bucketNormal[2]) / crossLength;
+                if (dot > 0.999)
+                {
+                    meshAreas[bucket] += area;
+                    bucketed = true;
+                    break;
+                }
+            }
+            if (!bucketed)
+                unbucketedArea += area;
+        }
+
+        for (size_t bucket = 0; bucket < NUM_NORMAL_BUCKETS; bucket++)
+            validation.maxAreaError = std::max(validation.maxAreaError, std::abs(meshAreas[bucket] - expectedAreas[bucket]));
+        validation.maxAreaError = std::max(validation.maxAreaError, unbucketedArea);
+        validation.normalSumLength = std::sqrt(normalSum[0] * normalSum[0] + normalSum[1] * normalSum[1] + normalSum[2] * normalSum[2]);
+
+        constexpr double EPSILON = 1e-3;
+        validation.isValid =
+            validation.maxAreaError < EPSILON &&
+            validation.normalSumLength < EPSILON &&
+            std::abs(validation.volume - validation.expectedVolume) < EPSILON &&
+            validation.windingMatchesNormals &&
+            validation.numTriangles <= validation.numUnmergedTriangles;
+        return validation;
+    }
+
+    //
+    // Self test
+    //
+    bool chunkMeshesMatch(const VoxelMesh& a, const VoxelMesh& b)
+    {
+        if (a.chunkMeshes.size() != b.chunkMeshes.size() ||
+            a.vertices.size() != b.vertices.size() ||
+            a.indices != b.indices)
+            return false;
+        for (auto& [key, chunkMesh] : a.chunkMeshes)
+        {
+            auto it = b.chunkMeshes.find(key);
+            if (it == b.chunkMeshes.end() ||
+                it->second.indices != chunkMesh.indices ||
+                it->second.vertices.size() != chunkMesh.vertices.size() ||
+                memcmp(it->second.vertices.data(), chunkMesh.vertices.data(), chunkMesh.vertices.size() * sizeof(MeshVertex)) != 0)
+                return false;
+        }
+        return true;
+    }
+
+    void remeshFromScratch(const VoxelStorage& storage, VoxelMesh& outMesh)
+    {
+        VoxelStorage copy = storage;
+        copy.dirtyBricks.clear();
+        for (auto& [key, brick] : copy.bricks)
+            copy.dirtyBricks.insert(key);
+        outMesh = VoxelMesh();
+        updateMesh(outMesh, copy);
+    }
+
+    bool reportCase(const char* name, const VoxelMesh& mesh, const VoxelStorage& storage, size_t expectedTriangles = 0)
+    {
+        MeshValidation validation = validateMesh(mesh, storage);
+        bool passed = validation.isValid && (expectedTriangles == 0 || validation.numTriangles == expectedTriangles);
+        std::cout << "    " << name << ": "
+            << validation.numTriangles << " triangles (" << validation.numUnmergedTriangles << " without merging)"
+            << ", chunks: " << mesh.chunkMeshes.size()
+            << ", volume: " << validation.volume << " (expected " << validation.expectedVolume << ")"
+            << ", max area error: " << validation.maxAreaError
+            << ", normal sum: " << validation.normalSumLength
+            << (validation.windingMatchesNormals ? "" : ", BAD WINDING")
+            << " -> " << (passed ? "OK" : "FAILED") << std::endl;
+        return passed;
+    }
+
+    bool runSelfTest()
+    {
+        std::cout << "[VOXEL MESHER SELF TEST]" << std::endl;
+        bool passed = true;
+
+        {
+            VoxelStorage storage;
+            setVoxel(storage, 0, 0, 0, 1);
+            VoxelMesh mesh;
+            updateMesh(mesh, storage);
+            passed &= reportCase("single voxel", mesh, storage, 12);
+        }
+
+        {
+            // Spans 8 bricks, so each brick's 3 outer sides come out as 1 quad each.
+            VoxelStorage storage;
+            for (int32_t i = 0; i < 32; i++)
+            for (int32_t j = 0; j < 32; j++)
+            for (int32_t k = 0; k < 32; k++)
+                setVoxel(storage, i, j, k, 1);
+            VoxelMesh mesh;
+            updateMesh(mesh, storage);
+            passed &= reportCase("32^3 block", mesh, storage, 48);
+        }
+
+        {
+            VoxelStorage storage;
+            for (uint8_t type = 2; type <= 5; type++)
+                setVoxel(storage, (type - 2) * 2, 0, 0, type);
+            VoxelMesh mesh;
+            updateMesh(mesh, storage);
+            passed &= reportCase("single slopes", mesh, storage, 4 * 8);
+        }
+
+        {
+            // A ramp made of a row of slopes on top of a floor.
+            VoxelStorage storage;
+            for (int32_t i = 0; i < 20; i++)
+            for (int32_t k = 0; k < 20; k++)
+            {
+                setVoxel(storage, i, 0, k, 1);
+                if (k == 10)
+                    setVoxel(storage, i, 1, k, 2);
+                if (k > 10)
+                    setVoxel(storage, i, 1, k, 1);
+            }
+            VoxelMesh mesh;
+            updateMesh(mesh, storage);
+            passed &= reportCase("ramp", mesh, storage);
+        }
+
+        // Random terrain (with triggers sprinkled in), then random edits re-meshed incrementally.
+        std::mt19937 rng(1337);
+        VoxelStorage storage;
+        storage.origin[0] = 40;
+        storage.origin[1] = 3;
+        storage.origin[2] = -20;  // Some bricks end up in negative storage space.
+        for (int32_t i = 0; i < 64; i++)
+        for (int32_t k = 0; k < 48; k++)
+        {
+            int32_t height = 2 + (int32_t)(rng() % 12);
+            for (int32_t j = 0; j < height; j++)
+                setVoxel(storage, i, j, k, 1);
+            uint32_t roll = rng() % 10;
+            if (roll < 4)
+                setVoxel(storage, i, height, k, (uint8_t)(2 + roll));
+            else if (roll == 4)
+                setVoxel(storage, i, height, k, (uint8_t)(6 + rng() % 2));
+        }
+        VoxelMesh mesh;
+        updateMesh(mesh, storage);
+        passed &= reportCase("random terrain", mesh, storage);
+
+        size_t numEditRounds = 8;
+        size_t numRemeshedTotal = 0;
+        bool incrementalMatches = true;
+        for (size_t round = 0; round < numEditRounds; round++)
+        {
+            for (size_t e = 0; e < 50; e++)
+                setVoxel(storage, (int32_t)(rng() % 72) - 4, (int32_t)(rng() % 20) - 2, (int32_t)(rng() % 56) - 4, (uint8_t)(rng() % 8));
+            numRemeshedTotal += updateMesh(mesh, storage);
+
+            VoxelMesh fullMesh;
+            remeshFromScratch(storage, fullMesh);
+            incrementalMatches &= chunkMeshesMatch(mesh, fullMesh);
+        }
+        passed &= reportCase("random terrain after edits", mesh, storage);
+        passed &= incrementalMatches;
+        std::cout << "    incremental re-meshing: " << numRemeshedTotal << " chunks re-meshed over " << numEditRounds
+            << " edit rounds (" << storage.bricks.size() << " bricks in the field)"
+            << " -> " << (incrementalMatches ? "matches a full re-mesh" : "DOES NOT MATCH a full re-mesh") << std::endl;
+
+        std::cout << (passed ? "All voxel mesher checks passed." : "Voxel mesher checks FAILED.") << std::endl;
+        return passed;
+    }
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "VoxelStorage.h"
+
+
+// @NOTE: turns a voxel field's bricks into render geometry. Each brick (chunk) gets its own face-culled mesh with
+//        the solid faces greedy merged into rectangles, and then all the chunk meshes get packed into one shared
+//        vertex/index buffer so a whole voxel field is a single model. Only the bricks that were marked dirty in
+//        the storage get re-meshed.
+//
+//        Positions are in storage space (logical voxel position + `VoxelStorage::origin`), so a chunk's mesh stays
+//        valid when the field's bounds get expanded or shrunk.
+//
+//        Rendered types: 1 (filled) and 2-5 (slopes). Everything else (empty, camera trigger volumes) is left out.
+namespace voxelmesher
+{
+    struct MeshVertex
+    {
+        float pos[3];
+        float normal[3];
+        float uv[2];
+    };
+
+    struct ChunkMesh
+    {
+        std::vector<MeshVertex> vertices;
+        std::vector<uint32_t> indices;  // Local to `vertices`.
+    };
+
+    struct ChunkRange
+    {
+        uint64_t brickKey;
+        uint32_t firstIndex;
+        uint32_t indexCount;
+    };
+
+    struct VoxelMesh
+    {
+        std::unordered_map<uint64_t, ChunkMesh> chunkMeshes;
+
+        // Shared buffer of all the chunk meshes (`indices` already point into the shared `vertices`).
+        std::vector<MeshVertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<ChunkRange> chunkRanges;
+    };
+
+    void meshChunk(const voxelstorage::VoxelStorage& storage, int32_t bx, int32_t by, int32_t bz, ChunkMesh& outChunkMesh);
+
+    // Re-meshes the storage's dirty bricks (and clears them), then repacks the shared buffer if anything changed.
+    // Returns the number of chunks that got re-meshed.
+    size_t updateMesh(VoxelMesh& mesh, voxelstorage::VoxelStorage& storage);
+
+    struct MeshValidation
+    {
+        size_t numTriangles = 0;
+        size_t numUnmergedTriangles = 0;  // What plain face culling w/o greedy merging would've emitted.
+        double volume = 0.0;              // Signed volume of the mesh (divergence theorem).
+        double expectedVolume = 0.0;      // 1 for each filled voxel, 0.5 for each slope.
+        double maxAreaError = 0.0;        // Worst difference between the mesh's area facing a direction and the area the voxels expose in it.
+        double normalSumLength = 0.0;     // Length of the sum of area-weighted normals. 0 for a closed surface.
+        bool windingMatchesNormals = true;
+        bool isValid = false;
+    };
+
+    // Checks the mesh against the voxel data: every exposed face is covered (per-direction area matches), the
+    // surface is closed (area-weighted normals sum to 0 and the enclosed volume matches the voxels) and the
+    // winding agrees with the vertex normals.
+    MeshValidation validateMesh(const VoxelMesh& mesh, const voxelstorage::VoxelStorage& storage);
+
+    // Headless check of the mesher on a few generated fields, including incremental re-meshing after edits. Prints a report.
+    bool runSelfTest();
+}
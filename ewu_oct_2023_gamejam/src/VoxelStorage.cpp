@@ -0,0 +1,265 @@
+#include "VoxelStorage.h"
+
+#include <algorithm>
+#include <cstring>
+
+
+namespace voxelstorage
+{
+    constexpr int32_t BRICK_KEY_BITS = 21;
+    constexpr uint64_t BRICK_KEY_MASK = (1ull << BRICK_KEY_BITS) - 1;
+
+    uint64_t toBrickKey(int32_t bx, int32_t by, int32_t bz)
+    {
+        return ((uint64_t)(bx & BRICK_KEY_MASK) << (BRICK_KEY_BITS * 2)) |
+            ((uint64_t)(by & BRICK_KEY_MASK) << BRICK_KEY_BITS) |
+            (uint64_t)(bz & BRICK_KEY_MASK);
+    }
+
+    inline int32_t signExtendBrickKeyPart(uint64_t part)
+    {
+        return (int32_t)((int64_t)(part << (64 - BRICK_KEY_BITS)) >> (64 - BRICK_KEY_BITS));
+    }
+
+    void fromBrickKey(uint64_t key, int32_t& outBX, int32_t& outBY, int32_t& outBZ)
+    {
+        outBX = signExtendBrickKeyPart((key >> (BRICK_KEY_BITS * 2)) & BRICK_KEY_MASK);
+        outBY = signExtendBrickKeyPart((key >> BRICK_KEY_BITS) & BRICK_KEY_MASK);
+        outBZ = signExtendBrickKeyPart(key & BRICK_KEY_MASK);
+    }
+
+    inline size_t toLocalIndex(int32_t lx, int32_t ly, int32_t lz)
+    {
+        return ((size_t)lx << (BRICK_SHIFT * 2)) | ((size_t)ly << BRICK_SHIFT) | (size_t)lz;
+    }
+
+    inline uint8_t readPacked(const std::vector<uint8_t>& packed, size_t localIndex)
+    {
+        return (packed[localIndex >> 1] >> ((localIndex & 1) * 4)) & 0xF;
+    }
+
+    inline void writePacked(std::vector<uint8_t>& packed, size_t localIndex, uint8_t type)
+    {
+        uint8_t& byte = packed[localIndex >> 1];
+        uint8_t shift = (uint8_t)((localIndex & 1) * 4);
+        byte = (byte & ~(0xF << shift)) | (type << shift);
+    }
+
+    const Brick* findBrick(const VoxelStorage& storage, int32_t bx, int32_t by, int32_t bz)
+    {
+        auto it = storage.bricks.find(toBrickKey(bx, by, bz));
+        return (it == storage.bricks.end() ? nullptr : &it->second);
+    }
+
+    uint8_t readBrickVoxel(const Brick& brick, int32_t lx, int32_t ly, int32_t lz)
+    {
+        if (brick.packed.empty())
+            return brick.uniformType;
+        return readPacked(brick.packed, toLocalIndex(lx, ly, lz));
+    }
+
+    void markDirty(VoxelStorage& storage, int32_t sx, int32_t sy, int32_t sz)
+    {
+        int32_t bx = sx >> BRICK_SHIFT;
+        int32_t by = sy >> BRICK_SHIFT;
+        int32_t bz = sz >> BRICK_SHIFT;
+        storage.dirtyBricks.insert(toBrickKey(bx, by, bz));
+
+        // Voxels on a brick's border also change how its neighbor's faces get culled.
+        int32_t local[3] = { sx & BRICK_MASK, sy & BRICK_MASK, sz & BRICK_MASK };
+        int32_t brickPos[3] = { bx, by, bz };
+        for (size_t a = 0; a < 3; a++)
+        {
+            int32_t neighbor[3] = { brickPos[0], brickPos[1], brickPos[2] };
+            if (local[a] == 0)
+                neighbor[a]--;
+            else if (local[a] == BRICK_MASK)
+                neighbor[a]++;
+            else
+                continue;
+            storage.dirtyBricks.insert(toBrickKey(neighbor[0], neighbor[1], neighbor[2]));
+        }
+    }
+
+    uint8_t getVoxel(const VoxelStorage& storage, int32_t x, int32_t y, int32_t z)
+    {
+        x += storage.origin[0];
+        y += storage.origin[1];
+        z += storage.origin[2];
+
+        auto it = storage.bricks.find(toBrickKey(x >> BRICK_SHIFT, y >> BRICK_SHIFT, z >> BRICK_SHIFT));
+        if (it == storage.bricks.end())
+            return 0;
+
+        const Brick& brick = it->second;
+        if (brick.packed.empty())
+            return brick.uniformType;
+        return readPacked(brick.packed, toLocalIndex(x & BRICK_MASK, y & BRICK_MASK, z & BRICK_MASK));
+    }
+
+    void setVoxel(VoxelStorage& storage, int32_t x, int32_t y, int32_t z, uint8_t type)
+    {
+        type &= 0xF;
+        x += storage.origin[0];
+        y += storage.origin[1];
+        z += storage.origin[2];
+
+        uint64_t key = toBrickKey(x >> BRICK_SHIFT, y >> BRICK_SHIFT, z >> BRICK_SHIFT);
+        auto it = storage.bricks.find(key);
+        if (it == storage.bricks.end())
+        {
+            if (type == 0)
+                return;  // Already empty.
+            it = storage.bricks.emplace(key, Brick{}).first;  // Starts out as a uniform empty brick.
+        }
+
+        Brick& brick = it->second;
+        if (brick.packed.empty())
+        {
+            if (brick.uniformType == type)
+                return;
+
+            // Break up the uniform brick.
+            uint8_t nibbles = brick.uniformType | (brick.uniformType << 4);
+            brick.packed.assign(BRICK_PACKED_BYTE_SIZE, nibbles);
+            brick.typeCounts.fill(0);
+            brick.typeCounts[brick.uniformType] = (uint16_t)BRICK_VOXEL_COUNT;
+        }
+
+        size_t localIndex = toLocalIndex(x & BRICK_MASK, y & BRICK_MASK, z & BRICK_MASK);
+        uint8_t prevType = readPacked(brick.packed, localIndex);
+        if (prevType == type)
+            return;
+        writePacked(brick.packed, localIndex, type);
+        brick.typeCounts[prevType]--;
+        brick.typeCounts[type]++;
+        markDirty(storage, x, y, z);
+
+        if (brick.typeCounts[type] == BRICK_VOXEL_COUNT)
+        {
+            // Whole brick is one type now. Collapse it (or drop it entirely if it's empty).
+            if (type == 0)
+                storage.bricks.erase(it);
+            else
+            {
+                brick.uniformType = type;
+                brick.packed.clear();
+                brick.packed.shrink_to_fit();
+            }
+        }
+    }
+
+    void clear(VoxelStorage& storage)
+    {
+        storage.origin[0] = storage.origin[1] = storage.origin[2] = 0;
+        storage.bricks.clear();
+        storage.dirtyBricks.clear();
+    }
+
+    void importDense(VoxelStorage& storage, const uint8_t* voxelData, size_t sizeX, size_t sizeY, size_t sizeZ)
+    {
+        for (size_t i = 0; i < sizeX; i++)
+        for (size_t j = 0; j < sizeY; j++)
+        for (size_t k = 0; k < sizeZ; k++)
+        {
+            uint8_t data = voxelData[i * sizeY * sizeZ + j * sizeZ + k];
+            if (data != 0)
+                setVoxel(storage, (int32_t)i, (int32_t)j, (int32_t)k, data);
+        }
+    }
+
+    void exportDense(const VoxelStorage& storage, size_t sizeX, size_t sizeY, size_t sizeZ, std::vector<uint8_t>& outVoxelData)
+    {
+        outVoxelData.assign(sizeX * sizeY * sizeZ, 0);
+
+        // Only visit the bricks that exist and copy the part of each that's inside the bounds.
+        for (auto& [key, brick] : storage.bricks)
+        {
+            int32_t brickPos[3];
+            fromBrickKey(key, brickPos[0], brickPos[1], brickPos[2]);
+
+            int32_t logicalMin[3], logicalMax[3];  // Exclusive max.
+            for (size_t a = 0; a < 3; a++)
+                logicalMin[a] = brickPos[a] * BRICK_SIZE - storage.origin[a];
+            logicalMax[0] = std::min(logicalMin[0] + BRICK_SIZE, (int32_t)sizeX);
+            logicalMax[1] = std::min(logicalMin[1] + BRICK_SIZE, (int32_t)sizeY);
+            logicalMax[2] = std::min(logicalMin[2] + BRICK_SIZE, (int32_t)sizeZ);
+
+            for (int32_t i = std::max(logicalMin[0], 0); i < logicalMax[0]; i++)
+            for (int32_t j = std::max(logicalMin[1], 0); j < logicalMax[1]; j++)
+            {
+                uint8_t* row = &outVoxelData[(size_t)i * sizeY * sizeZ + (size_t)j * sizeZ];
+                for (int32_t k = std::max(logicalMin[2], 0); k < logicalMax[2]; k++)
+                    row[k] = brick.packed.empty() ?
+                        brick.uniformType :
+                        readPacked(brick.packed, toLocalIndex(i - logicalMin[0], j - logicalMin[1], k - logicalMin[2]));
+            }
+        }
+    }
+
+    bool calculateFilledBounds(const VoxelStorage& storage, int32_t outBoundsMin[3], int32_t outBoundsMax[3])
+    {
+        bool found = false;
+        for (auto& [key, brick] : storage.bricks)
+        {
+            int32_t brickPos[3];
+            fromBrickKey(key, brickPos[0], brickPos[1], brickPos[2]);
+
+            int32_t localMin[3] = { BRICK_SIZE, BRICK_SIZE, BRICK_SIZE };
+            int32_t localMax[3] = { -1, -1, -1 };
+            if (brick.packed.empty())
+            {
+                if (brick.uniformType == 0)
+                    continue;
+                localMin[0] = localMin[1] = localMin[2] = 0;
+                localMax[0] = localMax[1] = localMax[2] = BRICK_MASK;
+            }
+            else
+            {
+                for (int32_t lx = 0; lx < BRICK_SIZE; lx++)
+                for (int32_t ly = 0; ly < BRICK_SIZE; ly++)
+                for (int32_t lz = 0; lz < BRICK_SIZE; lz++)
+                    if (readPacked(brick.packed, toLocalIndex(lx, ly, lz)) != 0)
+                    {
+                        localMin[0] = std::min(localMin[0], lx);
+                        localMin[1] = std::min(localMin[1], ly);
+                        localMin[2] = std::min(localMin[2], lz);
+                        localMax[0] = std::max(localMax[0], lx);
+                        localMax[1] = std::max(localMax[1], ly);
+                        localMax[2] = std::max(localMax[2], lz);
+                    }
+                if (localMax[0] < 0)
+                    continue;
+            }
+
+            for (size_t a = 0; a < 3; a++)
+            {
+                int32_t brickLogicalMin = brickPos[a] * BRICK_SIZE - storage.origin[a];
+                int32_t boundsMin = brickLogicalMin + localMin[a];
+                int32_t boundsMax = brickLogicalMin + localMax[a];
+                outBoundsMin[a] = found ? std::min(outBoundsMin[a], boundsMin) : boundsMin;
+                outBoundsMax[a] = found ? std::max(outBoundsMax[a], boundsMax) : boundsMax;
+            }
+            found = true;
+        }
+        return found;
+    }
+
+    MemoryUsage calculateMemoryUsage(const VoxelStorage& storage)
+    {
+        MemoryUsage usage;
+        for (auto& [key, brick] : storage.bricks)
+        {
+            if (brick.packed.empty())
+                usage.numUniformBricks++;
+            else
+            {
+                usage.numPackedBricks++;
+                usage.byteSize += brick.packed.capacity();
+            }
+        }
+        usage.byteSize += storage.bricks.size() * (sizeof(uint64_t) + sizeof(Brick) + sizeof(void*) * 2);  // Rough node overhead.
+        usage.byteSize += storage.bricks.bucket_count() * sizeof(void*);
+        return usage;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <cstddef>
+
+
+// @NOTE: voxel fields are stored as 16^3 bricks that only get allocated once something non-empty is written
+//        into them. A brick that's all one type (e.g. the solid inside of a big chunk of ground) doesn't keep
+//        any per-voxel data, and bricks that are all empty aren't stored at all. Voxel types get packed into
+//        4 bits, so there's room for 16 types (0-15).
+//
+//        Bricks are keyed by their "storage space" position, which is the logical voxel position plus `origin`.
+//        Growing the field in the negative direction just shifts `origin`, so nothing has to be copied.
+//        All the functions below take logical positions.
+namespace voxelstorage
+{
+    constexpr int32_t BRICK_SHIFT             = 4;
+    constexpr int32_t BRICK_SIZE              = 1 << BRICK_SHIFT;
+    constexpr int32_t BRICK_MASK              = BRICK_SIZE - 1;
+    constexpr size_t  BRICK_VOXEL_COUNT       = BRICK_SIZE * BRICK_SIZE * BRICK_SIZE;
+    constexpr size_t  BRICK_PACKED_BYTE_SIZE  = BRICK_VOXEL_COUNT / 2;
+    constexpr uint8_t NUM_VOXEL_TYPES         = 16;
+
+    struct Brick
+    {
+        uint8_t uniformType = 0;                          // Type of every voxel in the brick while `packed` is empty.
+        std::vector<uint8_t> packed;                      // 4 bits per voxel. Empty if the brick is uniform.
+        std::array<uint16_t, NUM_VOXEL_TYPES> typeCounts; // Only kept up to date while `packed` is in use.
+    };
+
+    struct VoxelStorage
+    {
+        int32_t origin[3] = { 0, 0, 0 };
+        std::unordered_map<uint64_t, Brick> bricks;
+        std::unordered_set<uint64_t> dirtyBricks;  // Keys of bricks whose contents (or neighboring voxels) changed since this was last cleared. Used for re-meshing.
+    };
+
+    struct MemoryUsage
+    {
+        size_t numUniformBricks = 0;
+        size_t numPackedBricks = 0;
+        size_t byteSize = 0;
+    };
+
+    uint64_t toBrickKey(int32_t bx, int32_t by, int32_t bz);
+    void fromBrickKey(uint64_t key, int32_t& outBX, int32_t& outBY, int32_t& outBZ);
+    const Brick* findBrick(const VoxelStorage& storage, int32_t bx, int32_t by, int32_t bz);  // Brick position is in storage space (divided by `BRICK_SIZE`). nullptr means all empty.
+    uint8_t readBrickVoxel(const Brick& brick, int32_t lx, int32_t ly, int32_t lz);        // Position local to the brick.
+
+    uint8_t getVoxel(const VoxelStorage& storage, int32_t x, int32_t y, int32_t z);
+    void setVoxel(VoxelStorage& storage, int32_t x, int32_t y, int32_t z, uint8_t type);
+    void clear(VoxelStorage& storage);
+
+    // Dense arrays are laid out x major, then y, then z (the same as the old `voxelData` array).
+    void importDense(VoxelStorage& storage, const uint8_t* voxelData, size_t sizeX, size_t sizeY, size_t sizeZ);
+    void exportDense(const VoxelStorage& storage, size_t sizeX, size_t sizeY, size_t sizeZ, std::vector<uint8_t>& outVoxelData);
+
+    // Bounds of all the non-empty voxels, in logical space. Only visits the bricks that exist. Returns false if there are none.
+    bool calculateFilledBounds(const VoxelStorage& storage, int32_t outBoundsMin[3], int32_t outBoundsMax[3]);
+
+    MemoryUsage calculateMemoryUsage(const VoxelStorage& storage);
+}
@@ -3,6 +3,7 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
 #include <vma/vk_mem_alloc.h>
+#include <taskflow/algorithm/for_each.hpp>
 #include "VkBootstrap.h"
 #include "VkInitializers.h"
 #include "VkDescriptorBuilderUtil.h"
@@ -13,6 +14,7 @@
 #include "Textbox.h"
 #include "UIQuad.h"
 #include "AudioEngine.h"
+#include "AudioAdapterSoftware.h"
 #include "PhysicsEngine.h"
 #include "InputManager.h"
 #include "RenderObject.h"
@@ -25,6 +27,7 @@
 #include "Debug.h"
 #include "HotswapResources.h"
 #include "GlobalState.h"
+#include "Profiler.h"
 #include "imgui/imgui.h"
 #include "imgui/imgui_stdlib.h"
 #include "imgui/imgui_impl_sdl.h"
@@ -94,26 +97,27 @@ void VulkanEngine::init()
 	loadMeshes();
 	generatePBRCubemaps();
 	generateBRDFLUT();
+	initMaterialHandles();
 	initDescriptors();
 	initPipelines();
 
-	AudioEngine::getInstance().initialize();
-	physengine::start(_entityManager);
+	AudioEngine::getInstance().initialize(_headless ? AudioAdapterType::SOFTWARE : AudioAdapterType::FMOD);  // @NOTE: headless runs mix offline, so they don't need an audio device.
+	physengine::start(_entityManager, _headless);
 	globalState::initGlobalState(_camera->mainCamMode, _camera->sceneCamera, _entityManager);
 	scene::init(this);
 
 	while (!physengine::isInitialized);  // Spin lock so that new scene doesn't get loaded before physics are finished initializing.
 
-	SDL_ShowWindow(_window);
+	if (_headless)
+		rng::seed(0);  // So that every headless run of the same recording plays out the same.
+	else
+		SDL_ShowWindow(_window);
 
 	_isInitialized = true;
 
 	scene::loadScene("first.ssdat", false);
 }
 
-constexpr size_t numPerfs = 15;
-uint64_t perfs[numPerfs];
-
 // vec4 lightDir = { -0.243f, 0.740f, 0.627f, 0.0f };  // Main light direction (set from MainMenu.cpp upon entering the game.)
 vec4 lightDir = { -0.009f, 0.505f, 0.863f, 0.0f };  // Initial light direction (for main menu only. Set in MainMenu.cpp)
 
@@ -147,43 +151,47 @@ void VulkanEngine::run()
 	std::mutex* hotswapMutex = hotswapres::startResourceChecker(this, &_recreateSwapchain, _roManager);
 #endif
 
+	if (!_recordInputPath.empty())
+		input::startRecording(_recordInputPath);
+
+	PROFILE_THREAD_NAME("Main");
+
 	while (isRunning)
 	{
-		perfs[0] = SDL_GetPerformanceCounter();
-		// Poll events from the window
-		input::processInput(&isRunning, &_isWindowMinimized);
-		perfs[0] = SDL_GetPerformanceCounter() - perfs[0];
-
+		PROFILE_FRAME_MARK();
+		PROFILE_ZONE("Frame");
 
-		perfs[1] = SDL_GetPerformanceCounter();
-		// Toggle fullscreen.
-		if (input::onKeyF11Press)
 		{
-			_windowFullscreen = !_windowFullscreen;
-			SDL_SetWindowFullscreen(_window, _windowFullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0);
+			PROFILE_ZONE("Process Input");
+			// Poll events from the window
+			input::processInput(&isRunning, &_isWindowMinimized);
 		}
 
-		// Update time multiplier
-		if (input::onKeyLSBPress || input::onKeyRSBPress)
 		{
-			globalState::timescale *= input::onKeyLSBPress ? 0.5f : 2.0f;
-			debug::pushDebugMessage({
-				.message = "Set timescale to " + std::to_string(globalState::timescale),
-			});
-		}
-		perfs[1] = SDL_GetPerformanceCounter() - perfs[1];
+			PROFILE_ZONE("Window Toggles");
+			// Toggle fullscreen.
+			if (input::onKeyF11Press)
+			{
+				_windowFullscreen = !_windowFullscreen;
+				SDL_SetWindowFullscreen(_window, _windowFullscreen ? SDL_WINDOW_FULLSCREEN_DESKTOP : 0);
+			}
 
+			// Update time multiplier
+			if (input::onKeyLSBPress || input::onKeyRSBPress)
+			{
+				globalState::timescale *= input::onKeyLSBPress ? 0.5f : 2.0f;
+				debug::pushDebugMessage({
+					.message = "Set timescale to " + std::to_string(globalState::timescale),
+				});
+			}
+		}
 
-		perfs[2] = SDL_GetPerformanceCounter();
 		// Update DeltaTime
 		uint64_t currentFrame = SDL_GetPerformanceCounter();
 		const float_t deltaTime = (float_t)(currentFrame - lastFrame) * ticksFrequency;
 		const float_t scaledDeltaTime = deltaTime * globalState::timescale;
 		lastFrame = currentFrame;
-		perfs[2] = SDL_GetPerformanceCounter() - perfs[2];
 
-
-		perfs[3] = SDL_GetPerformanceCounter();
 		// Stop anything from updating when window is minimized
 		// @NOTE: this prevents the VK_ERROR_DEVICE_LOST(-4) error
 		//        once the rendering code gets run while the window
@@ -194,106 +202,237 @@ void VulkanEngine::run()
 		if (_isWindowMinimized)
 			continue;
 
-		// Collect debug stats
-		updateDebugStats(deltaTime);
-		perfs[3] = SDL_GetPerformanceCounter() - perfs[3];
+		{
+			PROFILE_ZONE("Update Debug Stats");
+			// Collect debug stats
+			updateDebugStats(deltaTime);
+		}
 
+		{
+			PROFILE_ZONE("Entity Update");
+			// Update textbox
+			textbox::update(deltaTime);
 
-		perfs[4] = SDL_GetPerformanceCounter();
-		// Update textbox
-		textbox::update(deltaTime);
+			// Update entities
+			_entityManager->update(scaledDeltaTime);
+		}
 
-		// Update entities
-		_entityManager->update(scaledDeltaTime);
-		perfs[4] = SDL_GetPerformanceCounter() - perfs[4];
+		{
+			PROFILE_ZONE("Update Animators");
+			// Update animators
+			_roManager->updateAnimators(scaledDeltaTime);
+		}
 
+		{
+			PROFILE_ZONE("Entity Late Update");
+			// Late update (i.e. after animators are run)
+			_entityManager->lateUpdate(scaledDeltaTime);
+		}
 
-		perfs[5] = SDL_GetPerformanceCounter();
-		// Update animators
-		_roManager->updateAnimators(scaledDeltaTime);
-		perfs[5] = SDL_GetPerformanceCounter() - perfs[5];
+		{
+			PROFILE_ZONE("Camera Update");
+			// Update camera
+			_camera->update(deltaTime);
+		}
 
+		{
+			PROFILE_ZONE("Scene Tick");
+			// Tick scenemanagement for loading a new scene
+			scene::tick();
 
-		perfs[6] = SDL_GetPerformanceCounter();
-		// Late update (i.e. after animators are run)
-		_entityManager->lateUpdate(scaledDeltaTime);
-		perfs[6] = SDL_GetPerformanceCounter() - perfs[6];
+			// Add/Remove requested entities
+			_entityManager->INTERNALaddRemoveRequestedEntities();
 
+			// Add/Change/Remove text meshes
+			textmesh::INTERNALprocessChangeQueue();
+		}
 
-		perfs[7] = SDL_GetPerformanceCounter();
-		// Update camera
-		_camera->update(deltaTime);
-		perfs[7] = SDL_GetPerformanceCounter() - perfs[7];
+		{
+			PROFILE_ZONE("Global State");
+			// Update global state
+			saveGlobalStateTimeElapsed += deltaTime;
+			if (saveGlobalStateTimeElapsed > saveGlobalStateTime)
+			{
+				saveGlobalStateTimeElapsed = 0.0f;
+				globalState::launchAsyncWriteTask();
+			}
+			globalState::update(deltaTime, _blitToSnapshotImageFlag, _skyboxIsSnapshotImage);
+		}
 
+		{
+			PROFILE_ZONE("Audio Update");
+			// Update Audio Engine
+			AudioEngine::getInstance().update();
+		}
 
-		perfs[8] = SDL_GetPerformanceCounter();
-		// Tick scenemanagement for loading a new scene
-		scene::tick();
+		//
+		// Render
+		//
+#ifdef _DEVELOP
+		std::unique_lock<std::mutex> hotswapLock(*hotswapMutex, std::defer_lock);
+		{
+			PROFILE_ZONE("Wait For Hotswap Lock");
+			hotswapLock.lock();
+		}
 
-		// Add/Remove requested entities
-		_entityManager->INTERNALaddRemoveRequestedEntities();
+		if (!_changedShaderFilenames.empty())
+		{
+			PROFILE_ZONE("Reload Changed Shaders");
+			reloadChangedShaders();
+		}
+#endif
 
-		// Add/Change/Remove text meshes
-		textmesh::INTERNALprocessChangeQueue();
-		perfs[8] = SDL_GetPerformanceCounter() - perfs[8];
+		if (_recreateSwapchain)
+		{
+			PROFILE_ZONE("Recreate Swapchain");
+			recreateSwapchain();
+		}
 
+		{
+			PROFILE_ZONE("ImGui");
+			renderImGui(deltaTime);
+		}
 
-		perfs[9] = SDL_GetPerformanceCounter();
-		// Update global state
-		saveGlobalStateTimeElapsed += deltaTime;
-		if (saveGlobalStateTimeElapsed > saveGlobalStateTime)
 		{
-			saveGlobalStateTimeElapsed = 0.0f;
-			globalState::launchAsyncWriteTask();
+			PROFILE_ZONE("Render");
+			render();
 		}
-		globalState::update(deltaTime, _blitToSnapshotImageFlag, _skyboxIsSnapshotImage);
-		perfs[9] = SDL_GetPerformanceCounter() - perfs[9];
+	}
 
+	input::stopRecording();
+}
 
-		perfs[10] = SDL_GetPerformanceCounter();
-		// Update Audio Engine
-		AudioEngine::getInstance().update();
-		perfs[10] = SDL_GetPerformanceCounter() - perfs[10];
+int32_t VulkanEngine::runHeadless(const std::string& inputReplayPath, const std::string& reportPath)
+{
+	constexpr float_t HEADLESS_DELTA_TIME = 1.0f / 60.0f;
 
+	size_t numReplayFrames;
+	if (!input::loadReplay(inputReplayPath, numReplayFrames))
+		return 1;
 
-		perfs[11] = SDL_GetPerformanceCounter();
-		//
-		// Render
-		//
-#ifdef _DEVELOP
-		std::lock_guard<std::mutex> lg(*hotswapMutex);
-#endif
+	std::ofstream reportFile(reportPath);
+	if (!reportFile.is_open())
+	{
+		std::cerr << "[HEADLESS SIMULATION]" << std::endl
+			<< "ERROR: could not open \"" << reportPath << "\" for writing" << std::endl;
+		return 1;
+	}
+	reportFile << "frame,physicsTicks,physicsMS,updateMS,frameMS,stateHash" << std::endl;
 
-		if (_recreateSwapchain)
-			recreateSwapchain();
-		perfs[11] = SDL_GetPerformanceCounter() - perfs[11];
+	std::cout << "[HEADLESS SIMULATION]" << std::endl
+		<< "Replaying " << numReplayFrames << " frames of \"" << inputReplayPath << "\" at " << HEADLESS_DELTA_TIME << " s per frame" << std::endl;
+
+	//
+	// Simulation loop
+	// @NOTE: same order as `run()`, minus everything that needs a window or the gpu (debug stats,
+	//        ImGui, audio, rendering). Physics runs in lockstep right before the entities update.
+	//
+	PROFILE_THREAD_NAME("Main");
+	const double_t ticksToMS = 1000.0 / (double_t)SDL_GetPerformanceFrequency();
+	std::vector<double_t> frameTimesMS;
+	frameTimesMS.reserve(numReplayFrames);
+	uint64_t stateHash = 0;
+	bool isRunning = true;
 
+	// Pull one tick's worth of audio from the software mixer every frame, so voices play out
+	// (and finish) in lockstep with the simulation.
+	auto softwareAudio = dynamic_cast<AudioAdapter_Software*>(AudioEngine::getInstance().getAdapter());
+	std::vector<float> audioBuffer((size_t)std::roundf(HEADLESS_DELTA_TIME * AudioAdapter_Software::OUTPUT_SAMPLE_RATE) * AudioAdapter_Software::OUTPUT_CHANNELS);
 
-		perfs[12] = SDL_GetPerformanceCounter();
-		renderImGui(deltaTime);
-		perfs[12] = SDL_GetPerformanceCounter() - perfs[12];
+	while (true)
+	{
+		PROFILE_FRAME_MARK();
+		PROFILE_ZONE("Headless Frame");
+		getCurrentFrameArena().reset();  // @NOTE: nothing gets rendered, so there's no fence to wait on first.
 
+		input::processReplayInput(&isRunning);
+		if (!isRunning)
+			break;
 
-		perfs[13] = SDL_GetPerformanceCounter();
-		render();
-		perfs[13] = SDL_GetPerformanceCounter() - perfs[13];
+		uint64_t frameStart = SDL_GetPerformanceCounter();
 
+		if (input::onKeyLSBPress || input::onKeyRSBPress)
+			globalState::timescale *= input::onKeyLSBPress ? 0.5f : 2.0f;
 
-		//
-		// Calculate performance
-		//
-		if (input::keyCtrlPressed)
+		const float_t deltaTime = HEADLESS_DELTA_TIME;
+		const float_t scaledDeltaTime = deltaTime * globalState::timescale;
+
+		size_t physicsTicks;
+		{
+			PROFILE_ZONE("Physics Lockstep");
+			physicsTicks = physengine::stepLockstep(scaledDeltaTime);
+		}
+		uint64_t updateStart = SDL_GetPerformanceCounter();
+
+		{
+			PROFILE_ZONE("Entity Update");
+			textbox::update(deltaTime);
+			_entityManager->update(scaledDeltaTime);
+		}
+		{
+			PROFILE_ZONE("Update Animators");
+			_roManager->updateAnimators(scaledDeltaTime);
+		}
 		{
-			uint64_t totalPerf = 0;
-			for (size_t i = 0; i < numPerfs; i++)
-				totalPerf += perfs[i];
-
-			std::cout << "Performance:";
-			for (size_t i = 0; i < numPerfs; i++)
-				std::cout << "\t" << (perfs[i] * 100 / totalPerf) << "% (" << perfs[i] << ")";
-			std::cout << std::endl;
+			PROFILE_ZONE("Entity Late Update");
+			_entityManager->lateUpdate(scaledDeltaTime);
 		}
+		{
+			PROFILE_ZONE("Camera Update");
+			_camera->update(deltaTime);
+		}
+		{
+			PROFILE_ZONE("Scene Tick");
+			scene::tick();
+			_entityManager->INTERNALaddRemoveRequestedEntities();
+			textmesh::INTERNALprocessChangeQueue();
+		}
+		{
+			PROFILE_ZONE("Global State");
+			globalState::update(deltaTime, _blitToSnapshotImageFlag, _skyboxIsSnapshotImage);  // @NOTE: no `launchAsyncWriteTask()`. A headless run never touches the save file.
+		}
+		{
+			PROFILE_ZONE("Audio Update");
+			AudioEngine::getInstance().update();
+			if (softwareAudio != nullptr)
+				softwareAudio->renderToBuffer(audioBuffer.data(), audioBuffer.size() / AudioAdapter_Software::OUTPUT_CHANNELS);
+		}
+
+		uint64_t frameEnd = SDL_GetPerformanceCounter();
+
+		stateHash = physengine::hashSimulationState() ^ ((uint64_t)_entityManager->_entities.size() * 0x9E3779B97F4A7C15ull);
+
+		double_t physicsMS = (updateStart - frameStart) * ticksToMS;
+		double_t updateMS  = (frameEnd - updateStart) * ticksToMS;
+		double_t frameMS   = (frameEnd - frameStart) * ticksToMS;
+		frameTimesMS.push_back(frameMS);
+		reportFile << _frameNumber << "," << physicsTicks << "," << physicsMS << "," << updateMS << "," << frameMS << "," << std::hex << stateHash << std::dec << std::endl;
+
+		_frameNumber++;
 	}
+
+	//
+	// Report
+	//
+	std::vector<double_t> sortedFrameTimesMS = frameTimesMS;
+	std::sort(sortedFrameTimesMS.begin(), sortedFrameTimesMS.end());
+	double_t totalMS = 0.0;
+	for (double_t ms : frameTimesMS)
+		totalMS += ms;
+	auto percentile = [&](double_t p) {
+		return sortedFrameTimesMS.empty() ? 0.0 : sortedFrameTimesMS[(size_t)(p * (sortedFrameTimesMS.size() - 1))];
+	};
+
+	std::cout << "[HEADLESS SIMULATION]" << std::endl
+		<< "Frames:      " << frameTimesMS.size() << std::endl
+		<< "Frame avg:   " << (frameTimesMS.empty() ? 0.0 : totalMS / frameTimesMS.size()) << " ms" << std::endl
+		<< "Frame p50:   " << percentile(0.5) << " ms" << std::endl
+		<< "Frame p95:   " << percentile(0.95) << " ms" << std::endl
+		<< "Frame max:   " << percentile(1.0) << " ms" << std::endl
+		<< "State hash:  " << std::hex << stateHash << std::dec << std::endl
+		<< "Report:      " << reportPath << std::endl;
+
+	return 0;
 }
 
 void VulkanEngine::cleanup()
@@ -311,7 +450,8 @@ void VulkanEngine::cleanup()
 		hotswapres::flagStopRunning();
 #endif
 
-		globalState::cleanupGlobalState();
+		if (!_headless)
+			globalState::cleanupGlobalState();  // @NOTE: this writes the save file one last time.
 		AudioEngine::getInstance().cleanup();
 
 		// @NOTE: halting the async runner allows for an immediate flush of entities since it's guaranteed to not be read anymore
@@ -331,6 +471,7 @@ void VulkanEngine::cleanup()
 		textbox::cleanup();
 		textmesh::cleanup();
 		vkutil::pipelinelayoutcache::cleanup();
+		vkutil::pipelinecache::saveAndCleanup();
 		vkutil::descriptorlayoutcache::cleanup();
 		vkutil::descriptorallocator::cleanup();
 
@@ -365,6 +506,11 @@ void VulkanEngine::renderPickingRenderpass(const FrameData& currentFrame)
 
 	VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
 
+	// @NOTE: the skinned vertices were written by the compute jobs in the main frame's command buffer,
+	//        which is a separate submission, so this one needs its own barrier before reading them.
+	vkglTF::Animator::recordPreskinnedVerticesBarrier(this, cmd);
+	gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_PICKING);
+
 	VkClearValue clearValue;
 	clearValue.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
 
@@ -392,7 +538,7 @@ void VulkanEngine::renderPickingRenderpass(const FrameData& currentFrame)
 	vkCmdBeginRenderPass(cmd, &renderpassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
 	// Bind picking material
-	Material& pickingMaterial = *getMaterial("pickingMaterial");
+	Material& pickingMaterial = *getMaterial(_materialHandles.picking);
 	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pickingMaterial.pipeline);
 	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pickingMaterial.pipelineLayout, 0, 1, &currentFrame.globalDescriptor, 0, nullptr);
 	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pickingMaterial.pipelineLayout, 1, 1, &currentFrame.objectDescriptor, 0, nullptr);
@@ -414,6 +560,7 @@ void VulkanEngine::renderPickingRenderpass(const FrameData& currentFrame)
 
 	// End renderpass
 	vkCmdEndRenderPass(cmd);
+	gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_PICKING);
 	VK_CHECK(vkEndCommandBuffer(cmd));
 
 	//
@@ -467,6 +614,113 @@ void VulkanEngine::renderPickingRenderpass(const FrameData& currentFrame)
 	submitSelectedRenderObjectId(static_cast<int32_t>(nearestSelectedId) - 1);
 }
 
+void VulkanEngine::recordSecondaryCommandBuffers(const FrameData& currentFrame, const std::vector<ModelWithIndirectDrawId>& pickingIndirectDrawCommandIds)
+{
+	// Upload shadow cascades to GPU
+	void* data;
+	vmaMapMemory(_allocator, currentFrame.cascadeViewProjsBuffer._allocation, &data);
+	memcpy(data, &_camera->sceneCamera.gpuCascadeViewProjsData, sizeof(GPUCascadeViewProjsData));
+	vmaUnmapMemory(_allocator, currentFrame.cascadeViewProjsBuffer._allocation);
+
+	//
+	// Record each job into its secondary command buffer
+	// @NOTE: the jobs only ever read engine state, so they don't need any locking.
+	//
+	auto recordJob = [&](uint32_t jobIndex) {
+		PROFILE_ZONE("Record Secondary Command Buffer");
+		auto timeStart = std::chrono::high_resolution_clock::now();
+
+		VK_CHECK(vkResetCommandPool(_device, currentFrame.recordingJobCommandPools[jobIndex], 0));
+		VkCommandBuffer cmd = currentFrame.recordingJobCommandBuffers[jobIndex];
+
+		VkCommandBufferInheritanceInfo inheritanceInfo = {
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+			.pNext = nullptr,
+		};
+		if (jobIndex < RECORDING_JOB_MAIN_ZPREPASS)
+		{
+			inheritanceInfo.renderPass = _shadowRenderPass;
+			inheritanceInfo.subpass = 0;
+			inheritanceInfo.framebuffer = _shadowCascades[jobIndex - RECORDING_JOB_SHADOW_CASCADE_0].framebuffer;
+		}
+		else
+		{
+			inheritanceInfo.renderPass = _mainRenderPass;
+			inheritanceInfo.subpass = (jobIndex == RECORDING_JOB_MAIN_ZPREPASS) ? 0 : 1;
+			inheritanceInfo.framebuffer = _mainFramebuffer;
+		}
+
+		VkCommandBufferBeginInfo cmdBeginInfo = {
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+			.pNext = nullptr,
+			.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+			.pInheritanceInfo = &inheritanceInfo,
+		};
+		VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
+
+		if (jobIndex < RECORDING_JOB_MAIN_ZPREPASS)
+			recordShadowCascade(currentFrame, cmd, jobIndex - RECORDING_JOB_SHADOW_CASCADE_0);
+		else if (jobIndex == RECORDING_JOB_MAIN_ZPREPASS)
+			recordMainZPrepass(currentFrame, cmd);
+		else
+			recordMainOpaque(currentFrame, cmd, pickingIndirectDrawCommandIds);
+
+		VK_CHECK(vkEndCommandBuffer(cmd));
+		_recordingJobTimesMS[jobIndex] = std::chrono::duration<float_t, std::milli>(std::chrono::high_resolution_clock::now() - timeStart).count();
+	};
+
+	if (_parallelCommandRecording)
+	{
+		tf::Taskflow taskflow;
+		taskflow.for_each_index(0u, NUM_RECORDING_JOBS, 1u, recordJob);
+		_commandRecordingExecutor.run(taskflow).wait();
+	}
+	else
+	{
+		for (uint32_t i = 0; i < NUM_RECORDING_JOBS; i++)
+			recordJob(i);
+	}
+}
+
+void VulkanEngine::recordShadowCascade(const FrameData& currentFrame, VkCommandBuffer cmd, uint32_t cascadeIndex)
+{
+	Material& shadowDepthPassMaterial = *getMaterial(_materialHandles.shadowDepthPass);
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipeline);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 0, 1, &currentFrame.cascadeViewProjsDescriptor, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 1, 1, &currentFrame.objectDescriptor, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 2, 1, &currentFrame.instancePtrDescriptor, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 3, 1, &getMaterial(_materialHandles.pbr)->textureSet, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 4, 1, vkglTF::Animator::getGlobalAnimatorNodeCollectionDescriptorSet(this), 0, nullptr);
+
+	CascadeIndexPushConstBlock pc = { cascadeIndex };
+	vkCmdPushConstants(cmd, shadowDepthPassMaterial.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(CascadeIndexPushConstBlock), &pc);
+
+	renderRenderObjects(cmd, currentFrame);
+}
+
+void VulkanEngine::recordMainZPrepass(const FrameData& currentFrame, VkCommandBuffer cmd)
+{
+	Material& defaultMaterial = *getMaterial(_materialHandles.pbr);
+	Material& defaultZPrepassMaterial = *getMaterial(_materialHandles.pbrZPrepass);
+
+	gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_ZPREPASS);
+	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipeline);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 0, 1, &currentFrame.globalDescriptor, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 1, 1, &currentFrame.objectDescriptor, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 2, 1, &currentFrame.instancePtrDescriptor, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 3, 1, &defaultMaterial.textureSet, 0, nullptr);
+	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 4, 1, vkglTF::Animator::getGlobalAnimatorNodeCollectionDescriptorSet(this), 0, nullptr);
+	renderRenderObjects(cmd, currentFrame);
+	gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_ZPREPASS);
+}
+
+void VulkanEngine::renderPreskinningPass(VkCommandBuffer cmd)
+{
+	gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_SKINNING);
+	vkglTF::Animator::recordPreskinningJobs(this, cmd, _skinningPipeline, _skinningPipelineLayout);
+	gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_SKINNING);
+}
+
 void VulkanEngine::renderShadowRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd)
 {
 	VkClearValue depthClear;
@@ -486,31 +740,17 @@ void VulkanEngine::renderShadowRenderpass(const FrameData& currentFrame, VkComma
 		.pClearValues = &depthClear,
 	};
 
-	// Upload shadow cascades to GPU
-	void* data;
-	vmaMapMemory(_allocator, currentFrame.cascadeViewProjsBuffer._allocation, &data);
-	memcpy(data, &_camera->sceneCamera.gpuCascadeViewProjsData, sizeof(GPUCascadeViewProjsData));
-	vmaUnmapMemory(_allocator, currentFrame.cascadeViewProjsBuffer._allocation);
-
-	Material& shadowDepthPassMaterial = *getMaterial("shadowDepthPassMaterial");
 	for (uint32_t i = 0; i < SHADOWMAP_CASCADES; i++)
 	{
-		renderpassInfo.framebuffer = _shadowCascades[i].framebuffer;
-		vkCmdBeginRenderPass(cmd, &renderpassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipeline);
-		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 0, 1, &currentFrame.cascadeViewProjsDescriptor, 0, nullptr);
-		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 1, 1, &currentFrame.objectDescriptor, 0, nullptr);
-		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 2, 1, &currentFrame.instancePtrDescriptor, 0, nullptr);
-		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 3, 1, &getMaterial("pbrMaterial")->textureSet, 0, nullptr);
-		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, shadowDepthPassMaterial.pipelineLayout, 4, 1, vkglTF::Animator::getGlobalAnimatorNodeCollectionDescriptorSet(this), 0, nullptr);
+		gputimestamps::GPUPass gpuPass = (gputimestamps::GPUPass)(gputimestamps::GPU_PASS_SHADOW_CASCADE_0 + i);
+		gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gpuPass);
 
-		CascadeIndexPushConstBlock pc = { i };
-		vkCmdPushConstants(cmd, shadowDepthPassMaterial.pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(CascadeIndexPushConstBlock), &pc);
-
-		renderRenderObjects(cmd, currentFrame);
-		
+		renderpassInfo.framebuffer = _shadowCascades[i].framebuffer;
+		vkCmdBeginRenderPass(cmd, &renderpassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		vkCmdExecuteCommands(cmd, 1, &currentFrame.recordingJobCommandBuffers[RECORDING_JOB_SHADOW_CASCADE_0 + i]);
 		vkCmdEndRenderPass(cmd);
+
+		gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gpuPass);
 	}
 }
 
@@ -524,49 +764,9 @@ void renderSkybox(VkCommandBuffer cmd, Material& skyboxMaterial, VkDescriptorSet
 	skybox->draw(cmd);
 }
 
-void VulkanEngine::renderMainRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd, const std::vector<ModelWithIndirectDrawId>& pickingIndirectDrawCommandIds)
+void VulkanEngine::recordMainOpaque(const FrameData& currentFrame, VkCommandBuffer cmd, const std::vector<ModelWithIndirectDrawId>& pickingIndirectDrawCommandIds)
 {
-	VkClearValue clearValue;
-	clearValue.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
-
-	VkClearValue depthClear;
-	depthClear.depthStencil.depth = 1.0f;
-
-	VkClearValue clearValues[] = { clearValue, depthClear };
-
-	VkRenderPassBeginInfo renderpassInfo = {
-		.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-		.pNext = nullptr,
-
-		.renderPass = _mainRenderPass,
-		.framebuffer = _mainFramebuffer,
-		.renderArea = {
-			.offset = VkOffset2D{ 0, 0 },
-			.extent = _windowExtent,
-		},
-
-		.clearValueCount = 2,
-		.pClearValues = &clearValues[0],
-	};
-
-	// Begin renderpass
-	vkCmdBeginRenderPass(cmd, &renderpassInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-	Material& defaultMaterial = *getMaterial("pbrMaterial");    // @HACK: @TODO: currently, the way that the pipeline is getting used is by just hardcode using it in the draw commands for models... however, each model should get its pipeline set to this material instead (or whatever material its using... that's why we can't hardcode stuff!!!)   @TODO: create some kind of way to propagate the newly created pipeline to the primMat (calculated material in the gltf model) instead of using defaultMaterial directly.  -Timo
-	Material& defaultZPrepassMaterial = *getMaterial("pbrZPrepassMaterial");
-
-	// Render z prepass //
-	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipeline);
-	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 0, 1, &currentFrame.globalDescriptor, 0, nullptr);
-	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 1, 1, &currentFrame.objectDescriptor, 0, nullptr);
-	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 2, 1, &currentFrame.instancePtrDescriptor, 0, nullptr);
-	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 3, 1, &defaultMaterial.textureSet, 0, nullptr);
-	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultZPrepassMaterial.pipelineLayout, 4, 1, vkglTF::Animator::getGlobalAnimatorNodeCollectionDescriptorSet(this), 0, nullptr);
-	renderRenderObjects(cmd, currentFrame);
-	//////////////////////
-
-	// Switch from zprepass subpass to main subpass
-	vkCmdNextSubpass(cmd, VK_SUBPASS_CONTENTS_INLINE);
+	Material& defaultMaterial = *getMaterial(_materialHandles.pbr);    // @HACK: @TODO: currently, the way that the pipeline is getting used is by just hardcode using it in the draw commands for models... however, each model should get its pipeline set to this material instead (or whatever material its using... that's why we can't hardcode stuff!!!)   @TODO: create some kind of way to propagate the newly created pipeline to the primMat (calculated material in the gltf model) instead of using defaultMaterial directly.  -Timo
 
 	// @NOTE: for EWU Game Jam.
 	//        There is absolutely no need to render the skybox. It should be black for 99% of the time. The only thing you can see "outside" will be the scenery.  -Timo 2023/11/13
@@ -586,6 +786,7 @@ void VulkanEngine::renderMainRenderpass(const FrameData& currentFrame, VkCommand
 	// 	}
 
 	// Bind material and render renderobjects.
+	gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_MAIN);
 	vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultMaterial.pipeline);
 	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultMaterial.pipelineLayout, 0, 1, &currentFrame.globalDescriptor, 0, nullptr);
 	vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, defaultMaterial.pipelineLayout, 1, 1, &currentFrame.objectDescriptor, 0, nullptr);
@@ -598,7 +799,45 @@ void VulkanEngine::renderMainRenderpass(const FrameData& currentFrame, VkCommand
 	if (!pickingIndirectDrawCommandIds.empty())
 		renderPickedObject(cmd, currentFrame, pickingIndirectDrawCommandIds);
 	physengine::renderDebugVisualization(cmd);
-	////////////////
+	gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_MAIN);
+}
+
+void VulkanEngine::renderMainRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd)
+{
+	VkClearValue clearValue;
+	clearValue.color = { { 0.0f, 0.0f, 0.0f, 1.0f } };
+
+	VkClearValue depthClear;
+	depthClear.depthStencil.depth = 1.0f;
+
+	VkClearValue clearValues[] = { clearValue, depthClear };
+
+	VkRenderPassBeginInfo renderpassInfo = {
+		.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+		.pNext = nullptr,
+
+		.renderPass = _mainRenderPass,
+		.framebuffer = _mainFramebuffer,
+		.renderArea = {
+			.offset = VkOffset2D{ 0, 0 },
+			.extent = _windowExtent,
+		},
+
+		.clearValueCount = 2,
+		.pClearValues = &clearValues[0],
+	};
+
+	// Begin renderpass
+	vkCmdBeginRenderPass(cmd, &renderpassInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+	// Render z prepass
+	vkCmdExecuteCommands(cmd, 1, &currentFrame.recordingJobCommandBuffers[RECORDING_JOB_MAIN_ZPREPASS]);
+
+	// Switch from zprepass subpass to main subpass
+	vkCmdNextSubpass(cmd, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+	// Render renderobjects
+	vkCmdExecuteCommands(cmd, 1, &currentFrame.recordingJobCommandBuffers[RECORDING_JOB_MAIN_OPAQUE]);
 
 	// End renderpass
 	vkCmdEndRenderPass(cmd);
@@ -889,7 +1128,7 @@ struct IncrementalHalveCoCParams
 	VkExtent2D imageExtent;
 };
 
-void ppDepthOfField_IncrementalReductionHalveCircleOfConfusion(VkCommandBuffer cmd, VkRenderPass incrementalReductionHalveCoCRenderPass, std::vector<IncrementalHalveCoCParams>& incrementalReductions)
+void ppDepthOfField_IncrementalReductionHalveCircleOfConfusion(VkCommandBuffer cmd, VkRenderPass incrementalReductionHalveCoCRenderPass, FrameVector<IncrementalHalveCoCParams>& incrementalReductions)
 {
 	for (IncrementalHalveCoCParams& ihcp : incrementalReductions)
 	{
@@ -1035,7 +1274,7 @@ void ppDepthOfField(
 	VkCommandBuffer cmd,
 	VkRenderPass CoCRenderPass, VkFramebuffer CoCFramebuffer, Material& CoCMaterial, GPUCoCParams& CoCParams, VkExtent2D& windowExtent,
 	VkRenderPass halveCoCRenderPass, VkFramebuffer halveCoCFramebuffer, Material& halveCoCMaterial, VkExtent2D& halfResImageExtent,
-	VkRenderPass incrementalReductionHalveCoCRenderPass, std::vector<IncrementalHalveCoCParams>& incrementalReductions,
+	VkRenderPass incrementalReductionHalveCoCRenderPass, FrameVector<IncrementalHalveCoCParams>& incrementalReductions,
 	VkRenderPass blurXNearsideCoCRenderPass, VkFramebuffer blurXNearsideCoCFramebuffer, Material& blurXMaterial,
 	VkRenderPass blurYNearsideCoCRenderPass, VkFramebuffer blurYNearsideCoCFramebuffer, Material& blurYMaterial, GPUBlurParams& blurParams,
 	VkRenderPass gatherDOFRenderPass, VkFramebuffer gatherDOFFramebuffer, Material& gatherDOFMaterial, GPUGatherDOFParams& dofParams,
@@ -1141,6 +1380,7 @@ void ppCombinePostprocesses(
 void VulkanEngine::renderPostprocessRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd, uint32_t swapchainImageIndex)
 {
 	// Generate postprocessing.
+	gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_BLOOM);
 	ppBlitBloom(
 		cmd,
 		_mainImage,
@@ -1148,6 +1388,7 @@ void VulkanEngine::renderPostprocessRenderpass(const FrameData& currentFrame, Vk
 		_bloomPostprocessImage,
 		_bloomPostprocessImageExtent
 	);
+	gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_BLOOM);
 
 	GPUCoCParams CoCParams = {
 		.cameraZNear = _camera->sceneCamera.zNear,
@@ -1157,14 +1398,13 @@ void VulkanEngine::renderPostprocessRenderpass(const FrameData& currentFrame, Vk
 		.blurExtent = globalState::DOFBlurExtent,
 	};
 
-	std::vector<IncrementalHalveCoCParams> incrementalReductions;
+	FrameVector<IncrementalHalveCoCParams> incrementalReductions{ FrameArenaAllocator<IncrementalHalveCoCParams>(getCurrentFrameArena()) };
 	incrementalReductions.reserve(NUM_INCREMENTAL_COC_REDUCTIONS);
 	for (size_t i = 0; i < NUM_INCREMENTAL_COC_REDUCTIONS; i++)
 	{
-		std::string materialName = "incrementalReductionHalveCoCMaterial_" + std::to_string(i);
 		incrementalReductions.push_back({
 			.framebuffer = _incrementalReductionHalveCoCFramebuffers[i],
-			.material = getMaterial(materialName),
+			.material = getMaterial(_materialHandles.incrementalReductionHalveCoC[i]),
 			.imageExtent = _incrementalReductionHalveResImageExtents[i],
 		});
 	}
@@ -1185,35 +1425,39 @@ void VulkanEngine::renderPostprocessRenderpass(const FrameData& currentFrame, Vk
 	floodfillParams.oneOverImageExtent[1] = 1.0f / _halfResImageExtent.height;
 
 
+	gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_DOF);
 	ppDepthOfField(
 		cmd,
 		_CoCRenderPass,
 		_CoCFramebuffer,
-		*getMaterial("CoCMaterial"),
+		*getMaterial(_materialHandles.CoC),
 		CoCParams,
 		_windowExtent,
 		_halveCoCRenderPass,
 		_halveCoCFramebuffer,
-		*getMaterial("halveCoCMaterial"),
+		*getMaterial(_materialHandles.halveCoC),
 		_halfResImageExtent,
 		_incrementalReductionHalveCoCRenderPass,
 		incrementalReductions,
 		_blurXNearsideCoCRenderPass,
 		_blurXNearsideCoCFramebuffer,
-		*getMaterial("blurXSingleChannelMaterial"),
+		*getMaterial(_materialHandles.blurXSingleChannel),
 		_blurYNearsideCoCRenderPass,
 		_blurYNearsideCoCFramebuffer,
-		*getMaterial("blurYSingleChannelMaterial"),
+		*getMaterial(_materialHandles.blurYSingleChannel),
 		blurParams,
 		_gatherDOFRenderPass,
 		_gatherDOFFramebuffer,
-		*getMaterial("gatherDOFMaterial"),
+		*getMaterial(_materialHandles.gatherDOF),
 		dofParams,
 		_dofFloodFillRenderPass,
 		_dofFloodFillFramebuffer,
-		*getMaterial("DOFFloodFillMaterial"),
+		*getMaterial(_materialHandles.DOFFloodFill),
 		floodfillParams
 	);
+	gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_DOF);
+
+	gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_POSTPROCESS);
 
 	// Blit result to snapshot image.
 	if (_blitToSnapshotImageFlag)
@@ -1223,7 +1467,7 @@ void VulkanEngine::renderPostprocessRenderpass(const FrameData& currentFrame, Vk
 			cmd,
 			_postprocessRenderPass,
 			_swapchainFramebuffers[swapchainImageIndex],
-			*getMaterial("postprocessMaterial"),
+			*getMaterial(_materialHandles.postprocess),
 			_windowExtent,
 			currentFrame.globalDescriptor,
 			false,
@@ -1337,12 +1581,13 @@ void VulkanEngine::renderPostprocessRenderpass(const FrameData& currentFrame, Vk
 		cmd,
 		_postprocessRenderPass,
 		_swapchainFramebuffers[swapchainImageIndex],
-		*getMaterial("postprocessMaterial"),
+		*getMaterial(_materialHandles.postprocess),
 		_windowExtent,
 		currentFrame.globalDescriptor,
 		true,
 		true
 	);
+	gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_POSTPROCESS);
 }
 
 void VulkanEngine::render()
@@ -1351,17 +1596,24 @@ void VulkanEngine::render()
 	VkResult result;
 
 	// Wait until GPU finishes rendering the previous frame
-	result = vkWaitForFences(_device, 1, &currentFrame.renderFence, true, TIMEOUT_1_SEC);
+	{
+		PROFILE_ZONE("Wait For Fence");
+		result = vkWaitForFences(_device, 1, &currentFrame.renderFence, true, TIMEOUT_1_SEC);
+	}
 	if (result == VK_ERROR_DEVICE_LOST)
 		return;
 
 	VK_CHECK(vkResetFences(_device, 1, &currentFrame.renderFence));
+	getCurrentFrameArena().reset();
 
 	//
 	// Request image from swapchain
 	//
 	uint32_t swapchainImageIndex;
-	result = vkAcquireNextImageKHR(_device, _swapchain, TIMEOUT_1_SEC, currentFrame.presentSemaphore, nullptr, &swapchainImageIndex);
+	{
+		PROFILE_ZONE("Acquire Swapchain Image");
+		result = vkAcquireNextImageKHR(_device, _swapchain, TIMEOUT_1_SEC, currentFrame.presentSemaphore, nullptr, &swapchainImageIndex);
+	}
 	if (result == VK_ERROR_OUT_OF_DATE_KHR)
 	{
 		_recreateSwapchain = true;
@@ -1385,27 +1637,54 @@ void VulkanEngine::render()
 	};
 	VK_CHECK(vkBeginCommandBuffer(cmd, &cmdBeginInfo));
 
+	// Read back this frame slot's previous GPU timings (already finished since the fence got waited on)
+	gputimestamps::readResultsAndReset(cmd, _frameNumber % FRAME_OVERLAP, _frameNumber);
+
 	//
 	// Upload current frame to GPU and compact into draw calls
 	//
-	perfs[14] = SDL_GetPerformanceCounter();
-	recreateVoxelLightingDescriptor();
-	uploadCurrentFrameToGPU(currentFrame);
-	textmesh::uploadUICameraDataToGPU();
 #ifdef _DEVELOP
 	std::vector<size_t> pickedPoolIndices = { 0 };
-	if (!searchForPickedObjectPoolIndex(pickedPoolIndices[0]))
-		pickedPoolIndices.clear();
 	std::vector<ModelWithIndirectDrawId> pickingIndirectDrawCommandIds;
 #endif
-	compactRenderObjectsIntoDraws(currentFrame, pickedPoolIndices, pickingIndirectDrawCommandIds);
-	perfs[14] = SDL_GetPerformanceCounter() - perfs[14];
+	{
+		PROFILE_ZONE("Upload And Compact Draws");
+		recreateVoxelLightingDescriptor();
+		uploadCurrentFrameToGPU(currentFrame);
+		textmesh::uploadUICameraDataToGPU();
+#ifdef _DEVELOP
+		if (!searchForPickedObjectPoolIndex(pickedPoolIndices[0]))
+			pickedPoolIndices.clear();
+#endif
+		compactRenderObjectsIntoDraws(currentFrame, pickedPoolIndices, pickingIndirectDrawCommandIds);
+	}
 
 	// Render render passes.
-	renderShadowRenderpass(currentFrame, cmd);
-	renderMainRenderpass(currentFrame, cmd, pickingIndirectDrawCommandIds);
-	renderUIRenderpass(cmd);
-	renderPostprocessRenderpass(currentFrame, cmd, swapchainImageIndex);
+	{
+		PROFILE_ZONE("Record Render Passes");
+		auto timeStart = std::chrono::high_resolution_clock::now();
+		recordSecondaryCommandBuffers(currentFrame, pickingIndirectDrawCommandIds);
+		auto timeSecondaries = std::chrono::high_resolution_clock::now();
+
+		renderPreskinningPass(cmd);  // @NOTE: has to come before every pass that draws the render objects.
+		renderShadowRenderpass(currentFrame, cmd);
+		renderMainRenderpass(currentFrame, cmd);
+		gputimestamps::beginPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_UI);
+		renderUIRenderpass(cmd);
+		gputimestamps::endPass(cmd, _frameNumber % FRAME_OVERLAP, gputimestamps::GPU_PASS_UI);
+		auto timeUI = std::chrono::high_resolution_clock::now();
+
+		renderPostprocessRenderpass(currentFrame, cmd, swapchainImageIndex);
+		auto timePostprocess = std::chrono::high_resolution_clock::now();
+
+#ifdef _DEVELOP
+		memcpy(_debugStats.recordingJobTimesMS, _recordingJobTimesMS, sizeof(_recordingJobTimesMS));
+		_debugStats.recordSecondariesMS = std::chrono::duration<float_t, std::milli>(timeSecondaries - timeStart).count();
+		_debugStats.recordUIMS = std::chrono::duration<float_t, std::milli>(timeUI - timeSecondaries).count();
+		_debugStats.recordPostprocessMS = std::chrono::duration<float_t, std::milli>(timePostprocess - timeUI).count();
+		_debugStats.recordedInParallel = _parallelCommandRecording;
+#endif
+	}
 
 	//
 	// Submit command buffer to gpu for execution
@@ -1429,7 +1708,10 @@ void VulkanEngine::render()
 	submit.pCommandBuffers = &cmd;
 
 	// Submit work to gpu
-	result = vkQueueSubmit(_graphicsQueue, 1, &submit, currentFrame.renderFence);
+	{
+		PROFILE_ZONE("Submit");
+		result = vkQueueSubmit(_graphicsQueue, 1, &submit, currentFrame.renderFence);
+	}
 	if (result == VK_ERROR_DEVICE_LOST)
 		return;
 
@@ -1445,6 +1727,7 @@ void VulkanEngine::render()
 			true) &&
 		ImGui::IsMousePosValid())
 	{
+		PROFILE_ZONE("Picking");
 		renderPickingRenderpass(currentFrame);
 	}
 
@@ -1464,7 +1747,10 @@ void VulkanEngine::render()
 		.pImageIndices = &swapchainImageIndex,
 	};
 
-	result = vkQueuePresentKHR(_graphicsQueue, &presentInfo);
+	{
+		PROFILE_ZONE("Present");
+		result = vkQueuePresentKHR(_graphicsQueue, &presentInfo);
+	}
 	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
 	{
 		_recreateSwapchain = true;
@@ -1482,549 +1768,114 @@ void VulkanEngine::render()
 
 void VulkanEngine::loadImages()
 {
-	// Load empty
-	{
-		Texture empty;
-		vkutil::loadImageFromFile(*this, "res/textures/empty.png", VK_FORMAT_R8G8B8A8_UNORM, 1, empty.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_UNORM, empty.image._image, VK_IMAGE_ASPECT_COLOR_BIT, empty.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &empty.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(empty.image._mipLevels), VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &empty.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, empty.sampler, nullptr);
-			vkDestroyImageView(_device, empty.imageView, nullptr);
-		});
-
-		_loadedTextures["empty"] = empty;
-	}
-	{
-		Texture empty;
-		vkutil::loadImage3DFromFile(*this, { "res/textures/empty.png" }, VK_FORMAT_R8G8B8A8_UNORM, empty.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageview3DCreateInfo(VK_FORMAT_R8G8B8A8_UNORM, empty.image._image, VK_IMAGE_ASPECT_COLOR_BIT, empty.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &empty.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(empty.image._mipLevels), VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &empty.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, empty.sampler, nullptr);
-			vkDestroyImageView(_device, empty.imageView, nullptr);
-		});
-
-		_loadedTextures["empty3d"] = empty;
-	}
-
-	// Load woodFloor057
-	{
-		Texture woodFloor057;
-		vkutil::loadImageFromFile(*this, "res/textures/WoodFloor057_1K-JPG/WoodFloor057_1K_Color.jpg", VK_FORMAT_R8G8B8A8_SRGB, 0, woodFloor057.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, woodFloor057.image._image, VK_IMAGE_ASPECT_COLOR_BIT, woodFloor057.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &woodFloor057.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(woodFloor057.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &woodFloor057.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, woodFloor057.sampler, nullptr);
-			vkDestroyImageView(_device, woodFloor057.imageView, nullptr);
-			});
-
-		_loadedTextures["WoodFloor057"] = woodFloor057;
-	}
-
-	// Load date1
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/date1.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["Date1"] = texture;
-	}
-
-	// Load date2
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/date2.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["Date2"] = texture;
-	}
-
-	// Load date3
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/date3.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["Date3"] = texture;
-	}
-
-	// Load thinkingBox (left)
-	{
-		Texture thinkingBox;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/thinking_box_left.png", VK_FORMAT_R8G8B8A8_SRGB, 0, thinkingBox.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, thinkingBox.image._image, VK_IMAGE_ASPECT_COLOR_BIT, thinkingBox.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &thinkingBox.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(thinkingBox.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &thinkingBox.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, thinkingBox.sampler, nullptr);
-			vkDestroyImageView(_device, thinkingBox.imageView, nullptr);
-			});
-
-		_loadedTextures["ThinkingBoxLeft"] = thinkingBox;
-	}
-
-	// Load thinkingBox (right)
-	{
-		Texture thinkingBox;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/thinking_box_right.png", VK_FORMAT_R8G8B8A8_SRGB, 0, thinkingBox.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, thinkingBox.image._image, VK_IMAGE_ASPECT_COLOR_BIT, thinkingBox.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &thinkingBox.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(thinkingBox.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &thinkingBox.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, thinkingBox.sampler, nullptr);
-			vkDestroyImageView(_device, thinkingBox.imageView, nullptr);
-			});
-
-		_loadedTextures["ThinkingBoxRight"] = thinkingBox;
-	}
-
-	// Load thinkingBoxTrailLeft
-	{
-		Texture thinkingBoxTrailLeft;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/thinking_box_trail_left.png", VK_FORMAT_R8G8B8A8_SRGB, 0, thinkingBoxTrailLeft.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, thinkingBoxTrailLeft.image._image, VK_IMAGE_ASPECT_COLOR_BIT, thinkingBoxTrailLeft.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &thinkingBoxTrailLeft.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(thinkingBoxTrailLeft.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &thinkingBoxTrailLeft.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, thinkingBoxTrailLeft.sampler, nullptr);
-			vkDestroyImageView(_device, thinkingBoxTrailLeft.imageView, nullptr);
-			});
-
-		_loadedTextures["ThinkingBoxTrailLeft"] = thinkingBoxTrailLeft;
-	}
-
-	// Load thinkingBoxTrailRight
-	{
-		Texture thinkingBoxTrailRight;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/thinking_box_trail_right.png", VK_FORMAT_R8G8B8A8_SRGB, 0, thinkingBoxTrailRight.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, thinkingBoxTrailRight.image._image, VK_IMAGE_ASPECT_COLOR_BIT, thinkingBoxTrailRight.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &thinkingBoxTrailRight.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(thinkingBoxTrailRight.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &thinkingBoxTrailRight.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, thinkingBoxTrailRight.sampler, nullptr);
-			vkDestroyImageView(_device, thinkingBoxTrailRight.imageView, nullptr);
-			});
-
-		_loadedTextures["ThinkingBoxTrailRight"] = thinkingBoxTrailRight;
-	}
-
-	// Load SpeechSelectionButton
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/speech_selection_button.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["SpeechSelectionButton"] = texture;
-	}
-
-	// Load MenuSelectingCursor
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/menu_selecting_cursor.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["MenuSelectingCursor"] = texture;
-	}
-
-	// Load DateSpeechBox
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/date_speech_box.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["DateSpeechBox"] = texture;
-	}
-
-	// Load ContestantSpeechBox
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/contestant_speech_box.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["ContestantSpeechBox"] = texture;
-	}
-
-	// Load LoseArt
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/lose_art.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["LoseArt"] = texture;
-	}
-
-	// Load WonArt
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/won_art.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["WonArt"] = texture;
-	}
-
-	// Load DateArt0
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/date_art_0.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["DateArt0"] = texture;
-	}
-
-	// Load DateArt1
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/date_art_1.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["DateArt1"] = texture;
-	}
-
-	// Load DateArt2
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/date_art_2.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["DateArt2"] = texture;
-	}
-
-	// Load DatingBackground
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/dating_background.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["DatingBackground"] = texture;
-	}
-	
-	// Load ReadyAnnouncement
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/ready_announcement.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["ReadyAnnouncement"] = texture;
-	}
-
-	// Load GoAnnouncement
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/go_announcement.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["GoAnnouncement"] = texture;
-	}
-
-	// Load TitleLogo
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, "res/textures/ui/title.png", VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures["TitleLogo"] = texture;
-	}
-
-	// Load LogoDisplay logos @HARDCODE
-	struct LogoDisplayLogo
+	//
+	// Load 2D textures
+	// @NOTE: these all get decoded in parallel and then uploaded as a batch. Put any new
+	//        texture files into this list instead of loading them one by one.
+	//
+	struct TextureToLoad
 	{
 		std::string fname;
 		std::string textureName;
-	};
-	std::vector<LogoDisplayLogo> logoDisplayLogos = {
-		{ "res/textures/ui/logos/logo_shinkasuru_timo_kikansha.png", "LogoTimoEngine" },
-		{ "res/textures/ui/logos/logo_vulkan.png", "LogoVulkan" },
-		{ "res/textures/ui/logos/logo_fmod.png", "LogoFMOD" },
-		{ "res/textures/ui/logos/logo_sdl.png", "LogoSDL" },
-		{ "res/textures/ui/logos/logo_gltf.png", "LogoglTF" },
-		{ "res/textures/ui/logos/logo_jolt.png", "LogoJolt" },
-		{ "res/textures/ui/logos/special_thanks.png", "SpecialThanks" },
-	};
-	for (LogoDisplayLogo ldl : logoDisplayLogos)
-	{
-		Texture texture;
-		vkutil::loadImageFromFile(*this, ldl.fname.c_str(), VK_FORMAT_R8G8B8A8_SRGB, 0, texture.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), VK_FILTER_LINEAR);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, texture.sampler, nullptr);
-			vkDestroyImageView(_device, texture.imageView, nullptr);
-			});
-
-		_loadedTextures[ldl.textureName] = texture;
-	}
-
-	// Load imguiTextureLayerVisible
-	{
-		Texture textureLayerVisible;
-		vkutil::loadImageFromFile(*this, "res/_develop/icon_layer_visible.png", VK_FORMAT_R8G8B8A8_SRGB, 0, textureLayerVisible.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, textureLayerVisible.image._image, VK_IMAGE_ASPECT_COLOR_BIT, textureLayerVisible.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &textureLayerVisible.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(textureLayerVisible.image._mipLevels), VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &textureLayerVisible.sampler);
+		VkFormat format = VK_FORMAT_R8G8B8A8_SRGB;
+		uint32_t mipLevels = 0;
+		VkFilter filter = VK_FILTER_LINEAR;
+		VkSamplerAddressMode addressMode = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		bool enableAnisotropy = true;
+	};
+	std::vector<TextureToLoad> texturesToLoad = {
+		{ .fname = "res/textures/empty.png", .textureName = "empty", .format = VK_FORMAT_R8G8B8A8_UNORM, .mipLevels = 1, .filter = VK_FILTER_NEAREST, .addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, .enableAnisotropy = false },
+		{ .fname = "res/textures/WoodFloor057_1K-JPG/WoodFloor057_1K_Color.jpg", .textureName = "WoodFloor057" },
+		{ .fname = "res/textures/ui/date1.png", .textureName = "Date1" },
+		{ .fname = "res/textures/ui/date2.png", .textureName = "Date2" },
+		{ .fname = "res/textures/ui/date3.png", .textureName = "Date3" },
+		{ .fname = "res/textures/ui/thinking_box_left.png", .textureName = "ThinkingBoxLeft" },
+		{ .fname = "res/textures/ui/thinking_box_right.png", .textureName = "ThinkingBoxRight" },
+		{ .fname = "res/textures/ui/thinking_box_trail_left.png", .textureName = "ThinkingBoxTrailLeft" },
+		{ .fname = "res/textures/ui/thinking_box_trail_right.png", .textureName = "ThinkingBoxTrailRight" },
+		{ .fname = "res/textures/ui/speech_selection_button.png", .textureName = "SpeechSelectionButton" },
+		{ .fname = "res/textures/ui/menu_selecting_cursor.png", .textureName = "MenuSelectingCursor" },
+		{ .fname = "res/textures/ui/date_speech_box.png", .textureName = "DateSpeechBox" },
+		{ .fname = "res/textures/ui/contestant_speech_box.png", .textureName = "ContestantSpeechBox" },
+		{ .fname = "res/textures/ui/lose_art.png", .textureName = "LoseArt" },
+		{ .fname = "res/textures/ui/won_art.png", .textureName = "WonArt" },
+		{ .fname = "res/textures/ui/date_art_0.png", .textureName = "DateArt0" },
+		{ .fname = "res/textures/ui/date_art_1.png", .textureName = "DateArt1" },
+		{ .fname = "res/textures/ui/date_art_2.png", .textureName = "DateArt2" },
+		{ .fname = "res/textures/ui/dating_background.png", .textureName = "DatingBackground" },
+		{ .fname = "res/textures/ui/ready_announcement.png", .textureName = "ReadyAnnouncement" },
+		{ .fname = "res/textures/ui/go_announcement.png", .textureName = "GoAnnouncement" },
+		{ .fname = "res/textures/ui/title.png", .textureName = "TitleLogo" },
+
+		// LogoDisplay logos @HARDCODE
+		{ .fname = "res/textures/ui/logos/logo_shinkasuru_timo_kikansha.png", .textureName = "LogoTimoEngine" },
+		{ .fname = "res/textures/ui/logos/logo_vulkan.png", .textureName = "LogoVulkan" },
+		{ .fname = "res/textures/ui/logos/logo_fmod.png", .textureName = "LogoFMOD" },
+		{ .fname = "res/textures/ui/logos/logo_sdl.png", .textureName = "LogoSDL" },
+		{ .fname = "res/textures/ui/logos/logo_gltf.png", .textureName = "LogoglTF" },
+		{ .fname = "res/textures/ui/logos/logo_jolt.png", .textureName = "LogoJolt" },
+		{ .fname = "res/textures/ui/logos/special_thanks.png", .textureName = "SpecialThanks" },
+
+		// Imgui layer icons  @NOTE: imguiTextureLayerCollision is a special case. It's not a render layer but rather a toggle to see the debug shapes rendered
+		{ .fname = "res/_develop/icon_layer_visible.png", .textureName = "imguiTextureLayerVisible", .addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, .enableAnisotropy = false },
+		{ .fname = "res/_develop/icon_layer_invisible.png", .textureName = "imguiTextureLayerInvisible", .addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, .enableAnisotropy = false },
+		{ .fname = "res/_develop/icon_layer_builder.png", .textureName = "imguiTextureLayerBuilder", .addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, .enableAnisotropy = false },
+		{ .fname = "res/_develop/icon_layer_collision.png", .textureName = "imguiTextureLayerCollision", .addressMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, .enableAnisotropy = false },
+	};
+
+	std::vector<Texture> loadedTextures(texturesToLoad.size());
+	std::vector<vkutil::TextureUploadRequest> textureRequests;
+	textureRequests.reserve(texturesToLoad.size());
+	for (size_t i = 0; i < texturesToLoad.size(); i++)
+		textureRequests.push_back({
+			.fname = texturesToLoad[i].fname,
+			.imageFormat = texturesToLoad[i].format,
+			.mipLevels = texturesToLoad[i].mipLevels,
+			.allowCooked = true,
+			.outImage = &loadedTextures[i].image,
+		});
 
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, textureLayerVisible.sampler, nullptr);
-			vkDestroyImageView(_device, textureLayerVisible.imageView, nullptr);
-			});
+	vkutil::TextureBatchTimings textureTimings;
+	vkutil::loadImagesBatched(*this, textureRequests, &textureTimings);
 
-		_loadedTextures["imguiTextureLayerVisible"] = textureLayerVisible;
-	}
+	std::cout << "[LOAD TEXTURES]" << std::endl
+		<< "Textures:  " << textureTimings.numTextures << " (" << textureTimings.numSubmits << " submits, " << (textureTimings.stagingBytes / (1024 * 1024)) << " MB staged)" << std::endl
+		<< "Decode:    " << textureTimings.decodeMS << " ms" << std::endl
+		<< "Upload:    " << textureTimings.uploadMS << " ms" << std::endl;
 
-	// Load imguiTextureLayerInvisible
+	for (size_t i = 0; i < texturesToLoad.size(); i++)
 	{
-		Texture textureLayerInvisible;
-		vkutil::loadImageFromFile(*this, "res/_develop/icon_layer_invisible.png", VK_FORMAT_R8G8B8A8_SRGB, 0, textureLayerInvisible.image);
-
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, textureLayerInvisible.image._image, VK_IMAGE_ASPECT_COLOR_BIT, textureLayerInvisible.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &textureLayerInvisible.imageView);
-
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(textureLayerInvisible.image._mipLevels), VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &textureLayerInvisible.sampler);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, textureLayerInvisible.sampler, nullptr);
-			vkDestroyImageView(_device, textureLayerInvisible.imageView, nullptr);
-			});
-
-		_loadedTextures["imguiTextureLayerInvisible"] = textureLayerInvisible;
-	}
+		if (!textureRequests[i].success)
+			continue;
 
-	// Load imguiTextureLayerBuilder
-	{
-		Texture textureLayerBuilder;
-		vkutil::loadImageFromFile(*this, "res/_develop/icon_layer_builder.png", VK_FORMAT_R8G8B8A8_SRGB, 0, textureLayerBuilder.image);
+		const TextureToLoad& ttl = texturesToLoad[i];
+		Texture texture = loadedTextures[i];
 
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, textureLayerBuilder.image._image, VK_IMAGE_ASPECT_COLOR_BIT, textureLayerBuilder.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &textureLayerBuilder.imageView);
+		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(textureRequests[i].imageFormat, texture.image._image, VK_IMAGE_ASPECT_COLOR_BIT, texture.image._mipLevels);  // @NOTE: not `ttl.format`, since cooked textures come back as a block compressed format.
+		vkCreateImageView(_device, &imageInfo, nullptr, &texture.imageView);
 
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(textureLayerBuilder.image._mipLevels), VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &textureLayerBuilder.sampler);
+		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(texture.image._mipLevels), ttl.filter, ttl.addressMode, ttl.enableAnisotropy);
+		vkCreateSampler(_device, &samplerInfo, nullptr, &texture.sampler);
 
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, textureLayerBuilder.sampler, nullptr);
-			vkDestroyImageView(_device, textureLayerBuilder.imageView, nullptr);
-			});
+		_mainDeletionQueue.pushTextureViewAndSampler(_device, texture);
 
-		_loadedTextures["imguiTextureLayerBuilder"] = textureLayerBuilder;
+		_loadedTextures[ttl.textureName] = texture;
 	}
 
-	// Load imguiTextureLayerCollision  @NOTE: this is a special case. It's not a render layer but rather a toggle to see the debug shapes rendered
+	// Load empty3d
 	{
-		Texture textureLayerCollision;
-		vkutil::loadImageFromFile(*this, "res/_develop/icon_layer_collision.png", VK_FORMAT_R8G8B8A8_SRGB, 0, textureLayerCollision.image);
+		Texture empty;
+		vkutil::loadImage3DFromFile(*this, { "res/textures/empty.png" }, VK_FORMAT_R8G8B8A8_UNORM, empty.image);
 
-		VkImageViewCreateInfo imageInfo = vkinit::imageviewCreateInfo(VK_FORMAT_R8G8B8A8_SRGB, textureLayerCollision.image._image, VK_IMAGE_ASPECT_COLOR_BIT, textureLayerCollision.image._mipLevels);
-		vkCreateImageView(_device, &imageInfo, nullptr, &textureLayerCollision.imageView);
+		VkImageViewCreateInfo imageInfo = vkinit::imageview3DCreateInfo(VK_FORMAT_R8G8B8A8_UNORM, empty.image._image, VK_IMAGE_ASPECT_COLOR_BIT, empty.image._mipLevels);
+		vkCreateImageView(_device, &imageInfo, nullptr, &empty.imageView);
 
-		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(textureLayerCollision.image._mipLevels), VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
-		vkCreateSampler(_device, &samplerInfo, nullptr, &textureLayerCollision.sampler);
+		VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(static_cast<float_t>(empty.image._mipLevels), VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
+		vkCreateSampler(_device, &samplerInfo, nullptr, &empty.sampler);
 
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, textureLayerCollision.sampler, nullptr);
-			vkDestroyImageView(_device, textureLayerCollision.imageView, nullptr);
-			});
+		_mainDeletionQueue.pushTextureViewAndSampler(_device, empty);
 
-		_loadedTextures["imguiTextureLayerCollision"] = textureLayerCollision;
+		_loadedTextures["empty3d"] = empty;
 	}
 
 	// Initialize the shadow jitter image
@@ -2075,10 +1926,7 @@ void VulkanEngine::loadImages()
 		VkSamplerCreateInfo jitterSamplerInfo = vkinit::samplerCreateInfo(1.0f, VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_REPEAT, false);
 		VK_CHECK(vkCreateSampler(_device, &jitterSamplerInfo, nullptr, &_pbrSceneTextureSet.shadowJitterMap.sampler));
 
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, _pbrSceneTextureSet.shadowJitterMap.sampler, nullptr);
-			vkDestroyImageView(_device, _pbrSceneTextureSet.shadowJitterMap.imageView, nullptr);
-			});
+		_mainDeletionQueue.pushTextureViewAndSampler(_device, _pbrSceneTextureSet.shadowJitterMap);
 	}
 
 	//
@@ -2095,9 +1943,7 @@ void VulkanEngine::initVoxelLightingDescriptor()
 	// Prop up the transforms buffer
 	_voxelFieldLightingGridTextureSet.transformsBuffer = createBuffer(sizeof(VoxelFieldLightingGridTextureSet::GPUTransform) * MAX_NUM_VOXEL_FIELD_LIGHTMAPS, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
 
-	_mainDeletionQueue.pushFunction([=]() {
-		vmaDestroyBuffer(_allocator, _voxelFieldLightingGridTextureSet.transformsBuffer._buffer, _voxelFieldLightingGridTextureSet.transformsBuffer._allocation);
-	});
+	_mainDeletionQueue.pushBuffer(_allocator, _voxelFieldLightingGridTextureSet.transformsBuffer);
 
 	// Setup initial descriptor set and layout.
 	_voxelFieldLightingGridTextureSet.flagRecreateTextureSet = true;
@@ -2142,46 +1988,112 @@ void VulkanEngine::recreateVoxelLightingDescriptor()
 	_voxelFieldLightingGridTextureSet.flagRecreateTextureSet = false;
 }
 
-Material* VulkanEngine::attachPipelineToMaterial(VkPipeline pipeline, VkPipelineLayout layout, const std::string& name)
+MaterialHandle VulkanEngine::createMaterial(const std::string& name)
 {
-	Material material = {};
-	Material* alreadyExistsMaterial = getMaterial(name);
-	if (alreadyExistsMaterial != nullptr)
-	{
-		// Copy over the texture descriptorset
-		material.textureSet = alreadyExistsMaterial->textureSet;
-	}
-	material.pipeline = pipeline;
-	material.pipelineLayout = layout;
+	MaterialHandle handle = findMaterialHandle(name);
+	if (handle != INVALID_MATERIAL_HANDLE)
+		return handle;
+
+	handle = (MaterialHandle)_materials.size();
+	_materials.push_back({});
+	_materialNameToHandle[name] = handle;
+	return handle;
+}
 
-	_materials[name] = material;
-	return &_materials[name];
+Material* VulkanEngine::attachPipelineToMaterial(VkPipeline pipeline, VkPipelineLayout layout, const std::string& name)
+{
+	Material* material = getMaterial(createMaterial(name));
+	material->pipeline = pipeline;
+	material->pipelineLayout = layout;
+	return material;
 }
 
 Material* VulkanEngine::attachTextureSetToMaterial(VkDescriptorSet textureSet, const std::string& name)
 {
-	Material material = {};
-	Material* alreadyExistsMaterial = getMaterial(name);
-	if (alreadyExistsMaterial != nullptr)
-	{
-		// Copy over the pipeline and layout
-		material.pipeline = alreadyExistsMaterial->pipeline;
-		material.pipelineLayout = alreadyExistsMaterial->pipelineLayout;
-	}
-	material.textureSet = textureSet;
+	Material* material = getMaterial(createMaterial(name));
+	material->textureSet = textureSet;
+	return material;
+}
 
-	_materials[name] = material;
-	return &_materials[name];
+Material* VulkanEngine::getMaterial(MaterialHandle handle)
+{
+	if (handle >= _materials.size())
+		return nullptr;
+	return &_materials[handle];
 }
 
 Material* VulkanEngine::getMaterial(const std::string& name)
 {
-	auto it = _materials.find(name);
-	if (it == _materials.end())
-		return nullptr;
-	return &it->second;
+	return getMaterial(findMaterialHandle(name));
+}
+
+MaterialHandle VulkanEngine::findMaterialHandle(const std::string& name)
+{
+	auto it = _materialNameToHandle.find(name);
+	if (it == _materialNameToHandle.end())
+		return INVALID_MATERIAL_HANDLE;
+	return it->second;
+}
+
+void VulkanEngine::initMaterialHandles()
+{
+	_materialHandles.pbr = createMaterial("pbrMaterial");
+	_materialHandles.pbrZPrepass = createMaterial("pbrZPrepassMaterial");
+	_materialHandles.picking = createMaterial("pickingMaterial");
+	_materialHandles.shadowDepthPass = createMaterial("shadowDepthPassMaterial");
+	_materialHandles.wireframeColor = createMaterial("wireframeColorMaterial");
+	_materialHandles.wireframeColorBehind = createMaterial("wireframeColorBehindMaterial");
+	_materialHandles.CoC = createMaterial("CoCMaterial");
+	_materialHandles.halveCoC = createMaterial("halveCoCMaterial");
+	for (size_t i = 0; i < NUM_INCREMENTAL_COC_REDUCTIONS; i++)
+		_materialHandles.incrementalReductionHalveCoC[i] = createMaterial("incrementalReductionHalveCoCMaterial_" + std::to_string(i));
+	_materialHandles.blurXSingleChannel = createMaterial("blurXSingleChannelMaterial");
+	_materialHandles.blurYSingleChannel = createMaterial("blurYSingleChannelMaterial");
+	_materialHandles.gatherDOF = createMaterial("gatherDOFMaterial");
+	_materialHandles.DOFFloodFill = createMaterial("DOFFloodFillMaterial");
+	_materialHandles.postprocess = createMaterial("postprocessMaterial");
 }
 
+#ifdef _DEVELOP
+void VulkanEngine::benchmarkMaterialLookups()
+{
+	// @NOTE: does the same material lookups that one frame does (shadow, main, picking, DOF chain and
+	//        postprocess), once by name and once by handle. Doesn't need the engine to be initialized.
+	initMaterialHandles();
+
+	std::vector<std::string> frameLookupNames = {
+		"shadowDepthPassMaterial", "pbrMaterial", "pbrMaterial", "pbrZPrepassMaterial", "pbrMaterial", "pickingMaterial",
+		"CoCMaterial", "halveCoCMaterial", "blurXSingleChannelMaterial", "blurYSingleChannelMaterial",
+		"gatherDOFMaterial", "DOFFloodFillMaterial", "postprocessMaterial",
+	};
+	for (size_t i = 0; i < NUM_INCREMENTAL_COC_REDUCTIONS; i++)
+		frameLookupNames.push_back("incrementalReductionHalveCoCMaterial_" + std::to_string(i));
+	std::vector<MaterialHandle> frameLookupHandles;
+	for (auto& name : frameLookupNames)
+		frameLookupHandles.push_back(findMaterialHandle(name));
+
+	constexpr size_t numFrames = 100000;
+	uintptr_t checksum = 0;  // So that the lookups don't get optimized out.
+
+	auto timeStart = std::chrono::high_resolution_clock::now();
+	for (size_t frame = 0; frame < numFrames; frame++)
+		for (auto& name : frameLookupNames)
+			checksum += (uintptr_t)getMaterial(name);
+	auto timeByName = std::chrono::high_resolution_clock::now();
+	for (size_t frame = 0; frame < numFrames; frame++)
+		for (MaterialHandle handle : frameLookupHandles)
+			checksum += (uintptr_t)getMaterial(handle);
+	auto timeByHandle = std::chrono::high_resolution_clock::now();
+
+	float_t byNameNS = std::chrono::duration<float_t, std::nano>(timeByName - timeStart).count() / numFrames;
+	float_t byHandleNS = std::chrono::duration<float_t, std::nano>(timeByHandle - timeByName).count() / numFrames;
+	std::cout << "[BENCHMARK MATERIAL LOOKUPS]" << std::endl
+		<< "Lookups per frame: " << frameLookupNames.size() << " (" << numFrames << " frames, checksum " << (checksum & 0xFF) << ")" << std::endl
+		<< "By name:   " << byNameNS << " ns/frame" << std::endl
+		<< "By handle: " << byHandleNS << " ns/frame" << std::endl;
+}
+#endif
+
 AllocatedBuffer VulkanEngine::createBuffer(size_t allocSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage)
 {
 	VkBufferCreateInfo bufferInfo = {
@@ -2268,6 +2180,12 @@ void VulkanEngine::initVulkan()
 		.select()
 		.value();
 
+	// Optional features.
+	VkPhysicalDeviceFeatures supportedFeatures;
+	vkGetPhysicalDeviceFeatures(physicalDevice.physical_device, &supportedFeatures);
+	_supportsTextureCompressionBC = supportedFeatures.textureCompressionBC;  // @NOTE: for cooked textures (.htex). Without it they fall back to loading the source image.
+	physicalDevice.features.textureCompressionBC = supportedFeatures.textureCompressionBC;
+
 	//
 	// Create vulkan device
 	// @NOTE: @FEATURES: Enable device features right here.
@@ -2281,6 +2199,7 @@ void VulkanEngine::initVulkan()
 	VkPhysicalDeviceVulkan12Features vulkan12Features = {
 		.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
 		.pNext = nullptr,
+		.shaderSampledImageArrayNonUniformIndexing = VK_TRUE,  // @NOTE: for the batched ui quads, which index their texture array per instance.
 		.samplerFilterMinmax = VK_TRUE,
 	};
 	vkb::Device vkbDevice =
@@ -2312,6 +2231,9 @@ void VulkanEngine::initVulkan()
 	vkutil::descriptorallocator::init(_device);
 	vkutil::descriptorlayoutcache::init(_device);
 	vkutil::pipelinelayoutcache::init(_device);
+	vkutil::pipelinebuilder::init(_loadingExecutor);
+	vkutil::pipelinecache::init(_device, _gpuProperties);
+	gputimestamps::init(_device, _chosenGPU, _graphicsQueueFamily, _gpuProperties.limits.timestampPeriod, _mainDeletionQueue);
 	textmesh::init(this);
 	textbox::init(this);
 	ui::init(this);
@@ -2359,9 +2281,7 @@ void VulkanEngine::initSwapchain()
 	_swapchainImageFormat = vkbSwapchain.image_format;
 
 	// Add destroy command for cleanup
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroySwapchainKHR(_device, _swapchain, nullptr);
-		});
+	_swapchainDependentDeletionQueue.pushSwapchain(_device, _swapchain);
 
 	//
 	// Create depth buffer
@@ -2387,11 +2307,7 @@ void VulkanEngine::initSwapchain()
 	vkCreateSampler(_device, &depthSamplerInfo, nullptr, &_depthImage.sampler);
 
 	// Add destroy command
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroySampler(_device, _depthImage.sampler, nullptr);
-		vkDestroyImageView(_device, _depthImage.imageView, nullptr);
-		vmaDestroyImage(_allocator, _depthImage.image._image, _depthImage.image._allocation);
-		});
+	_swapchainDependentDeletionQueue.pushTexture(_device, _allocator, _depthImage);
 }
 
 void VulkanEngine::initCommands()
@@ -2410,14 +2326,27 @@ void VulkanEngine::initCommands()
 		// Create picking command buffer  @NOTE: commandbufferallocateinfo just says we're gonna allocate 1 commandbuffer from the pool
 		VK_CHECK(vkAllocateCommandBuffers(_device, &cmdAllocInfo, &_frames[i].pickingCommandBuffer));
 
+		// Transient CPU allocations of this frame
+		_frames[i].frameArena.init(FRAME_ARENA_CAPACITY);
+
 		// Create indirect draw command buffer
 		_frames[i].indirectDrawCommandBuffer = createBuffer(sizeof(VkDrawIndexedIndirectCommand) * INSTANCE_PTR_MAX_CAPACITY, VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU);
 
+		// Create recording job command pools and their secondary command buffers
+		// @NOTE: these pools get reset as a whole every frame, so no VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT.
+		VkCommandPoolCreateInfo recordingJobCommandPoolInfo = vkinit::commandPoolCreateInfo(_graphicsQueueFamily, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+		for (uint32_t j = 0; j < NUM_RECORDING_JOBS; j++)
+		{
+			VK_CHECK(vkCreateCommandPool(_device, &recordingJobCommandPoolInfo, nullptr, &_frames[i].recordingJobCommandPools[j]));
+			VkCommandBufferAllocateInfo secondaryAllocInfo = vkinit::commandBufferAllocateInfo(_frames[i].recordingJobCommandPools[j], 1, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+			VK_CHECK(vkAllocateCommandBuffers(_device, &secondaryAllocInfo, &_frames[i].recordingJobCommandBuffers[j]));
+		}
+
 		// Add destroy command for cleanup
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroyCommandPool(_device, _frames[i].commandPool, nullptr);
-			vmaDestroyBuffer(_allocator, _frames[i].indirectDrawCommandBuffer._buffer, _frames[i].indirectDrawCommandBuffer._allocation);
-			});
+		_mainDeletionQueue.pushBuffer(_allocator, _frames[i].indirectDrawCommandBuffer);
+		_mainDeletionQueue.pushCommandPool(_device, _frames[i].commandPool);
+		for (uint32_t j = 0; j < NUM_RECORDING_JOBS; j++)
+			_mainDeletionQueue.pushCommandPool(_device, _frames[i].recordingJobCommandPools[j]);
 	}
 
 	//
@@ -2427,9 +2356,7 @@ void VulkanEngine::initCommands()
 	VK_CHECK(vkCreateCommandPool(_device, &uploadCommandPoolInfo, nullptr, &_uploadContext.commandPool));
 
 	// Add destroy command for cleanup
-	_mainDeletionQueue.pushFunction([=]() {
-		vkDestroyCommandPool(_device, _uploadContext.commandPool, nullptr);
-		});
+	_mainDeletionQueue.pushCommandPool(_device, _uploadContext.commandPool);
 
 	VkCommandBufferAllocateInfo cmdAllocInfo = vkinit::commandBufferAllocateInfo(_uploadContext.commandPool, 1);
 	VK_CHECK(vkAllocateCommandBuffers(_device, &cmdAllocInfo, &_uploadContext.commandBuffer));
@@ -2440,9 +2367,7 @@ void createImageSampler(VkDevice device, uint32_t numMips, VkFilter samplerFilte
 	VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo((float_t)numMips, samplerFilter, samplerAddressMode, false);
 	VK_CHECK(vkCreateSampler(device, &samplerInfo, nullptr, &sampler));
 	
-	deletionQueue.pushFunction([=]() {
-		vkDestroySampler(device, sampler, nullptr);
-		});
+	deletionQueue.pushSampler(device, sampler);
 }
 
 void createRenderTexture(VmaAllocator allocator, VkDevice device, Texture& texture, VkFormat imageFormat, VkImageUsageFlags usageFlags, VkExtent3D imageExtent, uint32_t numMips, VkImageAspectFlags aspectFlags, VkFilter samplerFilter, VkSamplerAddressMode samplerAddressMode, DeletionQueue& deletionQueue, bool createSampler = true)
@@ -2460,10 +2385,8 @@ void createRenderTexture(VmaAllocator allocator, VkDevice device, Texture& textu
 	if (createSampler)
 		createImageSampler(device, numMips, samplerFilter, samplerAddressMode, texture.sampler, deletionQueue);
 
-	deletionQueue.pushFunction([=]() {
-		vkDestroyImageView(device, texture.imageView, nullptr);
-		vmaDestroyImage(allocator, texture.image._image, texture.image._allocation);
-		});
+	deletionQueue.pushImage(allocator, texture.image);
+	deletionQueue.pushImageView(device, texture.imageView);
 }
 
 void createFramebuffer(VkDevice device, VkFramebuffer& framebuffer, VkRenderPass renderPass, const std::vector<VkImageView>& attachments, VkExtent2D extent, uint32_t layers, DeletionQueue& deletionQueue)
@@ -2482,9 +2405,7 @@ void createFramebuffer(VkDevice device, VkFramebuffer& framebuffer, VkRenderPass
 
 	VK_CHECK(vkCreateFramebuffer(device, &fbInfo, nullptr, &framebuffer));
 
-	deletionQueue.pushFunction([=]() {
-		vkDestroyFramebuffer(device, framebuffer, nullptr);
-		});
+	deletionQueue.pushFramebuffer(device, framebuffer);
 }
 
 void VulkanEngine::initShadowRenderpass()  // @COPYPASTA
@@ -2559,9 +2480,7 @@ void VulkanEngine::initShadowRenderpass()  // @COPYPASTA
 	VK_CHECK(vkCreateRenderPass(_device, &renderPassInfo, nullptr, &_shadowRenderPass));
 
 	// Add destroy command for cleanup
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroyRenderPass(_device, _shadowRenderPass, nullptr);
-		});
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _shadowRenderPass);
 }
 
 void VulkanEngine::initShadowImages()
@@ -2596,11 +2515,7 @@ void VulkanEngine::initShadowImages()
 	VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(1.0f, /*VK_FILTER_LINEAR*/VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);  // Why linear? it should be nearest if I say so myself.
 	VK_CHECK(vkCreateSampler(_device, &samplerInfo, nullptr, &_pbrSceneTextureSet.shadowMap.sampler));
 
-	_mainDeletionQueue.pushFunction([=]() {
-		vkDestroySampler(_device, _pbrSceneTextureSet.shadowMap.sampler, nullptr);
-		vkDestroyImageView(_device, _pbrSceneTextureSet.shadowMap.imageView, nullptr);
-		vmaDestroyImage(_allocator, _pbrSceneTextureSet.shadowMap.image._image, _pbrSceneTextureSet.shadowMap.image._allocation);
-		});
+	_mainDeletionQueue.pushTexture(_device, _allocator, _pbrSceneTextureSet.shadowMap);
 
 	// One framebuffer and imageview per layer of shadow image
 	for (uint32_t i = 0; i < SHADOWMAP_CASCADES; i++)
@@ -2611,9 +2526,7 @@ void VulkanEngine::initShadowImages()
 		individualViewInfo.subresourceRange.layerCount = 1;
 		VK_CHECK(vkCreateImageView(_device, &individualViewInfo, nullptr, &_shadowCascades[i].imageView));
 
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroyImageView(_device, _shadowCascades[i].imageView, nullptr);
-			});
+		_mainDeletionQueue.pushImageView(_device, _shadowCascades[i].imageView);
 
 		createFramebuffer(
 			_device,
@@ -2729,9 +2642,7 @@ void VulkanEngine::initMainRenderpass()
 	VK_CHECK(vkCreateRenderPass(_device, &renderPassInfo, nullptr, &_mainRenderPass));
 
 	// Add destroy command for cleanup
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroyRenderPass(_device, _mainRenderPass, nullptr);
-		});
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _mainRenderPass);
 
 	//
 	// Create image for renderpass  (@NOTE: Depthmap is already created at this point... idk where it's at though.)
@@ -2754,11 +2665,7 @@ void VulkanEngine::initMainRenderpass()
 	VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(1.0f, VK_FILTER_NEAREST, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
 	VK_CHECK(vkCreateSampler(_device, &samplerInfo, nullptr, &_mainImage.sampler));
 
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroySampler(_device, _mainImage.sampler, nullptr);
-		vkDestroyImageView(_device, _mainImage.imageView, nullptr);
-		vmaDestroyImage(_allocator, _mainImage.image._image, _mainImage.image._allocation);
-		});
+	_swapchainDependentDeletionQueue.pushTexture(_device, _allocator, _mainImage);
 }
 
 void VulkanEngine::initUIRenderpass()    // @NOTE: @COPYPASTA: This is really copypasta of the above function (initMainRenderpass)
@@ -2818,9 +2725,7 @@ void VulkanEngine::initUIRenderpass()    // @NOTE: @COPYPASTA: This is really co
 	VK_CHECK(vkCreateRenderPass(_device, &renderPassInfo, nullptr, &_uiRenderPass));
 
 	// Add destroy command for cleanup
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroyRenderPass(_device, _uiRenderPass, nullptr);
-		});
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _uiRenderPass);
 
 	//
 	// Create image for renderpass
@@ -2843,11 +2748,7 @@ void VulkanEngine::initUIRenderpass()    // @NOTE: @COPYPASTA: This is really co
 	VkSamplerCreateInfo samplerInfo = vkinit::samplerCreateInfo(1.0f, VK_FILTER_LINEAR, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, false);
 	VK_CHECK(vkCreateSampler(_device, &samplerInfo, nullptr, &_uiImage.sampler));
 
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroySampler(_device, _uiImage.sampler, nullptr);
-		vkDestroyImageView(_device, _uiImage.imageView, nullptr);
-		vmaDestroyImage(_allocator, _uiImage.image._image, _uiImage.image._allocation);
-		});
+	_swapchainDependentDeletionQueue.pushTexture(_device, _allocator, _uiImage);
 }
 
 void initPostprocessCombineRenderPass(VkDevice device, VkFormat swapchainImageFormat, VkRenderPass& renderPass)
@@ -3329,16 +3230,14 @@ void VulkanEngine::initPostprocessRenderpass()    // @NOTE: @COPYPASTA: This is
 	initDOF_DOFFloodFillRenderPass(_device, _dofFloodFillRenderPass);
 
 	// Add destroy command for cleanup
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroyRenderPass(_device, _postprocessRenderPass, nullptr);
-		vkDestroyRenderPass(_device, _CoCRenderPass, nullptr);
-		vkDestroyRenderPass(_device, _halveCoCRenderPass, nullptr);
-		vkDestroyRenderPass(_device, _incrementalReductionHalveCoCRenderPass, nullptr);
-		vkDestroyRenderPass(_device, _blurXNearsideCoCRenderPass, nullptr);
-		vkDestroyRenderPass(_device, _blurYNearsideCoCRenderPass, nullptr);
-		vkDestroyRenderPass(_device, _gatherDOFRenderPass, nullptr);
-		vkDestroyRenderPass(_device, _dofFloodFillRenderPass, nullptr);
-		});
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _postprocessRenderPass);
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _CoCRenderPass);
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _halveCoCRenderPass);
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _incrementalReductionHalveCoCRenderPass);
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _blurXNearsideCoCRenderPass);
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _blurYNearsideCoCRenderPass);
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _gatherDOFRenderPass);
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _dofFloodFillRenderPass);
 }
 
 void VulkanEngine::initPostprocessImages()
@@ -3468,9 +3367,7 @@ void VulkanEngine::initPostprocessImages()
 
 			VK_CHECK(vkCreateSampler(_device, &samplerInfo, nullptr, &_CoCImageMaxSampler));
 
-			_swapchainDependentDeletionQueue.pushFunction([=]() {
-				vkDestroySampler(_device, _CoCImageMaxSampler, nullptr);
-				});
+			_swapchainDependentDeletionQueue.pushSampler(_device, _CoCImageMaxSampler);
 		}
 
 		createRenderTexture(
@@ -3772,12 +3669,10 @@ void VulkanEngine::initPickingRenderpass()    // @NOTE: @COPYPASTA: This is real
 	VkImageViewCreateInfo pickingDepthViewInfo = vkinit::imageviewCreateInfo(_depthFormat, _pickingDepthImage._image, VK_IMAGE_ASPECT_DEPTH_BIT, 1);
 	VK_CHECK(vkCreateImageView(_device, &pickingDepthViewInfo, nullptr, &_pickingDepthImageView));
 
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroyImageView(_device, _pickingImageView, nullptr);
-		vkDestroyImageView(_device, _pickingDepthImageView, nullptr);
-		vmaDestroyImage(_allocator, _pickingImage._image, _pickingImage._allocation);
-		vmaDestroyImage(_allocator, _pickingDepthImage._image, _pickingDepthImage._allocation);
-		});
+	_swapchainDependentDeletionQueue.pushImage(_allocator, _pickingImage);
+	_swapchainDependentDeletionQueue.pushImage(_allocator, _pickingDepthImage);
+	_swapchainDependentDeletionQueue.pushImageView(_device, _pickingImageView);
+	_swapchainDependentDeletionQueue.pushImageView(_device, _pickingDepthImageView);
 
 	//
 	// Color Attachment
@@ -3864,9 +3759,7 @@ void VulkanEngine::initPickingRenderpass()    // @NOTE: @COPYPASTA: This is real
 	VK_CHECK(vkCreateRenderPass(_device, &renderPassInfo, nullptr, &_pickingRenderPass));
 
 	// Add destroy command for cleanup
-	_swapchainDependentDeletionQueue.pushFunction([=]() {
-		vkDestroyRenderPass(_device, _pickingRenderPass, nullptr);
-		});
+	_swapchainDependentDeletionQueue.pushRenderPass(_device, _pickingRenderPass);
 }
 
 void VulkanEngine::initFramebuffers()
@@ -3883,9 +3776,7 @@ void VulkanEngine::initFramebuffers()
 			1,
 			_swapchainDependentDeletionQueue
 		);
-		_swapchainDependentDeletionQueue.pushFunction([=]() {
-			vkDestroyImageView(_device, _swapchainImageViews[i], nullptr);
-			});
+		_swapchainDependentDeletionQueue.pushImageView(_device, _swapchainImageViews[i]);
 	}
 
 	createFramebuffer(
@@ -4009,19 +3900,15 @@ void VulkanEngine::initSyncStructures()
 		VK_CHECK(vkCreateFence(_device, &fenceCreateInfo, nullptr, &_frames[i].pickingRenderFence));
 
 		// Add destroy command for cleanup
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroyFence(_device, _frames[i].renderFence, nullptr);
-			vkDestroyFence(_device, _frames[i].pickingRenderFence, nullptr);
-			});
+		_mainDeletionQueue.pushFence(_device, _frames[i].renderFence);
+		_mainDeletionQueue.pushFence(_device, _frames[i].pickingRenderFence);
 
 		VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &_frames[i].presentSemaphore));
 		VK_CHECK(vkCreateSemaphore(_device, &semaphoreCreateInfo, nullptr, &_frames[i].renderSemaphore));
 
 		// Add destroy command for cleanup
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySemaphore(_device, _frames[i].presentSemaphore, nullptr);
-			vkDestroySemaphore(_device, _frames[i].renderSemaphore, nullptr);
-			});
+		_mainDeletionQueue.pushSemaphore(_device, _frames[i].presentSemaphore);
+		_mainDeletionQueue.pushSemaphore(_device, _frames[i].renderSemaphore);
 	}
 
 	//
@@ -4035,9 +3922,7 @@ void VulkanEngine::initSyncStructures()
 	VK_CHECK(vkCreateFence(_device, &uploadFenceCreateInfo, nullptr, &_uploadContext.uploadFence));
 
 	// Add destroy command for cleanup
-	_mainDeletionQueue.pushFunction([=]() {
-		vkDestroyFence(_device, _uploadContext.uploadFence, nullptr);
-		});
+	_mainDeletionQueue.pushFence(_device, _uploadContext.uploadFence);
 }
 
 void VulkanEngine::initDescriptors()    // @NOTE: don't destroy and then recreate descriptors when recreating the swapchain. Only pipelines (not even pipelinelayouts), framebuffers, and the corresponding image/imageviews/samplers need to get recreated.  -Timo
@@ -4162,14 +4047,12 @@ void VulkanEngine::initDescriptors()    // @NOTE: don't destroy and then recreat
 		//
 		// Add destroy command for cleanup
 		//
-		_mainDeletionQueue.pushFunction([=]() {
-			vmaDestroyBuffer(_allocator, _frames[i].cameraBuffer._buffer, _frames[i].cameraBuffer._allocation);
-			vmaDestroyBuffer(_allocator, _frames[i].pbrShadingPropsBuffer._buffer, _frames[i].pbrShadingPropsBuffer._allocation);
-			vmaDestroyBuffer(_allocator, _frames[i].cascadeViewProjsBuffer._buffer, _frames[i].cascadeViewProjsBuffer._allocation);
-			vmaDestroyBuffer(_allocator, _frames[i].objectBuffer._buffer, _frames[i].objectBuffer._allocation);
-			vmaDestroyBuffer(_allocator, _frames[i].instancePtrBuffer._buffer, _frames[i].instancePtrBuffer._allocation);
-			vmaDestroyBuffer(_allocator, _frames[i].pickingSelectedIdBuffer._buffer, _frames[i].pickingSelectedIdBuffer._allocation);
-		});
+		_mainDeletionQueue.pushBuffer(_allocator, _frames[i].cameraBuffer);
+		_mainDeletionQueue.pushBuffer(_allocator, _frames[i].pbrShadingPropsBuffer);
+		_mainDeletionQueue.pushBuffer(_allocator, _frames[i].cascadeViewProjsBuffer);
+		_mainDeletionQueue.pushBuffer(_allocator, _frames[i].objectBuffer);
+		_mainDeletionQueue.pushBuffer(_allocator, _frames[i].instancePtrBuffer);
+		_mainDeletionQueue.pushBuffer(_allocator, _frames[i].pickingSelectedIdBuffer);
 	}
 
 	//
@@ -4285,10 +4168,25 @@ void VulkanEngine::initDescriptors()    // @NOTE: don't destroy and then recreat
 	//
 	vkglTF::Animator::initializeEmpty(this);
 
+	// Pre-skinning model vertices (read by `skinning.comp`)
+	VkDescriptorSetLayoutBinding skinningVerticesBinding = {
+		.binding = 0,
+		.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+		.descriptorCount = 1,
+		.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+		.pImmutableSamplers = nullptr,
+	};
+	VkDescriptorSetLayoutCreateInfo skinningVerticesLayoutInfo = {
+		.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
+		.pNext = nullptr,
+		.flags = 0,
+		.bindingCount = 1,
+		.pBindings = &skinningVerticesBinding,
+	};
+	_skinningVerticesSetLayout = vkutil::descriptorlayoutcache::createDescriptorLayout(&skinningVerticesLayoutInfo);
+
 	// Add cleanup procedure
-	_mainDeletionQueue.pushFunction([=]() {
-		vmaDestroyBuffer(_allocator, materialParamsBuffer._buffer, materialParamsBuffer._allocation);
-	});
+	_mainDeletionQueue.pushBuffer(_allocator, materialParamsBuffer);
 
 	//
 	// Text Mesh Fonts
@@ -4300,6 +4198,10 @@ void VulkanEngine::initDescriptors()    // @NOTE: don't destroy and then recreat
 
 void VulkanEngine::initPipelines()
 {
+	// @NOTE: all the pipelines get created in parallel at the end (`flushBatch()`), so the
+	//        pipelines have to get written straight into their materials, not into locals.
+	vkutil::pipelinebuilder::beginBatch();
+
 	//
 	// Load shader modules
 	//
@@ -4348,8 +4250,7 @@ void VulkanEngine::initPipelines()
 	}
 
 	// Mesh ZPrepass Pipeline
-	VkPipeline meshZPrepassPipeline;
-	VkPipelineLayout meshZPrepassPipelineLayout;
+	Material* meshZPrepassMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "pbrZPrepassMaterial");
 	vkutil::pipelinebuilder::build(
 		{},
 		{ _globalSetLayout, _objectSetLayout, _instancePtrSetLayout, _pbrTexturesSetLayout, _skeletalAnimationSetLayout },
@@ -4369,15 +4270,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_mainRenderPass,
 		0,
-		meshZPrepassPipeline,
-		meshZPrepassPipelineLayout,
+		meshZPrepassMaterial->pipeline,
+		meshZPrepassMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(meshZPrepassPipeline, meshZPrepassPipelineLayout, "pbrZPrepassMaterial");
 
 	// Mesh Pipeline
-	VkPipeline meshPipeline;
-	VkPipelineLayout meshPipelineLayout;
+	Material* meshMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "pbrMaterial");
 	vkutil::pipelinebuilder::build(
 		{},
 		{ _globalSetLayout, _objectSetLayout, _instancePtrSetLayout, _pbrTexturesSetLayout, _skeletalAnimationSetLayout, _voxelFieldLightingGridTextureSet.layout },
@@ -4397,15 +4296,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_mainRenderPass,
 		1,
-		meshPipeline,
-		meshPipelineLayout,
+		meshMaterial->pipeline,
+		meshMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(meshPipeline, meshPipelineLayout, "pbrMaterial");
 
 	// Snapshot image pipeline
-	VkPipeline snapshotImagePipeline;
-	VkPipelineLayout snapshotImagePipelineLayout;
+	Material* snapshotImageMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "snapshotImageMaterial");
 	vkutil::pipelinebuilder::build(
 		{},
 		{ _singleTextureSetLayout },
@@ -4425,15 +4322,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_mainRenderPass,
 		1,
-		snapshotImagePipeline,
-		snapshotImagePipelineLayout,
+		snapshotImageMaterial->pipeline,
+		snapshotImageMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(snapshotImagePipeline, snapshotImagePipelineLayout, "snapshotImageMaterial");
 
 	// Skybox pipeline
-	VkPipeline skyboxPipeline;
-	VkPipelineLayout skyboxPipelineLayout;
+	Material* skyboxMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "skyboxMaterial");
 	vkutil::pipelinebuilder::build(
 		{},
 		{ _globalSetLayout, _singleTextureSetLayout },
@@ -4453,15 +4348,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_mainRenderPass,
 		1,
-		skyboxPipeline,
-		skyboxPipelineLayout,
+		skyboxMaterial->pipeline,
+		skyboxMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(skyboxPipeline, skyboxPipelineLayout, "skyboxMaterial");
 
 	// Picking pipeline
-	VkPipeline pickingPipeline;
-	VkPipelineLayout pickingPipelineLayout;
+	Material* pickingMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "pickingMaterial");
 	vkutil::pipelinebuilder::build(
 		{},
 		{ _globalSetLayout, _objectSetLayout, _instancePtrSetLayout, _pickingReturnValueSetLayout, _skeletalAnimationSetLayout },
@@ -4481,15 +4374,13 @@ void VulkanEngine::initPipelines()
 		{ VK_DYNAMIC_STATE_SCISSOR },
 		_pickingRenderPass,
 		0,
-		pickingPipeline,
-		pickingPipelineLayout,
+		pickingMaterial->pipeline,
+		pickingMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(pickingPipeline, pickingPipelineLayout, "pickingMaterial");
 
 	// Wireframe color pipeline
-	VkPipeline wireframePipeline;
-	VkPipelineLayout wireframePipelineLayout;
+	Material* wireframeMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "wireframeColorMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4515,13 +4406,12 @@ void VulkanEngine::initPipelines()
 		{},
 		_mainRenderPass,
 		1,
-		wireframePipeline,
-		wireframePipelineLayout,
+		wireframeMaterial->pipeline,
+		wireframeMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(wireframePipeline, wireframePipelineLayout, "wireframeColorMaterial");
 
-	VkPipeline wireframeBehindPipeline;
+	Material* wireframeBehindMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "wireframeColorBehindMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4547,18 +4437,16 @@ void VulkanEngine::initPipelines()
 		{},
 		_mainRenderPass,
 		1,
-		wireframeBehindPipeline,
-		wireframePipelineLayout,
+		wireframeBehindMaterial->pipeline,
+		wireframeBehindMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(wireframeBehindPipeline, wireframePipelineLayout, "wireframeColorBehindMaterial");
 
 	// Shadow Depth Pass pipeline
 	auto shadowRasterizer = vkinit::rasterizationStateCreateInfo(VK_POLYGON_MODE_FILL, VK_CULL_MODE_NONE);
 	shadowRasterizer.depthClampEnable = VK_TRUE;
 
-	VkPipeline shadowDepthPassPipeline;
-	VkPipelineLayout shadowDepthPassPipelineLayout;
+	Material* shadowDepthPassMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "shadowDepthPassMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4591,15 +4479,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_shadowRenderPass,
 		0,
-		shadowDepthPassPipeline,
-		shadowDepthPassPipelineLayout,
+		shadowDepthPassMaterial->pipeline,
+		shadowDepthPassMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(shadowDepthPassPipeline, shadowDepthPassPipelineLayout, "shadowDepthPassMaterial");
 
 	// Postprocess pipeline
-	VkPipeline postprocessPipeline;
-	VkPipelineLayout postprocessPipelineLayout;
+	Material* postprocessMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "postprocessMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4625,11 +4511,10 @@ void VulkanEngine::initPipelines()
 		{},
 		_postprocessRenderPass,
 		0,
-		postprocessPipeline,
-		postprocessPipelineLayout,
+		postprocessMaterial->pipeline,
+		postprocessMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(postprocessPipeline, postprocessPipelineLayout, "postprocessMaterial");
 
 	// Generate CoC pipeline
 	VkPipelineColorBlendAttachmentState rChannelAttachmentState = vkinit::colorBlendAttachmentState();
@@ -4638,8 +4523,7 @@ void VulkanEngine::initPipelines()
 	VkPipelineColorBlendAttachmentState rgChannelAttachmentState = vkinit::colorBlendAttachmentState();
 	rgChannelAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT;
 
-	VkPipeline CoCPipeline;
-	VkPipelineLayout CoCPipelineLayout;
+	Material* cocMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "CoCMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4665,15 +4549,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_CoCRenderPass,
 		0,
-		CoCPipeline,
-		CoCPipelineLayout,
+		cocMaterial->pipeline,
+		cocMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(CoCPipeline, CoCPipelineLayout, "CoCMaterial");
 
 	// Halve CoC pipeline
-	VkPipeline halveCoCPipeline;
-	VkPipelineLayout halveCoCPipelineLayout;
+	Material* halveCoCMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "halveCoCMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4699,17 +4581,16 @@ void VulkanEngine::initPipelines()
 		{},
 		_halveCoCRenderPass,
 		0,
-		halveCoCPipeline,
-		halveCoCPipelineLayout,
+		halveCoCMaterial->pipeline,
+		halveCoCMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(halveCoCPipeline, halveCoCPipelineLayout, "halveCoCMaterial");
 
 	// IncrementalReductionHalve CoC pipeline
 	for (size_t i = 0; i < NUM_INCREMENTAL_COC_REDUCTIONS; i++)
 	{
-		VkPipeline incrementalReductionHalveCoCPipeline;
-		VkPipelineLayout incrementalReductionHalveCoCPipelineLayout;
+		std::string materialName = "incrementalReductionHalveCoCMaterial_" + std::to_string(i);
+		Material* incrementalReductionHalveCoCMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, materialName);
 		vkutil::pipelinebuilder::build(
 			{},
 			{ _dofSingleTextureLayout },
@@ -4729,17 +4610,14 @@ void VulkanEngine::initPipelines()
 			{},
 			_incrementalReductionHalveCoCRenderPass,
 			0,
-			incrementalReductionHalveCoCPipeline,
-			incrementalReductionHalveCoCPipelineLayout,
+			incrementalReductionHalveCoCMaterial->pipeline,
+			incrementalReductionHalveCoCMaterial->pipelineLayout,
 			_swapchainDependentDeletionQueue
 		);
-		std::string materialName = "incrementalReductionHalveCoCMaterial_" + std::to_string(i);
-		attachPipelineToMaterial(incrementalReductionHalveCoCPipeline, incrementalReductionHalveCoCPipelineLayout, materialName);
 	}
 
 	// Blur X Single Channel pipeline
-	VkPipeline blurXSingleChannelPipeline;
-	VkPipelineLayout blurXSingleChannelPipelineLayout;
+	Material* blurXSingleChannelMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "blurXSingleChannelMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4765,15 +4643,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_blurXNearsideCoCRenderPass,
 		0,
-		blurXSingleChannelPipeline,
-		blurXSingleChannelPipelineLayout,
+		blurXSingleChannelMaterial->pipeline,
+		blurXSingleChannelMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(blurXSingleChannelPipeline, blurXSingleChannelPipelineLayout, "blurXSingleChannelMaterial");
 
 	// Blur Y Single Channel pipeline
-	VkPipeline blurYSingleChannelPipeline;
-	VkPipelineLayout blurYSingleChannelPipelineLayout;
+	Material* blurYSingleChannelMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "blurYSingleChannelMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4799,15 +4675,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_blurYNearsideCoCRenderPass,
 		0,
-		blurYSingleChannelPipeline,
-		blurYSingleChannelPipelineLayout,
+		blurYSingleChannelMaterial->pipeline,
+		blurYSingleChannelMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(blurYSingleChannelPipeline, blurYSingleChannelPipelineLayout, "blurYSingleChannelMaterial");
 
 	// Gather Depth of Field pipeline
-	VkPipeline gatherDOFPipeline;
-	VkPipelineLayout gatherDOFPipelineLayout;
+	Material* gatherDOFMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "gatherDOFMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4833,15 +4707,13 @@ void VulkanEngine::initPipelines()
 		{},
 		_gatherDOFRenderPass,
 		0,
-		gatherDOFPipeline,
-		gatherDOFPipelineLayout,
+		gatherDOFMaterial->pipeline,
+		gatherDOFMaterial->pipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(gatherDOFPipeline, gatherDOFPipelineLayout, "gatherDOFMaterial");
 
 	// Depth of Field Flood-fill pipeline
-	VkPipeline dofFloodFillPipeline;
-	VkPipelineLayout dofFloodFillPipelineLayout;
+	Material* dofFloodFillMaterial = attachPipelineToMaterial(VK_NULL_HANDLE, VK_NULL_HANDLE, "DOFFloodFillMaterial");
 	vkutil::pipelinebuilder::build(
 		{
 			VkPushConstantRange{
@@ -4867,11 +4739,26 @@ void VulkanEngine::initPipelines()
 		{},
 		_dofFloodFillRenderPass,
 		0,
-		dofFloodFillPipeline,
-		dofFloodFillPipelineLayout,
+		dofFloodFillMaterial->pipeline,
+		dofFloodFillMaterial->pipelineLayout,
+		_swapchainDependentDeletionQueue
+	);
+
+	// Pre-skinning Pipeline
+	vkutil::pipelinebuilder::buildCompute(
+		{
+			VkPushConstantRange{
+				.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+				.offset = 0,
+				.size = sizeof(vkglTF::Animator::GPUPreskinningPushConstants)
+			}
+		},
+		{ _skeletalAnimationSetLayout, _skinningVerticesSetLayout },
+		"shader/skinning.comp.spv",
+		_skinningPipeline,
+		_skinningPipelineLayout,
 		_swapchainDependentDeletionQueue
 	);
-	attachPipelineToMaterial(dofFloodFillPipeline, dofFloodFillPipelineLayout, "DOFFloodFillMaterial");
 
 	//
 	// Other pipelines
@@ -4880,26 +4767,43 @@ void VulkanEngine::initPipelines()
 	textbox::initPipeline(screenspaceViewport, screenspaceScissor, _swapchainDependentDeletionQueue);
 	ui::initPipeline(screenspaceViewport, screenspaceScissor, _swapchainDependentDeletionQueue);
 	physengine::initDebugVisPipelines(_mainRenderPass, screenspaceViewport, screenspaceScissor, _swapchainDependentDeletionQueue);
+
+	vkutil::pipelinebuilder::flushBatch();
 }
 
-void VulkanEngine::generatePBRCubemaps()
+namespace
 {
-	//
-	// @NOTE: this function was copied and very slightly modified from Sascha Willem's Vulkan-glTF-PBR example.
-	//
+	enum PBRCubemapTarget
+	{
+		ENVIRONMENT = 0,
+		IRRADIANCE = 1,
+		PREFILTEREDENV = 2,
+	};
+
+	// @NOTE: everything that goes into the generated PBR textures, so that it all can be hashed into the cache keys.
+	const std::string PBR_CACHE_DIRECTORY = "cache/";
+	constexpr float_t PBR_ENVIRONMENT_SUN_RADIUS = 0.15f;
+	constexpr float_t PBR_ENVIRONMENT_SUN_ALPHA = 1.0f;
+	constexpr float_t PBR_IRRADIANCE_DELTA_PHI = (2.0f * float_t(M_PI)) / 180.0f;
+	constexpr float_t PBR_IRRADIANCE_DELTA_THETA = (0.5f * float_t(M_PI)) / 64.0f;
+	constexpr uint32_t PBR_PREFILTER_NUM_SAMPLES = 32;
+	constexpr uint32_t PBR_BRDF_LUT_NUM_SAMPLES = 1024;  // @NOTE: must match `NUM_SAMPLES` in genbrdflut.frag.
+}
 
+void VulkanEngine::generatePBRCubemaps()
+{
 	//
 	// Offline generation for the cubemaps used for PBR lighting
 	// - Environment cubemap for the next two cubemaps
 	// - Irradiance cubemap
 	// - Pre-filterd environment cubemap
+	// @NOTE: these get loaded from the cache in "cache/" if none of their inputs changed.
 	//
-	enum Target
-	{
-		ENVIRONMENT = 0,
-		IRRADIANCE = 1,
-		PREFILTEREDENV = 2,
-	};
+	uint64_t environmentCacheKey = pbrtexturecache::hashFile("shader/filtercube.vert.spv");
+	environmentCacheKey = pbrtexturecache::hashFile("shader/skyboxfiltercube.frag.spv", environmentCacheKey);
+	environmentCacheKey = pbrtexturecache::hashBytes(lightDir, sizeof(vec3), environmentCacheKey);
+	environmentCacheKey = pbrtexturecache::hashBytes(&PBR_ENVIRONMENT_SUN_RADIUS, sizeof(float_t), environmentCacheKey);
+	environmentCacheKey = pbrtexturecache::hashBytes(&PBR_ENVIRONMENT_SUN_ALPHA, sizeof(float_t), environmentCacheKey);
 
 	for (uint32_t target = 0; target <= PREFILTEREDENV; target++)
 	{
@@ -4911,25 +4815,42 @@ void VulkanEngine::generatePBRCubemaps()
 		auto tStart = std::chrono::high_resolution_clock::now();
 
 		VkFormat format;
+		uint32_t texelSize;
 		int32_t dim;
+		std::string cubemapTypeName;
+		uint64_t cacheKey = environmentCacheKey;  // @NOTE: the irradiance and prefilter cubemaps are made from the environment cubemap, so they all start from its key.
 
 		switch (target)
 		{
 		case ENVIRONMENT:
 			format = VK_FORMAT_R32G32B32A32_SFLOAT;
+			texelSize = 16;
 			dim = 512;
+			cubemapTypeName = "environment";
 			break;
 		case IRRADIANCE:
 			format = VK_FORMAT_R32G32B32A32_SFLOAT;
+			texelSize = 16;
 			dim = 64;
+			cubemapTypeName = "irradiance";
+			cacheKey = pbrtexturecache::hashFile("shader/irradiancecube.frag.spv", cacheKey);
+			cacheKey = pbrtexturecache::hashBytes(&PBR_IRRADIANCE_DELTA_PHI, sizeof(float_t), cacheKey);
+			cacheKey = pbrtexturecache::hashBytes(&PBR_IRRADIANCE_DELTA_THETA, sizeof(float_t), cacheKey);
 			break;
 		case PREFILTEREDENV:
 			format = VK_FORMAT_R16G16B16A16_SFLOAT;
+			texelSize = 8;
 			dim = 512;
+			cubemapTypeName = "prefilter";
+			cacheKey = pbrtexturecache::hashFile("shader/prefilterenvmap.frag.spv", cacheKey);
+			cacheKey = pbrtexturecache::hashBytes(&PBR_PREFILTER_NUM_SAMPLES, sizeof(uint32_t), cacheKey);
 			break;
 		};
 
 		const uint32_t numMips = (target == ENVIRONMENT) ? 1 : static_cast<uint32_t>(floor(log2(dim))) + 1;
+		cacheKey = pbrtexturecache::hashBytes(&format, sizeof(format), cacheKey);
+		cacheKey = pbrtexturecache::hashBytes(&dim, sizeof(dim), cacheKey);
+		cacheKey = pbrtexturecache::hashBytes(&numMips, sizeof(numMips), cacheKey);
 
 		// Create target cubemap
 
@@ -4945,7 +4866,7 @@ void VulkanEngine::generatePBRCubemaps()
 		imageCI.arrayLayers = 6;
 		imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
 		imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
-		imageCI.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+		imageCI.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;  // @NOTE: TRANSFER_SRC is for reading it back into the cache.
 		imageCI.flags = VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
 		VmaAllocationCreateInfo imageAllocInfo = {
 			.usage = VMA_MEMORY_USAGE_GPU_ONLY,
@@ -4980,567 +4901,593 @@ void VulkanEngine::generatePBRCubemaps()
 		};
 		VK_CHECK(vkCreateSampler(_device, &samplerCI, nullptr, &cubemapTexture.sampler));
 
-		// FB, Att, RP, Pipe, etc.
-		VkAttachmentDescription attDesc{};
-		// Color attachment
-		attDesc.format = format;
-		attDesc.samples = VK_SAMPLE_COUNT_1_BIT;
-		attDesc.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-		attDesc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-		attDesc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-		attDesc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-		attDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-		attDesc.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-		VkAttachmentReference colorReference = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
-
-		VkSubpassDescription subpassDescription{};
-		subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-		subpassDescription.colorAttachmentCount = 1;
-		subpassDescription.pColorAttachments = &colorReference;
-
-		// Use subpass dependencies for layout transitions
-		std::array<VkSubpassDependency, 2> dependencies;
-		dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-		dependencies[0].dstSubpass = 0;
-		dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-		dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-		dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-		dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-		dependencies[1].srcSubpass = 0;
-		dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-		dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-		dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-		dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-		dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-		dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-		// Renderpass
-		VkRenderPassCreateInfo renderPassCI{};
-		renderPassCI.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-		renderPassCI.attachmentCount = 1;
-		renderPassCI.pAttachments = &attDesc;
-		renderPassCI.subpassCount = 1;
-		renderPassCI.pSubpasses = &subpassDescription;
-		renderPassCI.dependencyCount = 2;
-		renderPassCI.pDependencies = dependencies.data();
-
-		VkRenderPass renderpass;
-		VK_CHECK(vkCreateRenderPass(_device, &renderPassCI, nullptr, &renderpass));
-
-		struct Offscreen
+		// Load from the cache, or render and then save to the cache
+		const std::string cacheFname = PBR_CACHE_DIRECTORY + "pbr_" + cubemapTypeName + ".hpbr";
+		pbrtexturecache::CachedImage cachedImage;
+		bool loadedFromCache =
+			pbrtexturecache::loadCachedImage(cacheFname, cacheKey, cachedImage) &&
+			vkutil::uploadImageLayers(*this, cubemapTexture.image._image, texelSize, dim, dim, numMips, 6, cachedImage.data);
+		if (!loadedFromCache)
 		{
-			Texture texture;
-			VkFramebuffer framebuffer;
-		} offscreen;
+			renderPBRCubemap(target, cubemapTexture, format, dim, numMips);
+
+			cachedImage = {
+				.key = cacheKey,
+				.format = (uint32_t)format,
+				.texelSize = texelSize,
+				.width = (uint32_t)dim,
+				.height = (uint32_t)dim,
+				.mipLevels = numMips,
+				.layerCount = 6,
+			};
+			if (vkutil::readbackImage(*this, cubemapTexture.image._image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texelSize, dim, dim, numMips, 6, cachedImage.data))
+				pbrtexturecache::saveCachedImage(cacheFname, cachedImage);
+		}
+
+		_mainDeletionQueue.pushTexture(_device, _allocator, cubemapTexture);
 
-		// Create offscreen framebuffer
+		// Apply the created texture/sampler to global scene
+		switch (target)
 		{
-			// Image
-			VkImageCreateInfo imageCI{};
-			imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-			imageCI.imageType = VK_IMAGE_TYPE_2D;
-			imageCI.format = format;
-			imageCI.extent.width = dim;
-			imageCI.extent.height = dim;
-			imageCI.extent.depth = 1;
-			imageCI.mipLevels = 1;
-			imageCI.arrayLayers = 1;
-			imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
-			imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
-			imageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			imageCI.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
-			imageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			VmaAllocationCreateInfo imageAllocInfo = {
-				.usage = VMA_MEMORY_USAGE_GPU_ONLY,
-			};
-			vmaCreateImage(_allocator, &imageCI, &imageAllocInfo, &offscreen.texture.image._image, &offscreen.texture.image._allocation, nullptr);
-
-			// ImageView
-			VkImageViewCreateInfo viewCI{};
-			viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-			viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
-			viewCI.format = format;
-			viewCI.flags = 0;
-			viewCI.subresourceRange = {};
-			viewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			viewCI.subresourceRange.baseMipLevel = 0;
-			viewCI.subresourceRange.levelCount = 1;
-			viewCI.subresourceRange.baseArrayLayer = 0;
-			viewCI.subresourceRange.layerCount = 1;
-			viewCI.image = offscreen.texture.image._image;
-			VK_CHECK(vkCreateImageView(_device, &viewCI, nullptr, &offscreen.texture.imageView));
-
-			// Framebuffer
-			VkFramebufferCreateInfo framebufferCI{};
-			framebufferCI.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-			framebufferCI.renderPass = renderpass;
-			framebufferCI.attachmentCount = 1;
-			framebufferCI.pAttachments = &offscreen.texture.imageView;
-			framebufferCI.width = dim;
-			framebufferCI.height = dim;
-			framebufferCI.layers = 1;
-			VK_CHECK(vkCreateFramebuffer(_device, &framebufferCI, nullptr, &offscreen.framebuffer));
+		case ENVIRONMENT:
+			_loadedTextures["CubemapSkybox"] = cubemapTexture;
+			break;
+		case IRRADIANCE:
+			_pbrSceneTextureSet.irradianceCubemap = cubemapTexture;
+			break;
+		case PREFILTEREDENV:
+			_pbrRendering.gpuSceneShadingProps.prefilteredCubemapMipLevels = static_cast<float_t>(numMips);
+			_pbrSceneTextureSet.prefilteredCubemap = cubemapTexture;
+			break;
+		};
 
-			immediateSubmit([&](VkCommandBuffer cmd) {
-				VkImageMemoryBarrier imageMemoryBarrier{};
-				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-				imageMemoryBarrier.image = offscreen.texture.image._image;
-				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-				imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-				imageMemoryBarrier.srcAccessMask = 0;
-				imageMemoryBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-				imageMemoryBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-				vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-				});
-		}
+		// Report time it took
+		auto tEnd = std::chrono::high_resolution_clock::now();
+		auto tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+		std::cout << "[GENERATING PBR CUBEMAP]" << std::endl
+			<< "type:               " << cubemapTypeName << std::endl
+			<< "source:             " << (loadedFromCache ? "cache" : "generated") << std::endl
+			<< "mip levels:         " << numMips << std::endl
+			<< "execution duration: " << tDiff << " ms" << std::endl;
+	}
+}
+
+void VulkanEngine::renderPBRCubemap(uint32_t target, Texture& cubemapTexture, VkFormat format, int32_t dim, uint32_t numMips)
+{
+	//
+	// @NOTE: this function was copied and very slightly modified from Sascha Willem's Vulkan-glTF-PBR example.
+	//
+	// FB, Att, RP, Pipe, etc.
+	VkAttachmentDescription attDesc{};
+	// Color attachment
+	attDesc.format = format;
+	attDesc.samples = VK_SAMPLE_COUNT_1_BIT;
+	attDesc.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	attDesc.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	attDesc.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	attDesc.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	attDesc.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	attDesc.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	VkAttachmentReference colorReference = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+
+	VkSubpassDescription subpassDescription{};
+	subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpassDescription.colorAttachmentCount = 1;
+	subpassDescription.pColorAttachments = &colorReference;
+
+	// Use subpass dependencies for layout transitions
+	std::array<VkSubpassDependency, 2> dependencies;
+	dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[0].dstSubpass = 0;
+	dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+	dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+	dependencies[1].srcSubpass = 0;
+	dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+	dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+	// Renderpass
+	VkRenderPassCreateInfo renderPassCI{};
+	renderPassCI.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassCI.attachmentCount = 1;
+	renderPassCI.pAttachments = &attDesc;
+	renderPassCI.subpassCount = 1;
+	renderPassCI.pSubpasses = &subpassDescription;
+	renderPassCI.dependencyCount = 2;
+	renderPassCI.pDependencies = dependencies.data();
+
+	VkRenderPass renderpass;
+	VK_CHECK(vkCreateRenderPass(_device, &renderPassCI, nullptr, &renderpass));
+
+	struct Offscreen
+	{
+		Texture texture;
+		VkFramebuffer framebuffer;
+	} offscreen;
+
+	// Create offscreen framebuffer
+	{
+		// Image
+		VkImageCreateInfo imageCI{};
+		imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCI.imageType = VK_IMAGE_TYPE_2D;
+		imageCI.format = format;
+		imageCI.extent.width = dim;
+		imageCI.extent.height = dim;
+		imageCI.extent.depth = 1;
+		imageCI.mipLevels = 1;
+		imageCI.arrayLayers = 1;
+		imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageCI.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageCI.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		imageCI.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		VmaAllocationCreateInfo imageAllocInfo = {
+			.usage = VMA_MEMORY_USAGE_GPU_ONLY,
+		};
+		vmaCreateImage(_allocator, &imageCI, &imageAllocInfo, &offscreen.texture.image._image, &offscreen.texture.image._allocation, nullptr);
+
+		// ImageView
+		VkImageViewCreateInfo viewCI{};
+		viewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewCI.format = format;
+		viewCI.flags = 0;
+		viewCI.subresourceRange = {};
+		viewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		viewCI.subresourceRange.baseMipLevel = 0;
+		viewCI.subresourceRange.levelCount = 1;
+		viewCI.subresourceRange.baseArrayLayer = 0;
+		viewCI.subresourceRange.layerCount = 1;
+		viewCI.image = offscreen.texture.image._image;
+		VK_CHECK(vkCreateImageView(_device, &viewCI, nullptr, &offscreen.texture.imageView));
+
+		// Framebuffer
+		VkFramebufferCreateInfo framebufferCI{};
+		framebufferCI.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+		framebufferCI.renderPass = renderpass;
+		framebufferCI.attachmentCount = 1;
+		framebufferCI.pAttachments = &offscreen.texture.imageView;
+		framebufferCI.width = dim;
+		framebufferCI.height = dim;
+		framebufferCI.layers = 1;
+		VK_CHECK(vkCreateFramebuffer(_device, &framebufferCI, nullptr, &offscreen.framebuffer));
+
+		immediateSubmit([&](VkCommandBuffer cmd) {
+			VkImageMemoryBarrier imageMemoryBarrier{};
+			imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+			imageMemoryBarrier.image = offscreen.texture.image._image;
+			imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+			imageMemoryBarrier.srcAccessMask = 0;
+			imageMemoryBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+			imageMemoryBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+			vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+			});
+	}
+
+	// Descriptors
+	VkDescriptorSetLayout descriptorsetlayout;
+	VkDescriptorSetLayoutBinding setLayoutBinding = { 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr };
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCI{};
+	descriptorSetLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	descriptorSetLayoutCI.pBindings = &setLayoutBinding;
+	descriptorSetLayoutCI.bindingCount = 1;
+	VK_CHECK(vkCreateDescriptorSetLayout(_device, &descriptorSetLayoutCI, nullptr, &descriptorsetlayout));
+
+	// Descriptor Pool
+	VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 };
+	VkDescriptorPoolCreateInfo descriptorPoolCI{};
+	descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCI.poolSizeCount = 1;
+	descriptorPoolCI.pPoolSizes = &poolSize;
+	descriptorPoolCI.maxSets = 2;
+	VkDescriptorPool descriptorpool;
+	VK_CHECK(vkCreateDescriptorPool(_device, &descriptorPoolCI, nullptr, &descriptorpool));
+
+
+	// Descriptor sets
+	VkDescriptorSet descriptorset;
+	if (target != ENVIRONMENT)
+	{
+		VkDescriptorImageInfo environmentCubemapBufferInfo = {
+			.sampler = _loadedTextures["CubemapSkybox"].sampler,  // @NOTE: CubemapSkybox is not available until it's generated by the `ENVIRONMENT` pbr texture generation step.
+			.imageView = _loadedTextures["CubemapSkybox"].imageView,
+			.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		};
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocInfo{};
+		descriptorSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocInfo.descriptorPool = descriptorpool;
+		descriptorSetAllocInfo.pSetLayouts = &descriptorsetlayout;
+		descriptorSetAllocInfo.descriptorSetCount = 1;
+		VK_CHECK(vkAllocateDescriptorSets(_device, &descriptorSetAllocInfo, &descriptorset));
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.dstSet = descriptorset;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.pImageInfo = &environmentCubemapBufferInfo;    // @TODO: @HACK: implement a proper system to get the environment cubemap!
+		vkUpdateDescriptorSets(_device, 1, &writeDescriptorSet, 0, nullptr);
+	}
+
+	struct PushBlockEnvironment
+	{
+		mat4 mvp;
+		vec3 lightDir;
+		float_t sunRadius;
+		float_t sunAlpha;
+	} pushBlockEnvironment;
+
+	struct PushBlockIrradiance
+	{
+		mat4 mvp;
+		float_t deltaPhi = PBR_IRRADIANCE_DELTA_PHI;
+		float_t deltaTheta = PBR_IRRADIANCE_DELTA_THETA;
+	} pushBlockIrradiance;
+
+	struct PushBlockPrefilterEnv
+	{
+		mat4 mvp;
+		float_t roughness;
+		uint32_t numSamples = PBR_PREFILTER_NUM_SAMPLES;
+	} pushBlockPrefilterEnv;
+
+	// Pipeline layout
+	VkPipelineLayout pipelinelayout;
+	VkPushConstantRange pushConstantRange = {
+		.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+	};
+
+	switch (target)
+	{
+	case ENVIRONMENT:
+		pushConstantRange.size = sizeof(PushBlockEnvironment);
+		break;
+	case IRRADIANCE:
+		pushConstantRange.size = sizeof(PushBlockIrradiance);
+		break;
+	case PREFILTEREDENV:
+		pushConstantRange.size = sizeof(PushBlockPrefilterEnv);
+		break;
+	};
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCI{};
+	pipelineLayoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCI.setLayoutCount = 1;
+	pipelineLayoutCI.pSetLayouts = &descriptorsetlayout;
+	pipelineLayoutCI.pushConstantRangeCount = 1;
+	pipelineLayoutCI.pPushConstantRanges = &pushConstantRange;
+	VK_CHECK(vkCreatePipelineLayout(_device, &pipelineLayoutCI, nullptr, &pipelinelayout));
 
-		// Descriptors
-		VkDescriptorSetLayout descriptorsetlayout;
-		VkDescriptorSetLayoutBinding setLayoutBinding = { 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr };
-		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCI{};
-		descriptorSetLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-		descriptorSetLayoutCI.pBindings = &setLayoutBinding;
-		descriptorSetLayoutCI.bindingCount = 1;
-		VK_CHECK(vkCreateDescriptorSetLayout(_device, &descriptorSetLayoutCI, nullptr, &descriptorsetlayout));
-
-		// Descriptor Pool
-		VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1 };
-		VkDescriptorPoolCreateInfo descriptorPoolCI{};
-		descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-		descriptorPoolCI.poolSizeCount = 1;
-		descriptorPoolCI.pPoolSizes = &poolSize;
-		descriptorPoolCI.maxSets = 2;
-		VkDescriptorPool descriptorpool;
-		VK_CHECK(vkCreateDescriptorPool(_device, &descriptorPoolCI, nullptr, &descriptorpool));
-
-
-		// Descriptor sets
-		VkDescriptorSet descriptorset;
-		if (target != ENVIRONMENT)
-		{
-			VkDescriptorImageInfo environmentCubemapBufferInfo = {
-				.sampler = _loadedTextures["CubemapSkybox"].sampler,  // @NOTE: CubemapSkybox is not available until it's generated by the `ENVIRONMENT` pbr texture generation step.
-				.imageView = _loadedTextures["CubemapSkybox"].imageView,
-				.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-			};
+	// Pipeline
+	VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCI{};
+	inputAssemblyStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	inputAssemblyStateCI.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
 
-			VkDescriptorSetAllocateInfo descriptorSetAllocInfo{};
-			descriptorSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			descriptorSetAllocInfo.descriptorPool = descriptorpool;
-			descriptorSetAllocInfo.pSetLayouts = &descriptorsetlayout;
-			descriptorSetAllocInfo.descriptorSetCount = 1;
-			VK_CHECK(vkAllocateDescriptorSets(_device, &descriptorSetAllocInfo, &descriptorset));
-			VkWriteDescriptorSet writeDescriptorSet{};
-			writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			writeDescriptorSet.descriptorCount = 1;
-			writeDescriptorSet.dstSet = descriptorset;
-			writeDescriptorSet.dstBinding = 0;
-			writeDescriptorSet.pImageInfo = &environmentCubemapBufferInfo;    // @TODO: @HACK: implement a proper system to get the environment cubemap!
-			vkUpdateDescriptorSets(_device, 1, &writeDescriptorSet, 0, nullptr);
-		}
+	VkPipelineRasterizationStateCreateInfo rasterizationStateCI{};
+	rasterizationStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	rasterizationStateCI.polygonMode = VK_POLYGON_MODE_FILL;
+	rasterizationStateCI.cullMode = VK_CULL_MODE_NONE;
+	rasterizationStateCI.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	rasterizationStateCI.lineWidth = 1.0f;
 
-		struct PushBlockEnvironment
-		{
-			mat4 mvp;
-			vec3 lightDir;
-			float_t sunRadius;
-			float_t sunAlpha;
-		} pushBlockEnvironment;
+	VkPipelineColorBlendAttachmentState blendAttachmentState{};
+	blendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	blendAttachmentState.blendEnable = VK_FALSE;
 
-		struct PushBlockIrradiance
-		{
-			mat4 mvp;
-			float_t deltaPhi = (2.0f * float_t(M_PI)) / 180.0f;
-			float_t deltaTheta = (0.5f * float_t(M_PI)) / 64.0f;
-		} pushBlockIrradiance;
+	VkPipelineColorBlendStateCreateInfo colorBlendStateCI{};
+	colorBlendStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	colorBlendStateCI.attachmentCount = 1;
+	colorBlendStateCI.pAttachments = &blendAttachmentState;
 
-		struct PushBlockPrefilterEnv
-		{
-			mat4 mvp;
-			float_t roughness;
-			uint32_t numSamples = 32u;
-		} pushBlockPrefilterEnv;
-
-		// Pipeline layout
-		VkPipelineLayout pipelinelayout;
-		VkPushConstantRange pushConstantRange = {
-			.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
-		};
+	VkPipelineDepthStencilStateCreateInfo depthStencilStateCI{};
+	depthStencilStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	depthStencilStateCI.depthTestEnable = VK_FALSE;
+	depthStencilStateCI.depthWriteEnable = VK_FALSE;
+	depthStencilStateCI.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
+	depthStencilStateCI.front = depthStencilStateCI.back;
+	depthStencilStateCI.back.compareOp = VK_COMPARE_OP_ALWAYS;
 
-		switch (target)
-		{
-		case ENVIRONMENT:
-			pushConstantRange.size = sizeof(PushBlockEnvironment);
-			break;
-		case IRRADIANCE:
-			pushConstantRange.size = sizeof(PushBlockIrradiance);
-			break;
-		case PREFILTEREDENV:
-			pushConstantRange.size = sizeof(PushBlockPrefilterEnv);
-			break;
-		};
+	VkPipelineViewportStateCreateInfo viewportStateCI{};
+	viewportStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	viewportStateCI.viewportCount = 1;
+	viewportStateCI.scissorCount = 1;
 
-		VkPipelineLayoutCreateInfo pipelineLayoutCI{};
-		pipelineLayoutCI.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		pipelineLayoutCI.setLayoutCount = 1;
-		pipelineLayoutCI.pSetLayouts = &descriptorsetlayout;
-		pipelineLayoutCI.pushConstantRangeCount = 1;
-		pipelineLayoutCI.pPushConstantRanges = &pushConstantRange;
-		VK_CHECK(vkCreatePipelineLayout(_device, &pipelineLayoutCI, nullptr, &pipelinelayout));
-
-		// Pipeline
-		VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateCI{};
-		inputAssemblyStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-		inputAssemblyStateCI.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-		VkPipelineRasterizationStateCreateInfo rasterizationStateCI{};
-		rasterizationStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-		rasterizationStateCI.polygonMode = VK_POLYGON_MODE_FILL;
-		rasterizationStateCI.cullMode = VK_CULL_MODE_NONE;
-		rasterizationStateCI.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE;
-		rasterizationStateCI.lineWidth = 1.0f;
-
-		VkPipelineColorBlendAttachmentState blendAttachmentState{};
-		blendAttachmentState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-		blendAttachmentState.blendEnable = VK_FALSE;
-
-		VkPipelineColorBlendStateCreateInfo colorBlendStateCI{};
-		colorBlendStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-		colorBlendStateCI.attachmentCount = 1;
-		colorBlendStateCI.pAttachments = &blendAttachmentState;
-
-		VkPipelineDepthStencilStateCreateInfo depthStencilStateCI{};
-		depthStencilStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-		depthStencilStateCI.depthTestEnable = VK_FALSE;
-		depthStencilStateCI.depthWriteEnable = VK_FALSE;
-		depthStencilStateCI.depthCompareOp = VK_COMPARE_OP_LESS_OR_EQUAL;
-		depthStencilStateCI.front = depthStencilStateCI.back;
-		depthStencilStateCI.back.compareOp = VK_COMPARE_OP_ALWAYS;
-
-		VkPipelineViewportStateCreateInfo viewportStateCI{};
-		viewportStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-		viewportStateCI.viewportCount = 1;
-		viewportStateCI.scissorCount = 1;
-
-		VkPipelineMultisampleStateCreateInfo multisampleStateCI{};
-		multisampleStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-		multisampleStateCI.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
-
-		std::vector<VkDynamicState> dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
-		VkPipelineDynamicStateCreateInfo dynamicStateCI{};
-		dynamicStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-		dynamicStateCI.pDynamicStates = dynamicStateEnables.data();
-		dynamicStateCI.dynamicStateCount = static_cast<uint32_t>(dynamicStateEnables.size());
-
-		// Vertex input state
-		VkVertexInputBindingDescription vertexInputBinding = { 0, sizeof(vkglTF::Model::Vertex), VK_VERTEX_INPUT_RATE_VERTEX };
-		VkVertexInputAttributeDescription vertexInputAttribute = { 0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0 };
-
-		VkPipelineVertexInputStateCreateInfo vertexInputStateCI{};
-		vertexInputStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-		vertexInputStateCI.vertexBindingDescriptionCount = 1;
-		vertexInputStateCI.pVertexBindingDescriptions = &vertexInputBinding;
-		vertexInputStateCI.vertexAttributeDescriptionCount = 1;
-		vertexInputStateCI.pVertexAttributeDescriptions = &vertexInputAttribute;
-
-		VkShaderModule filtercubeVertShader,
-						filtercubeFragShader;
-		vkutil::pipelinebuilder::loadShaderModule("shader/filtercube.vert.spv", filtercubeVertShader);
-		switch (target)
-		{
-		case ENVIRONMENT:
-			vkutil::pipelinebuilder::loadShaderModule("shader/skyboxfiltercube.frag.spv", filtercubeFragShader);
-			break;
-		case IRRADIANCE:
-			vkutil::pipelinebuilder::loadShaderModule("shader/irradiancecube.frag.spv", filtercubeFragShader);
-			break;
-		case PREFILTEREDENV:
-			vkutil::pipelinebuilder::loadShaderModule("shader/prefilterenvmap.frag.spv", filtercubeFragShader);
-			break;
-		default:
-			filtercubeFragShader = VK_NULL_HANDLE;
-			break;
-		};
+	VkPipelineMultisampleStateCreateInfo multisampleStateCI{};
+	multisampleStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	multisampleStateCI.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 
-		std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages = {
-			vkinit::pipelineShaderStageCreateInfo(VK_SHADER_STAGE_VERTEX_BIT, filtercubeVertShader),
-			vkinit::pipelineShaderStageCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT, filtercubeFragShader),
-		};
+	std::vector<VkDynamicState> dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+	VkPipelineDynamicStateCreateInfo dynamicStateCI{};
+	dynamicStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	dynamicStateCI.pDynamicStates = dynamicStateEnables.data();
+	dynamicStateCI.dynamicStateCount = static_cast<uint32_t>(dynamicStateEnables.size());
 
-		VkGraphicsPipelineCreateInfo pipelineCI{};
-		pipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-		pipelineCI.layout = pipelinelayout;
-		pipelineCI.renderPass = renderpass;
-		pipelineCI.pInputAssemblyState = &inputAssemblyStateCI;
-		pipelineCI.pVertexInputState = &vertexInputStateCI;
-		pipelineCI.pRasterizationState = &rasterizationStateCI;
-		pipelineCI.pColorBlendState = &colorBlendStateCI;
-		pipelineCI.pMultisampleState = &multisampleStateCI;
-		pipelineCI.pViewportState = &viewportStateCI;
-		pipelineCI.pDepthStencilState = &depthStencilStateCI;
-		pipelineCI.pDynamicState = &dynamicStateCI;
-		pipelineCI.stageCount = 2;
-		pipelineCI.pStages = shaderStages.data();
-		pipelineCI.renderPass = renderpass;
-
-		VkPipeline pipeline;
-		VK_CHECK(vkCreateGraphicsPipelines(_device, VK_NULL_HANDLE, 1, &pipelineCI, nullptr, &pipeline));
-		for (auto shaderStage : shaderStages)
-			vkDestroyShaderModule(_device, shaderStage.module, nullptr);
+	// Vertex input state
+	VkVertexInputBindingDescription vertexInputBinding = { 0, sizeof(vkglTF::Model::Vertex), VK_VERTEX_INPUT_RATE_VERTEX };
+	VkVertexInputAttributeDescription vertexInputAttribute = { 0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0 };
+
+	VkPipelineVertexInputStateCreateInfo vertexInputStateCI{};
+	vertexInputStateCI.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	vertexInputStateCI.vertexBindingDescriptionCount = 1;
+	vertexInputStateCI.pVertexBindingDescriptions = &vertexInputBinding;
+	vertexInputStateCI.vertexAttributeDescriptionCount = 1;
+	vertexInputStateCI.pVertexAttributeDescriptions = &vertexInputAttribute;
+
+	VkShaderModule filtercubeVertShader,
+					filtercubeFragShader;
+	vkutil::pipelinebuilder::loadShaderModule("shader/filtercube.vert.spv", filtercubeVertShader);
+	switch (target)
+	{
+	case ENVIRONMENT:
+		vkutil::pipelinebuilder::loadShaderModule("shader/skyboxfiltercube.frag.spv", filtercubeFragShader);
+		break;
+	case IRRADIANCE:
+		vkutil::pipelinebuilder::loadShaderModule("shader/irradiancecube.frag.spv", filtercubeFragShader);
+		break;
+	case PREFILTEREDENV:
+		vkutil::pipelinebuilder::loadShaderModule("shader/prefilterenvmap.frag.spv", filtercubeFragShader);
+		break;
+	default:
+		filtercubeFragShader = VK_NULL_HANDLE;
+		break;
+	};
 
-		//
-		// Render cubemap
-		//
-		VkClearValue clearValues[1];
-		clearValues[0].color = { { 0.0f, 0.0f, 0.2f, 0.0f } };    // @NOTE: the viewport doesn't resize, so when you see this clearcolor in renderdoc don't worry about it  -Timo
-
-		VkRenderPassBeginInfo renderPassBeginInfo{};
-		renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassBeginInfo.renderPass = renderpass;
-		renderPassBeginInfo.framebuffer = offscreen.framebuffer;
-		renderPassBeginInfo.renderArea.extent.width = dim;
-		renderPassBeginInfo.renderArea.extent.height = dim;
-		renderPassBeginInfo.clearValueCount = 1;
-		renderPassBeginInfo.pClearValues = clearValues;
-
-		mat4 matrices[] = {
-			GLM_MAT4_IDENTITY_INIT,
-			GLM_MAT4_IDENTITY_INIT,
-			GLM_MAT4_IDENTITY_INIT,
-			GLM_MAT4_IDENTITY_INIT,
-			GLM_MAT4_IDENTITY_INIT,
-			GLM_MAT4_IDENTITY_INIT,
-		};
+	std::array<VkPipelineShaderStageCreateInfo, 2> shaderStages = {
+		vkinit::pipelineShaderStageCreateInfo(VK_SHADER_STAGE_VERTEX_BIT, filtercubeVertShader),
+		vkinit::pipelineShaderStageCreateInfo(VK_SHADER_STAGE_FRAGMENT_BIT, filtercubeFragShader),
+	};
 
-		vec3 up      = { 0.0f, 1.0f, 0.0f };
-		vec3 right   = { 1.0f, 0.0f, 0.0f };
-		vec3 forward = { 0.0f, 0.0f, 1.0f };
+	VkGraphicsPipelineCreateInfo pipelineCI{};
+	pipelineCI.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	pipelineCI.layout = pipelinelayout;
+	pipelineCI.renderPass = renderpass;
+	pipelineCI.pInputAssemblyState = &inputAssemblyStateCI;
+	pipelineCI.pVertexInputState = &vertexInputStateCI;
+	pipelineCI.pRasterizationState = &rasterizationStateCI;
+	pipelineCI.pColorBlendState = &colorBlendStateCI;
+	pipelineCI.pMultisampleState = &multisampleStateCI;
+	pipelineCI.pViewportState = &viewportStateCI;
+	pipelineCI.pDepthStencilState = &depthStencilStateCI;
+	pipelineCI.pDynamicState = &dynamicStateCI;
+	pipelineCI.stageCount = 2;
+	pipelineCI.pStages = shaderStages.data();
+	pipelineCI.renderPass = renderpass;
 
-		glm_rotate(matrices[0], glm_rad(90.0f), up);
-		glm_rotate(matrices[0], glm_rad(180.0f), right);
+	VkPipeline pipeline;
+	VK_CHECK(vkCreateGraphicsPipelines(_device, vkutil::pipelinecache::getPipelineCache(), 1, &pipelineCI, nullptr, &pipeline));
+	for (auto shaderStage : shaderStages)
+		vkDestroyShaderModule(_device, shaderStage.module, nullptr);
 
-		glm_rotate(matrices[1], glm_rad(-90.0f), up);
-		glm_rotate(matrices[1], glm_rad(180.0f), right);
-		
-		glm_rotate(matrices[2], glm_rad(-90.0f), right);
-		glm_rotate(matrices[3], glm_rad(90.0f), right);
-		glm_rotate(matrices[4], glm_rad(180.0f), right);
-		glm_rotate(matrices[5], glm_rad(180.0f), forward);
+	//
+	// Render cubemap
+	//
+	VkClearValue clearValues[1];
+	clearValues[0].color = { { 0.0f, 0.0f, 0.2f, 0.0f } };    // @NOTE: the viewport doesn't resize, so when you see this clearcolor in renderdoc don't worry about it  -Timo
 
-		VkViewport viewport{};
-		viewport.width = (float_t)dim;
-		viewport.height = (float_t)dim;
-		viewport.minDepth = 0.0f;
-		viewport.maxDepth = 1.0f;
+	VkRenderPassBeginInfo renderPassBeginInfo{};
+	renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassBeginInfo.renderPass = renderpass;
+	renderPassBeginInfo.framebuffer = offscreen.framebuffer;
+	renderPassBeginInfo.renderArea.extent.width = dim;
+	renderPassBeginInfo.renderArea.extent.height = dim;
+	renderPassBeginInfo.clearValueCount = 1;
+	renderPassBeginInfo.pClearValues = clearValues;
 
-		VkRect2D scissor{};
-		scissor.extent.width = dim;
-		scissor.extent.height = dim;
+	mat4 matrices[] = {
+		GLM_MAT4_IDENTITY_INIT,
+		GLM_MAT4_IDENTITY_INIT,
+		GLM_MAT4_IDENTITY_INIT,
+		GLM_MAT4_IDENTITY_INIT,
+		GLM_MAT4_IDENTITY_INIT,
+		GLM_MAT4_IDENTITY_INIT,
+	};
 
-		VkImageSubresourceRange subresourceRange{};
-		subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		subresourceRange.baseMipLevel = 0;
-		subresourceRange.levelCount = numMips;
-		subresourceRange.layerCount = 6;
+	vec3 up      = { 0.0f, 1.0f, 0.0f };
+	vec3 right   = { 1.0f, 0.0f, 0.0f };
+	vec3 forward = { 0.0f, 0.0f, 1.0f };
 
-		// Change image layout for all cubemap faces to transfer destination
-		immediateSubmit([&](VkCommandBuffer cmd) {
-			VkImageMemoryBarrier imageMemoryBarrier{};
-			imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			imageMemoryBarrier.image = cubemapTexture.image._image;
-			imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			imageMemoryBarrier.srcAccessMask = 0;
-			imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			imageMemoryBarrier.subresourceRange = subresourceRange;
-			vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-		});
+	glm_rotate(matrices[0], glm_rad(90.0f), up);
+	glm_rotate(matrices[0], glm_rad(180.0f), right);
+
+	glm_rotate(matrices[1], glm_rad(-90.0f), up);
+	glm_rotate(matrices[1], glm_rad(180.0f), right);
+	
+	glm_rotate(matrices[2], glm_rad(-90.0f), right);
+	glm_rotate(matrices[3], glm_rad(90.0f), right);
+	glm_rotate(matrices[4], glm_rad(180.0f), right);
+	glm_rotate(matrices[5], glm_rad(180.0f), forward);
+
+	VkViewport viewport{};
+	viewport.width = (float_t)dim;
+	viewport.height = (float_t)dim;
+	viewport.minDepth = 0.0f;
+	viewport.maxDepth = 1.0f;
+
+	VkRect2D scissor{};
+	scissor.extent.width = dim;
+	scissor.extent.height = dim;
+
+	VkImageSubresourceRange subresourceRange{};
+	subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+	subresourceRange.baseMipLevel = 0;
+	subresourceRange.levelCount = numMips;
+	subresourceRange.layerCount = 6;
+
+	// Change image layout for all cubemap faces to transfer destination
+	immediateSubmit([&](VkCommandBuffer cmd) {
+		VkImageMemoryBarrier imageMemoryBarrier{};
+		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		imageMemoryBarrier.image = cubemapTexture.image._image;
+		imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageMemoryBarrier.srcAccessMask = 0;
+		imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageMemoryBarrier.subresourceRange = subresourceRange;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+	});
 
-		// Iterate thru all faces and all mips of cubemap convolution
-		for (uint32_t m = 0; m < numMips; m++)
+	// Iterate thru all faces and all mips of cubemap convolution
+	for (uint32_t m = 0; m < numMips; m++)
+	{
+		for (uint32_t f = 0; f < 6; f++)
 		{
-			for (uint32_t f = 0; f < 6; f++)
-			{
-				immediateSubmit([&](VkCommandBuffer cmd) {
-					viewport.width = static_cast<float_t>(dim * std::pow(0.5f, m));
-					viewport.height = static_cast<float_t>(dim * std::pow(0.5f, m));
-					vkCmdSetViewport(cmd, 0, 1, &viewport);
-					vkCmdSetScissor(cmd, 0, 1, &scissor);
-
-					// Render scene from cube face's point of view
-					vkCmdBeginRenderPass(cmd, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-					// Pass parameters for current pass using a push constant block
-					mat4 perspective;
-					glm_perspective((float_t)(M_PI / 2.0), 1.0f, 0.1f, 512.0f, perspective);
-					switch (target)
-					{
-					case ENVIRONMENT:
-						glm_mat4_mul(perspective, matrices[f], pushBlockEnvironment.mvp);
-						glm_vec3_copy(lightDir, pushBlockEnvironment.lightDir);
-						pushBlockEnvironment.sunRadius = 0.15f;
-						pushBlockEnvironment.sunAlpha = 1.0f;
-						vkCmdPushConstants(cmd, pipelinelayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushBlockEnvironment), &pushBlockEnvironment);
-						break;
-					case IRRADIANCE:
-						glm_mat4_mul(perspective, matrices[f], pushBlockIrradiance.mvp);
-						vkCmdPushConstants(cmd, pipelinelayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushBlockIrradiance), &pushBlockIrradiance);
-						break;
-					case PREFILTEREDENV:
-						glm_mat4_mul(perspective, matrices[f], pushBlockPrefilterEnv.mvp);
-						pushBlockPrefilterEnv.roughness = (float_t)m / (float_t)(numMips - 1);
-						vkCmdPushConstants(cmd, pipelinelayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushBlockPrefilterEnv), &pushBlockPrefilterEnv);
-						break;
-					};
+			immediateSubmit([&](VkCommandBuffer cmd) {
+				viewport.width = static_cast<float_t>(dim * std::pow(0.5f, m));
+				viewport.height = static_cast<float_t>(dim * std::pow(0.5f, m));
+				vkCmdSetViewport(cmd, 0, 1, &viewport);
+				vkCmdSetScissor(cmd, 0, 1, &scissor);
+
+				// Render scene from cube face's point of view
+				vkCmdBeginRenderPass(cmd, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+				// Pass parameters for current pass using a push constant block
+				mat4 perspective;
+				glm_perspective((float_t)(M_PI / 2.0), 1.0f, 0.1f, 512.0f, perspective);
+				switch (target)
+				{
+				case ENVIRONMENT:
+					glm_mat4_mul(perspective, matrices[f], pushBlockEnvironment.mvp);
+					glm_vec3_copy(lightDir, pushBlockEnvironment.lightDir);
+					pushBlockEnvironment.sunRadius = PBR_ENVIRONMENT_SUN_RADIUS;
+					pushBlockEnvironment.sunAlpha = PBR_ENVIRONMENT_SUN_ALPHA;
+					vkCmdPushConstants(cmd, pipelinelayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushBlockEnvironment), &pushBlockEnvironment);
+					break;
+				case IRRADIANCE:
+					glm_mat4_mul(perspective, matrices[f], pushBlockIrradiance.mvp);
+					vkCmdPushConstants(cmd, pipelinelayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushBlockIrradiance), &pushBlockIrradiance);
+					break;
+				case PREFILTEREDENV:
+					glm_mat4_mul(perspective, matrices[f], pushBlockPrefilterEnv.mvp);
+					pushBlockPrefilterEnv.roughness = (float_t)m / (float_t)(numMips - 1);
+					vkCmdPushConstants(cmd, pipelinelayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(PushBlockPrefilterEnv), &pushBlockPrefilterEnv);
+					break;
+				};
 
-					vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
-					if (target != ENVIRONMENT)
-						vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelinelayout, 0, 1, &descriptorset, 0, NULL);
+				vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+				if (target != ENVIRONMENT)
+					vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelinelayout, 0, 1, &descriptorset, 0, NULL);
 
-					VkDeviceSize offsets[1] = { 0 };
+				VkDeviceSize offsets[1] = { 0 };
 
-					auto skybox = _roManager->getModel("Box", nullptr, [](){});
-					skybox->bind(cmd);
-					skybox->draw(cmd);
+				auto skybox = _roManager->getModel("Box", nullptr, [](){});
+				skybox->bind(cmd);
+				skybox->draw(cmd);
 
-					vkCmdEndRenderPass(cmd);
+				vkCmdEndRenderPass(cmd);
 
-					VkImageSubresourceRange subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-					subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-					subresourceRange.baseMipLevel = 0;
-					subresourceRange.levelCount = numMips;
-					subresourceRange.layerCount = 6;
+				VkImageSubresourceRange subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+				subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				subresourceRange.baseMipLevel = 0;
+				subresourceRange.levelCount = numMips;
+				subresourceRange.layerCount = 6;
 
-					{
-						VkImageMemoryBarrier imageMemoryBarrier{};
-						imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-						imageMemoryBarrier.image = offscreen.texture.image._image;
-						imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-						imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-						imageMemoryBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-						imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-						imageMemoryBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-						vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-					}
+				{
+					VkImageMemoryBarrier imageMemoryBarrier{};
+					imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+					imageMemoryBarrier.image = offscreen.texture.image._image;
+					imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					imageMemoryBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+					imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+					imageMemoryBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+					vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+				}
 
-					// Copy region for transfer from framebuffer to cube face
-					VkImageCopy copyRegion{};
-
-					copyRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-					copyRegion.srcSubresource.baseArrayLayer = 0;
-					copyRegion.srcSubresource.mipLevel = 0;
-					copyRegion.srcSubresource.layerCount = 1;
-					copyRegion.srcOffset = { 0, 0, 0 };
-
-					copyRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-					copyRegion.dstSubresource.baseArrayLayer = f;
-					copyRegion.dstSubresource.mipLevel = m;
-					copyRegion.dstSubresource.layerCount = 1;
-					copyRegion.dstOffset = { 0, 0, 0 };
-
-					copyRegion.extent.width = static_cast<uint32_t>(viewport.width);
-					copyRegion.extent.height = static_cast<uint32_t>(viewport.height);
-					copyRegion.extent.depth = 1;
-
-					vkCmdCopyImage(
-						cmd,
-						offscreen.texture.image._image,
-						VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-						cubemapTexture.image._image,
-						VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-						1, &copyRegion
-					);
+				// Copy region for transfer from framebuffer to cube face
+				VkImageCopy copyRegion{};
+
+				copyRegion.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				copyRegion.srcSubresource.baseArrayLayer = 0;
+				copyRegion.srcSubresource.mipLevel = 0;
+				copyRegion.srcSubresource.layerCount = 1;
+				copyRegion.srcOffset = { 0, 0, 0 };
+
+				copyRegion.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				copyRegion.dstSubresource.baseArrayLayer = f;
+				copyRegion.dstSubresource.mipLevel = m;
+				copyRegion.dstSubresource.layerCount = 1;
+				copyRegion.dstOffset = { 0, 0, 0 };
+
+				copyRegion.extent.width = static_cast<uint32_t>(viewport.width);
+				copyRegion.extent.height = static_cast<uint32_t>(viewport.height);
+				copyRegion.extent.depth = 1;
+
+				vkCmdCopyImage(
+					cmd,
+					offscreen.texture.image._image,
+					VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					cubemapTexture.image._image,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					1, &copyRegion
+				);
 
-					{
-						VkImageMemoryBarrier imageMemoryBarrier{};
-						imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-						imageMemoryBarrier.image = offscreen.texture.image._image;
-						imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-						imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-						imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-						imageMemoryBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-						imageMemoryBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
-						vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-					}
-				});
-			}
+				{
+					VkImageMemoryBarrier imageMemoryBarrier{};
+					imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+					imageMemoryBarrier.image = offscreen.texture.image._image;
+					imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+					imageMemoryBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+					imageMemoryBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+					vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+				}
+			});
 		}
+	}
 
-		// Change final texture to shader compatible
-		immediateSubmit([&](VkCommandBuffer cmd) {
-			VkImageMemoryBarrier imageMemoryBarrier{};
-			imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-			imageMemoryBarrier.image = cubemapTexture.image._image;
-			imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-			imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-			imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-			imageMemoryBarrier.dstAccessMask = VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
-			imageMemoryBarrier.subresourceRange = subresourceRange;
-			vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-		});
-
-		//
-		// Cleanup
-		//
-		vkDestroyRenderPass(_device, renderpass, nullptr);
-		vkDestroyFramebuffer(_device, offscreen.framebuffer, nullptr);
-		vkDestroyImageView(_device, offscreen.texture.imageView, nullptr);
-		vmaDestroyImage(_allocator, offscreen.texture.image._image, offscreen.texture.image._allocation);
-		vkDestroyDescriptorPool(_device, descriptorpool, nullptr);
-		vkDestroyDescriptorSetLayout(_device, descriptorsetlayout, nullptr);
-		vkDestroyPipeline(_device, pipeline, nullptr);
-		vkDestroyPipelineLayout(_device, pipelinelayout, nullptr);
-
-		_mainDeletionQueue.pushFunction([=]() {
-			vkDestroySampler(_device, cubemapTexture.sampler, nullptr);
-			vkDestroyImageView(_device, cubemapTexture.imageView, nullptr);
-			vmaDestroyImage(_allocator, cubemapTexture.image._image, cubemapTexture.image._allocation);
-		});
-
-		// Apply the created texture/sampler to global scene
-		std::string cubemapTypeName = "";
-		switch (target)
-		{
-		case ENVIRONMENT:
-			cubemapTypeName = "environment";
-			_loadedTextures["CubemapSkybox"] = cubemapTexture;
-			break;
-		case IRRADIANCE:
-			cubemapTypeName = "irradiance";
-			_pbrSceneTextureSet.irradianceCubemap = cubemapTexture;
-			break;
-		case PREFILTEREDENV:
-			cubemapTypeName = "prefilter";
-			_pbrRendering.gpuSceneShadingProps.prefilteredCubemapMipLevels = static_cast<float_t>(numMips);
-			_pbrSceneTextureSet.prefilteredCubemap = cubemapTexture;
-			break;
-		};
+	// Change final texture to shader compatible
+	immediateSubmit([&](VkCommandBuffer cmd) {
+		VkImageMemoryBarrier imageMemoryBarrier{};
+		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+		imageMemoryBarrier.image = cubemapTexture.image._image;
+		imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageMemoryBarrier.dstAccessMask = VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+		imageMemoryBarrier.subresourceRange = subresourceRange;
+		vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+	});
 
-		// Report time it took
-		auto tEnd = std::chrono::high_resolution_clock::now();
-		auto tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-		std::cout << "[GENERATING PBR CUBEMAP]" << std::endl
-			<< "type:               " << cubemapTypeName << std::endl
-			<< "mip levels:         " << numMips << std::endl
-			<< "execution duration: " << tDiff << " ms" << std::endl;
-	}
+	//
+	// Cleanup
+	//
+	vkDestroyRenderPass(_device, renderpass, nullptr);
+	vkDestroyFramebuffer(_device, offscreen.framebuffer, nullptr);
+	vkDestroyImageView(_device, offscreen.texture.imageView, nullptr);
+	vmaDestroyImage(_allocator, offscreen.texture.image._image, offscreen.texture.image._allocation);
+	vkDestroyDescriptorPool(_device, descriptorpool, nullptr);
+	vkDestroyDescriptorSetLayout(_device, descriptorsetlayout, nullptr);
+	vkDestroyPipeline(_device, pipeline, nullptr);
+	vkDestroyPipelineLayout(_device, pipelinelayout, nullptr);
 }
 
 void VulkanEngine::generateBRDFLUT()
 {
-	//
-	// @NOTE: this function was copied and very slightly modified from Sascha Willem's Vulkan-glTF-PBR example.
-	//
 	auto tStart = std::chrono::high_resolution_clock::now();
 
 	//
 	// Setup
 	//
 	const VkFormat format = VK_FORMAT_R16G16_SFLOAT;
+	const uint32_t texelSize = 4;
 	const int32_t dim = 512;
 
+	uint64_t cacheKey = pbrtexturecache::hashFile("shader/genbrdflut.vert.spv");
+	cacheKey = pbrtexturecache::hashFile("shader/genbrdflut.frag.spv", cacheKey);
+	cacheKey = pbrtexturecache::hashBytes(&format, sizeof(format), cacheKey);
+	cacheKey = pbrtexturecache::hashBytes(&dim, sizeof(dim), cacheKey);
+	cacheKey = pbrtexturecache::hashBytes(&PBR_BRDF_LUT_NUM_SAMPLES, sizeof(uint32_t), cacheKey);
+
 	// Image
 	VkImageCreateInfo imageCI{};
 	imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
@@ -5553,7 +5500,7 @@ void VulkanEngine::generateBRDFLUT()
 	imageCI.arrayLayers = 1;
 	imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
 	imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
-	imageCI.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+	imageCI.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;  // @NOTE: TRANSFER_* are for the cache.
 	VmaAllocationCreateInfo imageAllocInfo = {
 		.usage = VMA_MEMORY_USAGE_GPU_ONLY,
 	};
@@ -5588,6 +5535,57 @@ void VulkanEngine::generateBRDFLUT()
 	};
 	VK_CHECK(vkCreateSampler(_device, &samplerCI, nullptr, &brdfLUTTexture.sampler));
 
+	// Load from the cache, or render and then save to the cache
+	const std::string cacheFname = PBR_CACHE_DIRECTORY + "pbr_brdf_lut.hpbr";
+	pbrtexturecache::CachedImage cachedImage;
+	bool loadedFromCache =
+		pbrtexturecache::loadCachedImage(cacheFname, cacheKey, cachedImage) &&
+		vkutil::uploadImageLayers(*this, brdfLUTTexture.image._image, texelSize, dim, dim, 1, 1, cachedImage.data);
+	if (!loadedFromCache)
+	{
+		renderBRDFLUT(brdfLUTTexture, format, dim);
+
+		cachedImage = {
+			.key = cacheKey,
+			.format = (uint32_t)format,
+			.texelSize = texelSize,
+			.width = (uint32_t)dim,
+			.height = (uint32_t)dim,
+			.mipLevels = 1,
+			.layerCount = 1,
+		};
+		if (vkutil::readbackImage(*this, brdfLUTTexture.image._image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, texelSize, dim, dim, 1, 1, cachedImage.data))
+		{
+#ifdef _DEVELOP
+			// Check the freshly rendered LUT against the CPU reference before it goes into the cache.
+			pbrtexturecache::BRDFLUTValidation validation = pbrtexturecache::validateBRDFLUT((const uint16_t*)cachedImage.data.data(), dim, PBR_BRDF_LUT_NUM_SAMPLES, 32);
+			std::cout << "[VALIDATING BRDF LUT]" << std::endl
+				<< "texels checked:     " << validation.numTexelsChecked << std::endl
+				<< "max error:          " << validation.maxError << std::endl
+				<< "avg error:          " << validation.avgError << std::endl;
+#endif
+			pbrtexturecache::saveCachedImage(cacheFname, cachedImage);
+		}
+	}
+
+	_mainDeletionQueue.pushTexture(_device, _allocator, brdfLUTTexture);
+
+	// Apply the created texture/sampler to global scene
+	_pbrSceneTextureSet.brdfLUTTexture = brdfLUTTexture;
+
+	// Report time it took
+	auto tEnd = std::chrono::high_resolution_clock::now();
+	auto tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+	std::cout << "[GENERATING BRDF LUT]" << std::endl
+		<< "source:             " << (loadedFromCache ? "cache" : "generated") << std::endl
+		<< "execution duration: " << tDiff << " ms" << std::endl;
+}
+
+void VulkanEngine::renderBRDFLUT(Texture& brdfLUTTexture, VkFormat format, int32_t dim)
+{
+	//
+	// @NOTE: this function was copied and very slightly modified from Sascha Willem's Vulkan-glTF-PBR example.
+	//
 	// FB, Att, RP, Pipe, etc.
 	VkAttachmentDescription attDesc{};
 	// Color attachment
@@ -5736,7 +5734,7 @@ void VulkanEngine::generateBRDFLUT()
 
 	// Look-up-table (from BRDF) pipeline
 	VkPipeline pipeline;
-	VK_CHECK(vkCreateGraphicsPipelines(_device, VK_NULL_HANDLE, 1, &pipelineCI, nullptr, &pipeline));
+	VK_CHECK(vkCreateGraphicsPipelines(_device, vkutil::pipelinecache::getPipelineCache(), 1, &pipelineCI, nullptr, &pipeline));
 	for (auto shaderStage : shaderStages)
 		vkDestroyShaderModule(_device, shaderStage.module, nullptr);
 
@@ -5786,21 +5784,6 @@ void VulkanEngine::generateBRDFLUT()
 	vkDestroyRenderPass(_device, renderpass, nullptr);
 	vkDestroyFramebuffer(_device, framebuffer, nullptr);
 	vkDestroyDescriptorSetLayout(_device, descriptorsetlayout, nullptr);
-
-	_mainDeletionQueue.pushFunction([=]() {
-		vkDestroySampler(_device, brdfLUTTexture.sampler, nullptr);
-		vkDestroyImageView(_device, brdfLUTTexture.imageView, nullptr);
-		vmaDestroyImage(_allocator, brdfLUTTexture.image._image, brdfLUTTexture.image._allocation);
-		});
-
-	// Apply the created texture/sampler to global scene
-	_pbrSceneTextureSet.brdfLUTTexture = brdfLUTTexture;
-
-	// Report time it took
-	auto tEnd = std::chrono::high_resolution_clock::now();
-	auto tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-	std::cout << "[GENERATING BRDF LUT]" << std::endl
-		<< "execution duration: " << tDiff << " ms" << std::endl;
 }
 
 void VulkanEngine::initImgui()
@@ -5848,6 +5831,7 @@ void VulkanEngine::initImgui()
 		.PhysicalDevice = _chosenGPU,
 		.Device = _device,
 		.Queue = _graphicsQueue,
+		.PipelineCache = vkutil::pipelinecache::getPipelineCache(),
 		.DescriptorPool = imguiPool,
 		.MinImageCount = 3,
 		.ImageCount = 3,
@@ -5904,11 +5888,27 @@ void VulkanEngine::recreateSwapchain()
 	_recreateSwapchain = false;
 }
 
+#ifdef _DEVELOP
+void VulkanEngine::reloadChangedShaders()
+{
+	// @NOTE: only the pipelines that use a changed shader get rebuilt (the rest of the
+	//        swapchain dependent resources are left alone).
+	vkDeviceWaitIdle(_device);
+	vkutil::pipelinebuilder::rebuildPipelinesUsingShaders(_changedShaderFilenames);
+	_changedShaderFilenames.clear();
+}
+#endif
+
 FrameData& VulkanEngine::getCurrentFrame()
 {
 	return _frames[_frameNumber % FRAME_OVERLAP];
 }
 
+FrameArena& VulkanEngine::getCurrentFrameArena()
+{
+	return getCurrentFrame().frameArena;
+}
+
 void VulkanEngine::loadMeshes()
 {
 #define MULTITHREAD_MESH_LOADING 1
@@ -5938,6 +5938,7 @@ void VulkanEngine::loadMeshes()
 #if MULTITHREAD_MESH_LOADING
 		taskflow.emplace([&, targetIndex, pathString]() {
 #endif
+			PROFILE_ZONE("Load Model");
 			modelNameAndModels[targetIndex].second = new vkglTF::Model();
 			modelNameAndModels[targetIndex].second->loadFromFile(this, pathString);
 #if MULTITHREAD_MESH_LOADING
@@ -5970,7 +5971,7 @@ void VulkanEngine::uploadCurrentFrameToGPU(const FrameData& currentFrame)
 	vmaUnmapMemory(_allocator, currentFrame.pbrShadingPropsBuffer._allocation);
 }
 
-void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame, std::vector<size_t> onlyPoolIndices, std::vector<ModelWithIndirectDrawId>& outIndirectDrawCommandIdsForPoolIndex)
+void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame, const std::vector<size_t>& onlyPoolIndices, std::vector<ModelWithIndirectDrawId>& outIndirectDrawCommandIdsForPoolIndex)
 {
 	std::lock_guard<std::mutex> lg(_roManager->renderObjectIndicesAndPoolMutex);
 
@@ -5989,10 +5990,16 @@ void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame,
 		);		// Another evil pointer trick I love... call me Dmitri the Evil
 	vmaUnmapMemory(_allocator, currentFrame.objectBuffer._allocation);
 
+	// Pre-skinning jobs get added back below for the visible skinned render objects.
+	vkglTF::Animator::clearPreskinningJobs(this);
+
 	//
 	// Cull out render object indices that are not marked as visible
+	// @NOTE: the containers here only live until the end of this function, so they go in the frame arena.
 	//
-	std::vector<size_t> visibleIndices;
+	FrameArena& arena = getCurrentFrameArena();
+	FrameVector<size_t> visibleIndices{ FrameArenaAllocator<size_t>(arena) };
+	visibleIndices.reserve(_roManager->_renderObjectsIndices.size());
 	for (size_t i = 0; i < _roManager->_renderObjectsIndices.size(); i++)
 	{
 		size_t poolIndex = _roManager->_renderObjectsIndices[i];
@@ -6006,6 +6013,11 @@ void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame,
 
 		// It's visible!!!!
 		visibleIndices.push_back(poolIndex);
+
+		// Skin it once up front for all the passes
+		if (_preskinning && _skinningPipeline != VK_NULL_HANDLE && object.animator != nullptr)
+			for (GPUInstancePointer& gip : object.calculatedModelInstances)
+				vkglTF::Animator::addPreskinningJob(this, gip.animatorNodeID, object.model);
 	}
 
 	//
@@ -6017,7 +6029,8 @@ void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame,
 		size_t drawCount;
 		size_t baseModelRenderObjectIndex;
 	};
-	std::vector<ModelDrawCount> mdcs;
+	FrameVector<ModelDrawCount> mdcs{ FrameArenaAllocator<ModelDrawCount>(arena) };
+	mdcs.reserve(visibleIndices.size());
 
 	vkglTF::Model* lastModel = nullptr;
 	for (size_t roIdx = 0; roIdx < visibleIndices.size(); roIdx++)
@@ -6041,7 +6054,7 @@ void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame,
 	//
 	// Gather each model's meshes and collate them into their own draw commands
 	//
-	std::vector<MeshCapturedInfo> meshDraws;
+	FrameVector<MeshCapturedInfo> meshDraws{ FrameArenaAllocator<MeshCapturedInfo>(arena) };
 	for (ModelDrawCount& mdc : mdcs)
 	{
 		uint32_t numMeshes = 0;
@@ -6070,8 +6083,10 @@ void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame,
 
 	//
 	// Write indirect commands
+	// @NOTE: `indirectBatches` is a member so that it keeps its capacity between frames.
 	//
-	std::vector<IndirectBatch> batches;
+	std::vector<IndirectBatch>& batches = indirectBatches;
+	batches.clear();
 	lastModel = nullptr;
 	size_t instanceID = 0;
 	size_t meshIndex = 0;
@@ -6132,7 +6147,6 @@ void VulkanEngine::compactRenderObjectsIntoDraws(const FrameData& currentFrame,
 	// Cleanup and return
 	vmaUnmapMemory(_allocator, currentFrame.instancePtrBuffer._allocation);
 	vmaUnmapMemory(_allocator, currentFrame.indirectDrawCommandBuffer._allocation);
-	indirectBatches = batches;
 }
 
 void VulkanEngine::renderRenderObjects(VkCommandBuffer cmd, const FrameData& currentFrame)
@@ -6169,9 +6183,9 @@ void VulkanEngine::renderPickedObject(VkCommandBuffer cmd, const FrameData& curr
 	// @BUG: recompacting and reuploading the picked pool index will overwrite the first mesh drawn's instance ptr information, so making a new system would be great, or not since this is just a debug feature.
 	//
 	constexpr size_t numRenders = 2;
-	std::string materialNames[numRenders] = {
-		"wireframeColorMaterial",
-		"wireframeColorBehindMaterial"
+	MaterialHandle materialHandles[numRenders] = {
+		_materialHandles.wireframeColor,
+		_materialHandles.wireframeColorBehind,
 	};
 	vec4 materialColors[numRenders] = {
 		{ 1, 0.25, 1, 1 },
@@ -6180,7 +6194,7 @@ void VulkanEngine::renderPickedObject(VkCommandBuffer cmd, const FrameData& curr
 
 	for (size_t i = 0; i < numRenders; i++)
 	{
-		Material& material = *getMaterial(materialNames[i]);
+		Material& material = *getMaterial(materialHandles[i]);
 
 		vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, material.pipeline);
 		vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, material.pipelineLayout, 0, 1, &currentFrame.globalDescriptor, 0, nullptr);
@@ -6231,6 +6245,20 @@ void VulkanEngine::updateDebugStats(const float_t& deltaTime)
 	_debugStats.renderTimesMS[_debugStats.renderTimesMSHeadIndex] =
 		_debugStats.renderTimesMS[_debugStats.renderTimesMSHeadIndex + _debugStats.renderTimesMSCount] =
 		renderTime;
+
+	// Grab the latest GPU pass timings
+	_debugStats.gpuTimings = gputimestamps::getLatestTimings();
+
+	_debugStats.uiQuadReorders = ui::getNumReordersLastFrame();
+
+	// @NOTE: an arena's stats are from the last frame that used it (i.e. `FRAME_OVERLAP` frames ago).
+	const FrameArena::Stats& arenaStats = getCurrentFrameArena().getStats();
+	_debugStats.frameArenaUsedBytes = arenaStats.usedLastFrame;
+	_debugStats.frameArenaOverflows = arenaStats.overflowAllocationsLastFrame;
+	_debugStats.preskinnedVertices = vkglTF::Animator::getNumPreskinnedVertices(this);
+	_debugStats.frameArenaHighWaterBytes = 0;
+	for (size_t i = 0; i < FRAME_OVERLAP; i++)
+		_debugStats.frameArenaHighWaterBytes = std::max(_debugStats.frameArenaHighWaterBytes, _frames[i].frameArena.getStats().highWater);
 }
 #endif
 
@@ -6367,6 +6395,27 @@ void VulkanEngine::renderImGuiContent(float_t deltaTime, ImGuiIO& io)
 
 		ImGui::Separator();
 
+		ImGui::Text((std::string("Command Recording (") + (_debugStats.recordedInParallel ? "parallel" : "serial") + ")").c_str());
+		std::string cascadeTimes = "Shadow Cascades:";
+		for (uint32_t i = 0; i < SHADOWMAP_CASCADES; i++)
+			cascadeTimes += " " + std::format("{:.2f}", _debugStats.recordingJobTimesMS[RECORDING_JOB_SHADOW_CASCADE_0 + i]);
+		ImGui::Text((cascadeTimes + "ms").c_str());
+		ImGui::Text(("Main ZPrepass: " + std::format("{:.2f}", _debugStats.recordingJobTimesMS[RECORDING_JOB_MAIN_ZPREPASS]) + "ms  Opaque: " + std::format("{:.2f}", _debugStats.recordingJobTimesMS[RECORDING_JOB_MAIN_OPAQUE]) + "ms").c_str());
+		ImGui::Text(("Secondaries (wall): " + std::format("{:.2f}", _debugStats.recordSecondariesMS) + "ms").c_str());
+		ImGui::Text(("UI: " + std::format("{:.2f}", _debugStats.recordUIMS) + "ms  Postprocess: " + std::format("{:.2f}", _debugStats.recordPostprocessMS) + "ms").c_str());
+		ImGui::Text(("UI Quad Reorders: " + std::to_string(_debugStats.uiQuadReorders)).c_str());
+		ImGui::Text(("Frame Arena: " + std::format("{:.1f}", _debugStats.frameArenaUsedBytes / 1024.0) + "KB  (high water " + std::format("{:.1f}", _debugStats.frameArenaHighWaterBytes / 1024.0) + "KB / " + std::to_string(FRAME_ARENA_CAPACITY / 1024) + "KB)  Overflows: " + std::to_string(_debugStats.frameArenaOverflows)).c_str());
+		ImGui::Text(("Pre-skinned Vertices: " + std::to_string(_debugStats.preskinnedVertices) + " / " + std::to_string(MAX_NUM_PRESKINNED_VERTICES)).c_str());
+
+		ImGui::Separator();
+
+		ImGui::Text(("GPU Pass Times (frame " + std::to_string(_debugStats.gpuTimings.frameNumber) + "): " + std::format("{:.2f}", _debugStats.gpuTimings.frameMS) + "ms").c_str());
+		for (uint32_t i = 0; i < gputimestamps::NUM_GPU_PASSES; i++)
+			if (_debugStats.gpuTimings.passWritten[i])
+				ImGui::Text((std::string(gputimestamps::getPassName((gputimestamps::GPUPass)i)) + ": " + std::format("{:.3f}", _debugStats.gpuTimings.passMS[i]) + "ms").c_str());
+
+		ImGui::Separator();
+
 		physengine::renderImguiPerformanceStats();
 
 		debugStatsWindowWidth = ImGui::GetWindowWidth();
@@ -6387,6 +6436,20 @@ void VulkanEngine::renderImGuiContent(float_t deltaTime, ImGuiIO& io)
 	}
 	ImGui::End();
 
+#if PROFILER_ENABLED
+	//
+	// Profiler window
+	//
+	ImGui::SetNextWindowPos(ImVec2(_windowExtent.width * 0.5f, 0.0f), ImGuiCond_FirstUseEver, ImVec2(0.5f, 0.0f));
+	ImGui::SetNextWindowSize(ImVec2(_windowExtent.width * 0.5f, 320.0f), ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+	ImGui::Begin("Profiler");
+	{
+		profiler::renderImGuiFlameView();
+	}
+	ImGui::End();
+#endif
+
 
 	//
 	// PBR Shading Properties
@@ -6519,6 +6582,15 @@ void VulkanEngine::renderImGuiContent(float_t deltaTime, ImGuiIO& io)
 		if (ImGui::CollapsingHeader("Debug Properties", ImGuiTreeNodeFlags_DefaultOpen))
 		{
 			ImGui::DragFloat("scrollSpeed", &scrollSpeed);
+			ImGui::Checkbox("parallelCommandRecording", &_parallelCommandRecording);
+			ImGui::Checkbox("preskinning", &_preskinning);
+			if (gputimestamps::isExportingCSV())
+			{
+				if (ImGui::Button("Stop GPU Timings CSV"))
+					gputimestamps::stopCSVExport();
+			}
+			else if (ImGui::Button("Export GPU Timings CSV"))
+				gputimestamps::startCSVExport("gpu_timings.csv");
 		}
 
 		if (ImGui::CollapsingHeader("Physics Properties", ImGuiTreeNodeFlags_DefaultOpen))
@@ -5,6 +5,8 @@
 #include "VkDataStructures.h"
 #include "EntityManager.h"
 #include "SceneManagement.h"
+#include "GPUTimestamps.h"
+#include "FrameArena.h"
 
 
 struct RenderObject;
@@ -53,16 +55,6 @@ struct ColorPushConstBlock
 	vec4 color;
 };
 
-struct UIQuadSettingsConstBlock
-{
-	vec4 tint;
-	float_t useNineSlicing;
-	float_t nineSlicingBoundX1;
-	float_t nineSlicingBoundX2;
-	float_t nineSlicingBoundY1;
-	float_t nineSlicingBoundY2;
-};
-
 struct GPUCoCParams
 {
 	float_t cameraZNear;
@@ -92,6 +84,15 @@ struct GPUPostProcessParams
 	bool pad2;  // Vulkan spec requires multiple of 4 bytes for push constants.
 };
 
+// @NOTE: the shadow cascades and both subpasses of the main renderpass get recorded into secondary
+//        command buffers on worker threads, then get stitched together into the main command buffer
+//        in pass order. Each recording job has its own command pool (per frame), since a command pool
+//        can only be used by one thread at a time.
+constexpr uint32_t RECORDING_JOB_SHADOW_CASCADE_0 = 0;
+constexpr uint32_t RECORDING_JOB_MAIN_ZPREPASS    = SHADOWMAP_CASCADES;
+constexpr uint32_t RECORDING_JOB_MAIN_OPAQUE      = SHADOWMAP_CASCADES + 1;
+constexpr uint32_t NUM_RECORDING_JOBS             = SHADOWMAP_CASCADES + 2;
+
 struct FrameData
 {
 	VkSemaphore presentSemaphore, renderSemaphore;
@@ -102,6 +103,9 @@ struct FrameData
 	VkCommandBuffer pickingCommandBuffer;
 	AllocatedBuffer indirectDrawCommandBuffer;
 
+	VkCommandPool recordingJobCommandPools[NUM_RECORDING_JOBS];
+	VkCommandBuffer recordingJobCommandBuffers[NUM_RECORDING_JOBS];  // Secondary command buffers.
+
 	AllocatedBuffer cameraBuffer;
 	AllocatedBuffer pbrShadingPropsBuffer;
 	VkDescriptorSet globalDescriptor;
@@ -117,6 +121,8 @@ struct FrameData
 
 	AllocatedBuffer pickingSelectedIdBuffer;
 	VkDescriptorSet pickingReturnValueDescriptor;
+
+	FrameArena frameArena;  // Transient CPU data. Gets reset right after `renderFence` is waited on.
 };
 
 struct UploadContext
@@ -133,7 +139,13 @@ public:
 	void run();
 	void cleanup();
 
+	// Steps the game at a fixed delta time off of an input recording w/o rendering anything, and writes
+	// each frame's timings and state hash into `reportPath` (CSV). Needs `_headless` set before `init()`.
+	int32_t runHeadless(const std::string& inputReplayPath, const std::string& reportPath);
+
 	bool _isInitialized{ false };
+	bool _headless{ false };        // Keeps the window hidden and puts physics into lockstep.
+	std::string _recordInputPath;   // If set, `run()` records all input into this file (for `runHeadless()`).
 	uint32_t _frameNumber{ 0 };
 
 	VkExtent2D _windowExtent{ 1920, 1080 };
@@ -150,6 +162,7 @@ public:
 	VkDebugUtilsMessengerEXT _debugMessenger;		// Vulkan debug output handle
 	VkPhysicalDevice _chosenGPU;					// GPU chosen as the default device
 	VkPhysicalDeviceProperties _gpuProperties;
+	bool _supportsTextureCompressionBC = false;
 	VkDevice _device;								// Vulkan device for commands
 	VkSurfaceKHR _surface;							// Vulkan window surface
 
@@ -268,6 +281,9 @@ public:
 	// VMA Lib Allocator
 	VmaAllocator _allocator;
 
+	// Worker threads for batches of loading work (e.g. texture decoding), so each batch doesn't spin up its own.
+	tf::Executor _loadingExecutor;
+
 	void render();		// @TODO: Why is this public?
 
 	//
@@ -301,10 +317,37 @@ public:
 	//
 	RenderObjectManager* _roManager;
 
-	std::unordered_map<std::string, Material> _materials;
+	std::deque<Material> _materials;  // @NOTE: a deque so that `Material*`s stay valid when more materials get created.
+	std::unordered_map<std::string, MaterialHandle> _materialNameToHandle;
+	MaterialHandle createMaterial(const std::string& name);  // Returns the existing handle if `name` was already created.
 	Material* attachPipelineToMaterial(VkPipeline pipeline, VkPipelineLayout layout, const std::string& name);
 	Material* attachTextureSetToMaterial(VkDescriptorSet textureSet, const std::string& name);
-	Material* getMaterial(const std::string& name);
+	Material* getMaterial(MaterialHandle handle);
+	Material* getMaterial(const std::string& name);  // Load time and editor use only. Render code should use a handle.
+	MaterialHandle findMaterialHandle(const std::string& name);
+
+	// Materials that get used every frame.
+	struct MaterialHandles
+	{
+		MaterialHandle pbr;
+		MaterialHandle pbrZPrepass;
+		MaterialHandle picking;
+		MaterialHandle shadowDepthPass;
+		MaterialHandle wireframeColor;
+		MaterialHandle wireframeColorBehind;
+		MaterialHandle CoC;
+		MaterialHandle halveCoC;
+		MaterialHandle incrementalReductionHalveCoC[NUM_INCREMENTAL_COC_REDUCTIONS];
+		MaterialHandle blurXSingleChannel;
+		MaterialHandle blurYSingleChannel;
+		MaterialHandle gatherDOF;
+		MaterialHandle DOFFloodFill;
+		MaterialHandle postprocess;
+	} _materialHandles;
+	void initMaterialHandles();
+#ifdef _DEVELOP
+	void benchmarkMaterialLookups();
+#endif
 
 	struct PBRSceneTextureSet    // @NOTE: these are the textures that are needed for any type of pbr scene (i.e. the irradiance, prefilter, and brdf maps)
 	{
@@ -326,6 +369,7 @@ public:
 	VkDescriptorSetLayout _pbrTexturesSetLayout;
 	VkDescriptorSetLayout _pickingReturnValueSetLayout;
 	VkDescriptorSetLayout _skeletalAnimationSetLayout;    // @NOTE: for this one, descriptor sets are created inside of the vkglTFModels themselves, they're not global
+	VkDescriptorSetLayout _skinningVerticesSetLayout;     // @NOTE: same here. Each skinned model builds its own once it gets pre-skinned.
 	VkDescriptorSetLayout _postprocessSetLayout;
 
 	AllocatedBuffer createBuffer(size_t allocSize, VkBufferUsageFlags usage, VmaMemoryUsage memoryUsage);
@@ -333,6 +377,7 @@ public:
 
 #ifdef _DEVELOP
 	bool generateCollisionDebugVisualization = false;
+	std::vector<std::string> _changedShaderFilenames;  // Filled in by the hotswap thread (guarded by its mutex).
 #endif
 
 	// Upload context
@@ -355,13 +400,19 @@ private:
 	void initDescriptors();
 	void initPipelines();
 	void generatePBRCubemaps();
+	void renderPBRCubemap(uint32_t target, Texture& cubemapTexture, VkFormat format, int32_t dim, uint32_t numMips);
 	void generateBRDFLUT();
+	void renderBRDFLUT(Texture& brdfLUTTexture, VkFormat format, int32_t dim);
 	void initImgui();
 
 	void recreateSwapchain();
+#ifdef _DEVELOP
+	void reloadChangedShaders();
+#endif
 
 	FrameData _frames[FRAME_OVERLAP];
 	FrameData& getCurrentFrame();
+	FrameArena& getCurrentFrameArena();
 
 	void loadMeshes();
 
@@ -378,7 +429,7 @@ private:
 	void compactRenderObjectsIntoDraws(
 		const FrameData& currentFrame,
 #ifdef _DEVELOP
-		std::vector<size_t> onlyPoolIndices,
+		const std::vector<size_t>& onlyPoolIndices,
 		std::vector<ModelWithIndirectDrawId>& outIndirectDrawCommandIdsForPoolIndex
 #endif
 		);
@@ -388,8 +439,22 @@ private:
 	void renderPickedObject(VkCommandBuffer cmd, const FrameData& currentFrame, const std::vector<ModelWithIndirectDrawId>& indirectDrawCommandIds);
 
 	void renderPickingRenderpass(const FrameData& currentFrame);
+
+	bool _parallelCommandRecording = true;
+	tf::Executor _commandRecordingExecutor{ NUM_RECORDING_JOBS };
+	float_t _recordingJobTimesMS[NUM_RECORDING_JOBS] = {};
+	void recordSecondaryCommandBuffers(const FrameData& currentFrame, const std::vector<ModelWithIndirectDrawId>& pickingIndirectDrawCommandIds);
+	void recordShadowCascade(const FrameData& currentFrame, VkCommandBuffer cmd, uint32_t cascadeIndex);
+	void recordMainZPrepass(const FrameData& currentFrame, VkCommandBuffer cmd);
+	void recordMainOpaque(const FrameData& currentFrame, VkCommandBuffer cmd, const std::vector<ModelWithIndirectDrawId>& pickingIndirectDrawCommandIds);
+
+	bool _preskinning = true;
+	VkPipeline _skinningPipeline = VK_NULL_HANDLE;
+	VkPipelineLayout _skinningPipelineLayout = VK_NULL_HANDLE;
+	void renderPreskinningPass(VkCommandBuffer cmd);
+
 	void renderShadowRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd);
-	void renderMainRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd, const std::vector<ModelWithIndirectDrawId>& pickingIndirectDrawCommandIds);
+	void renderMainRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd);
 	void renderUIRenderpass(VkCommandBuffer cmd);
 	void renderPostprocessRenderpass(const FrameData& currentFrame, VkCommandBuffer cmd, uint32_t swapchainImageIndex);
 
@@ -464,6 +529,20 @@ private:
 		size_t renderTimesMSCount = 256;
 		float_t renderTimesMS[256 * 2];
 		float_t highestRenderTime = -1.0f;
+
+		// CPU command recording times of the last frame.
+		float_t recordingJobTimesMS[NUM_RECORDING_JOBS] = {};
+		float_t recordSecondariesMS = 0.0f;  // Wall time of recording all the secondary command buffers.
+		float_t recordUIMS = 0.0f;
+		float_t recordPostprocessMS = 0.0f;
+		bool    recordedInParallel = true;
+		uint32_t uiQuadReorders = 0;
+		size_t   frameArenaUsedBytes = 0;
+		size_t   frameArenaHighWaterBytes = 0;
+		uint32_t frameArenaOverflows = 0;
+		uint32_t preskinnedVertices = 0;
+
+		gputimestamps::FrameTimings gpuTimings;  // @NOTE: `FRAME_OVERLAP` frames behind.
 	} _debugStats;
 	void updateDebugStats(const float_t& deltaTime);
 